@@ -0,0 +1,89 @@
+/**
+ * @file BenchmarkData.cpp
+ * @brief Test data for the benchmarks, generated by the stand-in server fixtures
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "BenchmarkData.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include "backend/Storage.h"
+#include "log/Logger.h"
+
+namespace Mattermost {
+
+SyntheticParams singleChannelParams (int users, int postsPerChannel)
+{
+	SyntheticParams params;
+	params.teams = 1;
+	params.channelsPerTeam = 1;
+	params.directChannels = 0;
+	params.users = users;
+	params.postsPerChannel = postsPerChannel;
+	return params;
+}
+
+QByteArray getSyntheticResponse (SyntheticFixtures& fixtures, const QString& path)
+{
+	HttpRequest request;
+	request.method = "GET";
+	request.target = "/api/v4/" + path;
+
+	HttpResponse response;
+
+	if (!fixtures.respond (request, response)) {
+		qFatal ("No synthetic response for %s", qPrintable (path));
+	}
+
+	return response.body;
+}
+
+void fillStorage (Storage& storage, SyntheticFixtures& fixtures)
+{
+	for (const QJsonObject& user: fixtures.getUsers()) {
+		storage.addUser (user, storage.users.empty());
+	}
+}
+
+void fillStorageChannels (Storage& storage, SyntheticFixtures& fixtures)
+{
+	for (const QJsonObject& team: fixtures.getTeams()) {
+		storage.addTeam (team);
+	}
+
+	for (const QJsonObject& channel: fixtures.getChannels()) {
+		BackendTeam* team = storage.getTeamById (channel.value("team_id").toString());
+
+		if (team) {
+			storage.addTeamScopeChannel (*team, channel);
+		} else {
+			storage.addDirectChannel (channel);
+		}
+	}
+}
+
+void setBenchmarkLogLevel ()
+{
+	Logger::instance().setLevel (LogLevel::warning);
+}
+
+} /* namespace Mattermost */
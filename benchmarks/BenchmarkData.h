@@ -0,0 +1,74 @@
+/**
+ * @file BenchmarkData.h
+ * @brief Test data for the benchmarks, generated by the stand-in server fixtures
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QNetworkReply>
+#include "SyntheticFixtures.h"
+
+namespace Mattermost {
+
+class Storage;
+
+/**
+ * Data set with a single team and a single channel
+ */
+SyntheticParams singleChannelParams (int users, int postsPerChannel);
+
+/**
+ * Body of a GET request to the synthetic data set, for example "channels/<id>/posts?page=0&per_page=200"
+ */
+QByteArray getSyntheticResponse (SyntheticFixtures& fixtures, const QString& path);
+
+/**
+ * Add all users of the data set to the storage
+ */
+void fillStorage (Storage& storage, SyntheticFixtures& fixtures);
+
+/**
+ * Add all teams, team channels and direct channels of the data set to the storage. The users must be added first
+ */
+void fillStorageChannels (Storage& storage, SyntheticFixtures& fixtures);
+
+/**
+ * Only log warnings and errors, so that logging does not affect the results
+ */
+void setBenchmarkLogLevel ();
+
+/**
+ * Reply, passed to HTTP response callbacks, which do not use it
+ */
+class NullReply: public QNetworkReply {
+public:
+	void abort () override {}
+protected:
+	qint64 readData (char*, qint64) override
+	{
+		return -1;
+	}
+};
+
+} /* namespace Mattermost */
@@ -0,0 +1,214 @@
+/**
+ * @file ChannelPostsBenchmark.cpp
+ * @brief Benchmark of merging post pages into a channel (BackendChannel::addPosts / addPostsBefore)
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include "BenchmarkData.h"
+#include "backend/Storage.h"
+#include "backend/types/BackendChannel.h"
+#include "backend/emoji/EmojiInfo.h"
+#include "log/ProcessMemory.h"
+
+using namespace Mattermost;
+
+class ChannelPostsBenchmark: public QObject {
+	Q_OBJECT
+private:
+	struct PostsPage {
+		QJsonArray	order;
+		QJsonObject	posts;
+	};
+
+	PostsPage getPage (const QString& query);
+private slots:
+	void initTestCase ();
+
+	void addPostsInitial_data ();
+	void addPostsInitial ();
+
+	/**
+	 * Initial load, followed by a page, which contains the 10 newest posts and 50 already known posts
+	 * (the sync after a reconnect). The difference to addPostsInitial is the cost of the merge
+	 */
+	void addPostsSync ();
+
+	void prependPosts ();
+
+	/**
+	 * Heap memory per post, for a channel with 2000 posts. Includes the post index and the
+	 * texts, but not the JSON they are decoded from. The result is reported as BytesAllocated
+	 */
+	void memoryPerPost ();
+
+	/**
+	 * Removing and adding back the reaction of each user, on a post where all of them have reacted
+	 * with the same emoji. The cost per toggle should not depend on the number of users
+	 */
+	void toggleReactions_data ();
+	void toggleReactions ();
+private:
+	SyntheticFixtures	fixtures {singleChannelParams (200, 2000)};
+	Storage				storage;
+	QJsonObject			channelJson;
+};
+
+ChannelPostsBenchmark::PostsPage ChannelPostsBenchmark::getPage (const QString& query)
+{
+	QJsonObject root (QJsonDocument::fromJson (getSyntheticResponse (fixtures, "channels/" + channelJson.value("id").toString() + "/posts?" + query)).object());
+	return PostsPage {root.value("order").toArray(), root.value("posts").toObject()};
+}
+
+void ChannelPostsBenchmark::initTestCase ()
+{
+	setBenchmarkLogLevel ();
+	fillStorage (storage, fixtures);
+	channelJson = fixtures.getChannels().front();
+}
+
+void ChannelPostsBenchmark::addPostsInitial_data ()
+{
+	QTest::addColumn<int> ("postsCount");
+
+	QTest::newRow ("60 posts") << 60;
+	QTest::newRow ("200 posts") << 200;
+}
+
+void ChannelPostsBenchmark::addPostsInitial ()
+{
+	QFETCH (int, postsCount);
+	PostsPage page (getPage ("page=0&per_page=" + QString::number (postsCount)));
+
+	QBENCHMARK {
+		BackendChannel channel (storage, channelJson);
+		channel.addPosts (page.order, page.posts);
+	}
+}
+
+void ChannelPostsBenchmark::addPostsSync ()
+{
+	PostsPage newest (getPage ("page=0&per_page=200"));
+
+	//the same 200 posts, without the newest 10
+	PostsPage initial;
+	for (int i = 10; i < newest.order.size(); ++i) {
+		QString id (newest.order[i].toString());
+		initial.order.push_back (id);
+		initial.posts.insert (id, newest.posts.value (id));
+	}
+
+	PostsPage sync;
+	for (int i = 0; i < 60; ++i) {
+		QString id (newest.order[i].toString());
+		sync.order.push_back (id);
+		sync.posts.insert (id, newest.posts.value (id));
+	}
+
+	QBENCHMARK {
+		BackendChannel channel (storage, channelJson);
+		channel.addPosts (initial.order, initial.posts);
+		channel.addPosts (sync.order, sync.posts);
+	}
+}
+
+void ChannelPostsBenchmark::prependPosts ()
+{
+	PostsPage newest (getPage ("page=0&per_page=200"));
+	PostsPage older (getPage ("page=0&per_page=200&before=" + newest.order.last().toString()));
+
+	QBENCHMARK {
+		BackendChannel channel (storage, channelJson);
+		channel.addPosts (newest.order, newest.posts);
+		channel.addPostsBefore (newest.order.last().toString(), older.order, older.posts);
+	}
+}
+
+void ChannelPostsBenchmark::memoryPerPost ()
+{
+	PostsPage page (getPage ("page=0&per_page=2000"));
+	int postsCount = page.order.size ();
+
+	if (getAllocatedHeapMemory () == 0) {
+		QSKIP ("Heap memory statistics are not available on this platform");
+	}
+
+	BackendChannel channel (storage, channelJson);
+	uint64_t before = getAllocatedHeapMemory ();
+
+	channel.addPosts (page.order, page.posts);
+
+	uint64_t after = getAllocatedHeapMemory ();
+	QCOMPARE (channel.posts.size(), size_t (postsCount));
+
+	QTest::setBenchmarkResult (double (after - before) / postsCount, QTest::BytesAllocated);
+}
+
+void ChannelPostsBenchmark::toggleReactions_data ()
+{
+	QTest::addColumn<int> ("usersCount");
+
+	QTest::newRow ("10 users") << 10;
+	QTest::newRow ("100 users") << 100;
+	QTest::newRow ("500 users") << 500;
+}
+
+void ChannelPostsBenchmark::toggleReactions ()
+{
+	QFETCH (int, usersCount);
+	PostsPage page (getPage ("page=0&per_page=1"));
+
+	BackendChannel channel (storage, channelJson);
+	channel.addPosts (page.order, page.posts);
+	BackendPost& post = *channel.posts.back();
+
+	//users, which are not in the storage, are reacting as well (their IDs are shown until they are loaded)
+	QVector<MattermostId> userIds;
+	for (int i = 0; i < usersCount; ++i) {
+		userIds.push_back (SyntheticFixtures::makeId ('u', i));
+	}
+
+	for (const MattermostId& userId: userIds) {
+		post.addReaction (userId, "thumbsup");
+	}
+
+	QBENCHMARK {
+		for (const MattermostId& userId: userIds) {
+			post.removeReaction (userId, "thumbsup");
+			post.addReaction (userId, "thumbsup");
+		}
+	}
+
+	const BackendPostEmojiReaction* reaction = nullptr;
+	for (const BackendPostEmojiReaction& it: post.getReactions()) {
+		if (it.emojiId == EmojiInfo::findByName ("thumbsup")) {
+			reaction = &it;
+		}
+	}
+
+	QVERIFY (reaction);
+	QCOMPARE (reaction->users.size(), uint32_t (usersCount));
+}
+
+QTEST_GUILESS_MAIN (ChannelPostsBenchmark)
+#include "ChannelPostsBenchmark.moc"
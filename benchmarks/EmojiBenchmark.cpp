@@ -0,0 +1,64 @@
+/**
+ * @file EmojiBenchmark.cpp
+ * @brief Benchmark of the emoji lookup by name
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include <QtTest>
+#include "BenchmarkData.h"
+#include "backend/emoji/EmojiInfo.h"
+
+using namespace Mattermost;
+
+class EmojiBenchmark: public QObject {
+	Q_OBJECT
+private slots:
+	void initTestCase ();
+
+	void findByName_data ();
+	void findByName ();
+};
+
+void EmojiBenchmark::initTestCase ()
+{
+	setBenchmarkLogLevel ();
+}
+
+void EmojiBenchmark::findByName_data ()
+{
+	QTest::addColumn<QString> ("name");
+
+	QTest::newRow ("found") << QString ("smile");
+	QTest::newRow ("not found") << QString ("no_such_emoji");
+	QTest::newRow ("skin tone") << QString ("wave_medium_dark_skin_tone");
+}
+
+void EmojiBenchmark::findByName ()
+{
+	QFETCH (QString, name);
+
+	QBENCHMARK {
+		EmojiInfo::findByName (name);
+	}
+}
+
+QTEST_GUILESS_MAIN (EmojiBenchmark)
+#include "EmojiBenchmark.moc"
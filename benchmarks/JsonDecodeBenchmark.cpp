@@ -0,0 +1,138 @@
+/**
+ * @file JsonDecodeBenchmark.cpp
+ * @brief Benchmark of the JSON decoding of large HTTP responses
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include "BenchmarkData.h"
+#include "backend/HttpResponseCallback.h"
+#include "backend/Storage.h"
+#include "backend/types/BackendPost.h"
+
+using namespace Mattermost;
+
+class JsonDecodeBenchmark: public QObject {
+	Q_OBJECT
+private slots:
+	void initTestCase ();
+
+	void parse_data ();
+
+	/**
+	 * QJsonDocument parsing, as done by HttpResponseCallback for JSON callbacks
+	 */
+	void parse ();
+
+	/**
+	 * Parsing and creation of BackendPost objects for a page of posts
+	 */
+	void decodePosts ();
+
+	/**
+	 * Same as decodePosts, followed by the decoding of files, reactions and polls, as done when a post is displayed.
+	 * The difference to decodePosts is the cost, saved for posts which are never displayed
+	 */
+	void decodePostsAndRawFields ();
+private:
+	SyntheticFixtures	fixtures {singleChannelParams (200, 1000)};
+	Storage				storage;
+	QString				channelId;
+};
+
+void JsonDecodeBenchmark::initTestCase ()
+{
+	setBenchmarkLogLevel ();
+	fillStorage (storage, fixtures);
+	channelId = fixtures.getChannels().front().value("id").toString();
+}
+
+void JsonDecodeBenchmark::parse_data ()
+{
+	QTest::addColumn<QByteArray> ("data");
+
+	QTest::newRow ("60 posts") << getSyntheticResponse (fixtures, "channels/" + channelId + "/posts?page=0&per_page=60");
+	QTest::newRow ("1000 posts") << getSyntheticResponse (fixtures, "channels/" + channelId + "/posts?page=0&per_page=1000");
+	QTest::newRow ("200 users") << getSyntheticResponse (fixtures, "users?page=0&per_page=200");
+}
+
+void JsonDecodeBenchmark::parse ()
+{
+	QFETCH (QByteArray, data);
+
+	NullReply reply;
+	int elements = 0;
+
+	HttpResponseCallback callback ([&elements] (const QJsonDocument& doc) {
+		elements += doc.isArray() ? doc.array().size() : doc.object().size();
+	});
+
+	QBENCHMARK {
+		callback (200, data, reply);
+	}
+
+	QVERIFY (elements > 0);
+}
+
+void JsonDecodeBenchmark::decodePosts ()
+{
+	QByteArray data (getSyntheticResponse (fixtures, "channels/" + channelId + "/posts?page=0&per_page=1000"));
+	size_t count = 0;
+
+	QBENCHMARK {
+		QJsonObject root (QJsonDocument::fromJson (data).object());
+		QJsonObject posts (root.value("posts").toObject());
+		BackendPostArena decoded;
+
+		for (const auto& id: root.value("order").toArray()) {
+			decoded.createPost (posts.value (id.toString()).toObject(), storage);
+		}
+
+		count = decoded.getPostsCount ();
+	}
+
+	QCOMPARE (count, size_t (1000));
+}
+
+void JsonDecodeBenchmark::decodePostsAndRawFields ()
+{
+	QByteArray data (getSyntheticResponse (fixtures, "channels/" + channelId + "/posts?page=0&per_page=1000"));
+	size_t decodedFields = 0;
+
+	QBENCHMARK {
+		QJsonObject root (QJsonDocument::fromJson (data).object());
+		QJsonObject posts (root.value("posts").toObject());
+		BackendPostArena decoded;
+		decodedFields = 0;
+
+		for (const auto& id: root.value("order").toArray()) {
+			BackendPost* post = decoded.createPost (posts.value (id.toString()).toObject(), storage);
+			decodedFields += post->getReactions().size() + post->getFiles().size() + (post->getPoll() != nullptr);
+		}
+	}
+
+	QVERIFY (decodedFields > 0);
+}
+
+QTEST_GUILESS_MAIN (JsonDecodeBenchmark)
+#include "JsonDecodeBenchmark.moc"
@@ -0,0 +1,68 @@
+/**
+ * @file MessageTextFormatBenchmark.cpp
+ * @brief Benchmark of the conversion of post messages to rich text
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include <QtTest>
+#include "BenchmarkData.h"
+#include "chat-area/post/MessageTextFormat.h"
+
+using namespace Mattermost;
+
+class MessageTextFormatBenchmark: public QObject {
+	Q_OBJECT
+private slots:
+	void initTestCase ();
+
+	void formatMessageText_data ();
+	void formatMessageText ();
+};
+
+void MessageTextFormatBenchmark::initTestCase ()
+{
+	setBenchmarkLogLevel ();
+}
+
+void MessageTextFormatBenchmark::formatMessageText_data ()
+{
+	QTest::addColumn<QString> ("message");
+
+	QString paragraph ("The release build is ready, please check the logs at https://ci.example.com/job/1234 :thumbsup:\n");
+
+	QTest::newRow ("short") << QString ("ok, thanks");
+	QTest::newRow ("multiline") << QString ("first line\nsecond line\nthird line <with> & \"escaping\"");
+	QTest::newRow ("emojis") << QString (":wave: hello :smile: :wave_medium_skin_tone: :no_such_emoji: :tada:");
+	QTest::newRow ("links") << QString ("see http://example.com/a and https://example.com/b?c=d and https://example.com/e");
+	QTest::newRow ("4 KB") << paragraph.repeated (4096 / paragraph.size());
+}
+
+void MessageTextFormatBenchmark::formatMessageText ()
+{
+	QFETCH (QString, message);
+
+	QBENCHMARK {
+		Mattermost::formatMessageText (message);
+	}
+}
+
+QTEST_GUILESS_MAIN (MessageTextFormatBenchmark)
+#include "MessageTextFormatBenchmark.moc"
@@ -0,0 +1,196 @@
+/**
+ * @file StorageBenchmark.cpp
+ * @brief Benchmark of the user lookups and inserts of Storage
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include "BenchmarkData.h"
+#include "backend/Storage.h"
+
+using namespace Mattermost;
+
+class StorageBenchmark: public QObject {
+	Q_OBJECT
+private slots:
+	void initTestCase ();
+
+	void getUserById_data ();
+	void getUserById ();
+
+	void getChannelById ();
+	void getDirectChannelByUserId ();
+
+	void addUsersPage_data ();
+	void addUsersPage ();
+};
+
+void StorageBenchmark::initTestCase ()
+{
+	setBenchmarkLogLevel ();
+}
+
+void StorageBenchmark::getUserById_data ()
+{
+	QTest::addColumn<int> ("usersCount");
+
+	QTest::newRow ("100 users") << 100;
+	QTest::newRow ("1000 users") << 1000;
+	QTest::newRow ("10000 users") << 10000;
+	QTest::newRow ("50000 users") << 50000;
+}
+
+/**
+ * 1000 lookups of existing users, and one of a missing user
+ */
+void StorageBenchmark::getUserById ()
+{
+	QFETCH (int, usersCount);
+
+	SyntheticFixtures fixtures (singleChannelParams (usersCount, 0));
+	Storage storage;
+	fillStorage (storage, fixtures);
+
+	//converted before the measurement, as the IDs in the storage are converted when parsing the JSON
+	QVector<MattermostId> ids;
+	for (int i = 0; i < 1000; ++i) {
+		ids.push_back (SyntheticFixtures::makeId ('u', (i * 7919) % usersCount));
+	}
+
+	MattermostId missingId (SyntheticFixtures::makeId ('u', usersCount));
+	int found = 0;
+
+	QBENCHMARK {
+		for (const MattermostId& id: ids) {
+			found += storage.getUserById (id) != nullptr;
+		}
+
+		found += storage.getUserById (missingId) != nullptr;
+	}
+
+	QVERIFY (found > 0);
+}
+
+/**
+ * Large server: 50000 users, 5 teams with 1000 channels each, and 500 direct channels
+ */
+static SyntheticParams largeServerParams ()
+{
+	SyntheticParams params;
+	params.teams = 5;
+	params.channelsPerTeam = 1000;
+	params.directChannels = 500;
+	params.users = 50000;
+	params.postsPerChannel = 0;
+	return params;
+}
+
+/**
+ * 1000 lookups of existing channels, and one of a missing channel
+ */
+void StorageBenchmark::getChannelById ()
+{
+	SyntheticFixtures fixtures (largeServerParams ());
+	Storage storage;
+	fillStorage (storage, fixtures);
+	fillStorageChannels (storage, fixtures);
+
+	int channelsCount = fixtures.getParams().teams * fixtures.getParams().channelsPerTeam;
+
+	QVector<MattermostId> ids;
+	for (int i = 0; i < 1000; ++i) {
+		ids.push_back (SyntheticFixtures::makeId ('c', (i * 7919) % channelsCount));
+	}
+
+	MattermostId missingId (SyntheticFixtures::makeId ('c', channelsCount));
+	int found = 0;
+
+	QBENCHMARK {
+		for (const MattermostId& id: ids) {
+			found += storage.getChannelById (id) != nullptr;
+		}
+
+		found += storage.getChannelById (missingId) != nullptr;
+	}
+
+	QVERIFY (found > 0);
+}
+
+/**
+ * 1000 lookups of direct channels by the other user, as done for each direct message.
+ * Half of the users have no direct channel
+ */
+void StorageBenchmark::getDirectChannelByUserId ()
+{
+	SyntheticFixtures fixtures (largeServerParams ());
+	Storage storage;
+	fillStorage (storage, fixtures);
+	fillStorageChannels (storage, fixtures);
+
+	int directChannelsCount = fixtures.getParams().directChannels;
+
+	QVector<MattermostId> ids;
+	for (int i = 0; i < 1000; ++i) {
+		ids.push_back (SyntheticFixtures::makeId ('u', 1 + (i * 7919) % (directChannelsCount * 2)));
+	}
+
+	int found = 0;
+
+	QBENCHMARK {
+		for (const MattermostId& id: ids) {
+			found += storage.getDirectChannelByUserId (id) != nullptr;
+		}
+	}
+
+	QVERIFY (found > 0);
+}
+
+void StorageBenchmark::addUsersPage_data ()
+{
+	QTest::addColumn<int> ("usersCount");
+
+	QTest::newRow ("200 users") << 200;
+	QTest::newRow ("1000 users") << 1000;
+}
+
+/**
+ * Decoding of 'users?page=..' pages into an empty storage
+ */
+void StorageBenchmark::addUsersPage ()
+{
+	QFETCH (int, usersCount);
+
+	SyntheticFixtures fixtures (singleChannelParams (usersCount, 0));
+	QJsonArray page (QJsonDocument::fromJson (getSyntheticResponse (fixtures, "users?page=0&per_page=" + QString::number (usersCount))).array());
+
+	QBENCHMARK {
+		Storage storage;
+
+		for (const auto& user: page) {
+			storage.addUser (user.toObject());
+		}
+	}
+}
+
+QTEST_GUILESS_MAIN (StorageBenchmark)
+#include "StorageBenchmark.moc"
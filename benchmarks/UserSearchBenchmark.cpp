@@ -0,0 +1,179 @@
+/**
+ * @file UserSearchBenchmark.cpp
+ * @brief Benchmark of the user search index of the user dialogs
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include <algorithm>
+#include <QtTest>
+#include "BenchmarkData.h"
+#include "backend/Storage.h"
+#include "backend/UserSearchIndex.h"
+#include "channel-tree-dialogs/UserListModel.h"
+
+using namespace Mattermost;
+
+class UserSearchBenchmark: public QObject {
+	Q_OBJECT
+private slots:
+	void initTestCase ();
+
+	void build_data ();
+	void build ();
+
+	void search_data ();
+	void search ();
+
+	void filter_data ();
+	void filter ();
+};
+
+namespace {
+
+constexpr int usersCount = 30000;
+
+//the filter should keep up with typing
+constexpr qint64 keystrokeTargetNs = 5 * 1000 * 1000;
+
+//rows, which a view of the user dialog shows (and so asks the model for) after a filter change
+constexpr int visibleRows = 40;
+
+std::vector<const BackendUser*> getUsers (const Storage& storage)
+{
+	std::vector<const BackendUser*> users;
+
+	for (auto& it: storage.users) {
+		users.push_back (&it.second);
+	}
+
+	return users;
+}
+
+}
+
+void UserSearchBenchmark::initTestCase ()
+{
+	setBenchmarkLogLevel ();
+}
+
+void UserSearchBenchmark::build_data ()
+{
+	QTest::addColumn<int> ("usersCount");
+
+	QTest::newRow ("1000 users") << 1000;
+	QTest::newRow ("30000 users") << usersCount;
+}
+
+/**
+ * Building the index, when a user dialog is opened
+ */
+void UserSearchBenchmark::build ()
+{
+	QFETCH (int, usersCount);
+
+	SyntheticFixtures fixtures (singleChannelParams (usersCount, 0));
+	Storage storage;
+	fillStorage (storage, fixtures);
+
+	QBENCHMARK {
+		UserSearchIndex index (getUsers (storage));
+		QVERIFY (index.getUsers().size() == (size_t)usersCount);
+	}
+}
+
+void UserSearchBenchmark::search_data ()
+{
+	QTest::addColumn<QString> ("query");
+
+	QTest::newRow ("single letter") << "u";
+	QTest::newRow ("prefix") << "user12";
+	QTest::newRow ("full name") << "first123 last123";
+	QTest::newRow ("no match") << "zzz";
+}
+
+/**
+ * A search over 30000 users, as done on each key press in the filter field
+ */
+void UserSearchBenchmark::search ()
+{
+	QFETCH (QString, query);
+
+	SyntheticFixtures fixtures (singleChannelParams (usersCount, 0));
+	Storage storage;
+	fillStorage (storage, fixtures);
+	UserSearchIndex index (getUsers (storage));
+	size_t matches = 0;
+
+	QBENCHMARK {
+		matches += index.search (query).size();
+	}
+
+	QVERIFY (matches > 0 || query == "zzz");
+}
+
+void UserSearchBenchmark::filter_data ()
+{
+	search_data ();
+}
+
+/**
+ * A key press in the filter field of a user dialog with 30000 users: the search, the model reset and
+ * the rows, shown after it. Fails if the average over a few key presses is above the 5 ms target
+ */
+void UserSearchBenchmark::filter ()
+{
+	QFETCH (QString, query);
+
+	SyntheticFixtures fixtures (singleChannelParams (usersCount, 0));
+	Storage storage;
+	fillStorage (storage, fixtures);
+	UserListModel model (getUsers (storage), nullptr);
+
+	auto applyFilter = [&model, &query] {
+		model.setFilter (query);
+
+		for (int row = 0; row < std::min (model.rowCount(), visibleRows); ++row) {
+			model.data (model.index (row, UserListModel::nameColumn));
+			model.data (model.index (row, UserListModel::statusColumn));
+		}
+	};
+
+	QBENCHMARK {
+		applyFilter ();
+	}
+
+	constexpr int keystrokes = 20;
+	QElapsedTimer timer;
+	timer.start ();
+
+	for (int i = 0; i < keystrokes; ++i) {
+		applyFilter ();
+	}
+
+	qint64 keystrokeNs = timer.nsecsElapsed() / keystrokes;
+	qInfo ("Filter '%s': %d matches, %.2f ms per key press", qPrintable (query), model.rowCount(), keystrokeNs / 1e6);
+
+	QVERIFY2 (keystrokeNs < keystrokeTargetNs, qPrintable (QString ("%1 ms per key press, the target is %2 ms")
+			.arg (keystrokeNs / 1e6, 0, 'f', 2).arg (keystrokeTargetNs / 1e6)));
+}
+
+QTEST_GUILESS_MAIN (UserSearchBenchmark)
+#include "UserSearchBenchmark.moc"
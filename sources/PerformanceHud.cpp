@@ -0,0 +1,107 @@
+/**
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "PerformanceHud.h"
+
+#include <QEvent>
+#include "backend/Backend.h"
+#include "chat-area/post/PostWidget.h"
+#include "log/StallWatchdog.h"
+#include "log/ProcessMemory.h"
+#include "channel-tree/ChannelPrefetcher.h"
+
+namespace Mattermost {
+
+PerformanceHud::PerformanceHud (QWidget* parent, Backend& backend, StallWatchdog& watchdog, const ChannelPrefetcher& channelPrefetcher)
+:QLabel (parent)
+,backend (backend)
+,watchdog (watchdog)
+,channelPrefetcher (channelPrefetcher)
+{
+	setAttribute (Qt::WA_TransparentForMouseEvents);
+	setStyleSheet ("QLabel { background-color: rgba(0, 0, 0, 170); color: white; padding: 6px; font-family: monospace; }");
+	setTextFormat (Qt::PlainText);
+	hide ();
+
+	parent->installEventFilter (this);
+
+	refreshTimer.setInterval (500);
+	connect (&refreshTimer, &QTimer::timeout, this, &PerformanceHud::refresh);
+}
+
+PerformanceHud::~PerformanceHud () = default;
+
+void PerformanceHud::toggle ()
+{
+	if (isVisible()) {
+		refreshTimer.stop ();
+		hide ();
+		return;
+	}
+
+	refresh ();
+	show ();
+	raise ();
+	refreshTimer.start ();
+}
+
+bool PerformanceHud::eventFilter (QObject* watched, QEvent* event)
+{
+	if (watched == parent() && event->type() == QEvent::Resize) {
+		updatePosition ();
+	}
+
+	return QLabel::eventFilter (watched, event);
+}
+
+void PerformanceHud::refresh ()
+{
+	const std::deque<StallRecord>& stalls = watchdog.getStalls ();
+
+	QString text;
+	text += QString ("Event loop: %1 ms (max %2 ms/s)\n").arg (watchdog.getLatencyMs()).arg (watchdog.getMaxLatencyMs());
+
+	if (stalls.empty()) {
+		text += "Stalls: 0\n";
+	} else {
+		text += QString ("Stalls: %1 (last %2 ms in %3)\n").arg (stalls.size()).arg (stalls.back().durationMs).arg (stalls.back().span);
+	}
+
+	text += QString ("HTTP pending: %1\n").arg (backend.getPendingHttpRequestsCount());
+	text += QString ("PostWidgets: %1\n").arg (PostWidget::getInstanceCount());
+
+	const ChannelPrefetchStats& prefetchStats = channelPrefetcher.getStats ();
+	text += QString ("Switches: %1 (%2 instant), prefetch hits %3/%4 (%5%)\n").arg (prefetchStats.switches).arg (prefetchStats.instantSwitches)
+			.arg (prefetchStats.prefetchHits).arg (prefetchStats.firstViews).arg (prefetchStats.hitRate() * 100, 0, 'f', 0);
+
+	uint64_t rss = getResidentMemory ();
+	text += rss ? QString ("RSS: %1 MB").arg (rss / (1024.0 * 1024.0), 0, 'f', 1) : QString ("RSS: n/a");
+
+	setText (text);
+	adjustSize ();
+	updatePosition ();
+}
+
+void PerformanceHud::updatePosition ()
+{
+	QWidget* parentWidget = this->parentWidget ();
+	move (parentWidget->width() - width() - 10, 10);
+}
+
+} /* namespace Mattermost */
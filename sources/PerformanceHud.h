@@ -0,0 +1,55 @@
+/**
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <QLabel>
+#include <QTimer>
+
+namespace Mattermost {
+
+class Backend;
+class StallWatchdog;
+class ChannelPrefetcher;
+
+/**
+ * Overlay in the top right corner of the main window. Shows the event loop latency, stalls,
+ * pending HTTP requests, live PostWidget count, channel switches and the resident memory of the process
+ */
+class PerformanceHud: public QLabel
+{
+    Q_OBJECT
+
+public:
+    PerformanceHud (QWidget* parent, Backend& backend, StallWatchdog& watchdog, const ChannelPrefetcher& channelPrefetcher);
+    ~PerformanceHud ();
+public:
+    void toggle ();
+private:
+    bool eventFilter (QObject* watched, QEvent* event) override;
+    void refresh ();
+    void updatePosition ();
+private:
+    Backend&		backend;
+    StallWatchdog&	watchdog;
+    const ChannelPrefetcher&	channelPrefetcher;
+    QTimer			refreshTimer;
+};
+
+} /* namespace Mattermost */
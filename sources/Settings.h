@@ -30,5 +30,11 @@ static constexpr const char* DOWNLOAD_LOCATION = "config/downloadLocation";
 static constexpr const char* DOWNLOAD_ASK = "config/downloadAsk";
 static constexpr const char* DOWNLOAD_IMAGE_MAX_WIDTH = "config/imageMaxWidth";
 static constexpr const char* DOWNLOAD_IMAGE_MAX_HEIGHT = "config/imageMaxHeight";
+static constexpr const char* WEBSOCKET_COMPRESSION = "config/websocketCompression";
+static constexpr const char* LOG_LEVELS = "config/logLevels";
+static constexpr const char* HISTORY_MEMORY_BUDGET = "config/historyMemoryBudgetMB";
+static constexpr const char* HISTORY_INACTIVE_CHANNEL_POSTS = "config/historyInactiveChannelPosts";
+static constexpr const char* SCROLL_PREFETCH_SCREENS = "config/scrollPrefetchScreens";
+static constexpr const char* PREFETCH_BANDWIDTH = "config/prefetchBandwidthKB";
 
 
@@ -25,6 +25,7 @@
 #include <QStandardPaths>
 #include "ui_SettingsWindow.h"
 #include "Settings.h"
+#include "build-config.h"
 
 namespace Mattermost {
 
@@ -43,6 +44,12 @@ SettingsWindow::SettingsWindow(QWidget *parent) :
 	ui->askLocationCheckBox->setChecked (settings.value (DOWNLOAD_ASK, 0).toBool());
 	ui->imageMaxWidthValue->setText (settings.value (DOWNLOAD_IMAGE_MAX_WIDTH, 400).toString());
 	ui->imageMaxHeightValue->setText (settings.value (DOWNLOAD_IMAGE_MAX_HEIGHT, 400).toString());
+	ui->websocketCompressionCheckBox->setChecked (settings.value (WEBSOCKET_COMPRESSION, true).toBool());
+
+#if !BUILD_WEBSOCKET_DEFLATE
+	ui->websocketCompressionCheckBox->setEnabled (false);
+	ui->websocketCompressionCheckBox->setToolTip ("This build does not support WebSocket compression");
+#endif
 
 	connect (ui->downloadLocationButton, &QPushButton::clicked, [this] {
 		QDir defaultDir (ui->downloadLocationValue->text());
@@ -66,6 +73,7 @@ void SettingsWindow::applyNewSettings ()
 	settings.setValue (DOWNLOAD_ASK, ui->askLocationCheckBox->text());
 	settings.setValue (DOWNLOAD_IMAGE_MAX_WIDTH, ui->imageMaxWidthValue->text());
 	settings.setValue (DOWNLOAD_IMAGE_MAX_HEIGHT, ui->imageMaxHeightValue->text());
+	settings.setValue (WEBSOCKET_COMPRESSION, ui->websocketCompressionCheckBox->isChecked());
 	settings.sync ();
 }
 
@@ -24,6 +24,7 @@
 
 #include "Backend.h"
 
+#include <algorithm>
 #include <iostream>
 #include <QtWebSockets/QWebSocket>
 #include <QNetworkCookie>
@@ -33,6 +34,7 @@
 #include <QJsonArray>
 #include "QByteArrayCreator.h"
 #include <QFile>
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
 #include <QSettings>
@@ -45,6 +47,7 @@
 #include "types/BackendNewPollData.h"
 #include "emoji/EmojiInfo.h"
 #include "log.h"
+#include "log/ChannelSwitchMetrics.h"
 
 /**
  * Get number of 'containers' needed for 'total' items, if each container
@@ -54,22 +57,67 @@
 
 namespace Mattermost {
 
+namespace {
+
+//the maximum page size of the server
+constexpr uint32_t channelMembersPerPage = 200;
+
+constexpr uint32_t teamMembersPerPage = 200;
+
+/*
+ * Pages of a team or channel member list, requested at a time. QNetworkAccessManager uses up to 6 connections
+ * per host, so a few are left for the other requests (a channel being opened, avatars), instead of queuing them
+ * behind all pages of a big team
+ */
+constexpr uint32_t maxParallelMemberPages = 4;
+
+constexpr qint64 teamMembersCacheMaxAgeMs = 24 * 3600 * 1000;
+
+QString teamMembersCacheFile (const MattermostId& teamId)
+{
+	return QDir (QStandardPaths::writableLocation (QStandardPaths::CacheLocation)).filePath ("team-members/" + teamId.toString() + ".json");
+}
+
+std::vector<BackendChannelSummary> parseChannelSummaries (const QJsonDocument& doc)
+{
+	const QJsonArray array (doc.array());
+	std::vector<BackendChannelSummary> channels;
+
+	channels.reserve (array.size());
+
+	for (const auto &item: array) {
+		channels.emplace_back (item.toObject());
+	}
+
+	return channels;
+}
+
+}
+
 Backend::Backend(QObject *parent)
 :QObject (parent)
+,historyBudget (storage)
 ,serverDialogsMap (*this)
+,httpConnector (networkMetrics)
 ,webSocketEventHandler (*this)
-,webSocketConnector (webSocketEventHandler)
+,webSocketConnector (webSocketEventHandler, networkMetrics)
 ,currentChannel (nullptr)
 ,isLoggedIn (false)
 ,autoLoginEnabledFlag (true)
 ,nonFilledTeams (0)
+,lastMembersLoadId (0)
+,lastMissingRootsRequestId (0)
 {
+	missingRootsTimer.setSingleShot (true);
+	missingRootsTimer.setInterval (0);
+	connect (&missingRootsTimer, &QTimer::timeout, this, &Backend::retrieveMissingRootPosts);
+
 	connect (&webSocketConnector, &WebSocketConnector::onConnect, [this] (bool isReconnect) {
 
 		emit onWebSocketConnect ();
 
 		if (isReconnect) {
-			LOG_DEBUG ("Reconnect - check for missed posts");
+			LOG_DEBUG (backend, "Reconnect - check for missed posts");
 
 			/**
 			 * Reset the HTTP connector, so that all waiting requests are cancelled.
@@ -79,9 +127,51 @@ Backend::Backend(QObject *parent)
 			 */
 			httpConnector.reset ();
 
+			//channels without loaded posts are loaded when they are shown
 			for (auto& it: storage.channels) {
-				retrieveChannelPosts (*it, 0, 25);
+				if (!it.second->posts.empty()) {
+					retrieveChannelPosts (*it.second, 0, 25);
+				}
+
+				//member events may have been missed, the members are loaded again when they are needed
+				it.second->membersLoaded = false;
 			}
+
+			//the member loads in progress were cancelled by the reset, start them again
+			std::vector<std::pair<MattermostId, decltype (ChannelMembersLoad::callbacks)>> interruptedLoads;
+
+			for (auto& it: channelMembersLoads) {
+				interruptedLoads.emplace_back (it.first, std::move (it.second.callbacks));
+			}
+
+			channelMembersLoads.clear ();
+
+			for (auto& load: interruptedLoads) {
+				BackendChannel* channel = storage.getChannelById (load.first);
+
+				for (auto& callbacks: load.second) {
+					if (channel) {
+						retrieveChannelMembers (*channel, callbacks.first, callbacks.second);
+					}
+				}
+			}
+
+			//the team member lists, which were being loaded or have failed, are loaded again
+			teamMembersLoads.clear ();
+
+			for (auto& it: storage.teams) {
+				if (!it.second.membersLoaded) {
+					retrieveTeamMembers (it.second);
+				}
+			}
+
+			//the root posts of the cancelled requests are requested again
+			for (auto& it: missingRootsRequests) {
+				requeueMissingRootIds (it.second);
+			}
+
+			missingRootsRequests.clear ();
+			scheduleMissingRootPosts ();
 		}
 	});
 
@@ -113,12 +203,12 @@ Backend::Backend(QObject *parent)
 
 void debugRequest (const QNetworkRequest& request, QByteArray data = QByteArray())
 {
-  qDebug() << request.url().toString();
-  const QList<QByteArray>& rawHeaderList(request.rawHeaderList());
-  foreach (QByteArray rawHeader, rawHeaderList) {
-    qDebug() << rawHeader << ":"  << request.rawHeader(rawHeader);
-  }
-  qDebug() << data;
+	LOG_TRACE (http, request.url().toString());
+	const QList<QByteArray>& rawHeaderList(request.rawHeaderList());
+	foreach (QByteArray rawHeader, rawHeaderList) {
+		LOG_TRACE (http, rawHeader << ":"  << request.rawHeader(rawHeader));
+	}
+	LOG_TRACE (http, data);
 }
 
 void Backend::login (const BackendLoginData& loginData, std::function<void(const QString&)> callback)
@@ -143,7 +233,7 @@ void Backend::login (const BackendLoginData& loginData, std::function<void(const
 			QJsonDocument doc = QJsonDocument::fromJson(data);
 
 			QString jsonString = doc.toJson(QJsonDocument::Indented);
-			LOG_DEBUG (jsonString);
+			LOG_DEBUG (backend, jsonString);
 		});
 #endif
 
@@ -190,12 +280,13 @@ void Backend::loginRetry ()
 		return;
 	}
 
-	LOG_DEBUG ("Login retry - no token");
+	LOG_DEBUG (backend, "Login retry - no token");
 }
 
 void Backend::setCurrentChannel (BackendChannel& channel)
 {
 	currentChannel = &channel;
+	historyBudget.setCurrentChannel (channel);
 }
 
 BackendChannel* Backend::getCurrentChannel () const
@@ -210,10 +301,7 @@ bool Backend::autoLoginEnabled ()
 
 void Backend::loginSuccess (const QJsonDocument& doc, const QNetworkReply& reply, std::function<void (const QString&)> callback)
 {
-#if 1
-	QString jsonString = doc.toJson(QJsonDocument::Indented);
-	std::cout << "loginUser: " << jsonString.toStdString() << std::endl;
-#endif
+	LOG_TRACE (http, "loginUser: " << doc.toJson (QJsonDocument::Compact));
 	BackendUser* loginUser = storage.addUser (doc.object(), true);
 	loginUser->isLoginUser = true;
 
@@ -222,7 +310,7 @@ void Backend::loginSuccess (const QJsonDocument& doc, const QNetworkReply& reply
 	}
 
 	if (NetworkRequest::getToken().isEmpty()) {
-		qCritical() << "Login Token is empty. WebSocket communication may not work";
+		LOG_ERROR (backend, "Login Token is empty. WebSocket communication may not work");
 	}
 
 	webSocketConnector.open (NetworkRequest::host() + "api/v4/", NetworkRequest::getToken());
@@ -245,9 +333,14 @@ void Backend::reset ()
 
 	//reinit all network connectors
 	timeoutTimer.disconnect ();
+	missingRootsTimer.stop ();
 	httpConnector.reset ();
 	webSocketConnector.close ();
 	storage.reset ();
+	historyBudget.reset ();
+	channelMembersLoads.clear ();
+	teamMembersLoads.clear ();
+	missingRootsRequests.clear ();
 	nonFilledTeams = 0;
 }
 
@@ -261,7 +354,7 @@ void Backend::logout (std::function<void ()> callback)
 
 	timeoutTimer.setSingleShot (true);
 	connect (&timeoutTimer, &QTimer::timeout, [this, callback] {
-		LOG_DEBUG ("Logout timeout");
+		LOG_DEBUG (backend, "Logout timeout");
 		reset ();
 		callback ();
 	});
@@ -269,27 +362,23 @@ void Backend::logout (std::function<void ()> callback)
 	timeoutTimer.start (1000);
 
 	httpConnector.post (request, QByteArray(), HttpResponseCallback ([this, callback] (const QJsonDocument& doc) {
-		LOG_DEBUG ("Logout done");
+		LOG_DEBUG (backend, "Logout done");
 
 		timeoutTimer.stop();
 		reset ();
 
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
-		qDebug () << jsonString;
+		LOG_TRACE (http, "logout reply: " << doc.toJson (QJsonDocument::Compact));
 		callback ();
 	}));
 }
 
-void Backend::retrieveUser (QString userID, std::function<void (BackendUser&)> callback)
+void Backend::retrieveUser (const MattermostId& userID, std::function<void (BackendUser&)> callback)
 {
-	NetworkRequest request ("users/" + userID);
+	NetworkRequest request ("users/" + userID.toString());
 
 	httpConnector.get (request, HttpResponseCallback ([this, callback](const QJsonDocument& doc) {
 
-		LOG_DEBUG ("getUser reply");
-
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
-		//std::cout << "get users reply: " << statusCode.toInt() << std::endl;
+		LOG_DEBUG (backend, "getUser reply");
 
 		BackendUser *user = storage.addUser (doc.object());
 		retrieveUserAvatar (user->id, user->update_at);
@@ -299,48 +388,45 @@ void Backend::retrieveUser (QString userID, std::function<void (BackendUser&)> c
 
 void Backend::retrieveUserPreferences ()
 {
-	NetworkRequest request ("users/" + getLoginUser().id + "/preferences");
+	NetworkRequest request ("users/" + getLoginUser().id.toString() + "/preferences");
 
 	httpConnector.get (request, HttpResponseCallback ([this](const QJsonDocument& doc) {
 
-		LOG_DEBUG ("retrieveUserPreferences reply");
-
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
-		//LOG_DEBUG ("retrieveUserPreferences reply: " << jsonString);
+		LOG_DEBUG (backend, "retrieveUserPreferences reply");
+		LOG_TRACE (http, "retrieveUserPreferences reply: " << doc.toJson (QJsonDocument::Compact));
 	}));
 }
 
 void Backend::updateUserPreferences (const BackendUserPreferences& preferences)
 {
-	NetworkRequest request ("users/" + getLoginUser().id + "/preferences");
+	NetworkRequest request ("users/" + getLoginUser().id.toString() + "/preferences");
 
 	QJsonArray jsonArr;
 	jsonArr.push_back (QJsonObject {
-		{"user_id", getLoginUser().id},
+		{"user_id", getLoginUser().id.toString()},
 		{"category", preferences.category},
 		{"name", preferences.name},
 		{"value", preferences.value},
 	});
 
 	httpConnector.put (request, jsonArr, HttpResponseCallback ([this](const QJsonDocument& doc) {
-
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
+		LOG_TRACE (http, "updateUserPreferences reply: " << doc.toJson (QJsonDocument::Compact));
 	}));
 }
 
-void Backend::retrieveMultipleUsersStatus (QVector<QString> userIDs, std::function<void ()> callback)
+void Backend::retrieveMultipleUsersStatus (QVector<MattermostId> userIDs, std::function<void ()> callback)
 {
 	QJsonArray userIDsJson;
 
 	for (auto& id: userIDs) {
-		userIDsJson.push_back (id);
+		userIDsJson.push_back (id.toString());
 	}
 
 	NetworkRequest request ("users/status/ids");
 
 	httpConnector.post (request, userIDsJson, HttpResponseCallback ([this, callback] (const QJsonDocument& doc) {
 
-		LOG_DEBUG ("getStatus reply");
+		LOG_DEBUG (backend, "getStatus reply");
 
 		for (const auto& element: doc.array()) {
 
@@ -351,7 +437,7 @@ void Backend::retrieveMultipleUsersStatus (QVector<QString> userIDs, std::functi
 			BackendUser* user = storage.getUserById (userId);
 
 			if (!user) {
-				LOG_DEBUG ("retrieveMultipleUsersStatus: used with id '" << userId << "not found");
+				LOG_DEBUG (backend, "retrieveMultipleUsersStatus: used with id '" << userId << "not found");
 				continue;
 			}
 
@@ -374,10 +460,8 @@ void Backend::retrieveTotalUsersCount (std::function<void(uint32_t)> callback)
 
 	httpConnector.get (request, HttpResponseCallback ([this, callback] (const QJsonDocument& doc) {
 
-		LOG_DEBUG ("getTotalUsersCount reply");
-
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
-		std::cout << jsonString.toStdString() << std::endl;
+		LOG_DEBUG (backend, "getTotalUsersCount reply");
+		LOG_TRACE (http, "getTotalUsersCount reply: " << doc.toJson (QJsonDocument::Compact));
 
 		storage.totalUsersCount = doc.object().value("total_users_count").toInt();
 		callback (storage.totalUsersCount);
@@ -397,13 +481,9 @@ void Backend::retrieveAllUsers ()
 
 		httpConnector.get (request, HttpResponseCallback ([this, page, totalPages] (const QJsonDocument& doc) {
 
-			LOG_DEBUG ("getAllUsers reply");
+			LOG_DEBUG (backend, "getAllUsers reply");
 
-			QString jsonString = doc.toJson(QJsonDocument::Indented);
-			//std::cout << "get users reply: " << statusCode.toInt() << std::endl;
-			//std::cout << jsonString.toStdString() << std::endl;
-
-			QVector<QString> userIds;
+			QVector<MattermostId> userIds;
 			userIds.reserve (200);
 
 			for (const auto &itemRef: doc.array()) {
@@ -415,7 +495,7 @@ void Backend::retrieveAllUsers ()
 			retrieveMultipleUsersStatus (userIds, [] {
 			});
 
-			LOG_DEBUG ("Page " << page << " (" << obtainedPages << " of " << totalPages << "): users count " << storage.users.size());
+			LOG_DEBUG (backend, "Page " << page << " (" << obtainedPages << " of " << totalPages << "): users count " << storage.users.size());
 		#if 0
 			for (auto& user: users) {
 				std::cout << user.id.toStdString() << " "
@@ -429,7 +509,7 @@ void Backend::retrieveAllUsers ()
 			++obtainedPages;
 			if (obtainedPages == totalPages) {
 				emit onAllUsers ();
-				LOG_DEBUG ("Get Users: Done ");
+				LOG_DEBUG (backend, "Get Users: Done ");
 				obtainedPages = 0;
 			}
 		}));
@@ -437,18 +517,18 @@ void Backend::retrieveAllUsers ()
 	}
 }
 
-void Backend::retrieveUserAvatar (QString userID, uint64_t lastUpdateTime)
+void Backend::retrieveUserAvatar (const MattermostId& userID, uint64_t lastUpdateTime)
 {
-	NetworkRequest request ("users/" + userID + "/image", true);
+	NetworkRequest request ("users/" + userID.toString() + "/image", true);
 
 	httpConnector.get (request, HttpResponseCallback ([this, userID] (QVariant, QByteArray data) {
 
-		//LOG_DEBUG ("getUserImage reply");
+		//LOG_DEBUG (backend, "getUserImage reply");
 
 		BackendUser* user = storage.getUserById (userID);
 
 		if (!user) {
-			qCritical() << "Get Image: user " << userID << " not found";
+			LOG_ERROR (backend, "Get Image: user " << userID << " not found");
 			return;
 		}
 
@@ -465,7 +545,7 @@ void Backend::retrieveFile (QString fileID, std::function<void (const QByteArray
 	QIODevice* cachedFile = attachmentsCache.data (fileID);
 
 	if (cachedFile) {
-		//LOG_DEBUG ("Retrieve File " << fileID << " done (from custom cache). Attachment cache size: " << attachmentsCache.cacheSize());
+		//LOG_DEBUG (backend, "Retrieve File " << fileID << " done (from custom cache). Attachment cache size: " << attachmentsCache.cacheSize());
 
 		/**
 		 * Do not call callback in the same stack frame
@@ -485,7 +565,7 @@ void Backend::retrieveFile (QString fileID, std::function<void (const QByteArray
 	request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
 
 	httpConnector.get (request, HttpResponseCallback ([this, fileID, callback, cacheIO](QVariant, QByteArray data) {
-		//LOG_DEBUG ("Retrieve File " << fileID << " done");
+		//LOG_DEBUG (backend, "Retrieve File " << fileID << " done");
 		cacheIO->write (data);
 		attachmentsCache.insert (cacheIO);
 		callback (data);
@@ -500,10 +580,10 @@ void Backend::retrieveOwnTeams (std::function<void(BackendTeam&)> callback)
     NetworkRequest request ("users/me/teams");
     //request.setRawHeader("X-Requested-With", "XMLHttpRequest");
 
-    LOG_DEBUG ("retrieveOwnTeams request");
+    LOG_DEBUG (backend, "retrieveOwnTeams request");
 
     httpConnector.get (request, HttpResponseCallback ([this, callback] (const QJsonDocument& doc) {
-    	LOG_DEBUG ("retrieveOwnTeams reply");
+    	LOG_DEBUG (backend, "retrieveOwnTeams reply");
 		storage.teams.clear ();
 
 #if 0
@@ -524,20 +604,16 @@ void Backend::retrieveOwnTeams (std::function<void(BackendTeam&)> callback)
     }));
 }
 
-void Backend::retrieveTeam (QString teamID)
+void Backend::retrieveTeam (const MattermostId& teamID)
 {
-	NetworkRequest request ("teams/" + teamID);
-
-    std::cout << "get team " << teamID.toStdString() << std::endl;
+	NetworkRequest request ("teams/" + teamID.toString());
 
+    LOG_DEBUG (backend, "get team " << teamID);
 
     httpConnector.get (request, HttpResponseCallback ([this] (const QJsonDocument& doc) {
-    	LOG_DEBUG ("getTeam reply");
+    	LOG_DEBUG (backend, "getTeam reply");
 
-#if 1
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
-		std::cout << "get team reply: " <<  jsonString.toStdString() << std::endl;
-#endif
+		LOG_TRACE (http, "get team reply: " << doc.toJson (QJsonDocument::Compact));
 
 		auto object = doc.object();
 		BackendTeam *team = storage.addTeam (doc.object());
@@ -549,38 +625,35 @@ void Backend::retrieveTeam (QString teamID)
 }
 
 
-void Backend::retrieveTeamPublicChannels (QString teamID, std::function<void(std::list<BackendChannel>&)> callback)
+void Backend::retrieveTeamPublicChannelsPage (const MattermostId& teamID, int page, int perPage, std::function<void(std::vector<BackendChannelSummary>&)> callback)
 {
-	NetworkRequest request ("teams/" + teamID + "/channels");
+	NetworkRequest request ("teams/" + teamID.toString() + "/channels?page=" + QString::number (page) + "&per_page=" + QString::number (perPage));
 
-    std::cout << "get team channels " << teamID.toStdString() << std::endl;
+	LOG_DEBUG (backend, "get team channels" << LogField ("team_id", teamID) << LogField ("page", page));
 
-    httpConnector.get (request, HttpResponseCallback ([this, callback, teamID](QVariant, const QJsonDocument& doc) {
-    	LOG_DEBUG ("getTeamChannels reply");
-
-		BackendTeam* team = storage.getTeamById (teamID);
-
-		if (!team) {
-			return;
-		}
+	httpConnector.get (request, HttpResponseCallback ([callback](QVariant, const QJsonDocument& doc) {
+		std::vector<BackendChannelSummary> channels (parseChannelSummaries (doc));
+		callback (channels);
+	}));
+}
 
-		team->allPublicChannels.clear();
+void Backend::searchTeamPublicChannels (const MattermostId& teamID, const QString& term, std::function<void(std::vector<BackendChannelSummary>&)> callback)
+{
+	QJsonObject json {
+		{"term", term}
+	};
 
-		for (const auto &item: doc.array()) {
-			team->allPublicChannels.emplace_back (storage, item.toObject());
-		}
+	NetworkRequest request ("teams/" + teamID.toString() + "/channels/search");
 
-#if 0
-		QString jsonString = QJsonDocument::fromJson(data).toJson(QJsonDocument::Indented);
-		std::cout << "get team channels reply: " <<  jsonString.toStdString() << std::endl;
-#endif
-		callback (team->allPublicChannels);
-    }));
+	httpConnector.post (request, json, HttpResponseCallback ([callback](QVariant, const QJsonDocument& doc) {
+		std::vector<BackendChannelSummary> channels (parseChannelSummaries (doc));
+		callback (channels);
+	}));
 }
 
 void Backend::retrieveOwnChannelMembershipsForTeam (BackendTeam& team, std::function<void(BackendChannel&)> callback)
 {
-    NetworkRequest request ("users/me/teams/" + team.id + "/channels");
+    NetworkRequest request ("users/me/teams/" + team.id.toString() + "/channels");
 
     httpConnector.get (request, HttpResponseCallback ([this, &team, callback] (const QJsonDocument& doc) {
     	team.channels.clear ();
@@ -590,7 +663,7 @@ void Backend::retrieveOwnChannelMembershipsForTeam (BackendTeam& team, std::func
     	std::cout << "retrieveOwnChannelMembershipsForTeam reply: " <<  jsonString.toStdString() << std::endl;
 #endif
 
-    	LOG_DEBUG ("Team " << team.display_name << ":");
+    	LOG_DEBUG (backend, "Team " << team.display_name << ":");
 		for (const auto &itemRef: doc.array()) {
 
 			const QJsonObject& channelObject = itemRef.toObject();
@@ -611,7 +684,7 @@ void Backend::retrieveOwnChannelMembershipsForTeam (BackendTeam& team, std::func
 
 		for (auto& channel: team.channels) {
 			callback (*channel.get());
-			LOG_DEBUG ("\tChannel added: " << channel->id << " " << channel->display_name);
+			LOG_DEBUG (backend, "\tChannel added: " << channel->id << " " << channel->display_name);
 		}
 
 		--nonFilledTeams;
@@ -643,49 +716,149 @@ void Backend::retrieveOwnAllChannelMemberships (std::function<void ()> callback)
 }
 #endif
 
-void Backend::retrieveTeamMembers (BackendTeam& team, int page)
+void Backend::retrieveTeamMembers (BackendTeam& team)
 {
-	static constexpr int itemsPerPage = 60;
-	NetworkRequest request ("teams/" + team.id + "/members?page=" + QString::number(page) + "&per_page=" + QString::number (itemsPerPage));
+	TeamMembersLoad& load = teamMembersLoads[team.id];
+	load.start (++lastMembersLoadId);
+	load.memberCount = 0;
+	load.membersJson = QJsonArray ();
 
-	//LOG_DEBUG ("retrieveTeamMembers " << team.display_name << " page " << page);
+	MattermostId teamId (team.id);
+	uint32_t loadId = load.id;
+	NetworkRequest request ("teams/" + team.id.toString() + "/stats");
 
-	httpConnector.get(request, HttpResponseCallback ([this, &team, page] (const QJsonDocument& doc) {
+	httpConnector.get (request, HttpResponseCallback ([this, teamId, loadId] (const QJsonDocument& doc) {
 
-		auto root = doc.array();
-		for(const auto &itemRef: qAsConst(root)) {
-			BackendTeamMember member (itemRef.toObject());
-			member.user = storage.getUserById(member.user_id);
-			team.members.append (std::move (member));
-		}
+		auto loadIt = teamMembersLoads.find (teamId);
+		BackendTeam* team = storage.getTeamById (teamId);
 
-		//LOG_DEBUG ("Team " << team.display_name << " page " << page << " Members Count: " << root.size());
+		if (loadIt == teamMembersLoads.end() || loadIt->second.id != loadId) {
+			return;
+		}
 
-		//there may be more pages
-		if (root.size() == itemsPerPage) {
-			retrieveTeamMembers (team, page + 1);
+		if (!team) {
+			teamMembersLoads.erase (loadIt);
+			return;
 		}
 
-#if 0
-		for (auto& it: team.members) {
-			if (!it.user) {
-				std::cout << "\t" << it.user_id.toStdString() << " (no user) " << std::endl;
-			} else {
-				std::cout << "\t" << it.user_id.toStdString() << " " << it.user->username.toStdString() << std::endl;
+		TeamMembersLoad& load = loadIt->second;
+		load.memberCount = doc.object().value("total_member_count").toInt();
+
+		QFile cacheFile (teamMembersCacheFile (teamId));
+
+		if (cacheFile.open (QIODevice::ReadOnly)) {
+			QJsonObject cache (QJsonDocument::fromJson (cacheFile.readAll()).object());
+			qint64 age = QDateTime::currentMSecsSinceEpoch() - cache.value("saved_at").toVariant().toLongLong();
+
+			if (age >= 0 && age < teamMembersCacheMaxAgeMs && (uint32_t)cache.value("member_count").toInt() == load.memberCount) {
+				team->members.clear ();
+
+				for (const auto &itemRef: cache.value("members").toArray()) {
+					BackendTeamMember member (itemRef.toObject());
+					member.user = storage.getUserById (member.user_id);
+					team->addMember (std::move (member));
+				}
+
+				team->membersLoaded = true;
+				LOG_DEBUG (backend, "Team members of " << team->display_name << " loaded from the cache" << LogField ("members", (uint64_t)team->members.size()));
+				teamMembersLoads.erase (loadIt);
+				return;
 			}
 		}
-#endif
-	}));
+
+		load.pageCount = std::max<uint32_t> (CONTAINER_COUNT (load.memberCount, teamMembersPerPage), 1);
+		team->members.clear ();
+
+		LOG_DEBUG (backend, "retrieveTeamMembers " << team->display_name << LogField ("members", load.memberCount) << LogField ("pages", load.pageCount));
+
+		load.requestPages ([this, teamId, loadId] (uint32_t page) {
+			retrieveTeamMembersPage (teamId, page, loadId);
+		});
+	}), [this, teamId, loadId] (int) {
+		failTeamMembersLoad (teamId, loadId);
+	});
+}
+
+void Backend::retrieveTeamMembersPage (const MattermostId& teamId, uint32_t page, uint32_t loadId)
+{
+	NetworkRequest request ("teams/" + teamId.toString() + "/members?page=" + QString::number (page) + "&per_page=" + QString::number (teamMembersPerPage));
+
+	httpConnector.get (request, HttpResponseCallback ([this, teamId, page, loadId] (const QJsonDocument& doc) {
+
+		auto loadIt = teamMembersLoads.find (teamId);
+
+		if (loadIt == teamMembersLoads.end() || loadIt->second.id != loadId) {
+			return;
+		}
+
+		BackendTeam* team = storage.getTeamById (teamId);
+
+		if (!team) {
+			teamMembersLoads.erase (loadIt);
+			return;
+		}
+
+		TeamMembersLoad& load = loadIt->second;
+		QJsonArray root (doc.array());
+
+		for (const auto &itemRef: qAsConst(root)) {
+			BackendTeamMember member (itemRef.toObject());
+			member.user = storage.getUserById (member.user_id);
+			team->addMember (std::move (member));
+			load.membersJson.push_back (itemRef);
+		}
+
+		if (!load.pageReceived (page, root.size(), teamMembersPerPage)) {
+			load.requestPages ([this, teamId, loadId] (uint32_t nextPage) {
+				retrieveTeamMembersPage (teamId, nextPage, loadId);
+			});
+			return;
+		}
+
+		team->membersLoaded = true;
+
+		LOG_DEBUG (backend, "Team members of " << team->display_name << " loaded" << LogField ("members", (uint64_t)team->members.size())
+				<< LogField ("pages", load.pageCount) << LogField ("ms", load.timer.elapsed()));
+
+		QFile cacheFile (teamMembersCacheFile (teamId));
+		QDir().mkpath (QFileInfo (cacheFile).path());
+
+		if (cacheFile.open (QIODevice::WriteOnly | QIODevice::Truncate)) {
+			cacheFile.write (QJsonDocument (QJsonObject {
+				{"saved_at", QDateTime::currentMSecsSinceEpoch()},
+				{"member_count", (qint64)load.memberCount},
+				{"members", load.membersJson},
+			}).toJson (QJsonDocument::Compact));
+		}
+
+		teamMembersLoads.erase (loadIt);
+	}), [this, teamId, loadId] (int) {
+		failTeamMembersLoad (teamId, loadId);
+	});
+}
+
+void Backend::failTeamMembersLoad (const MattermostId& teamId, uint32_t loadId)
+{
+	auto loadIt = teamMembersLoads.find (teamId);
+
+	//a page of this load has failed before, or the load was started again
+	if (loadIt == teamMembersLoads.end() || loadIt->second.id != loadId) {
+		return;
+	}
+
+	//the load is started again after a reconnect
+	LOG_DEBUG (backend, "retrieveTeamMembers: load for " << teamId << " failed");
+	teamMembersLoads.erase (loadIt);
 }
 
-void Backend::retrieveChannel (BackendTeam& team, QString channelID)
+void Backend::retrieveChannel (BackendTeam& team, const MattermostId& channelID)
 {
-	NetworkRequest request ("channels/" + channelID);
+	NetworkRequest request ("channels/" + channelID.toString());
 
-	LOG_DEBUG ("retrieveChannel " << channelID);
+	LOG_DEBUG (backend, "retrieveChannel " << channelID);
 
 	httpConnector.get (request, HttpResponseCallback ([this, &team] (const QJsonDocument& doc) {
-		LOG_DEBUG ("retrieveChannel reply");
+		LOG_DEBUG (backend, "retrieveChannel reply");
 
 #if 0
 		QString jsonString = doc.toJson(QJsonDocument::Indented);
@@ -693,20 +866,20 @@ void Backend::retrieveChannel (BackendTeam& team, QString channelID)
 #endif
 
 		BackendChannel* channel =  storage.addTeamScopeChannel (team, doc.object());
-		LOG_DEBUG ("\tNew Channel added: " << channel->id << " " << channel->display_name);
+		LOG_DEBUG (backend, "\tNew Channel added: " << channel->id << " " << channel->display_name);
 
 		emit team.onNewChannel (*channel);
     }));
 }
 
-void Backend::retrieveDirectChannel (QString channelID)
+void Backend::retrieveDirectChannel (const MattermostId& channelID)
 {
-	NetworkRequest request ("channels/" + channelID);
+	NetworkRequest request ("channels/" + channelID.toString());
 
-	LOG_DEBUG ("retrieveChannel " << channelID);
+	LOG_DEBUG (backend, "retrieveChannel " << channelID);
 
 	httpConnector.get (request, HttpResponseCallback ([this] (const QJsonDocument& doc) {
-		LOG_DEBUG ("retrieveChannel reply");
+		LOG_DEBUG (backend, "retrieveChannel reply");
 
 #if 0
 		QString jsonString = doc.toJson(QJsonDocument::Indented);
@@ -714,7 +887,7 @@ void Backend::retrieveDirectChannel (QString channelID)
 #endif
 
 		BackendChannel* channel =  storage.addDirectChannel (doc.object());
-		LOG_DEBUG ("\tNew Channel added: " << channel->id << " " << channel->display_name);
+		LOG_DEBUG (backend, "\tNew Channel added: " << channel->id << " " << channel->display_name);
 
 		emit storage.directChannels.onNewChannel (*channel);
 
@@ -727,13 +900,17 @@ void Backend::retrieveDirectChannel (QString channelID)
     }));
 }
 
-void Backend::retrieveChannelPosts (BackendChannel& channel, int page, int perPage)
+void Backend::retrieveChannelPosts (BackendChannel& channel, int page, int perPage, std::function<void()> callback, std::function<void()> errorCallback)
 {
-    NetworkRequest request ("channels/" + channel.id + "/posts?page=" + QString::number(page) + "&per_page=" + QString::number(perPage));
+    NetworkRequest request ("channels/" + channel.id.toString() + "/posts?page=" + QString::number(page) + "&per_page=" + QString::number(perPage));
 
-    httpConnector.get (request, HttpResponseCallback ([this, &channel](const QJsonDocument& doc) {
+    //parsed here, so that the decoding is measured separately from the fetch, if the user is waiting for the channel
+    httpConnector.get (request, HttpResponseCallback ([this, &channel, callback](QByteArray data) {
 
-		LOG_DEBUG ("retrieveChannelPosts reply for " << channel.display_name << " (" << channel.id << ")");
+		LOG_DEBUG (backend, "retrieveChannelPosts reply for " << channel.display_name << " (" << channel.id << ")");
+		ChannelSwitchMetrics::instance().phaseDone (channel, SwitchPhase::fetch);
+
+		QJsonDocument doc = QJsonDocument::fromJson (data);
 
 #if 0
 		QString jsonString = doc.toJson(QJsonDocument::Indented);
@@ -742,34 +919,220 @@ void Backend::retrieveChannelPosts (BackendChannel& channel, int page, int perPa
 
 		QJsonObject root = doc.object();
 		channel.addPosts (root.value("order").toArray(), root.value("posts").toObject());
-    }));
+		scheduleMissingRootPosts ();
+		ChannelSwitchMetrics::instance().phaseDone (channel, SwitchPhase::decode);
+
+		if (callback) {
+			callback ();
+		}
+    }), [errorCallback] (int) {
+		if (errorCallback) {
+			errorCallback ();
+		}
+    });
 }
 
-void Backend::retrieveChannelOlderPosts (BackendChannel& channel, int perPage)
+void Backend::retrieveChannelPostsBefore (BackendChannel& channel, const MattermostId& postId, int perPage, std::function<void(int)> callback, std::function<void()> errorCallback)
 {
-    NetworkRequest request ("channels/" + channel.id + "/posts?page=" + QString::number(0) + "&per_page=" + QString::number(perPage) + "&before=" + channel.posts.front().id);
+	uint32_t historyGeneration = channel.historyGeneration;
 
-    httpConnector.get (request, HttpResponseCallback ([this, &channel](const QJsonDocument& doc) {
+    NetworkRequest request ("channels/" + channel.id.toString() + "/posts?page=" + QString::number(0) + "&per_page=" + QString::number(perPage) + "&before=" + postId.toString());
 
-		LOG_DEBUG ("retrieveChannelOlderPosts reply for " << channel.display_name << " (" << channel.id << ") - since " << channel.posts.front().id);
+    httpConnector.get (request, HttpResponseCallback ([this, &channel, postId, historyGeneration, callback](const QJsonDocument& doc) {
 
-#if 0
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
-		std::cout << jsonString.toStdString() << std::endl;
-#endif
+		LOG_DEBUG (backend, "retrieveChannelPostsBefore reply for " << channel.display_name << " (" << channel.id << ") - before " << postId);
+
+		//the history was trimmed while waiting, the posts would not be adjacent to the loaded ones
+		if (channel.historyGeneration != historyGeneration) {
+			LOG_DEBUG (backend, "retrieveChannelPostsBefore: history of " << channel.display_name << " trimmed, reply ignored");
+			return;
+		}
 
 		QJsonObject root = doc.object();
-		channel.prependPosts (root.value("order").toArray(), root.value("posts").toObject());
-    }));
+		QJsonArray orderArray (root.value("order").toArray());
+		channel.addPostsBefore (postId, orderArray, root.value("posts").toObject());
+		scheduleMissingRootPosts ();
+
+		if (callback) {
+			callback (orderArray.size());
+		}
+    }), [errorCallback] (int) {
+		if (errorCallback) {
+			errorCallback ();
+		}
+    });
+}
+
+void Backend::retrieveChannelPostsAfter (BackendChannel& channel, const MattermostId& postId, int perPage, std::function<void(int)> callback, std::function<void()> errorCallback)
+{
+	uint32_t historyGeneration = channel.historyGeneration;
+
+    NetworkRequest request ("channels/" + channel.id.toString() + "/posts?page=" + QString::number(0) + "&per_page=" + QString::number(perPage) + "&after=" + postId.toString());
+
+    httpConnector.get (request, HttpResponseCallback ([this, &channel, postId, historyGeneration, callback](const QJsonDocument& doc) {
+
+		LOG_DEBUG (backend, "retrieveChannelPostsAfter reply for " << channel.display_name << " (" << channel.id << ") - after " << postId);
+
+		if (channel.historyGeneration != historyGeneration) {
+			LOG_DEBUG (backend, "retrieveChannelPostsAfter: history of " << channel.display_name << " trimmed, reply ignored");
+			return;
+		}
+
+		QJsonObject root = doc.object();
+		QJsonArray orderArray (root.value("order").toArray());
+		channel.addPostsAfter (postId, orderArray, root.value("posts").toObject());
+		scheduleMissingRootPosts ();
+
+		if (callback) {
+			callback (orderArray.size());
+		}
+    }), [errorCallback] (int) {
+		if (errorCallback) {
+			errorCallback ();
+		}
+    });
+}
+
+void Backend::retrieveChannelPostsAround (BackendChannel& channel, const MattermostId& postId, int perPage)
+{
+	if (channel.isPostLoaded (postId)) {
+		retrieveChannelPostsBefore (channel, postId, perPage);
+		retrieveChannelPostsAfter (channel, postId, perPage);
+		return;
+	}
+
+	//the anchor post is added first, so that the pages around it have a post to be adjacent to
+	NetworkRequest request ("posts/" + postId.toString());
+
+	httpConnector.get (request, HttpResponseCallback ([this, &channel, postId, perPage](const QJsonDocument& doc) {
+
+		LOG_DEBUG (backend, "retrieveChannelPostsAround reply for " << channel.display_name << " (" << channel.id << ") - around " << postId);
+
+		if (!channel.addAnchorPost (doc.object())) {
+			return;
+		}
+
+		retrieveChannelPostsBefore (channel, postId, perPage);
+		retrieveChannelPostsAfter (channel, postId, perPage);
+		scheduleMissingRootPosts ();
+	}));
+}
+
+void Backend::retrieveThread (BackendChannel& channel, const MattermostId& rootId)
+{
+	NetworkRequest request ("posts/" + rootId.toString() + "/thread");
+
+	httpConnector.get (request, HttpResponseCallback ([this, &channel, rootId](const QJsonDocument& doc) {
+
+		LOG_DEBUG (backend, "retrieveThread reply for " << rootId << " in " << channel.display_name);
+
+		QJsonObject root = doc.object();
+		channel.addThreadPosts (rootId, root.value("order").toArray(), root.value("posts").toObject());
+		scheduleMissingRootPosts ();
+	}));
+}
+
+void Backend::scheduleMissingRootPosts ()
+{
+	if (!missingRootsTimer.isActive()) {
+		missingRootsTimer.start ();
+	}
 }
 
-void Backend::retrieveChannelUnreadPost (BackendChannel& channel, std::function<void (const QString&)> responseHandler)
+void Backend::retrieveMissingRootPosts ()
 {
-	NetworkRequest request ("users/me/channels/" + channel.id + "/posts/unread?limit_before=0&limit_after=1");
+	RequestedRootIds requestedRoots;
+
+	for (auto& it: storage.channels) {
+		for (const MattermostId& rootId: it.second->takeMissingRootIds ()) {
+			requestedRoots.emplace_back (it.second->id, rootId);
+		}
+	}
+
+	if (!requestedRoots.empty()) {
+		retrieveRootPosts (std::move (requestedRoots));
+	}
+}
+
+void Backend::retrieveRootPosts (RequestedRootIds&& requestedRoots)
+{
+	QJsonArray postIDsJson;
+
+	for (const auto& it: requestedRoots) {
+		postIDsJson.push_back (it.second.toString());
+	}
+
+	NetworkRequest request ("posts/ids");
+	uint32_t requestId = ++lastMissingRootsRequestId;
+	missingRootsRequests.emplace (requestId, std::move (requestedRoots));
+
+	httpConnector.post (request, postIDsJson, HttpResponseCallback ([this, requestId] (const QJsonDocument& doc) {
+		missingRootsRequests.erase (requestId);
+
+		LOG_DEBUG (backend, "retrieveMissingRootPosts reply" << LogField ("posts", doc.array().size()));
+
+		for (const auto& element: doc.array()) {
+			QJsonObject postObject (element.toObject());
+			BackendChannel* channel = storage.getChannelById (postObject.value("channel_id").toString());
+
+			if (!channel) {
+				continue;
+			}
+
+			channel->addDetachedPost (postObject);
+		}
+	}), [this, requestId] (int httpStatus) {
+		auto it = missingRootsRequests.find (requestId);
+
+		//cancelled by a reconnect, the roots are already requested again
+		if (it == missingRootsRequests.end()) {
+			return;
+		}
+
+		RequestedRootIds requestedRoots (std::move (it->second));
+		missingRootsRequests.erase (it);
+
+		//network error: the roots are sent with the next request, or after the reconnect
+		if (!httpStatus) {
+			LOG_DEBUG (backend, "retrieveMissingRootPosts failed, roots queued again" << LogField ("roots", (uint64_t) requestedRoots.size()));
+			requeueMissingRootIds (requestedRoots);
+			return;
+		}
+
+		/*
+		 * The server has rejected the request, for example because of a root post, which cannot be read.
+		 * The batch is split, so that the other roots are still received, and a rejected root is dropped
+		 */
+		if (requestedRoots.size() == 1) {
+			LOG_DEBUG (backend, "retrieveMissingRootPosts: root " << requestedRoots.front().second << " dropped" << LogField ("status", httpStatus));
+			return;
+		}
+
+		RequestedRootIds secondHalf (requestedRoots.begin() + requestedRoots.size() / 2, requestedRoots.end());
+		requestedRoots.resize (requestedRoots.size() / 2);
+		retrieveRootPosts (std::move (requestedRoots));
+		retrieveRootPosts (std::move (secondHalf));
+	});
+}
+
+void Backend::requeueMissingRootIds (const RequestedRootIds& requestedRoots)
+{
+	for (const auto& it: requestedRoots) {
+		BackendChannel* channel = storage.getChannelById (it.first);
+
+		if (channel) {
+			channel->requeueMissingRootIds ({it.second});
+		}
+	}
+}
+
+void Backend::retrieveChannelUnreadPost (BackendChannel& channel, std::function<void (const MattermostId&)> responseHandler, std::function<void()> errorCallback)
+{
+	NetworkRequest request ("users/me/channels/" + channel.id.toString() + "/posts/unread?limit_before=0&limit_after=1");
 
     httpConnector.get (request, HttpResponseCallback ([this, &channel, responseHandler](const QJsonDocument& doc) {
 
-    	//LOG_DEBUG ("getChannelUnreadPost reply for " << channel.display_name << " (" << channel.id << ")");
+    	//LOG_DEBUG (backend, "getChannelUnreadPost reply for " << channel.display_name << " (" << channel.id << ")");
 
 #if 0
 		QString jsonString = doc.toJson(QJsonDocument::Indented);
@@ -777,58 +1140,181 @@ void Backend::retrieveChannelUnreadPost (BackendChannel& channel, std::function<
 #endif
 
 		QJsonObject root = doc.object();
-		QString lastReadPost (root.value("prev_post_id").toString());
+		MattermostId lastReadPost (root.value("prev_post_id").toString());
+
+		responseHandler (lastReadPost);
 
 		if (!lastReadPost.isEmpty()) {
-			responseHandler (lastReadPost);
 			emit onUnreadPostsAtStartup (channel);
-		} else {
-			static QString emptyString ("");
-			responseHandler (emptyString);
 		}
-    }));
+    }), [errorCallback] (int) {
+		if (errorCallback) {
+			errorCallback ();
+		}
+    });
 }
 
-void Backend::retrieveChannelMembers (BackendChannel& channel)
+void Backend::retrieveChannelMembers (BackendChannel& channel, std::function<void()> callback, std::function<void()> errorCallback)
 {
-	NetworkRequest request ("channels/" + channel.id + "/members");
+	if (channel.membersLoaded) {
+		callback ();
+		return;
+	}
+
+	auto loadIt = channelMembersLoads.find (channel.id);
 
-	httpConnector.get (request, HttpResponseCallback ([this, &channel](const QJsonDocument& doc) {
+	if (loadIt != channelMembersLoads.end()) {
+		loadIt->second.callbacks.emplace_back (callback, errorCallback);
+		return;
+	}
 
-		//LOG_DEBUG ("retrieveChannelMembers reply");
+	ChannelMembersLoad& load = channelMembersLoads[channel.id];
+	load.start (++lastMembersLoadId);
+	load.callbacks.emplace_back (callback, errorCallback);
 
-		auto root = doc.array();
-		for(const auto &itemRef: qAsConst(root)) {
+	MattermostId channelId (channel.id);
+	uint32_t loadId = load.id;
+	NetworkRequest request ("channels/" + channel.id.toString() + "/stats");
+
+	httpConnector.get (request, HttpResponseCallback ([this, channelId, loadId](const QJsonDocument& doc) {
+
+		auto loadIt = channelMembersLoads.find (channelId);
+
+		if (loadIt == channelMembersLoads.end() || loadIt->second.id != loadId) {
+			return;
+		}
+
+		ChannelMembersLoad& load = loadIt->second;
+		uint32_t memberCount = doc.object().value("member_count").toInt();
+		load.pageCount = std::max<uint32_t> (CONTAINER_COUNT (memberCount, channelMembersPerPage), 1);
+
+		LOG_DEBUG (backend, "retrieveChannelMembers " << channelId << LogField ("members", memberCount) << LogField ("pages", load.pageCount));
+
+		//the members, loaded before (and possibly missed updates since), are replaced
+		BackendChannel* channel = storage.getChannelById (channelId);
+
+		if (channel) {
+			channel->members.clear ();
+		}
+
+		load.requestPages ([this, channelId, loadId] (uint32_t page) {
+			retrieveChannelMembersPage (channelId, page, loadId);
+		});
+	}), [this, channelId, loadId] (int) {
+		failChannelMembersLoad (channelId, loadId);
+	});
+}
+
+void Backend::retrieveChannelMembersPage (const MattermostId& channelId, uint32_t page, uint32_t loadId)
+{
+	NetworkRequest request ("channels/" + channelId.toString() + "/members?page=" + QString::number (page) + "&per_page=" + QString::number (channelMembersPerPage));
+
+	httpConnector.get (request, HttpResponseCallback ([this, channelId, page, loadId](const QJsonDocument& doc) {
+
+		auto loadIt = channelMembersLoads.find (channelId);
+
+		//the load was started again
+		if (loadIt == channelMembersLoads.end() || loadIt->second.id != loadId) {
+			return;
+		}
+
+		BackendChannel* channel = storage.getChannelById (channelId);
+
+		//the channel was left meanwhile
+		if (!channel) {
+			channelMembersLoads.erase (loadIt);
+			return;
+		}
+
+		ChannelMembersLoad& load = loadIt->second;
+		QJsonArray root (doc.array());
+
+		for (const auto &itemRef: qAsConst(root)) {
 			BackendChannelMember member (itemRef.toObject());
-			member.user = storage.getUserById(member.user_id);
-			channel.members.append (std::move (member));
+			member.user = storage.getUserById (member.user_id);
+			channel->addMember (std::move (member));
 		}
 
-		//LOG_DEBUG ("Channel Members Count: " << channel.members.size());
-#if 0
-		for (auto& it: team.members) {
-			if (!it.user) {
-				std::cout << "\t" << it.user_id.toStdString() << " (no user) " << std::endl;
-			} else {
-				std::cout << "\t" << it.user_id.toStdString() << " " << it.user->username.toStdString() << std::endl;
-			}
+		if (!load.pageReceived (page, root.size(), channelMembersPerPage)) {
+			load.requestPages ([this, channelId, loadId] (uint32_t nextPage) {
+				retrieveChannelMembersPage (channelId, nextPage, loadId);
+			});
+			return;
 		}
-#endif
-	}));
+
+		LOG_DEBUG (backend, "Channel members of " << channel->display_name << " loaded" << LogField ("members", (uint64_t)channel->members.size())
+				<< LogField ("pages", load.pageCount) << LogField ("ms", load.timer.elapsed()));
+
+		channel->membersLoaded = true;
+		auto callbacks (std::move (load.callbacks));
+		channelMembersLoads.erase (loadIt);
+
+		for (auto& callback: callbacks) {
+			callback.first ();
+		}
+	}), [this, channelId, loadId] (int) {
+		failChannelMembersLoad (channelId, loadId);
+	});
+}
+
+void Backend::failChannelMembersLoad (const MattermostId& channelId, uint32_t loadId)
+{
+	auto loadIt = channelMembersLoads.find (channelId);
+
+	if (loadIt == channelMembersLoads.end() || loadIt->second.id != loadId) {
+		return;
+	}
+
+	//the next use starts a new load
+	LOG_DEBUG (backend, "retrieveChannelMembers: load for " << channelId << " failed");
+	auto callbacks (std::move (loadIt->second.callbacks));
+	channelMembersLoads.erase (loadIt);
+
+	for (auto& callback: callbacks) {
+		if (callback.second) {
+			callback.second ();
+		}
+	}
+}
+
+void Backend::MembersPagesLoad::start (uint32_t loadId)
+{
+	id = loadId;
+	pageCount = 0;
+	nextPage = 0;
+	receivedPages = 0;
+	timer.start ();
+}
+
+void Backend::MembersPagesLoad::requestPages (const std::function<void(uint32_t page)>& requestPage)
+{
+	while (nextPage < pageCount && nextPage - receivedPages < maxParallelMemberPages) {
+		requestPage (nextPage++);
+	}
+}
+
+bool Backend::MembersPagesLoad::pageReceived (uint32_t page, uint32_t pageSize, uint32_t perPage)
+{
+	++receivedPages;
+
+	//members, added after the count was taken, may not fit in the counted pages
+	if (page + 1 == pageCount && pageSize == perPage) {
+		++pageCount;
+	}
+
+	return receivedPages == pageCount;
 }
 
 void Backend::retrievePollMetadata (BackendPoll& poll)
 {
 	NetworkRequest request (NetworkRequest::matterpoll, "polls/" + poll.id + "/metadata");
 
-	LOG_DEBUG ("retrievePollMetadata request");
+	LOG_DEBUG (backend, "retrievePollMetadata request");
 
 	httpConnector.get (request, HttpResponseCallback ([this, &poll](const QJsonDocument& doc) {
 
-		LOG_DEBUG ("retrievePollMetadata reply");
-
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
-		std::cout << jsonString.toStdString() << std::endl;
+		LOG_DEBUG (backend, "retrievePollMetadata reply");
+		LOG_TRACE (http, "retrievePollMetadata reply: " << doc.toJson (QJsonDocument::Compact));
 
 		poll.fillMetadata (doc.object());
 	}));
@@ -838,10 +1324,10 @@ void Backend::markChannelAsViewed (BackendChannel& channel)
 {
 	QJsonObject  json;
 
-	json.insert ("channel_id", channel.id);
+	json.insert ("channel_id", channel.id.toString());
 
 	//maybe add prev_channel_id, the Mattermost API supports it
-	//json.insert ("prev_channel_id", channel.id);
+	//json.insert ("prev_channel_id", channel.id.toString());
 
 	NetworkRequest request ("channels/members/me/view");
 
@@ -861,19 +1347,17 @@ void Backend::markChannelAsViewed (BackendChannel& channel)
 void Backend::editChannelProperties (BackendChannel& channel, const BackendChannelProperties& newProperties)
 {
 	QJsonObject  json {
-		{"id", channel.id},
+		{"id", channel.id.toString()},
 		{"name", channel.name},
 		{"display_name", newProperties.displayName},
 		{"purpose", newProperties.purpose},
 		{"header", newProperties.header},
 	};
 
-	QString jsonString = QJsonDocument(json).toJson(QJsonDocument::Indented);
-	std::cout << jsonString.toStdString() << std::endl;
-
 	QByteArray data (QJsonDocument (json).toJson(QJsonDocument::Compact));
+	LOG_TRACE (http, "editChannelProperties request: " << data);
 
-	NetworkRequest request ("channels/" + channel.id);
+	NetworkRequest request ("channels/" + channel.id.toString());
 	request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
 	httpConnector.put (request, data, HttpResponseCallback ([this](QVariant, QByteArray) {
@@ -886,7 +1370,7 @@ void Backend::editChannelProperties (BackendChannel& channel, const BackendChann
 	}));
 }
 
-void Backend::addPost (BackendChannel& channel, const QString& message, const QList<QString>& attachments, const QString& rootID)
+void Backend::addPost (BackendChannel& channel, const QString& message, const QList<QString>& attachments, const MattermostId& rootID)
 {
 	QJsonArray files;
 
@@ -896,7 +1380,7 @@ void Backend::addPost (BackendChannel& channel, const QString& message, const QL
 
 	QJsonObject  json;
 
-	json.insert ("channel_id", channel.id);
+	json.insert ("channel_id", channel.id.toString());
 	json.insert ("message", message);
 
 	if (!files.isEmpty()) {
@@ -904,7 +1388,7 @@ void Backend::addPost (BackendChannel& channel, const QString& message, const QL
 	}
 
 	if (!rootID.isEmpty()) {
-		json.insert ("root_id", rootID);
+		json.insert ("root_id", rootID.toString());
 	}
 
 
@@ -919,7 +1403,7 @@ void Backend::addPost (BackendChannel& channel, const QString& message, const QL
 	}));
 }
 
-void Backend::editPost (const QString& postID, const QString& message, const QList<QString>& attachments)
+void Backend::editPost (const MattermostId& postID, const QString& message, const QList<QString>& attachments)
 {
 	QJsonArray files;
 
@@ -935,32 +1419,26 @@ void Backend::editPost (const QString& postID, const QString& message, const QLi
 		json.insert ("file_ids", files);
 	}
 
-	QString jsonString = QJsonDocument(json).toJson(QJsonDocument::Indented);
-	std::cout << jsonString.toStdString() << std::endl;
-
     QByteArray data (QJsonDocument (json).toJson(QJsonDocument::Compact));
+	LOG_TRACE (http, "editPost request: " << data);
 
-	NetworkRequest request ("posts/" + postID + "/patch");
+	NetworkRequest request ("posts/" + postID.toString() + "/patch");
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
 	httpConnector.put (request, data, HttpResponseCallback ([this](const QJsonDocument& doc) {
 
-#if 1
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
-		std::cout << jsonString.toStdString() << std::endl;
-#endif
-
+		LOG_TRACE (http, "editPost reply: " << doc.toJson (QJsonDocument::Compact));
 	}));
 }
 
-void Backend::deletePost (const QString postID)
+void Backend::deletePost (const MattermostId& postID)
 {
-	NetworkRequest request ("posts/" + postID);
+	NetworkRequest request ("posts/" + postID.toString());
 
 	httpConnector.del (request);
 }
 
-void Backend::pinPost (const QString postID)
+void Backend::pinPost (const MattermostId& postID)
 {
 
 }
@@ -971,10 +1449,10 @@ void Backend::addPoll (BackendChannel& channel, const BackendNewPollData& pollDa
 
 	QJsonObject json {
 		{"callback_id", ""},
-		{"channel_id", channel.id},
+		{"channel_id", channel.id.toString()},
 		{"state", ""},
 		{"url", "/plugins/com.github.matterpoll.matterpoll/api/v1/polls/create"},
-		{"team_id", channel.team->id}
+		{"team_id", channel.team->id.toString()}
 	};
 
 	auto submission = QJsonObject {
@@ -1009,11 +1487,11 @@ void Backend::addPoll (BackendChannel& channel, const BackendNewPollData& pollDa
 	return;
 }
 
-void Backend::addPostReaction (const QString& postID, const QString& emojiName)
+void Backend::addPostReaction (const MattermostId& postID, const QString& emojiName)
 {
 	QJsonObject json {
-		{"user_id", getLoginUser().id},
-		{"post_id", postID},
+		{"user_id", getLoginUser().id.toString()},
+		{"post_id", postID.toString()},
 		{"emoji_name", emojiName},
 		{"create_at", 0},
 	};
@@ -1026,19 +1504,16 @@ void Backend::addPostReaction (const QString& postID, const QString& emojiName)
 
 void Backend::sendPostAction (const BackendPost& post, const QString& action)
 {
-	NetworkRequest request  ("posts/" + post.id + "/actions/" + action);
+	NetworkRequest request  ("posts/" + post.id.toString() + "/actions/" + action);
 
 	httpConnector.post (request, QByteArray(), HttpResponseCallback ([this](const QJsonDocument& doc) {
 
-#if 1
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
-		std::cout << "sendPostAction reply: " << jsonString.toStdString() << std::endl;
+		LOG_TRACE (http, "sendPostAction reply: " << doc.toJson (QJsonDocument::Compact));
 
 		const QJsonObject& obj = doc.object();
 		if (obj.value("status").toString() == "OK") {
 			serverDialogsMap.addEvent (obj.value ("trigger_id").toString());
 		}
-#endif
 
 	}));
 }
@@ -1047,25 +1522,22 @@ void Backend::uploadFile (BackendChannel& channel, const QString& filePath, std:
 {
 	QFileInfo fileInfo (filePath);
 
-	NetworkRequest request ("files?channel_id=" + channel.id + "&filename=" + fileInfo.fileName());
+	NetworkRequest request ("files?channel_id=" + channel.id.toString() + "&filename=" + fileInfo.fileName());
 	request.setHeader(QNetworkRequest::ContentTypeHeader, "application/octet-stream");
 
 	QFile file (filePath);
 
 	if (!file.open(QIODevice::ReadOnly)) {
-		qDebug() << "Cannot open file " << filePath;
+		LOG_ERROR (backend, "Cannot open file " << filePath);
 		return;
 	}
 
 	QByteArray data = file.readAll();
-	qDebug() << data.size();
+	LOG_DEBUG (backend, "uploadFile " << fileInfo.fileName() << LogField ("channel_id", channel.id) << LogField ("bytes", data.size()));
 
 	httpConnector.post (request, data, HttpResponseCallback ([this, responseHandler](QVariant, const QJsonDocument& doc) {
 
-#if 1
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
-		std::cout << jsonString.toStdString() << std::endl;
-#endif
+		LOG_TRACE (http, "uploadFile reply: " << doc.toJson (QJsonDocument::Compact));
 
 		QJsonObject root = doc.object();
 		QJsonArray arr = root.value ("file_infos").toArray();
@@ -1080,7 +1552,7 @@ void Backend::uploadFile (BackendChannel& channel, const QString& filePath, std:
 
 void Backend::createDirectChannel (const BackendUser& user)
 {
-	QJsonArray json {getLoginUser().id, user.id};
+	QJsonArray json {getLoginUser().id.toString(), user.id.toString()};
 
 	NetworkRequest request ("channels/direct");
 
@@ -1094,13 +1566,18 @@ void Backend::createDirectChannel (const BackendUser& user)
 	}));
 }
 
-void Backend::addUserToChannel (const BackendChannel& channel, const QString& userID)
+void Backend::addUserToChannel (const BackendChannel& channel, const MattermostId& userID)
+{
+	addUserToChannel (channel.id, userID);
+}
+
+void Backend::addUserToChannel (const MattermostId& channelID, const MattermostId& userID)
 {
 	QJsonObject json {
-		{"user_id", userID}
+		{"user_id", userID.toString()}
 	};
 
-	NetworkRequest request ("channels/" + channel.id + "/members");
+	NetworkRequest request ("channels/" + channelID.toString() + "/members");
 
 	httpConnector.post (request, json, HttpResponseCallback ([this](QVariant, QByteArray) {
 #if 0
@@ -1118,21 +1595,26 @@ void Backend::joinChannel (const BackendChannel& channel)
 	return addUserToChannel (channel, getLoginUser().id);
 }
 
+void Backend::joinChannel (const BackendChannelSummary& channel)
+{
+	addUserToChannel (channel.id, getLoginUser().id);
+}
+
 void Backend::leaveChannel (const BackendChannel& channel)
 {
-	NetworkRequest request ("channels/" + channel.id + "/members/" + getLoginUser().id);
+	NetworkRequest request ("channels/" + channel.id.toString() + "/members/" + getLoginUser().id.toString());
 
 	httpConnector.del (request);
 }
 
-void Backend::addUserToTeam (const BackendTeam& team, const QString& userID)
+void Backend::addUserToTeam (const BackendTeam& team, const MattermostId& userID)
 {
 	QJsonObject json {
-		{"user_id", userID},
-		{"team_id", team.id}
+		{"user_id", userID.toString()},
+		{"team_id", team.id.toString()}
 	};
 
-	NetworkRequest request ("teams/" + team.id + "/members");
+	NetworkRequest request ("teams/" + team.id.toString() + "/members");
 
 	httpConnector.post (request, json, HttpResponseCallback ([this](QVariant, QByteArray) {
 #if 0
@@ -1147,9 +1629,7 @@ void Backend::addUserToTeam (const BackendTeam& team, const QString& userID)
 
 void Backend::sendSubmitDialog (const QJsonDocument& json)
 {
-	QString jsonString = json.toJson(QJsonDocument::Indented);
-	qDebug() << "SendSubmitDialog request: " << jsonString.toStdString().c_str();
-
+	LOG_TRACE (http, "SendSubmitDialog request: " << json.toJson (QJsonDocument::Compact));
 
 	NetworkRequest request ("actions/dialogs/submit");
 	httpConnector.post (request, json, HttpResponseCallback ([] (QVariant, QByteArray) {
@@ -1187,7 +1667,7 @@ void Backend::retrieveCustomEmojis ()
 				QFile file (filePath);
 
 				if (!file.open (QIODevice::WriteOnly)) {
-					qDebug() << "retrieveCustomEmojiImage: Cannot open " << filePath << ":" << file.errorString();
+					LOG_ERROR (backend, "retrieveCustomEmojiImage: Cannot open " << filePath << ":" << file.errorString());
 					return;
 				}
 
@@ -1220,5 +1700,31 @@ ServerDialogsMap& Backend::getServerDialogsMap ()
 	return serverDialogsMap;
 }
 
+NetworkMetrics& Backend::getNetworkMetrics ()
+{
+	return networkMetrics;
+}
+
+const PostHistoryBudget& Backend::getHistoryBudget () const
+{
+	return historyBudget;
+}
+
+uint32_t Backend::getPendingHttpRequestsCount () const
+{
+	return httpConnector.getPendingRequestsCount ();
+}
+
+WebSocketCompressionStats Backend::getWebSocketCompressionStats () const
+{
+	return webSocketConnector.getCompressionStats ();
+}
+
+void Backend::setNetworkConditions (const NetworkConditions& conditions)
+{
+	httpConnector.setNetworkConditions (conditions);
+	webSocketConnector.setNetworkConditions (conditions);
+}
+
 } /* namespace Mattermost */
 
@@ -24,17 +24,23 @@
 
 #pragma once
 
+#include <map>
 #include <QNetworkCookie>
 #include <QObject>
 #include <QList>
 #include <QNetworkDiskCache>
+#include <QElapsedTimer>
+#include <QJsonArray>
 
 #include "backend/types/BackendLoginData.h"
+#include "backend/types/BackendChannelSummary.h"
 #include "backend/HTTPConnector.h"
 #include "backend/WebSocketConnector.h"
 #include "backend/WebSocketEventHandler.h"
 #include "backend/Storage.h"
 #include "backend/ServerDialogsMap.h"
+#include "backend/NetworkMetrics.h"
+#include "backend/PostHistoryBudget.h"
 
 namespace Mattermost {
 
@@ -60,7 +66,7 @@ public:
 	void logout (std::function<void ()> callback);
 
 	//get specific user (/users/userID)
-	void retrieveUser (QString userID, std::function<void(BackendUser&)> callback);
+	void retrieveUser (const MattermostId& userID, std::function<void(BackendUser&)> callback);
 
 	//get user's preferences (/users/{user_id}/preferences)
 	void retrieveUserPreferences ();
@@ -68,7 +74,7 @@ public:
 	void updateUserPreferences (const BackendUserPreferences& preferences);
 
 	//get user's status (/users/status/ids)
-	void retrieveMultipleUsersStatus (QVector<QString> userIDs, std::function<void()> callback);
+	void retrieveMultipleUsersStatus (QVector<MattermostId> userIDs, std::function<void()> callback);
 
 	//get count of all users in the system (users/stats)
 	void retrieveTotalUsersCount (std::function<void(uint32_t)> callback);
@@ -77,7 +83,7 @@ public:
 	void retrieveAllUsers ();
 
 	//get user's avatar image (/users/userID/image). Emits BackendUser::onAvatarChanged
-	void retrieveUserAvatar (QString userID, uint64_t lastUpdateTime = 0);
+	void retrieveUserAvatar (const MattermostId& userID, uint64_t lastUpdateTime = 0);
 
 	//get file (files/fileID)
 	void retrieveFile (QString fileID, std::function<void(const QByteArray&)> callback);
@@ -86,10 +92,13 @@ public:
 	void retrieveOwnTeams (std::function<void(BackendTeam&)> callback);
 
 	//get a team (/teams/teamID)
-	void retrieveTeam (QString teamID);
+	void retrieveTeam (const MattermostId& teamID);
 
-	//get all public channels for a team (/teams/teamID/channels)
-	void retrieveTeamPublicChannels (QString teamID, std::function<void(std::list<BackendChannel>&)> callback);
+	//get a page of the public channels in a team (/teams/teamID/channels?page=page&per_page=perPage)
+	void retrieveTeamPublicChannelsPage (const MattermostId& teamID, int page, int perPage, std::function<void(std::vector<BackendChannelSummary>&)> callback);
+
+	//search the public channels in a team by name (POST /teams/teamID/channels/search)
+	void searchTeamPublicChannels (const MattermostId& teamID, const QString& term, std::function<void(std::vector<BackendChannelSummary>&)> callback);
 
 	//get own channel memberships (/users/me/teams/teamID/channels)
 	void retrieveOwnChannelMembershipsForTeam (BackendTeam& team, std::function<void(BackendChannel&)> callback);
@@ -97,24 +106,56 @@ public:
 	//get own channel memberships from all teams (/users/me/channel_members)
 	//void retrieveOwnAllChannelMemberships (std::function<void()> callback);
 
-	//get team members (/teams/teamID/members)
-	void retrieveTeamMembers (BackendTeam& team, int page = 0);
+	/**
+	 * Get the team members: the member count (/teams/teamID/stats), then the pages of /teams/teamID/members,
+	 * a few of them in parallel. The list is saved in the cache directory and used instead of the pages,
+	 * while it is not older than a day and the member count has not changed
+	 */
+	void retrieveTeamMembers (BackendTeam& team);
 
 	//get a channel (/channels/channelID)
-	void retrieveChannel (BackendTeam& team, QString channelID);
-	void retrieveDirectChannel (QString channelID);
+	void retrieveChannel (BackendTeam& team, const MattermostId& channelID);
+	void retrieveDirectChannel (const MattermostId& channelID);
+
+	/**
+	 * get posts in a channel (/channels/ID/posts). The callback is called after the posts are merged,
+	 * the error callback if the request fails
+	 */
+	void retrieveChannelPosts (BackendChannel& channel, int page, int perPage, std::function<void()> callback = nullptr, std::function<void()> errorCallback = nullptr);
+
+	/**
+	 * get the posts before / after a loaded post (/channels/ID/posts?before=postID, /channels/ID/posts?after=postID).
+	 * The callback is called with the number of received posts, after they are merged, the error callback
+	 * if the request fails
+	 */
+	void retrieveChannelPostsBefore (BackendChannel& channel, const MattermostId& postId, int perPage, std::function<void(int)> callback = nullptr, std::function<void()> errorCallback = nullptr);
+	void retrieveChannelPostsAfter (BackendChannel& channel, const MattermostId& postId, int perPage, std::function<void(int)> callback = nullptr, std::function<void()> errorCallback = nullptr);
 
-	//get posts in a channel (/channels/ID/posts)
-	void retrieveChannelPosts (BackendChannel& channel, int page, int perPage);
+	/**
+	 * Load a window of the history around a post, which may be far from the loaded history (/posts/{post_id},
+	 * then the pages before and after it). The new posts are reported by BackendChannel::onNewPosts()
+	 */
+	void retrieveChannelPostsAround (BackendChannel& channel, const MattermostId& postId, int perPage);
 
-	//get older posts in a channel (before the first one) (/channels/ID/posts)
-	void retrieveChannelOlderPosts (BackendChannel& channel, int perPage);
+	//get the posts of a thread (/posts/{post_id}/thread), when the thread is opened. The result is reported by BackendChannel::onThreadLoaded()
+	void retrieveThread (BackendChannel& channel, const MattermostId& rootId);
+
+	/**
+	 * Request the root posts, which are missing in the channels (see BackendChannel::takeMissingRootIds()).
+	 * The request is sent once per event loop iteration, for the missing roots of all channels (/posts/ids)
+	 */
+	void scheduleMissingRootPosts ();
 
 	//get first unread post in a channel (/users/{user_id}/channels/{channel_id}/posts/unread)
-	void retrieveChannelUnreadPost (BackendChannel& channel, std::function<void(const QString&)> responseHandler);
+	void retrieveChannelUnreadPost (BackendChannel& channel, std::function<void(const MattermostId&)> responseHandler, std::function<void()> errorCallback = nullptr);
 
-	//get channel members (/channels/{channel_id}/members)
-	void retrieveChannelMembers (BackendChannel& channel);
+	/**
+	 * Load the members of a channel, when a feature needs them: the member count (/channels/{channel_id}/stats),
+	 * then the pages of /channels/{channel_id}/members, a few of them in parallel. The loaded members are kept
+	 * up to date by the WebSocket events. The callback is called when all members are loaded, immediately if they
+	 * already are. The error callback is called if a request of the load fails
+	 */
+	void retrieveChannelMembers (BackendChannel& channel, std::function<void()> callback, std::function<void()> errorCallback = nullptr);
 
 	//get poll metadata (/plugins/com.github.matterpoll.matterpoll/api/v1/polls/{poll_id}/metadata)
 	void retrievePollMetadata (BackendPoll& poll);
@@ -126,22 +167,22 @@ public:
 	void editChannelProperties (BackendChannel& channel, const BackendChannelProperties& newProperties);
 
 	//add new post in a channel (/posts)
-	void addPost (BackendChannel& channel, const QString& message, const QList<QString>& attachments, const QString& rootID = "");
+	void addPost (BackendChannel& channel, const QString& message, const QList<QString>& attachments, const MattermostId& rootID = MattermostId());
 
 	//edit post (/posts/{post_id}/patch)
-	void editPost (const QString& postID, const QString& message, const QList<QString>& attachments);
+	void editPost (const MattermostId& postID, const QString& message, const QList<QString>& attachments);
 
 	//delete a post (/posts/{post_id})
-	void deletePost (const QString postID);
+	void deletePost (const MattermostId& postID);
 
 	//pin a post (/posts/{post_id}/pin)
-	void pinPost (const QString postID);
+	void pinPost (const MattermostId& postID);
 
 	//add a poll (/actions/dialogs/submit /plugins/com.github.matterpoll.matterpoll/api/v1/polls/create)
 	void addPoll (BackendChannel& channel, const BackendNewPollData& pollData);
 
 	//add a reaction to a post (/reactions)
-	void addPostReaction (const QString& postID, const QString& emojiName);
+	void addPostReaction (const MattermostId& postID, const QString& emojiName);
 
 	//send a post action (/posts/{post_id}/actions/{action})
 	void sendPostAction (const BackendPost& post, const QString& action);
@@ -153,16 +194,18 @@ public:
 	void createDirectChannel (const BackendUser& user);
 
 	//add a user to a channel (/channels/{channel_id}/members)
-	void addUserToChannel (const BackendChannel& channel, const QString& userID);
+	void addUserToChannel (const BackendChannel& channel, const MattermostId& userID);
+	void addUserToChannel (const MattermostId& channelID, const MattermostId& userID);
 
 	//join a channel (addUserToChannel for loginUser)
 	void joinChannel (const BackendChannel& channel);
+	void joinChannel (const BackendChannelSummary& channel);
 
 	//leave a channel (/channels/{channel_id}/members/{user_id})
 	void leaveChannel (const BackendChannel& channel);
 
 	//add a user to a channel (/teams/{team_id}/members)
-	void addUserToTeam (const BackendTeam& team, const QString& userID);
+	void addUserToTeam (const BackendTeam& team, const MattermostId& userID);
 
 	//send a submit dialog response. In most cases, dialogs are handled by the UI
 	void sendSubmitDialog (const QJsonDocument& json);
@@ -182,6 +225,19 @@ public:
 	Storage& getStorage ();
 
 	ServerDialogsMap& getServerDialogsMap ();
+
+	NetworkMetrics& getNetworkMetrics ();
+
+	const PostHistoryBudget& getHistoryBudget () const;
+
+	uint32_t getPendingHttpRequestsCount () const;
+
+	WebSocketCompressionStats getWebSocketCompressionStats () const;
+
+	/**
+	 * Simulate a slow or unreliable network for HTTP and WebSocket (for testing)
+	 */
+	void setNetworkConditions (const NetworkConditions& conditions);
 signals:
 
 	/**
@@ -223,11 +279,58 @@ signals:
     void onWebSocketConnect ();
     void onWebSocketDisconnect ();
 private:
+    //(channel ID, root ID) pairs, requested by a posts/ids request
+    using RequestedRootIds = std::vector<std::pair<MattermostId, MattermostId>>;
+
+    void retrieveMissingRootPosts ();
+    void retrieveRootPosts (RequestedRootIds&& requestedRoots);
+    void requeueMissingRootIds (const RequestedRootIds& requestedRoots);
+    void retrieveChannelMembersPage (const MattermostId& channelId, uint32_t page, uint32_t loadId);
+    void retrieveTeamMembersPage (const MattermostId& teamId, uint32_t page, uint32_t loadId);
+    void failTeamMembersLoad (const MattermostId& teamId, uint32_t loadId);
+    void failChannelMembersLoad (const MattermostId& channelId, uint32_t loadId);
     void loginSuccess (const QJsonDocument& data, const QNetworkReply& reply, std::function<void(const QString&)> callback);
 private:
+    /**
+     * A member list, loaded in pages. Only a few pages are requested at a time (see requestPages())
+     */
+    struct MembersPagesLoad {
+    	uint32_t							id;
+    	uint32_t							pageCount;
+    	uint32_t							nextPage;
+    	uint32_t							receivedPages;
+    	QElapsedTimer						timer;
+
+    	void start (uint32_t loadId);
+
+    	/**
+    	 * Request the next pages, up to the limit of the pages in flight
+    	 */
+    	void requestPages (const std::function<void(uint32_t page)>& requestPage);
+
+    	/**
+    	 * Count a received page. Returns true if all pages are received
+    	 */
+    	bool pageReceived (uint32_t page, uint32_t pageSize, uint32_t perPage);
+    };
+
+    struct ChannelMembersLoad: public MembersPagesLoad {
+    	//the callbacks of retrieveChannelMembers(): loaded, failed
+    	std::vector<std::pair<std::function<void()>, std::function<void()>>>	callbacks;
+    };
+
+    struct TeamMembersLoad: public MembersPagesLoad {
+    	uint32_t							memberCount;
+
+    	//the received members, saved in the cache when all pages are received
+    	QJsonArray							membersJson;
+    };
+
     Storage							storage;
+    PostHistoryBudget				historyBudget;
     ServerDialogsMap				serverDialogsMap;
 
+    NetworkMetrics					networkMetrics;
     HTTPConnector 					httpConnector;
     WebSocketEventHandler			webSocketEventHandler;
     WebSocketConnector				webSocketConnector;
@@ -235,10 +338,20 @@ private:
     QNetworkDiskCache				attachmentsCache;
     BackendChannel*					currentChannel;
     QTimer 							timeoutTimer;
+    QTimer							missingRootsTimer;
     bool							isLoggedIn;
     bool							autoLoginEnabledFlag;
     uint32_t						nonFilledTeams;
     uint64_t						lastStartTime;
+
+    //channel / team ID -> member list being loaded
+    IdHashMap<ChannelMembersLoad>	channelMembersLoads;
+    IdHashMap<TeamMembersLoad>		teamMembersLoads;
+    uint32_t						lastMembersLoadId;
+
+    //posts/ids requests without a reply -> the requested root IDs, requested again if the request fails
+    std::map<uint32_t, RequestedRootIds>	missingRootsRequests;
+    uint32_t						lastMissingRootsRequestId;
 };
 
 } /* namespace Mattermost */
@@ -0,0 +1,273 @@
+/**
+ * @file CompactVector.h
+ * @brief Vector, which takes a single pointer when empty
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace Mattermost {
+
+/**
+ * Vector for the small per-post collections (files, reactions). Most posts have none, so the vector
+ * is a single pointer, which is null when empty, and the size and capacity are kept in the heap block,
+ * in front of the elements. Pointers to the elements are invalidated by insertion and erasure.
+ */
+template <typename T>
+class CompactVector {
+public:
+	CompactVector ();
+	CompactVector (CompactVector&& other);
+	CompactVector& operator= (CompactVector&& other);
+	~CompactVector ();
+
+	CompactVector (const CompactVector&) = delete;
+	CompactVector& operator= (const CompactVector&) = delete;
+public:
+	T* begin ();
+	T* end ();
+	const T* begin () const;
+	const T* end () const;
+
+	uint32_t size () const;
+	bool empty () const;
+
+	T& operator[] (uint32_t index);
+	const T& operator[] (uint32_t index) const;
+
+	/**
+	 * Construct an element before 'position'. Returns the new element
+	 */
+	template <typename... Args>
+	T* emplace (const T* position, Args&&... args);
+
+	template <typename... Args>
+	T& emplace_back (Args&&... args);
+
+	/**
+	 * Remove an element. Returns the element after it. The memory is released when the last element is removed
+	 */
+	T* erase (const T* position);
+
+	void clear ();
+
+	/**
+	 * Memory of the heap block, without the memory owned by the elements
+	 */
+	size_t getAllocatedBytes () const;
+private:
+	struct alignas(8) Header {
+		uint32_t	size;
+		uint32_t	capacity;
+	};
+
+	static_assert (alignof(T) <= alignof(Header), "CompactVector element alignment is not supported");
+
+	T* items () const;
+private:
+	Header*		block;
+};
+
+template <typename T>
+CompactVector<T>::CompactVector ()
+:block (nullptr)
+{
+}
+
+template <typename T>
+CompactVector<T>::CompactVector (CompactVector&& other)
+:block (other.block)
+{
+	other.block = nullptr;
+}
+
+template <typename T>
+CompactVector<T>& CompactVector<T>::operator= (CompactVector&& other)
+{
+	if (this != &other) {
+		clear ();
+		std::swap (block, other.block);
+	}
+
+	return *this;
+}
+
+template <typename T>
+CompactVector<T>::~CompactVector ()
+{
+	clear ();
+}
+
+template <typename T>
+T* CompactVector<T>::items () const
+{
+	return block ? reinterpret_cast<T*> (block + 1) : nullptr;
+}
+
+template <typename T>
+T* CompactVector<T>::begin ()
+{
+	return items ();
+}
+
+template <typename T>
+T* CompactVector<T>::end ()
+{
+	return items () + size ();
+}
+
+template <typename T>
+const T* CompactVector<T>::begin () const
+{
+	return items ();
+}
+
+template <typename T>
+const T* CompactVector<T>::end () const
+{
+	return items () + size ();
+}
+
+template <typename T>
+uint32_t CompactVector<T>::size () const
+{
+	return block ? block->size : 0;
+}
+
+template <typename T>
+bool CompactVector<T>::empty () const
+{
+	return !block;
+}
+
+template <typename T>
+T& CompactVector<T>::operator[] (uint32_t index)
+{
+	return items()[index];
+}
+
+template <typename T>
+const T& CompactVector<T>::operator[] (uint32_t index) const
+{
+	return items()[index];
+}
+
+template <typename T>
+template <typename... Args>
+T* CompactVector<T>::emplace (const T* position, Args&&... args)
+{
+	uint32_t index = position - items();
+	uint32_t count = size ();
+
+	//constructed first, as the arguments may refer to an element
+	T value (std::forward<Args> (args)...);
+
+	if (!block || block->size == block->capacity) {
+		uint32_t capacity = block ? block->capacity * 2 : 1;
+		Header* newBlock = static_cast<Header*> (::operator new (sizeof (Header) + capacity * sizeof (T)));
+		T* newItems = reinterpret_cast<T*> (newBlock + 1);
+		T* oldItems = items ();
+
+		for (uint32_t i = 0; i < index; ++i) {
+			new (newItems + i) T (std::move (oldItems[i]));
+		}
+
+		new (newItems + index) T (std::move (value));
+
+		for (uint32_t i = index; i < count; ++i) {
+			new (newItems + i + 1) T (std::move (oldItems[i]));
+		}
+
+		clear ();
+		newBlock->size = count + 1;
+		newBlock->capacity = capacity;
+		block = newBlock;
+		return newItems + index;
+	}
+
+	T* current = items ();
+
+	if (index == count) {
+		new (current + count) T (std::move (value));
+	} else {
+		new (current + count) T (std::move (current[count - 1]));
+		std::move_backward (current + index, current + count - 1, current + count);
+		current[index] = std::move (value);
+	}
+
+	++block->size;
+	return current + index;
+}
+
+template <typename T>
+template <typename... Args>
+T& CompactVector<T>::emplace_back (Args&&... args)
+{
+	return *emplace (end(), std::forward<Args> (args)...);
+}
+
+template <typename T>
+T* CompactVector<T>::erase (const T* position)
+{
+	T* current = items ();
+	uint32_t index = position - current;
+
+	std::move (current + index + 1, current + block->size, current + index);
+	current[block->size - 1].~T ();
+
+	if (--block->size == 0) {
+		::operator delete (block);
+		block = nullptr;
+		return nullptr;
+	}
+
+	return current + index;
+}
+
+template <typename T>
+void CompactVector<T>::clear ()
+{
+	if (!block) {
+		return;
+	}
+
+	T* current = items ();
+
+	for (uint32_t i = 0; i < block->size; ++i) {
+		current[i].~T ();
+	}
+
+	::operator delete (block);
+	block = nullptr;
+}
+
+template <typename T>
+size_t CompactVector<T>::getAllocatedBytes () const
+{
+	return block ? sizeof (Header) + block->capacity * sizeof (T) : 0;
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,701 @@
+/**
+ * @file DeflateWebSocket.cpp
+ * @brief Minimal WebSocket client with permessage-deflate (RFC 7692) support
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "DeflateWebSocket.h"
+
+namespace Mattermost {
+
+double WebSocketCompressionStats::receiveRatio () const
+{
+	if (!receivedWireBytes) {
+		return 1.0;
+	}
+
+	return (double) receivedPayloadBytes / receivedWireBytes;
+}
+
+double WebSocketCompressionStats::sendRatio () const
+{
+	if (!sentWireBytes) {
+		return 1.0;
+	}
+
+	return (double) sentPayloadBytes / sentWireBytes;
+}
+
+} /* namespace Mattermost */
+
+#if BUILD_WEBSOCKET_DEFLATE
+
+#include <algorithm>
+#include <zlib.h>
+#include <QCryptographicHash>
+#include <QRandomGenerator>
+#include <QtEndian>
+#include "log.h"
+
+namespace Mattermost {
+
+namespace {
+
+namespace Opcode {
+enum type: uint8_t {
+	continuation	= 0x0,
+	text			= 0x1,
+	binary			= 0x2,
+	close			= 0x8,
+	ping			= 0x9,
+	pong			= 0xA,
+};
+}
+
+//RFC 6455, section 1.3
+const QByteArray handshakeGuid ("258EAFA5-E914-47DA-95CA-C5AB0DC85B11");
+
+//RFC 7692, section 7.2.1 - the tail, which is removed from each compressed message
+const QByteArray deflateTail ("\x00\x00\xff\xff", 4);
+
+//refuse messages larger than this (the biggest Mattermost events are a few hundred KB)
+constexpr uint64_t maxMessageSize = 64 * 1024 * 1024;
+
+}
+
+struct DeflateStream {
+
+	DeflateStream (int windowBits)
+	{
+		//zlib does not support window size of 8 bits for raw deflate
+		deflateInit2 (&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -std::max (windowBits, 9), 8, Z_DEFAULT_STRATEGY);
+	}
+
+	~DeflateStream ()
+	{
+		deflateEnd (&stream);
+	}
+
+	QByteArray compress (const QByteArray& data, bool resetContext)
+	{
+		QByteArray ret;
+		char buffer[16384];
+
+		stream.next_in = (Bytef*) data.constData();
+		stream.avail_in = data.size();
+
+		do {
+			stream.next_out = (Bytef*) buffer;
+			stream.avail_out = sizeof (buffer);
+			deflate (&stream, Z_SYNC_FLUSH);
+			ret.append (buffer, sizeof (buffer) - stream.avail_out);
+		} while (stream.avail_out == 0);
+
+		if (ret.endsWith (deflateTail)) {
+			ret.chop (deflateTail.size());
+		}
+
+		if (resetContext) {
+			deflateReset (&stream);
+		}
+
+		return ret;
+	}
+
+	z_stream stream {};
+};
+
+struct InflateStream {
+
+	InflateStream ()
+	{
+		inflateInit2 (&stream, -15);
+	}
+
+	~InflateStream ()
+	{
+		inflateEnd (&stream);
+	}
+
+	bool decompress (const QByteArray& data, QByteArray& out, bool resetContext)
+	{
+		QByteArray input (data + deflateTail);
+		char buffer[16384];
+
+		stream.next_in = (Bytef*) input.constData();
+		stream.avail_in = input.size();
+
+		int ret;
+
+		do {
+			stream.next_out = (Bytef*) buffer;
+			stream.avail_out = sizeof (buffer);
+			ret = inflate (&stream, Z_SYNC_FLUSH);
+
+			if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+				return false;
+			}
+
+			out.append (buffer, sizeof (buffer) - stream.avail_out);
+
+			if ((uint64_t) out.size() > maxMessageSize) {
+				return false;
+			}
+
+		} while (stream.avail_out == 0 && ret != Z_STREAM_END);
+
+		if (resetContext || ret == Z_STREAM_END) {
+			inflateReset (&stream);
+		}
+
+		return true;
+	}
+
+	z_stream stream {};
+};
+
+DeflateWebSocket::DeflateWebSocket (QObject* parent)
+:QObject (parent)
+,state (State::closed)
+,messageOpcode (Opcode::continuation)
+,messageCompressed (false)
+,compressionEnabled (true)
+,compressionActive (false)
+,serverNoContextTakeover (false)
+,clientNoContextTakeover (false)
+,clientMaxWindowBits (15)
+,lastCloseCode (QWebSocketProtocol::CloseCodeNormal)
+,lastError (QAbstractSocket::UnknownSocketError)
+{
+	connect (&socket, &QSslSocket::connected, [this] {
+		//for wss, the handshake is sent after the TLS handshake is done
+		if (url.scheme() != "wss") {
+			onSocketConnected ();
+		}
+	});
+
+	connect (&socket, &QSslSocket::encrypted, this, &DeflateWebSocket::onSocketConnected);
+	connect (&socket, &QSslSocket::readyRead, this, &DeflateWebSocket::onSocketReadyRead);
+	connect (&socket, &QSslSocket::disconnected, this, &DeflateWebSocket::onSocketDisconnected);
+
+#if QT_VERSION < QT_VERSION_CHECK(5,15,0)
+	connect (&socket, qOverload<QAbstractSocket::SocketError>(&QSslSocket::error), this, &DeflateWebSocket::onSocketError);
+#else
+	connect (&socket, &QSslSocket::errorOccurred, this, &DeflateWebSocket::onSocketError);
+#endif
+}
+
+DeflateWebSocket::~DeflateWebSocket () = default;
+
+void DeflateWebSocket::open (const QUrl& url)
+{
+	if (state != State::closed) {
+		socket.abort ();
+	}
+
+	this->url = url;
+	state = State::connecting;
+	readBuffer.clear ();
+	messageBuffer.clear ();
+	compressionActive = false;
+	serverNoContextTakeover = false;
+	clientNoContextTakeover = false;
+	clientMaxWindowBits = 15;
+	deflater.reset ();
+	inflater.reset ();
+	stats = WebSocketCompressionStats ();
+	lastCloseCode = QWebSocketProtocol::CloseCodeNormal;
+	lastCloseReason.clear ();
+
+	if (url.scheme() == "wss") {
+		socket.connectToHostEncrypted (url.host(), url.port (443));
+	} else {
+		socket.connectToHost (url.host(), url.port (80));
+	}
+}
+
+void DeflateWebSocket::close (QWebSocketProtocol::CloseCode closeCode, const QString& reason)
+{
+	switch (state) {
+	case State::closed:
+		return;
+	case State::connecting:
+	case State::handshake:
+		state = State::closed;
+		socket.abort ();
+		return;
+	case State::open: {
+		QByteArray payload (2, 0);
+		qToBigEndian<quint16> (closeCode, payload.data());
+		payload.append (reason.toUtf8().left (123));
+		sendFrame (Opcode::close, payload);
+
+		lastCloseCode = closeCode;
+		lastCloseReason = reason;
+		state = State::closing;
+		socket.disconnectFromHost ();
+		return;
+	}
+	case State::closing:
+		return;
+	}
+}
+
+void DeflateWebSocket::ping (const QByteArray& payload)
+{
+	if (state != State::open) {
+		return;
+	}
+
+	pingTimer.start ();
+	sendFrame (Opcode::ping, payload.left (125));
+}
+
+qint64 DeflateWebSocket::sendTextMessage (const QString& message)
+{
+	if (state != State::open) {
+		return 0;
+	}
+
+	QByteArray data (message.toUtf8());
+	stats.sentPayloadBytes += data.size();
+
+	if (compressionActive) {
+		QByteArray compressed (deflater->compress (data, clientNoContextTakeover));
+		stats.sentWireBytes += compressed.size();
+		sendFrame (Opcode::text, compressed, true);
+	} else {
+		stats.sentWireBytes += data.size();
+		sendFrame (Opcode::text, data);
+	}
+
+	return data.size();
+}
+
+void DeflateWebSocket::setCompressionEnabled (bool enabled)
+{
+	compressionEnabled = enabled;
+}
+
+bool DeflateWebSocket::isCompressionActive () const
+{
+	return compressionActive;
+}
+
+const WebSocketCompressionStats& DeflateWebSocket::compressionStats () const
+{
+	return stats;
+}
+
+QUrl DeflateWebSocket::requestUrl () const
+{
+	return url;
+}
+
+QWebSocketProtocol::CloseCode DeflateWebSocket::closeCode () const
+{
+	return lastCloseCode;
+}
+
+QString DeflateWebSocket::closeReason () const
+{
+	return lastCloseReason;
+}
+
+QAbstractSocket::SocketError DeflateWebSocket::error () const
+{
+	return lastError;
+}
+
+QString DeflateWebSocket::errorString () const
+{
+	return lastErrorString;
+}
+
+void DeflateWebSocket::onSocketConnected ()
+{
+	QByteArray nonce (16, 0);
+	QRandomGenerator::global()->fillRange ((quint32*) nonce.data(), nonce.size() / sizeof (quint32));
+	handshakeKey = nonce.toBase64 ();
+
+	QByteArray resource (url.path (QUrl::FullyEncoded).toLatin1());
+
+	if (resource.isEmpty()) {
+		resource = "/";
+	}
+
+	if (url.hasQuery()) {
+		resource += "?" + url.query (QUrl::FullyEncoded).toLatin1();
+	}
+
+	QByteArray host (url.host (QUrl::FullyEncoded).toLatin1());
+
+	if (url.port() != -1) {
+		host += ":" + QByteArray::number (url.port());
+	}
+
+	QByteArray request;
+	request += "GET " + resource + " HTTP/1.1\r\n";
+	request += "Host: " + host + "\r\n";
+	request += "Upgrade: websocket\r\n";
+	request += "Connection: Upgrade\r\n";
+	request += "Sec-WebSocket-Key: " + handshakeKey + "\r\n";
+	request += "Sec-WebSocket-Version: 13\r\n";
+
+	if (compressionEnabled) {
+		request += "Sec-WebSocket-Extensions: permessage-deflate; client_max_window_bits\r\n";
+	}
+
+	request += "\r\n";
+
+	state = State::handshake;
+	socket.write (request);
+}
+
+void DeflateWebSocket::onSocketReadyRead ()
+{
+	readBuffer.append (socket.readAll());
+
+	if (state == State::handshake) {
+
+		if (!processHandshakeResponse ()) {
+			return;
+		}
+
+		state = State::open;
+		emit connected ();
+	}
+
+	if (state == State::open || state == State::closing) {
+		processFrames ();
+	}
+}
+
+void DeflateWebSocket::onSocketDisconnected ()
+{
+	State oldState = state;
+	state = State::closed;
+
+	//'disconnected' is emitted only if 'connected' was emitted before, like QWebSocket does
+	if (oldState == State::open || oldState == State::closing) {
+
+		if (oldState == State::open) {
+			lastCloseCode = QWebSocketProtocol::CloseCodeAbnormalDisconnection;
+		}
+
+		LOG_INFO (websocket, "WebSocket session compression: " << (compressionActive ? "on" : "off")
+				<< LogField ("received_bytes", stats.receivedPayloadBytes) << LogField ("received_wire_bytes", stats.receivedWireBytes)
+				<< LogField ("receive_ratio", stats.receiveRatio())
+				<< LogField ("sent_bytes", stats.sentPayloadBytes) << LogField ("sent_wire_bytes", stats.sentWireBytes)
+				<< LogField ("send_ratio", stats.sendRatio()));
+
+		emit disconnected ();
+	}
+}
+
+void DeflateWebSocket::onSocketError (QAbstractSocket::SocketError socketError)
+{
+	//the remote side closing the connection is handled as a disconnect
+	if (socketError == QAbstractSocket::RemoteHostClosedError && state == State::closing) {
+		return;
+	}
+
+	lastError = socketError;
+	lastErrorString = socket.errorString ();
+	emit error (socketError);
+}
+
+bool DeflateWebSocket::processHandshakeResponse ()
+{
+	int headersEnd = readBuffer.indexOf ("\r\n\r\n");
+
+	if (headersEnd == -1) {
+		return false;
+	}
+
+	QList<QByteArray> lines = readBuffer.left (headersEnd).split ('\n');
+	readBuffer.remove (0, headersEnd + 4);
+
+	QList<QByteArray> statusLine = lines.takeFirst().trimmed().split (' ');
+
+	if (statusLine.size() < 2 || statusLine[1] != "101") {
+		failConnection ("WebSocket handshake failed: " + QString::fromLatin1 (statusLine.join (' ')));
+		return false;
+	}
+
+	QByteArray expectedAccept (QCryptographicHash::hash (handshakeKey + handshakeGuid, QCryptographicHash::Sha1).toBase64());
+	bool acceptValid = false;
+
+	for (const QByteArray& line: lines) {
+		int separator = line.indexOf (':');
+
+		if (separator == -1) {
+			continue;
+		}
+
+		QByteArray name (line.left (separator).trimmed().toLower());
+		QByteArray value (line.mid (separator + 1).trimmed());
+
+		if (name == "sec-websocket-accept") {
+			acceptValid = (value == expectedAccept);
+		} else if (name == "sec-websocket-extensions") {
+			parseExtensions (value);
+		}
+	}
+
+	if (!acceptValid) {
+		failConnection ("WebSocket handshake failed: invalid Sec-WebSocket-Accept");
+		return false;
+	}
+
+	if (compressionActive) {
+		deflater = std::make_unique<DeflateStream> (clientMaxWindowBits);
+		inflater = std::make_unique<InflateStream> ();
+	}
+
+	return true;
+}
+
+void DeflateWebSocket::parseExtensions (const QByteArray& extensionsHeader)
+{
+	for (const QByteArray& extension: extensionsHeader.split (',')) {
+
+		QList<QByteArray> params = extension.split (';');
+
+		if (params.takeFirst().trimmed() != "permessage-deflate" || !compressionEnabled) {
+			continue;
+		}
+
+		compressionActive = true;
+
+		for (const QByteArray& param: params) {
+			QList<QByteArray> keyValue = param.trimmed().split ('=');
+			QByteArray key (keyValue[0].trimmed());
+
+			if (key == "server_no_context_takeover") {
+				serverNoContextTakeover = true;
+			} else if (key == "client_no_context_takeover") {
+				clientNoContextTakeover = true;
+			} else if (key == "client_max_window_bits" && keyValue.size() == 2) {
+				clientMaxWindowBits = keyValue[1].trimmed().replace ("\"", "").toInt();
+			}
+		}
+
+		return;
+	}
+}
+
+void DeflateWebSocket::processFrames ()
+{
+	while (readBuffer.size() >= 2) {
+
+		const uchar* data = (const uchar*) readBuffer.constData();
+
+		bool fin = data[0] & 0x80;
+		bool rsv1 = data[0] & 0x40;
+		uint8_t opcode = data[0] & 0x0F;
+		bool masked = data[1] & 0x80;
+		uint64_t payloadSize = data[1] & 0x7F;
+		int headerSize = 2;
+
+		if (payloadSize == 126) {
+			if (readBuffer.size() < 4) {
+				return;
+			}
+			payloadSize = qFromBigEndian<quint16> (data + 2);
+			headerSize = 4;
+		} else if (payloadSize == 127) {
+			if (readBuffer.size() < 10) {
+				return;
+			}
+			payloadSize = qFromBigEndian<quint64> (data + 2);
+			headerSize = 10;
+		}
+
+		if (payloadSize > maxMessageSize) {
+			return failConnection ("WebSocket frame too big");
+		}
+
+		int maskOffset = headerSize;
+
+		if (masked) {
+			headerSize += 4;
+		}
+
+		if ((uint64_t) readBuffer.size() < headerSize + payloadSize) {
+			return;
+		}
+
+		QByteArray payload (readBuffer.mid (headerSize, payloadSize));
+
+		if (masked) {
+			for (int i = 0; i < payload.size(); ++i) {
+				payload[i] = (char) (payload[i] ^ data[maskOffset + (i % 4)]);
+			}
+		}
+
+		readBuffer.remove (0, headerSize + payloadSize);
+
+		if (opcode & 0x08) {
+			processControlFrame (opcode, payload);
+
+			if (state == State::closed) {
+				return;
+			}
+			continue;
+		}
+
+		if (rsv1 && !compressionActive) {
+			return failConnection ("WebSocket frame with RSV1 set, but compression is not negotiated");
+		}
+
+		if (opcode != Opcode::continuation) {
+			messageOpcode = opcode;
+			messageCompressed = rsv1;
+			messageBuffer = payload;
+		} else {
+			messageBuffer += payload;
+		}
+
+		stats.receivedWireBytes += payloadSize;
+
+		if ((uint64_t) messageBuffer.size() > maxMessageSize) {
+			return failConnection ("WebSocket message too big");
+		}
+
+		if (fin) {
+			processMessage ();
+		}
+	}
+}
+
+void DeflateWebSocket::processMessage ()
+{
+	QByteArray message;
+
+	if (messageCompressed) {
+		if (!inflater->decompress (messageBuffer, message, serverNoContextTakeover)) {
+			return failConnection ("WebSocket message decompression failed");
+		}
+		++stats.compressedMessages;
+	} else {
+		message = std::move (messageBuffer);
+		++stats.uncompressedMessages;
+	}
+
+	messageBuffer.clear ();
+	stats.receivedPayloadBytes += message.size();
+
+	if (messageOpcode == Opcode::text) {
+		emit textMessageReceived (QString::fromUtf8 (message));
+	}
+}
+
+void DeflateWebSocket::processControlFrame (uint8_t opcode, const QByteArray& payload)
+{
+	switch (opcode) {
+	case Opcode::ping:
+		sendFrame (Opcode::pong, payload);
+		break;
+
+	case Opcode::pong:
+		emit pong (pingTimer.isValid() ? pingTimer.elapsed() : 0, payload);
+		break;
+
+	case Opcode::close:
+		if (payload.size() >= 2) {
+			lastCloseCode = (QWebSocketProtocol::CloseCode) qFromBigEndian<quint16> (payload.constData());
+			lastCloseReason = QString::fromUtf8 (payload.mid (2));
+		} else {
+			lastCloseCode = QWebSocketProtocol::CloseCodeNormal;
+			lastCloseReason.clear ();
+		}
+
+		//echo the close frame, if the close is initiated by the server
+		if (state == State::open) {
+			sendFrame (Opcode::close, payload.left (2));
+			state = State::closing;
+		}
+
+		socket.disconnectFromHost ();
+		break;
+
+	default:
+		failConnection ("Unknown WebSocket control frame " + QString::number (opcode));
+		break;
+	}
+}
+
+void DeflateWebSocket::sendFrame (uint8_t opcode, const QByteArray& payload, bool rsv1)
+{
+	QByteArray frame;
+	frame.reserve (payload.size() + 14);
+
+	frame.append ((char) (0x80 | (rsv1 ? 0x40 : 0) | opcode));
+
+	//client frames are always masked
+	if (payload.size() < 126) {
+		frame.append ((char) (0x80 | payload.size()));
+	} else if (payload.size() <= 0xFFFF) {
+		frame.append ((char) (0x80 | 126));
+		char size[2];
+		qToBigEndian<quint16> (payload.size(), size);
+		frame.append (size, sizeof (size));
+	} else {
+		frame.append ((char) (0x80 | 127));
+		char size[8];
+		qToBigEndian<quint64> (payload.size(), size);
+		frame.append (size, sizeof (size));
+	}
+
+	quint32 maskKey = QRandomGenerator::global()->generate();
+	const char* mask = (const char*) &maskKey;
+	frame.append (mask, 4);
+
+	int payloadStart = frame.size();
+	frame.append (payload);
+
+	for (int i = 0; i < payload.size(); ++i) {
+		frame[payloadStart + i] = (char) (frame[payloadStart + i] ^ mask[i % 4]);
+	}
+
+	socket.write (frame);
+}
+
+void DeflateWebSocket::failConnection (const QString& reason)
+{
+	LOG_ERROR (websocket, reason);
+	lastErrorString = reason;
+	lastError = QAbstractSocket::UnknownSocketError;
+
+	if (state == State::open) {
+		close (QWebSocketProtocol::CloseCodeProtocolError, reason);
+	} else {
+		state = State::closed;
+		socket.abort ();
+	}
+
+	emit error (lastError);
+}
+
+} /* namespace Mattermost */
+
+#endif //BUILD_WEBSOCKET_DEFLATE
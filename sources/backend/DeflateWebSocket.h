@@ -0,0 +1,166 @@
+/**
+ * @file DeflateWebSocket.h
+ * @brief Minimal WebSocket client with permessage-deflate (RFC 7692) support
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include "build-config.h"
+
+#include <cstdint>
+
+namespace Mattermost {
+
+/**
+ * Compression counters for a single WebSocket session (from open() to disconnect).
+ * 'payload' bytes are the application message sizes, 'wire' bytes are the sizes of the
+ * message data, as sent / received over the socket (after compression)
+ */
+struct WebSocketCompressionStats {
+
+	/**
+	 * Ratio between uncompressed and compressed received data. 1.0 if nothing is compressed
+	 */
+	double receiveRatio () const;
+
+	/**
+	 * Ratio between uncompressed and compressed sent data. 1.0 if nothing is compressed
+	 */
+	double sendRatio () const;
+
+	uint64_t	receivedPayloadBytes = 0;
+	uint64_t	receivedWireBytes = 0;
+	uint64_t	sentPayloadBytes = 0;
+	uint64_t	sentWireBytes = 0;
+	uint32_t	compressedMessages = 0;
+	uint32_t	uncompressedMessages = 0;
+};
+
+} /* namespace Mattermost */
+
+#if BUILD_WEBSOCKET_DEFLATE
+
+#include <memory>
+#include <QObject>
+#include <QUrl>
+#include <QElapsedTimer>
+#include <QSslSocket>
+#include <QtWebSockets/qwebsocketprotocol.h>
+
+namespace Mattermost {
+
+struct DeflateStream;
+struct InflateStream;
+
+/**
+ * QWebSocket in Qt5 rejects frames with the RSV1 bit set, so it cannot be used with permessage-deflate.
+ * This class implements the client side of RFC 6455 over QSslSocket and negotiates permessage-deflate.
+ * It provides the subset of the QWebSocket interface, used by WebSocketConnector, so that the connector
+ * can use either of them. If the server does not accept the extension, messages are sent uncompressed.
+ */
+class DeflateWebSocket: public QObject {
+	Q_OBJECT
+public:
+	explicit DeflateWebSocket (QObject* parent = nullptr);
+	virtual ~DeflateWebSocket ();
+public:
+	void open (const QUrl& url);
+	void close (QWebSocketProtocol::CloseCode closeCode = QWebSocketProtocol::CloseCodeNormal, const QString& reason = QString());
+	void ping (const QByteArray& payload = QByteArray());
+	qint64 sendTextMessage (const QString& message);
+
+	/**
+	 * Enable or disable the permessage-deflate offer. Takes effect on the next open()
+	 */
+	void setCompressionEnabled (bool enabled);
+
+	/**
+	 * Whether the server has accepted permessage-deflate for the current session
+	 */
+	bool isCompressionActive () const;
+
+	const WebSocketCompressionStats& compressionStats () const;
+
+	QUrl requestUrl () const;
+	QWebSocketProtocol::CloseCode closeCode () const;
+	QString closeReason () const;
+	QAbstractSocket::SocketError error () const;
+	QString errorString () const;
+signals:
+	void connected ();
+	void disconnected ();
+	void textMessageReceived (const QString& message);
+	void pong (quint64 elapsedTime, const QByteArray& payload);
+	void error (QAbstractSocket::SocketError error);
+private:
+	enum class State {
+		closed,
+		connecting,
+		handshake,
+		open,
+		closing,
+	};
+
+	void onSocketConnected ();
+	void onSocketReadyRead ();
+	void onSocketDisconnected ();
+	void onSocketError (QAbstractSocket::SocketError socketError);
+
+	bool processHandshakeResponse ();
+	void processFrames ();
+	void processMessage ();
+	void processControlFrame (uint8_t opcode, const QByteArray& payload);
+	void parseExtensions (const QByteArray& extensionsHeader);
+	void sendFrame (uint8_t opcode, const QByteArray& payload, bool rsv1 = false);
+	void failConnection (const QString& reason);
+private:
+	QSslSocket							socket;
+	QUrl								url;
+	State								state;
+	QByteArray							handshakeKey;
+	QByteArray							readBuffer;
+
+	//current (possibly fragmented) data message
+	QByteArray							messageBuffer;
+	uint8_t								messageOpcode;
+	bool								messageCompressed;
+
+	//permessage-deflate parameters
+	bool								compressionEnabled;
+	bool								compressionActive;
+	bool								serverNoContextTakeover;
+	bool								clientNoContextTakeover;
+	int									clientMaxWindowBits;
+	std::unique_ptr<DeflateStream>		deflater;
+	std::unique_ptr<InflateStream>		inflater;
+
+	WebSocketCompressionStats			stats;
+	QElapsedTimer						pingTimer;
+	QWebSocketProtocol::CloseCode		lastCloseCode;
+	QString								lastCloseReason;
+	QAbstractSocket::SocketError		lastError;
+	QString								lastErrorString;
+};
+
+} /* namespace Mattermost */
+
+#endif //BUILD_WEBSOCKET_DEFLATE
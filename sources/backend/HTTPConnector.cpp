@@ -32,7 +32,11 @@
 #include <QJsonObject>
 #include <QStandardPaths>
 #include <QNetworkReply>
+#include <QElapsedTimer>
 #include "QByteArrayCreator.h"
+#include "NetworkMetrics.h"
+#include "SessionRecorder.h"
+#include "log/Tracer.h"
 #include "log.h"
 
 namespace Mattermost {
@@ -45,80 +49,107 @@ static QNetworkDiskCache* createDiskCache ()
 	return diskCache;
 }
 
-HTTPConnector::HTTPConnector ()
-:qnetworkManager (std::make_unique <QNetworkAccessManager> ())
+HTTPConnector::HTTPConnector (NetworkMetrics& metrics)
+:metrics (metrics)
+,pendingRequests (0)
 {
-	//qnetworkManager takes ownership over the disk cache
-	qnetworkManager->setCache (createDiskCache ());
+	createNetworkManager ();
 }
 
 HTTPConnector::~HTTPConnector () = default;
 
 void HTTPConnector::reset ()
 {
+	createNetworkManager ();
+}
+
+void HTTPConnector::setNetworkConditions (const NetworkConditions& conditions)
+{
+	networkConditions = conditions;
+	createNetworkManager ();
+}
+
+void HTTPConnector::createNetworkManager ()
+{
+	if (networkConditions.isIdeal ()) {
+		qnetworkManager.reset (new QNetworkAccessManager());
+	} else {
+		qnetworkManager.reset (new SimulatedNetworkAccessManager (networkConditions));
+	}
+
 	//qnetworkManager takes ownership over the disk cache
-	qnetworkManager.reset(new QNetworkAccessManager());
 	qnetworkManager->setCache (createDiskCache ());
 }
 
-void HTTPConnector::get (const QNetworkRequest& request, HttpResponseCallback responseHandler)
+void HTTPConnector::get (const QNetworkRequest& request, HttpResponseCallback responseHandler, HttpErrorCallback errorHandler)
 {
 	QNetworkReply* reply = qnetworkManager->get (request);
-	setProcessReply (reply, std::move (responseHandler));
+	setProcessReply (reply, 0, std::move (responseHandler), std::move (errorHandler));
 }
 
-void HTTPConnector::post (QNetworkRequest& request, const QByteArrayCreator& data, HttpResponseCallback responseHandler)
+void HTTPConnector::post (QNetworkRequest& request, const QByteArrayCreator& data, HttpResponseCallback responseHandler, HttpErrorCallback errorHandler)
 {
 	if (data.isJson()) {
 		request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 	}
 
-	//LOG_DEBUG ("POST " << request.url() << " " << request.rawHeaderList() << data);
+	//LOG_DEBUG (http, "POST " << request.url() << " " << request.rawHeaderList() << data);
 	QNetworkReply* reply = qnetworkManager->post (request, data);
-	setProcessReply (reply, std::move (responseHandler));
+	setProcessReply (reply, data.size(), std::move (responseHandler), std::move (errorHandler));
 }
 
-void HTTPConnector::put (const QNetworkRequest& request, const QByteArrayCreator& data, HttpResponseCallback responseHandler)
+void HTTPConnector::put (const QNetworkRequest& request, const QByteArrayCreator& data, HttpResponseCallback responseHandler, HttpErrorCallback errorHandler)
 {
 	QNetworkReply* reply = qnetworkManager->put (request, data);
-	setProcessReply (reply, std::move (responseHandler));
+	setProcessReply (reply, data.size(), std::move (responseHandler), std::move (errorHandler));
 }
 
 void HTTPConnector::del (const QNetworkRequest& request)
 {
 	QNetworkReply* reply = qnetworkManager->deleteResource (request);
-	setProcessReply (reply, [](QVariant, QByteArray, const QNetworkReply&){});
+	setProcessReply (reply, 0, [](QVariant, QByteArray, const QNetworkReply&){}, nullptr);
 }
 
-void HTTPConnector::setProcessReply (QNetworkReply* reply, std::function<void (QVariant, QByteArray, const QNetworkReply&)> responseHandler)
+uint32_t HTTPConnector::getPendingRequestsCount () const
 {
-	connect(reply, &QNetworkReply::finished, [this, reply, responseHandler]() {
+	return pendingRequests;
+}
 
-		//print whether the resource is obtained from the cache
-#if 0
-		QVariant fromCache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute);
+void HTTPConnector::setProcessReply (QNetworkReply* reply, uint64_t requestBytes, std::function<void (QVariant, QByteArray, const QNetworkReply&)> responseHandler, HttpErrorCallback errorHandler)
+{
+	QElapsedTimer timer;
+	timer.start ();
+	int64_t traceStart = Tracer::isEnabled () ? Tracer::now () : 0;
+
+	//also called for replies, which are deleted without 'finished', because of reset()
+	++pendingRequests;
+	connect (reply, &QObject::destroyed, [this] {
+		--pendingRequests;
+	});
 
-		if (fromCache.value<bool>()) {
-			qDebug () << "Reply " << reply->request().url() << " is from cache";
-		} else {
-			qDebug () << "Reply " << reply->request().url() << " is not from cache";
+	connect(reply, &QNetworkReply::finished, [this, reply, requestBytes, responseHandler, errorHandler, timer, traceStart]() {
+
+		if (traceStart && Tracer::isEnabled ()) {
+			Tracer::instance().addAsyncSpan ("http", NetworkMetrics::endpointTemplate (reply->request().url().path()), traceStart, Tracer::now ());
 		}
-#endif
+
+		TRACE_SCOPE_DYNAMIC (http, "reply " + NetworkMetrics::endpointTemplate (reply->request().url().path()));
 
 		QVariant statusCode = reply->attribute( QNetworkRequest::HttpStatusCodeAttribute );
 		auto data = reply->readAll();
 		reply->deleteLater();
 
-		//print the cache size
-#if 0
-		QAbstractNetworkCache* cache = qnetworkManager->cache();
+		LOG_TRACE (http, "Reply " << LogField ("endpoint", reply->request().url().path())
+				<< LogField ("status", statusCode.toInt())
+				<< LogField ("bytes", data.size())
+				<< LogField ("duration_ms", timer.elapsed())
+				<< LogField ("from_cache", reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool()));
+
+		metrics.addHttpReply (*reply, timer.nsecsElapsed() / 1000, requestBytes, data.size());
 
-		if (cache) {
-			qDebug () << "Cache size: " << cache->cacheSize();
-		} else {
-			qDebug () << "No Cache: ";
+		if (SessionRecorder::isEnabled ()) {
+			SessionRecorder::instance().addHttpReply (*reply, data);
 		}
-#endif
 
 		if (statusCode == 200 || statusCode == 201) {
 			return responseHandler (statusCode, qMove (data), *reply);
@@ -130,15 +161,19 @@ void HTTPConnector::setProcessReply (QNetworkReply* reply, std::function<void (Q
 		BackendError error;
 		error.deserialize (root);
 
-		qCritical() << reply->url();
-		qCritical() << "HTTP error " << statusCode.toInt() << ", message: " << error.message;
+		LOG_ERROR (http, "HTTP error " << statusCode.toInt() << ", message: " << error.message
+				<< LogField ("endpoint", reply->url().path()) << LogField ("duration_ms", timer.elapsed()));
 
 		if (statusCode.toInt()) {
 			emit onHttpError (statusCode.toInt(), error.message);
 		}
+
+		if (errorHandler) {
+			errorHandler (statusCode.toInt());
+		}
 	});
 
-#if QT_VERSION <= QT_VERSION_CHECK(5,15,0)
+#if QT_VERSION < QT_VERSION_CHECK(5,15,0)
 	connect(reply, qOverload<QNetworkReply::NetworkError>(&QNetworkReply::error),
 #else
 	connect(reply, qOverload<QNetworkReply::NetworkError>(&QNetworkReply::errorOccurred),
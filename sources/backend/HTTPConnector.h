@@ -28,33 +28,56 @@
 #include <QNetworkReply>
 #include "backend/types/BackendError.h"
 #include "backend/HttpResponseCallback.h"
+#include "backend/NetworkSimulator.h"
 
 class QNetworkAccessManager;
 
 namespace Mattermost {
 
 class QByteArrayCreator;
+class NetworkMetrics;
 
 class HTTPConnector: public QObject {
 	Q_OBJECT
 public:
-	HTTPConnector ();
+	HTTPConnector (NetworkMetrics& metrics);
 	virtual ~HTTPConnector ();
 
 	void reset ();
 
-	void get (const QNetworkRequest &request, HttpResponseCallback responseHandler);
-	void post (QNetworkRequest &request, const QByteArrayCreator &data, HttpResponseCallback responseHandler);
-	void put (const QNetworkRequest &request, const QByteArrayCreator &data, HttpResponseCallback responseHandler);
+	/**
+	 * Simulate a slow or unreliable network for the next requests (see NetworkSimulator.h).
+	 * Pending requests are dropped, as in reset()
+	 */
+	void setNetworkConditions (const NetworkConditions& conditions);
+
+	/**
+	 * Send a request. The response handler is called for a successful reply, the error handler (if any)
+	 * for an HTTP error reply or a network error
+	 */
+	void get (const QNetworkRequest &request, HttpResponseCallback responseHandler, HttpErrorCallback errorHandler = nullptr);
+	void post (QNetworkRequest &request, const QByteArrayCreator &data, HttpResponseCallback responseHandler, HttpErrorCallback errorHandler = nullptr);
+	void put (const QNetworkRequest &request, const QByteArrayCreator &data, HttpResponseCallback responseHandler, HttpErrorCallback errorHandler = nullptr);
 	void del (const QNetworkRequest &request);
 
+	/**
+	 * Number of requests, for which no reply is received yet
+	 */
+	uint32_t getPendingRequestsCount () const;
+
 signals:
 	void onNetworkError (uint32_t errorNumber, const QString& errorText);
 	void onHttpError (uint32_t errorNumber, const QString& errorText);
 
 private:
-	virtual void setProcessReply (QNetworkReply* reply, std::function<void(QVariant,QByteArray,const QNetworkReply&)> responseHandler);
+	void createNetworkManager ();
+	virtual void setProcessReply (QNetworkReply* reply, uint64_t requestBytes, std::function<void(QVariant,QByteArray,const QNetworkReply&)> responseHandler, HttpErrorCallback errorHandler);
 private:
+	NetworkMetrics&							metrics;
+	uint32_t								pendingRequests;
+	NetworkConditions						networkConditions;
+
+	//destroyed first, the replies are counted in pendingRequests on destruction
 	std::unique_ptr<QNetworkAccessManager> 	qnetworkManager;
 };
 
@@ -26,9 +26,16 @@
 
 #include <QJsonDocument>
 #include <QVariant>
+#include "log/Tracer.h"
 
 namespace Mattermost {
 
+static QJsonDocument parseJson (const QByteArray& data)
+{
+	TRACE_SCOPE (http, "QJsonDocument::fromJson");
+	return QJsonDocument::fromJson (data);
+}
+
 HttpResponseCallback::HttpResponseCallback (std::function<void (QVariant, QByteArray, const QNetworkReply&)> fn)
 :std::function<void(QVariant,QByteArray,const QNetworkReply&)> (fn)
 {}
@@ -47,19 +54,19 @@ HttpResponseCallback::HttpResponseCallback (std::function<void (QByteArray)> fn)
 
 HttpResponseCallback::HttpResponseCallback (std::function<void (QVariant, const QJsonDocument&)> fn)
 :HttpResponseCallback ([fn] (QVariant status, QByteArray result, const QNetworkReply&) {
-	fn (status, QJsonDocument::fromJson(result));
+	fn (status, parseJson (result));
 })
 {}
 
 HttpResponseCallback::HttpResponseCallback (std::function<void (const QJsonDocument&, const QNetworkReply&)> fn)
 :HttpResponseCallback ([fn] (QVariant, QByteArray result, const QNetworkReply& reply) {
-	fn (QJsonDocument::fromJson(result), reply);
+	fn (parseJson (result), reply);
 })
 {}
 
 HttpResponseCallback::HttpResponseCallback (std::function<void (const QJsonDocument&)> fn)
 :HttpResponseCallback ([fn] (QVariant, QByteArray result, const QNetworkReply&) {
-	fn (QJsonDocument::fromJson(result));
+	fn (parseJson (result));
 })
 {
 }
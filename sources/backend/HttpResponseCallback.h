@@ -75,4 +75,11 @@ public:
 	virtual ~HttpResponseCallback ();
 };
 
+/**
+ * Called instead of the response callback, when a request fails. Not called for the requests, cancelled by
+ * HTTPConnector::reset() - they are sent again after the reconnect.
+ * @param httpStatus status of the HTTP error reply, or 0 if there is no reply (network error)
+ */
+using HttpErrorCallback = std::function<void(int httpStatus)>;
+
 } /* namespace Mattermost */
@@ -0,0 +1,421 @@
+/**
+ * @file IdHashMap.h
+ * @brief Open-addressing hash map, keyed by MattermostId
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "backend/types/MattermostId.h"
+
+namespace Mattermost {
+
+/**
+ * Hash map from MattermostId to Value, used for the Storage indexes. The table is open-addressing
+ * with linear probing, and keeps only the hash and a pointer to the node, so a probe touches a single
+ * cache line. The nodes are allocated separately and never move, so pointers to the values stay valid
+ * until the value is erased, regardless of insertions and rehashes. Iterators are invalidated by insertion
+ * and erasure. The iteration order is unspecified.
+ *
+ * The interface is the subset of std::map / std::unordered_map, used by Storage.
+ */
+template <typename Value>
+class IdHashMap {
+public:
+	using value_type = std::pair<const MattermostId, Value>;
+private:
+	struct Slot {
+		uint64_t		hash;
+		value_type*		node;
+	};
+
+	template <typename Node>
+	class Iterator {
+	public:
+		Iterator (Slot* slot, Slot* end)
+		:slot (slot)
+		,end (end)
+		{
+			skipEmpty ();
+		}
+
+		//const_iterator from iterator
+		template <typename OtherNode>
+		Iterator (const Iterator<OtherNode>& other)
+		:slot (other.slot)
+		,end (other.end)
+		{
+		}
+
+		Node& operator* () const
+		{
+			return *slot->node;
+		}
+
+		Node* operator-> () const
+		{
+			return slot->node;
+		}
+
+		Iterator& operator++ ()
+		{
+			++slot;
+			skipEmpty ();
+			return *this;
+		}
+
+		bool operator== (const Iterator& other) const
+		{
+			return slot == other.slot;
+		}
+
+		bool operator!= (const Iterator& other) const
+		{
+			return slot != other.slot;
+		}
+	private:
+		void skipEmpty ()
+		{
+			while (slot != end && !slot->node) {
+				++slot;
+			}
+		}
+	private:
+		template <typename> friend class Iterator;
+		friend class IdHashMap;
+
+		Slot*		slot;
+		Slot*		end;
+	};
+public:
+	using iterator = Iterator<value_type>;
+	using const_iterator = Iterator<const value_type>;
+
+	IdHashMap ();
+	~IdHashMap ();
+
+	IdHashMap (const IdHashMap&) = delete;
+	IdHashMap& operator= (const IdHashMap&) = delete;
+public:
+	iterator begin ();
+	iterator end ();
+	const_iterator begin () const;
+	const_iterator end () const;
+
+	size_t size () const;
+	bool empty () const;
+
+	iterator find (const MattermostId& key);
+	const_iterator find (const MattermostId& key) const;
+
+	/**
+	 * Construct the value from 'args', if the key is not present. Returns the iterator to the
+	 * value with this key, and whether it was inserted
+	 */
+	template <typename... Args>
+	std::pair<iterator, bool> emplace (const MattermostId& key, Args&&... args);
+
+	/**
+	 * Value with the given key, value-initialized if the key is not present
+	 */
+	Value& operator[] (const MattermostId& key);
+
+	void erase (iterator it);
+	size_t erase (const MattermostId& key);
+	void clear ();
+
+	/**
+	 * Make room for 'count' values without rehashing
+	 */
+	void reserve (size_t count);
+
+	void swap (IdHashMap& other);
+
+	/**
+	 * Memory of the table and the nodes, without the allocator overhead and the memory owned by the values
+	 */
+	size_t getAllocatedBytes () const;
+private:
+	static uint64_t hashOf (const MattermostId& key);
+	size_t slotIndex (uint64_t hash) const;
+	size_t findSlot (const MattermostId& key, uint64_t hash) const;
+	void rehash (size_t newCapacity);
+	void insertSlot (const Slot& slot);
+private:
+	std::vector<Slot>	slots;
+	size_t				count;
+	int					shift;		//64 - log2 (capacity)
+};
+
+template <typename Value>
+IdHashMap<Value>::IdHashMap ()
+:count (0)
+,shift (64)
+{
+}
+
+template <typename Value>
+IdHashMap<Value>::~IdHashMap ()
+{
+	clear ();
+}
+
+template <typename Value>
+typename IdHashMap<Value>::iterator IdHashMap<Value>::begin ()
+{
+	return iterator (slots.data(), slots.data() + slots.size());
+}
+
+template <typename Value>
+typename IdHashMap<Value>::iterator IdHashMap<Value>::end ()
+{
+	return iterator (slots.data() + slots.size(), slots.data() + slots.size());
+}
+
+template <typename Value>
+typename IdHashMap<Value>::const_iterator IdHashMap<Value>::begin () const
+{
+	return const_cast<IdHashMap*> (this)->begin ();
+}
+
+template <typename Value>
+typename IdHashMap<Value>::const_iterator IdHashMap<Value>::end () const
+{
+	return const_cast<IdHashMap*> (this)->end ();
+}
+
+template <typename Value>
+size_t IdHashMap<Value>::size () const
+{
+	return count;
+}
+
+template <typename Value>
+bool IdHashMap<Value>::empty () const
+{
+	return count == 0;
+}
+
+template <typename Value>
+typename IdHashMap<Value>::iterator IdHashMap<Value>::find (const MattermostId& key)
+{
+	if (count == 0) {
+		return end ();
+	}
+
+	size_t index = findSlot (key, hashOf (key));
+
+	if (!slots[index].node) {
+		return end ();
+	}
+
+	return iterator (slots.data() + index, slots.data() + slots.size());
+}
+
+template <typename Value>
+typename IdHashMap<Value>::const_iterator IdHashMap<Value>::find (const MattermostId& key) const
+{
+	return const_cast<IdHashMap*> (this)->find (key);
+}
+
+template <typename Value>
+template <typename... Args>
+std::pair<typename IdHashMap<Value>::iterator, bool> IdHashMap<Value>::emplace (const MattermostId& key, Args&&... args)
+{
+	uint64_t hash = hashOf (key);
+
+	if (count) {
+		size_t index = findSlot (key, hash);
+
+		if (slots[index].node) {
+			return {iterator (slots.data() + index, slots.data() + slots.size()), false};
+		}
+	}
+
+	//keep the load factor at most 3/4, so that the probe sequences stay short
+	if ((count + 1) * 4 > slots.size() * 3) {
+		rehash (slots.empty() ? 16 : slots.size() * 2);
+	}
+
+	value_type* node = new value_type (std::piecewise_construct, std::forward_as_tuple (key), std::forward_as_tuple (std::forward<Args> (args)...));
+
+	//the key is not present, so the first empty slot is the insertion point
+	size_t index = findSlot (key, hash);
+	slots[index] = Slot {hash, node};
+	++count;
+
+	return {iterator (slots.data() + index, slots.data() + slots.size()), true};
+}
+
+template <typename Value>
+Value& IdHashMap<Value>::operator[] (const MattermostId& key)
+{
+	return emplace (key).first->second;
+}
+
+template <typename Value>
+void IdHashMap<Value>::erase (iterator it)
+{
+	size_t hole = it.slot - slots.data();
+	size_t mask = slots.size() - 1;
+
+	delete slots[hole].node;
+	--count;
+
+	/*
+	 * Backward shift deletion: move the following values of the probe sequence into the hole,
+	 * unless they are already in their home slot, so that no tombstones are needed
+	 */
+	for (size_t next = (hole + 1) & mask; slots[next].node; next = (next + 1) & mask) {
+		size_t home = slotIndex (slots[next].hash);
+
+		if (((next - home) & mask) >= ((next - hole) & mask)) {
+			slots[hole] = slots[next];
+			hole = next;
+		}
+	}
+
+	slots[hole] = Slot {0, nullptr};
+}
+
+template <typename Value>
+size_t IdHashMap<Value>::erase (const MattermostId& key)
+{
+	auto it = find (key);
+
+	if (it == end()) {
+		return 0;
+	}
+
+	erase (it);
+	return 1;
+}
+
+template <typename Value>
+void IdHashMap<Value>::clear ()
+{
+	for (Slot& slot: slots) {
+		delete slot.node;
+		slot = Slot {0, nullptr};
+	}
+
+	count = 0;
+}
+
+template <typename Value>
+void IdHashMap<Value>::reserve (size_t newCount)
+{
+	size_t capacity = slots.empty() ? 16 : slots.size();
+
+	while (newCount * 4 > capacity * 3) {
+		capacity *= 2;
+	}
+
+	if (capacity > slots.size()) {
+		rehash (capacity);
+	}
+}
+
+template <typename Value>
+void IdHashMap<Value>::swap (IdHashMap& other)
+{
+	slots.swap (other.slots);
+	std::swap (count, other.count);
+	std::swap (shift, other.shift);
+}
+
+template <typename Value>
+size_t IdHashMap<Value>::getAllocatedBytes () const
+{
+	return slots.capacity() * sizeof (Slot) + count * sizeof (value_type);
+}
+
+template <typename Value>
+uint64_t IdHashMap<Value>::hashOf (const MattermostId& key)
+{
+	/*
+	 * Fibonacci hashing - the slot is taken from the high bits of the product, so that IDs which differ
+	 * only in a few bits (interned strings, test data) are spread over the table as well as random ones
+	 */
+	return (uint64_t) key.hash() * 0x9E3779B97F4A7C15ull;
+}
+
+template <typename Value>
+size_t IdHashMap<Value>::slotIndex (uint64_t hash) const
+{
+	return (size_t) (hash >> shift);
+}
+
+template <typename Value>
+size_t IdHashMap<Value>::findSlot (const MattermostId& key, uint64_t hash) const
+{
+	size_t mask = slots.size() - 1;
+	size_t index = slotIndex (hash);
+
+	//the load factor is below 1, so there is always an empty slot which ends the probe sequence
+	while (slots[index].node) {
+		if (slots[index].hash == hash && slots[index].node->first == key) {
+			break;
+		}
+
+		index = (index + 1) & mask;
+	}
+
+	return index;
+}
+
+template <typename Value>
+void IdHashMap<Value>::rehash (size_t newCapacity)
+{
+	std::vector<Slot> oldSlots (newCapacity, Slot {0, nullptr});
+	oldSlots.swap (slots);
+
+	shift = 64;
+	for (size_t capacity = newCapacity; capacity > 1; capacity >>= 1) {
+		--shift;
+	}
+
+	//only the slots move, the nodes stay in place
+	for (const Slot& slot: oldSlots) {
+		if (slot.node) {
+			insertSlot (slot);
+		}
+	}
+}
+
+template <typename Value>
+void IdHashMap<Value>::insertSlot (const Slot& slot)
+{
+	size_t mask = slots.size() - 1;
+	size_t index = slotIndex (slot.hash);
+
+	while (slots[index].node) {
+		index = (index + 1) & mask;
+	}
+
+	slots[index] = slot;
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,302 @@
+/**
+ * @file IdHashSet.h
+ * @brief Compact hash set of MattermostIds
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include "backend/types/MattermostId.h"
+
+namespace Mattermost {
+
+/**
+ * Set of MattermostIds, used for the users of a post reaction. The IDs are kept directly in an
+ * open-addressing table with linear probing (the null ID marks an empty slot), so the set is a single
+ * allocation and insert / erase / contains are O(1). Erasure uses backward shifting, so there are no
+ * tombstones. The iteration order is unspecified.
+ */
+class IdHashSet {
+public:
+	class const_iterator {
+	public:
+		const_iterator (const MattermostId* slot, const MattermostId* end)
+		:slot (slot)
+		,end (end)
+		{
+			skipEmpty ();
+		}
+
+		const MattermostId& operator* () const
+		{
+			return *slot;
+		}
+
+		const MattermostId* operator-> () const
+		{
+			return slot;
+		}
+
+		const_iterator& operator++ ()
+		{
+			++slot;
+			skipEmpty ();
+			return *this;
+		}
+
+		bool operator== (const const_iterator& other) const
+		{
+			return slot == other.slot;
+		}
+
+		bool operator!= (const const_iterator& other) const
+		{
+			return slot != other.slot;
+		}
+	private:
+		void skipEmpty ()
+		{
+			while (slot != end && slot->isNull()) {
+				++slot;
+			}
+		}
+	private:
+		const MattermostId*		slot;
+		const MattermostId*		end;
+	};
+public:
+	IdHashSet ();
+	IdHashSet (IdHashSet&& other);
+	IdHashSet& operator= (IdHashSet&& other);
+
+	IdHashSet (const IdHashSet&) = delete;
+	IdHashSet& operator= (const IdHashSet&) = delete;
+public:
+	const_iterator begin () const;
+	const_iterator end () const;
+
+	uint32_t size () const;
+	bool empty () const;
+	bool contains (const MattermostId& id) const;
+
+	/**
+	 * Add an ID. Returns false if it is already in the set. The null ID cannot be added
+	 */
+	bool insert (const MattermostId& id);
+
+	/**
+	 * Remove an ID. Returns false if it is not in the set
+	 */
+	bool erase (const MattermostId& id);
+
+	void clear ();
+
+	size_t getAllocatedBytes () const;
+private:
+	static constexpr uint32_t minCapacity = 4;
+
+	uint32_t capacity () const;
+	uint32_t slotIndex (const MattermostId& id) const;
+
+	//index of the slot with the ID, or of the empty slot where it would be inserted
+	uint32_t findSlot (const MattermostId& id) const;
+	void rehash (uint32_t newCapacity);
+private:
+	std::unique_ptr<MattermostId[]>		slots;
+	uint32_t							count;
+
+	//64 - log2(capacity), 64 when there are no slots
+	uint32_t							shift;
+};
+
+inline IdHashSet::IdHashSet ()
+:count (0)
+,shift (64)
+{
+}
+
+inline IdHashSet::IdHashSet (IdHashSet&& other)
+:slots (std::move (other.slots))
+,count (other.count)
+,shift (other.shift)
+{
+	other.count = 0;
+	other.shift = 64;
+}
+
+inline IdHashSet& IdHashSet::operator= (IdHashSet&& other)
+{
+	if (this != &other) {
+		slots = std::move (other.slots);
+		count = other.count;
+		shift = other.shift;
+		other.count = 0;
+		other.shift = 64;
+	}
+
+	return *this;
+}
+
+inline IdHashSet::const_iterator IdHashSet::begin () const
+{
+	return const_iterator (slots.get(), slots.get() + capacity());
+}
+
+inline IdHashSet::const_iterator IdHashSet::end () const
+{
+	return const_iterator (slots.get() + capacity(), slots.get() + capacity());
+}
+
+inline uint32_t IdHashSet::size () const
+{
+	return count;
+}
+
+inline bool IdHashSet::empty () const
+{
+	return count == 0;
+}
+
+inline uint32_t IdHashSet::capacity () const
+{
+	return shift == 64 ? 0 : (uint32_t) 1 << (64 - shift);
+}
+
+inline uint32_t IdHashSet::slotIndex (const MattermostId& id) const
+{
+	//Fibonacci hashing, same as IdHashMap
+	return (uint32_t) (((uint64_t) id.hash() * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+inline uint32_t IdHashSet::findSlot (const MattermostId& id) const
+{
+	uint32_t mask = capacity() - 1;
+	uint32_t index = slotIndex (id);
+
+	//the load factor is below 1, so there is always an empty slot which ends the probe sequence
+	while (!slots[index].isNull() && slots[index] != id) {
+		index = (index + 1) & mask;
+	}
+
+	return index;
+}
+
+inline bool IdHashSet::contains (const MattermostId& id) const
+{
+	if (!count || id.isNull()) {
+		return false;
+	}
+
+	return !slots[findSlot (id)].isNull();
+}
+
+inline bool IdHashSet::insert (const MattermostId& id)
+{
+	if (id.isNull()) {
+		return false;
+	}
+
+	//max load factor 3/4
+	if ((count + 1) * 4 > capacity() * 3) {
+		rehash (capacity() ? capacity() * 2 : minCapacity);
+	}
+
+	uint32_t index = findSlot (id);
+
+	if (!slots[index].isNull()) {
+		return false;
+	}
+
+	slots[index] = id;
+	++count;
+	return true;
+}
+
+inline bool IdHashSet::erase (const MattermostId& id)
+{
+	if (!count || id.isNull()) {
+		return false;
+	}
+
+	uint32_t mask = capacity() - 1;
+	uint32_t index = findSlot (id);
+
+	if (slots[index].isNull()) {
+		return false;
+	}
+
+	//backward shift - move the following IDs of the probe sequence into the hole, if their home slot allows it
+	uint32_t hole = index;
+
+	for (uint32_t next = (hole + 1) & mask; !slots[next].isNull(); next = (next + 1) & mask) {
+		uint32_t home = slotIndex (slots[next]);
+
+		if (((next - home) & mask) >= ((next - hole) & mask)) {
+			slots[hole] = slots[next];
+			hole = next;
+		}
+	}
+
+	slots[hole] = MattermostId ();
+
+	//the memory is released with the last ID, as most reactions have few users
+	if (--count == 0) {
+		clear ();
+	}
+
+	return true;
+}
+
+inline void IdHashSet::clear ()
+{
+	slots.reset ();
+	count = 0;
+	shift = 64;
+}
+
+inline size_t IdHashSet::getAllocatedBytes () const
+{
+	return capacity() * sizeof (MattermostId);
+}
+
+inline void IdHashSet::rehash (uint32_t newCapacity)
+{
+	std::unique_ptr<MattermostId[]> oldSlots (std::move (slots));
+	uint32_t oldCapacity = capacity();
+
+	slots.reset (new MattermostId[newCapacity]);
+
+	shift = 64;
+	for (uint32_t capacity = newCapacity; capacity > 1; capacity >>= 1) {
+		--shift;
+	}
+
+	for (uint32_t i = 0; i < oldCapacity; ++i) {
+		if (!oldSlots[i].isNull()) {
+			slots[findSlot (oldSlots[i])] = oldSlots[i];
+		}
+	}
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,275 @@
+/**
+ * @file NetworkMetrics.cpp
+ * @brief Per-endpoint counters and latency histograms for the HTTP and WebSocket traffic
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "NetworkMetrics.h"
+
+#include <cmath>
+#include <algorithm>
+#include <QtAlgorithms>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QJsonArray>
+
+namespace Mattermost {
+
+namespace {
+
+const char* operationName (QNetworkAccessManager::Operation operation)
+{
+	switch (operation) {
+	case QNetworkAccessManager::HeadOperation:
+		return "HEAD";
+	case QNetworkAccessManager::GetOperation:
+		return "GET";
+	case QNetworkAccessManager::PutOperation:
+		return "PUT";
+	case QNetworkAccessManager::PostOperation:
+		return "POST";
+	case QNetworkAccessManager::DeleteOperation:
+		return "DELETE";
+	default:
+		return "CUSTOM";
+	}
+}
+
+bool isIdSegment (const QString& segment)
+{
+	//Mattermost IDs are 26 characters, lower case letters and digits
+	if (segment.size() != 26) {
+		return false;
+	}
+
+	for (QChar c: segment) {
+		if (!(c >= 'a' && c <= 'z') && !c.isDigit()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool isNumberSegment (const QString& segment)
+{
+	bool isNumber;
+	segment.toULongLong (&isNumber);
+	return isNumber;
+}
+
+double toMs (uint32_t durationUs)
+{
+	return std::round (durationUs / 10.0) / 100.0;
+}
+
+} /* namespace */
+
+void LatencyHistogram::add (uint32_t durationUs)
+{
+	++buckets[bucketIndex (durationUs)];
+	++total;
+
+	if (durationUs > maxValue) {
+		maxValue = durationUs;
+	}
+}
+
+uint32_t LatencyHistogram::percentile (double fraction) const
+{
+	if (!total) {
+		return 0;
+	}
+
+	uint64_t rank = (uint64_t)std::ceil (fraction * total);
+	uint64_t count = 0;
+
+	for (int i = 0; i < bucketCount; ++i) {
+		count += buckets[i];
+
+		if (count >= rank && buckets[i]) {
+			return std::min (bucketUpperBound (i), maxValue);
+		}
+	}
+
+	return maxValue;
+}
+
+uint32_t LatencyHistogram::count () const
+{
+	return total;
+}
+
+uint32_t LatencyHistogram::max () const
+{
+	return maxValue;
+}
+
+int LatencyHistogram::bucketIndex (uint32_t value)
+{
+	//small values have a bucket each
+	if (value < (uint32_t)subBuckets) {
+		return value;
+	}
+
+	int msb = 31 - qCountLeadingZeroBits (value);
+	int subBucket = (value >> (msb - subBucketBits)) & (subBuckets - 1);
+	return (msb - subBucketBits + 1) * subBuckets + subBucket;
+}
+
+uint32_t LatencyHistogram::bucketUpperBound (int index)
+{
+	if (index < subBuckets) {
+		return index;
+	}
+
+	int msb = index / subBuckets + subBucketBits - 1;
+	int subBucket = index % subBuckets;
+	return (uint32_t)((((uint64_t)subBuckets + subBucket + 1) << (msb - subBucketBits)) - 1);
+}
+
+double EndpointMetrics::cacheHitRatio () const
+{
+	return requests ? (double)cacheHits / requests : 0;
+}
+
+NetworkMetrics::NetworkMetrics ()
+:startTime (QDateTime::currentDateTime())
+{
+}
+
+void NetworkMetrics::addHttpReply (const QNetworkReply& reply, uint32_t durationUs, uint64_t requestBytes, uint64_t responseBytes)
+{
+	QString endpoint (operationName (reply.operation()));
+	endpoint += ' ';
+	endpoint += endpointTemplate (reply.request().url().path());
+
+	int statusCode = reply.attribute (QNetworkRequest::HttpStatusCodeAttribute).toInt();
+	EndpointMetrics& metrics = endpoints[endpoint];
+
+	++metrics.requests;
+	metrics.requestBytes += requestBytes;
+	metrics.responseBytes += responseBytes;
+	metrics.latency.add (durationUs);
+
+	if (reply.attribute (QNetworkRequest::SourceIsFromCacheAttribute).toBool()) {
+		++metrics.cacheHits;
+	}
+
+	if (reply.error() != QNetworkReply::NoError || statusCode < 200 || statusCode >= 400) {
+		++metrics.failures;
+	}
+}
+
+void NetworkMetrics::addWebSocketEvent (const QString& event, uint64_t bytes, uint32_t durationUs)
+{
+	EndpointMetrics& metrics = endpoints["WS in " + event];
+
+	++metrics.requests;
+	metrics.responseBytes += bytes;
+	metrics.latency.add (durationUs);
+}
+
+void NetworkMetrics::addWebSocketAction (const QString& action, uint64_t bytes)
+{
+	EndpointMetrics& metrics = endpoints["WS out " + action];
+
+	++metrics.requests;
+	metrics.requestBytes += bytes;
+}
+
+void NetworkMetrics::reset ()
+{
+	endpoints.clear ();
+	startTime = QDateTime::currentDateTime ();
+}
+
+const std::map<QString, EndpointMetrics>& NetworkMetrics::getEndpoints () const
+{
+	return endpoints;
+}
+
+QDateTime NetworkMetrics::getStartTime () const
+{
+	return startTime;
+}
+
+QJsonObject NetworkMetrics::toJson () const
+{
+	QJsonArray endpointsJson;
+
+	for (const auto& it: endpoints) {
+		const EndpointMetrics& metrics = it.second;
+
+		endpointsJson.push_back (QJsonObject {
+			{"endpoint", it.first},
+			{"requests", (qint64)metrics.requests},
+			{"failures", (qint64)metrics.failures},
+			{"cache_hits", (qint64)metrics.cacheHits},
+			{"cache_hit_ratio", metrics.cacheHitRatio()},
+			{"request_bytes", (qint64)metrics.requestBytes},
+			{"response_bytes", (qint64)metrics.responseBytes},
+			{"latency_ms", QJsonObject {
+				{"p50", toMs (metrics.latency.percentile (0.5))},
+				{"p95", toMs (metrics.latency.percentile (0.95))},
+				{"p99", toMs (metrics.latency.percentile (0.99))},
+				{"max", toMs (metrics.latency.max())},
+			}},
+		});
+	}
+
+	return QJsonObject {
+		{"start_time", startTime.toUTC().toString (Qt::ISODate)},
+		{"end_time", QDateTime::currentDateTimeUtc().toString (Qt::ISODate)},
+		{"endpoints", endpointsJson},
+	};
+}
+
+QString NetworkMetrics::endpointTemplate (const QString& path)
+{
+	static const QString apiPrefix ("/api/v4/");
+	static const QString pluginsPrefix ("/plugins/");
+
+	int apiPos = path.indexOf (apiPrefix);
+	QString relativePath;
+
+	if (apiPos >= 0) {
+		relativePath = path.mid (apiPos + apiPrefix.size());
+	} else if (path.startsWith (pluginsPrefix)) {
+		relativePath = path.mid (1);
+	} else {
+		relativePath = path.startsWith ('/') ? path.mid (1) : path;
+	}
+
+	QStringList segments (relativePath.split ('/'));
+
+	for (QString& segment: segments) {
+		if (isIdSegment (segment)) {
+			segment = "{id}";
+		} else if (isNumberSegment (segment)) {
+			segment = "{n}";
+		}
+	}
+
+	return segments.join ('/');
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,107 @@
+/**
+ * @file NetworkMetrics.h
+ * @brief Per-endpoint counters and latency histograms for the HTTP and WebSocket traffic
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <map>
+#include <array>
+#include <cstdint>
+#include <QString>
+#include <QDateTime>
+#include <QJsonObject>
+
+class QNetworkReply;
+
+namespace Mattermost {
+
+/**
+ * Log-linear histogram of durations in microseconds. Each power of 2 is split in 8 buckets,
+ * so a percentile is reported with an error below 12.5%, using a fixed amount of memory
+ */
+class LatencyHistogram {
+public:
+	void add (uint32_t durationUs);
+
+	/**
+	 * Upper bound of the bucket, containing the given percentile (0.0 - 1.0). 0 if empty
+	 */
+	uint32_t percentile (double fraction) const;
+
+	uint32_t count () const;
+	uint32_t max () const;
+private:
+	static constexpr int subBucketBits = 3;
+	static constexpr int subBuckets = 1 << subBucketBits;
+	static constexpr int bucketCount = (32 - subBucketBits + 1) * subBuckets;
+
+	static int bucketIndex (uint32_t value);
+	static uint32_t bucketUpperBound (int index);
+private:
+	std::array<uint32_t, bucketCount>	buckets {};
+	uint32_t							total = 0;
+	uint32_t							maxValue = 0;
+};
+
+struct EndpointMetrics {
+	double cacheHitRatio () const;
+
+	uint32_t			requests = 0;
+	uint32_t			failures = 0;
+	uint32_t			cacheHits = 0;
+	uint64_t			requestBytes = 0;
+	uint64_t			responseBytes = 0;
+	LatencyHistogram	latency;
+};
+
+/**
+ * Network metrics, grouped by endpoint template. IDs in the request paths are replaced
+ * by '{id}', so for example all post requests are counted as 'GET channels/{id}/posts'.
+ * WebSocket messages are counted as 'WS in <event>' / 'WS out <action>'. The latency of an
+ * incoming WebSocket event is the time needed to handle it.
+ */
+class NetworkMetrics {
+public:
+	NetworkMetrics ();
+public:
+	void addHttpReply (const QNetworkReply& reply, uint32_t durationUs, uint64_t requestBytes, uint64_t responseBytes);
+	void addWebSocketEvent (const QString& event, uint64_t bytes, uint32_t durationUs);
+	void addWebSocketAction (const QString& action, uint64_t bytes);
+	void reset ();
+
+	const std::map<QString, EndpointMetrics>& getEndpoints () const;
+	QDateTime getStartTime () const;
+
+	QJsonObject toJson () const;
+
+	/**
+	 * Convert an API path to an endpoint template, for example
+	 * '/api/v4/channels/4xp9fdt77pncbef59f4k1qe83o/posts' to 'channels/{id}/posts'
+	 */
+	static QString endpointTemplate (const QString& path);
+private:
+	std::map<QString, EndpointMetrics>	endpoints;
+	QDateTime							startTime;
+};
+
+} /* namespace Mattermost */
@@ -0,0 +1,406 @@
+/**
+ * @file NetworkSimulator.cpp
+ * @brief Simulation of slow and unreliable networks, for HTTP and WebSocket
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "NetworkSimulator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <QMap>
+#include <QStringList>
+#include "log.h"
+
+namespace Mattermost {
+
+//a lost HTTP request fails after this time (Qt5 has no default transfer timeout, the value is similar to browsers on a stalled connection)
+static constexpr int64_t lossTimeoutMs = 5000;
+
+//interval of the WebSocket disconnect check
+static constexpr int webSocketDisconnectCheckMs = 10000;
+
+static const QMap<QString, NetworkConditions> profiles {
+	//								latency		jitter	down	up		loss	disconnect
+	{"lan",						{	1,			0,		0,		0,		0,		0}},
+	{"hotel-wifi",				{	80,			60,		2000,	500,	3,		2}},
+	{"vpn-intercontinental",	{	300,		30,		8000,	4000,	1,		0.5}},
+	{"mobile-3g",				{	200,		100,	1500,	750,	2,		1}},
+};
+
+static int64_t transferTimeMs (qint64 bytes, uint32_t kbps)
+{
+	return kbps ? bytes * 8 / kbps : 0;
+}
+
+static bool randomPercent (std::mt19937& random, double percent)
+{
+	return percent > 0 && std::uniform_real_distribution<double> (0, 100) (random) < percent;
+}
+
+bool NetworkConditions::parse (const QString& spec)
+{
+	for (const QString& item: spec.split (',')) {
+
+		if (item.trimmed().isEmpty()) {
+			continue;
+		}
+
+		QStringList keyValue (item.trimmed().split ('='));
+
+		if (keyValue.size() == 1) {
+			auto it = profiles.find (keyValue[0]);
+
+			if (it == profiles.end()) {
+				return false;
+			}
+
+			*this = it.value();
+			continue;
+		}
+
+		bool ok = false;
+		double value = keyValue[1].toDouble (&ok);
+
+		if (keyValue.size() != 2 || !ok || value < 0) {
+			return false;
+		}
+
+		const QString& key = keyValue[0];
+
+		if (key == "latency") {
+			latencyMs = value;
+		} else if (key == "jitter") {
+			jitterMs = value;
+		} else if (key == "down") {
+			downloadKbps = value;
+		} else if (key == "up") {
+			uploadKbps = value;
+		} else if (key == "loss") {
+			lossPercent = std::min (value, 100.0);
+		} else if (key == "disconnect") {
+			disconnectPercent = std::min (value, 100.0);
+		} else if (key == "seed") {
+			seed = value;
+		} else {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+QStringList NetworkConditions::profileNames ()
+{
+	return profiles.keys ();
+}
+
+bool NetworkConditions::isIdeal () const
+{
+	return !latencyMs && !jitterMs && !downloadKbps && !uploadKbps && !lossPercent && !disconnectPercent;
+}
+
+int64_t NetworkConditions::randomDelay (std::mt19937& random) const
+{
+	int64_t jitter = jitterMs ? std::uniform_int_distribution<int64_t> (-(int64_t)jitterMs, jitterMs) (random) : 0;
+	return std::max<int64_t> (latencyMs + jitter, 0);
+}
+
+SimulatedNetworkAccessManager::SimulatedNetworkAccessManager (const NetworkConditions& conditions, QObject* parent)
+:QNetworkAccessManager (parent)
+,conditions (conditions)
+,random (conditions.seed)
+{
+	LOG_INFO (http, "Network simulation enabled" << LogField ("latency_ms", conditions.latencyMs)
+			<< LogField ("jitter_ms", conditions.jitterMs) << LogField ("down_kbps", conditions.downloadKbps)
+			<< LogField ("up_kbps", conditions.uploadKbps) << LogField ("loss_percent", conditions.lossPercent)
+			<< LogField ("disconnect_percent", conditions.disconnectPercent));
+}
+
+QNetworkReply* SimulatedNetworkAccessManager::createRequest (Operation op, const QNetworkRequest& request, QIODevice* outgoingData)
+{
+	SimulatedNetworkReply::Fate fate = SimulatedNetworkReply::Fate::deliver;
+
+	if (randomPercent (random, conditions.lossPercent)) {
+		fate = SimulatedNetworkReply::Fate::lose;
+	} else if (randomPercent (random, conditions.disconnectPercent)) {
+		fate = SimulatedNetworkReply::Fate::disconnect;
+	}
+
+	int64_t delayMs = conditions.randomDelay (random);
+
+	if (outgoingData && !outgoingData->isSequential()) {
+		delayMs += transferTimeMs (outgoingData->size(), conditions.uploadKbps);
+	}
+
+	QNetworkReply* realReply = nullptr;
+
+	if (fate != SimulatedNetworkReply::Fate::lose) {
+		realReply = QNetworkAccessManager::createRequest (op, request, outgoingData);
+	}
+
+	SimulatedNetworkReply* reply = new SimulatedNetworkReply (realReply, request, op, fate, delayMs, conditions.downloadKbps);
+	reply->setParent (this);
+	return reply;
+}
+
+SimulatedNetworkReply::SimulatedNetworkReply (QNetworkReply* realReply, const QNetworkRequest& request, Operation op, Fate fate, int64_t delayMs, uint32_t downloadKbps)
+:realReply (realReply)
+,fate (fate)
+,delayMs (delayMs)
+,downloadKbps (downloadKbps)
+,readPosition (0)
+{
+	setRequest (request);
+	setUrl (request.url());
+	setOperation (op);
+	open (QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+	timer.start ();
+	deliveryTimer.setSingleShot (true);
+
+	if (fate == Fate::lose) {
+		connect (&deliveryTimer, &QTimer::timeout, this, [this] {
+			fail (TimeoutError, "Simulated packet loss");
+		});
+		deliveryTimer.start (delayMs + lossTimeoutMs);
+		return;
+	}
+
+	connect (&deliveryTimer, &QTimer::timeout, this, &SimulatedNetworkReply::deliver);
+	connect (realReply, &QNetworkReply::finished, this, &SimulatedNetworkReply::onRealReplyFinished);
+}
+
+SimulatedNetworkReply::~SimulatedNetworkReply ()
+{
+	if (realReply) {
+		realReply->deleteLater ();
+	}
+}
+
+void SimulatedNetworkReply::abort ()
+{
+	if (isFinished()) {
+		return;
+	}
+
+	deliveryTimer.stop ();
+
+	if (realReply) {
+		realReply->disconnect (this);
+		realReply->abort ();
+	}
+
+	fail (OperationCanceledError, "Operation canceled");
+}
+
+qint64 SimulatedNetworkReply::bytesAvailable () const
+{
+	return data.size() - readPosition + QNetworkReply::bytesAvailable ();
+}
+
+bool SimulatedNetworkReply::isSequential () const
+{
+	return true;
+}
+
+qint64 SimulatedNetworkReply::readData (char* buffer, qint64 maxSize)
+{
+	qint64 size = std::min<qint64> (maxSize, data.size() - readPosition);
+
+	if (size <= 0) {
+		return isFinished() ? -1 : 0;
+	}
+
+	memcpy (buffer, data.constData() + readPosition, size);
+	readPosition += size;
+	return size;
+}
+
+void SimulatedNetworkReply::onRealReplyFinished ()
+{
+	data = realReply->readAll ();
+
+	int64_t transferMs = transferTimeMs (data.size(), downloadKbps);
+
+	if (fate == Fate::disconnect) {
+		transferMs /= 2;
+	}
+
+	deliveryTimer.start (std::max<int64_t> (delayMs + transferMs - timer.elapsed(), 0));
+}
+
+void SimulatedNetworkReply::deliver ()
+{
+	if (fate == Fate::disconnect) {
+		data.clear ();
+		return fail (RemoteHostClosedError, "Simulated disconnect during the transfer");
+	}
+
+	copyMetaData ();
+	emit metaDataChanged ();
+
+	if (realReply->error() != NoError) {
+		setError (realReply->error(), realReply->errorString());
+		emitError (realReply->error());
+	}
+
+	if (!data.isEmpty()) {
+		emit readyRead ();
+	}
+
+	setFinished (true);
+	emit finished ();
+}
+
+void SimulatedNetworkReply::fail (NetworkError code, const QString& errorString)
+{
+	setError (code, errorString);
+	emitError (code);
+	setFinished (true);
+	emit finished ();
+}
+
+void SimulatedNetworkReply::copyMetaData ()
+{
+	static const QNetworkRequest::Attribute attributes[] = {
+		QNetworkRequest::HttpStatusCodeAttribute,
+		QNetworkRequest::HttpReasonPhraseAttribute,
+		QNetworkRequest::RedirectionTargetAttribute,
+		QNetworkRequest::ConnectionEncryptedAttribute,
+		QNetworkRequest::SourceIsFromCacheAttribute,
+	};
+
+	for (QNetworkRequest::Attribute attribute: attributes) {
+		setAttribute (attribute, realReply->attribute (attribute));
+	}
+
+	//known headers (content type, length, etc.) are parsed from the raw headers
+	for (const RawHeaderPair& header: realReply->rawHeaderPairs()) {
+		setRawHeader (header.first, header.second);
+	}
+
+	setUrl (realReply->url());
+}
+
+void SimulatedNetworkReply::emitError (NetworkError code)
+{
+#if QT_VERSION < QT_VERSION_CHECK(5,15,0)
+	emit error (code);
+#else
+	emit errorOccurred (code);
+#endif
+}
+
+SimulatedWebSocketLink::SimulatedWebSocketLink (const NetworkConditions& conditions, QObject* parent)
+:QObject (parent)
+,conditions (conditions)
+,random (conditions.seed)
+{
+	clock.start ();
+	deliveryTimer.setSingleShot (true);
+	deliveryTimer.setTimerType (Qt::PreciseTimer);
+	connect (&deliveryTimer, &QTimer::timeout, this, &SimulatedWebSocketLink::deliverQueued);
+
+	if (conditions.disconnectPercent > 0) {
+		connect (&disconnectTimer, &QTimer::timeout, this, [this] {
+			if (randomPercent (this->random, this->conditions.disconnectPercent)) {
+				LOG_DEBUG (websocket, "Simulated WebSocket disconnect");
+				emit disconnectRequested ();
+			}
+		});
+		disconnectTimer.start (webSocketDisconnectCheckMs);
+	}
+}
+
+void SimulatedWebSocketLink::receive (const QString& message)
+{
+	enqueue (message, true, conditions.downloadKbps);
+}
+
+void SimulatedWebSocketLink::send (const QString& message)
+{
+	enqueue (message, false, conditions.uploadKbps);
+}
+
+void SimulatedWebSocketLink::clear ()
+{
+	incomingQueue.clear ();
+	outgoingQueue.clear ();
+	deliveryTimer.stop ();
+}
+
+void SimulatedWebSocketLink::enqueue (const QString& message, bool incoming, uint32_t kbps)
+{
+	std::deque<QueuedMessage>& queue = incoming ? incomingQueue : outgoingQueue;
+	int64_t transferMs = transferTimeMs (message.toUtf8().size(), kbps);
+
+	//one way delay. A lost segment is retransmitted after a round trip
+	int64_t delayMs = conditions.randomDelay (random) / 2 + transferMs;
+
+	if (randomPercent (random, conditions.lossPercent)) {
+		delayMs += conditions.latencyMs;
+	}
+
+	//the messages of a TCP stream arrive in order and share the bandwidth
+	int64_t deliverAt = clock.elapsed() + delayMs;
+
+	if (!queue.empty()) {
+		deliverAt = std::max (deliverAt, queue.back().deliverAt + transferMs);
+	}
+
+	queue.push_back ({deliverAt, message});
+	deliverQueued ();
+}
+
+void SimulatedWebSocketLink::deliverQueued ()
+{
+	int64_t now = clock.elapsed ();
+
+	//a handler may clear the queues (on disconnect), so the front is checked each time
+	while (!outgoingQueue.empty() && outgoingQueue.front().deliverAt <= now) {
+		QString message (std::move (outgoingQueue.front().message));
+		outgoingQueue.pop_front ();
+		emit messageSent (message);
+	}
+
+	while (!incomingQueue.empty() && incomingQueue.front().deliverAt <= now) {
+		QString message (std::move (incomingQueue.front().message));
+		incomingQueue.pop_front ();
+		emit messageReceived (message);
+	}
+
+	int64_t next = INT64_MAX;
+
+	if (!outgoingQueue.empty()) {
+		next = outgoingQueue.front().deliverAt;
+	}
+
+	if (!incomingQueue.empty()) {
+		next = std::min (next, incomingQueue.front().deliverAt);
+	}
+
+	if (next != INT64_MAX) {
+		deliveryTimer.start (std::max<int64_t> (next - now, 0));
+	}
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,163 @@
+/**
+ * @file NetworkSimulator.h
+ * @brief Simulation of slow and unreliable networks, for HTTP and WebSocket
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <deque>
+#include <random>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QTimer>
+
+namespace Mattermost {
+
+/**
+ * Network conditions, applied to all HTTP requests and WebSocket messages. The default
+ * values mean an ideal network (no simulation)
+ */
+struct NetworkConditions {
+
+	/**
+	 * Parse a profile name and / or comma separated values, which override the profile values.
+	 * For example "hotel-wifi", "vpn-intercontinental,loss=5" or "latency=200,down=1000"
+	 * @return false on an unknown profile or key
+	 */
+	bool parse (const QString& spec);
+
+	/**
+	 * Names of the predefined profiles
+	 */
+	static QStringList profileNames ();
+
+	bool isIdeal () const;
+
+	/**
+	 * Random delay for a single request or message: latency plus up to +/- jitter
+	 */
+	int64_t randomDelay (std::mt19937& random) const;
+
+	uint32_t	latencyMs = 0;			//round trip time
+	uint32_t	jitterMs = 0;			//maximum deviation from the latency
+	uint32_t	downloadKbps = 0;		//0 - unlimited
+	uint32_t	uploadKbps = 0;			//0 - unlimited
+	double		lossPercent = 0;		//HTTP: requests, which fail with TimeoutError. WebSocket: messages, which are retransmitted
+	double		disconnectPercent = 0;	//HTTP: replies, which are cut in the middle. WebSocket: chance to drop the connection every 10 seconds
+	uint32_t	seed = 1;				//seed of the random generator, for reproducible runs
+};
+
+/**
+ * Sends the requests with the base QNetworkAccessManager and delivers the replies
+ * according to the network conditions. Cached replies are delayed as well.
+ */
+class SimulatedNetworkAccessManager: public QNetworkAccessManager {
+	Q_OBJECT
+public:
+	SimulatedNetworkAccessManager (const NetworkConditions& conditions, QObject* parent = nullptr);
+protected:
+	QNetworkReply* createRequest (Operation op, const QNetworkRequest& request, QIODevice* outgoingData = nullptr) override;
+private:
+	NetworkConditions	conditions;
+	std::mt19937		random;
+};
+
+/**
+ * Reply returned by SimulatedNetworkAccessManager. Buffers the real reply and delivers it when
+ * the simulated transfer is complete.
+ */
+class SimulatedNetworkReply: public QNetworkReply {
+	Q_OBJECT
+public:
+	enum class Fate {
+		deliver,
+		lose,			//the request is not sent and fails after the timeout
+		disconnect,		//the transfer is cut after half of the reply is received
+	};
+
+	SimulatedNetworkReply (QNetworkReply* realReply, const QNetworkRequest& request, Operation op, Fate fate, int64_t delayMs, uint32_t downloadKbps);
+	~SimulatedNetworkReply ();
+public:
+	void abort () override;
+	qint64 bytesAvailable () const override;
+	bool isSequential () const override;
+protected:
+	qint64 readData (char* data, qint64 maxSize) override;
+private:
+	void onRealReplyFinished ();
+	void deliver ();
+	void fail (NetworkError code, const QString& errorString);
+	void copyMetaData ();
+	void emitError (NetworkError code);
+private:
+	QPointer<QNetworkReply>		realReply;
+	Fate						fate;
+	int64_t						delayMs;
+	uint32_t					downloadKbps;
+	QElapsedTimer				timer;
+	QTimer						deliveryTimer;
+	QByteArray					data;
+	qint64						readPosition;
+};
+
+/**
+ * Applies the network conditions to a WebSocket connection. Received and sent messages are
+ * passed through the link, which delays them, keeping the order. Loss is simulated as a retransmission
+ * (an additional round trip), because WebSocket runs over TCP
+ */
+class SimulatedWebSocketLink: public QObject {
+	Q_OBJECT
+public:
+	SimulatedWebSocketLink (const NetworkConditions& conditions, QObject* parent = nullptr);
+public:
+	void receive (const QString& message);
+	void send (const QString& message);
+
+	/**
+	 * Drop the queued messages (on disconnect)
+	 */
+	void clear ();
+signals:
+	void messageReceived (const QString& message);
+	void messageSent (const QString& message);
+	void disconnectRequested ();
+private:
+	struct QueuedMessage {
+		int64_t		deliverAt;
+		QString		message;
+	};
+
+	void enqueue (const QString& message, bool incoming, uint32_t kbps);
+	void deliverQueued ();
+private:
+	NetworkConditions			conditions;
+	std::mt19937				random;
+	QElapsedTimer				clock;
+	std::deque<QueuedMessage>	incomingQueue;
+	std::deque<QueuedMessage>	outgoingQueue;
+	QTimer						deliveryTimer;
+	QTimer						disconnectTimer;
+};
+
+} /* namespace Mattermost */
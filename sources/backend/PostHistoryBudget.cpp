@@ -0,0 +1,139 @@
+/**
+ * @file PostHistoryBudget.cpp
+ * @brief Limits the memory, used by the post history of inactive channels
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "PostHistoryBudget.h"
+
+#include <algorithm>
+#include <vector>
+#include <QDateTime>
+#include "backend/Storage.h"
+#include "Settings.h"
+#include "log.h"
+
+namespace Mattermost {
+
+namespace {
+
+constexpr int checkIntervalMs = 60 * 1000;
+constexpr uint32_t defaultBudgetMB = 32;
+constexpr uint32_t defaultInactiveChannelPosts = 100;
+
+}
+
+PostHistoryBudget::PostHistoryBudget (Storage& storage)
+:storage (storage)
+,currentChannel (nullptr)
+{
+	QSettings settings;
+	budgetBytes = (size_t) settings.value (HISTORY_MEMORY_BUDGET, defaultBudgetMB).toUInt() * 1024 * 1024;
+	inactiveChannelPosts = settings.value (HISTORY_INACTIVE_CHANNEL_POSTS, defaultInactiveChannelPosts).toUInt();
+
+	checkTimer.setInterval (checkIntervalMs);
+	connect (&checkTimer, &QTimer::timeout, this, &PostHistoryBudget::enforce);
+
+	//a budget of 0 disables the trimming
+	if (budgetBytes) {
+		checkTimer.start ();
+	}
+}
+
+PostHistoryBudget::~PostHistoryBudget () = default;
+
+void PostHistoryBudget::setCurrentChannel (BackendChannel& channel)
+{
+	//the previous channel was active until now
+	if (currentChannel) {
+		currentChannel->lastActiveAt = QDateTime::currentMSecsSinceEpoch ();
+	}
+
+	currentChannel = &channel;
+	channel.lastActiveAt = QDateTime::currentMSecsSinceEpoch ();
+}
+
+size_t PostHistoryBudget::getHistoryMemory () const
+{
+	size_t total = 0;
+
+	for (auto& it: storage.channels) {
+		total += it.second->getHistoryMemory ();
+	}
+
+	return total;
+}
+
+size_t PostHistoryBudget::getBudget () const
+{
+	return budgetBytes;
+}
+
+void PostHistoryBudget::enforce ()
+{
+	if (!budgetBytes) {
+		return;
+	}
+
+	size_t total = getHistoryMemory ();
+
+	if (total <= budgetBytes) {
+		return;
+	}
+
+	std::vector<BackendChannel*> candidates;
+
+	for (auto& it: storage.channels) {
+		BackendChannel* channel = it.second;
+
+		if (channel != currentChannel && channel->posts.size() > inactiveChannelPosts) {
+			candidates.push_back (channel);
+		}
+	}
+
+	std::sort (candidates.begin(), candidates.end(), [] (const BackendChannel* a, const BackendChannel* b) {
+		return a->lastActiveAt < b->lastActiveAt;
+	});
+
+	size_t totalBefore = total;
+	uint32_t trimmedChannels = 0;
+
+	for (BackendChannel* channel: candidates) {
+		if (total <= budgetBytes) {
+			break;
+		}
+
+		size_t channelMemory = channel->getHistoryMemory ();
+		channel->trimHistory (inactiveChannelPosts);
+		total = total - channelMemory + channel->getHistoryMemory ();
+		++trimmedChannels;
+	}
+
+	LOG_DEBUG (storage, "Post history over budget" << LogField ("budget_bytes", (qint64) budgetBytes) << LogField ("bytes_before", (qint64) totalBefore)
+			<< LogField ("bytes_after", (qint64) total) << LogField ("trimmed_channels", trimmedChannels));
+}
+
+void PostHistoryBudget::reset ()
+{
+	currentChannel = nullptr;
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,69 @@
+/**
+ * @file PostHistoryBudget.h
+ * @brief Limits the memory, used by the post history of inactive channels
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+
+namespace Mattermost {
+
+class Storage;
+class BackendChannel;
+
+/**
+ * Keeps the memory of the loaded posts of all channels below a budget. When the budget is exceeded,
+ * the channels, which are not shown, are trimmed to their newest posts, starting from the one used
+ * least recently. The evicted posts are loaded again from the server when the user scrolls back.
+ */
+class PostHistoryBudget: public QObject {
+	Q_OBJECT
+public:
+	explicit PostHistoryBudget (Storage& storage);
+	virtual ~PostHistoryBudget ();
+public:
+	void setCurrentChannel (BackendChannel& channel);
+
+	/**
+	 * Trim inactive channels if the loaded history is over the budget
+	 */
+	void enforce ();
+
+	/**
+	 * Memory, used by the loaded posts of all channels
+	 */
+	size_t getHistoryMemory () const;
+
+	size_t getBudget () const;
+
+	void reset ();
+private:
+	Storage&			storage;
+	QTimer				checkTimer;
+	BackendChannel*		currentChannel;
+	size_t				budgetBytes;
+	uint32_t			inactiveChannelPosts;
+};
+
+} /* namespace Mattermost */
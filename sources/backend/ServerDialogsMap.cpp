@@ -45,8 +45,8 @@ ServerDialogsMap::~ServerDialogsMap () = default;
  */
 void ServerDialogsMap::addEvent (const OpenDialogEvent& event)
 {
-	LOG_DEBUG ("ServerDialogsMap::total events: " << events.size());
-	//LOG_DEBUG ("ServerDialogsMap::addEvent - WebSocket: " << event.triggerID);
+	LOG_DEBUG (backend, "ServerDialogsMap::total events: " << events.size());
+	//LOG_DEBUG (backend, "ServerDialogsMap::addEvent - WebSocket: " << event.triggerID);
 	auto it = events.find (event.triggerID);
 
 	bool hasHttpResponse = (it != events.end());
@@ -70,8 +70,8 @@ void ServerDialogsMap::addEvent (const OpenDialogEvent& event)
  */
 void ServerDialogsMap::addEvent (const QString& triggerID)
 {
-	LOG_DEBUG ("ServerDialogsMap::total events: " << events.size());
-	//LOG_DEBUG ("ServerDialogsMap::addEvent - HTTP: " << triggerID);
+	LOG_DEBUG (backend, "ServerDialogsMap::total events: " << events.size());
+	//LOG_DEBUG (backend, "ServerDialogsMap::addEvent - HTTP: " << triggerID);
 
 	auto it = events.find (triggerID);
 
@@ -95,21 +95,21 @@ void ServerDialogsMap::sendEvent (const OpenDialogEvent& event)
 	BackendChannel* currentChannel = backend.getCurrentChannel();
 
 	if (!currentChannel) {
-		LOG_DEBUG ("WebSocketEventHandler::handleEvent (OpenDialogEvent): no current channel set");
+		LOG_DEBUG (backend, "WebSocketEventHandler::handleEvent (OpenDialogEvent): no current channel set");
 		return;
 	}
 
 	if (!currentChannel->team) {
-		LOG_DEBUG ("WebSocketEventHandler::handleEvent (OpenDialogEvent): no current channel's team set");
+		LOG_DEBUG (backend, "WebSocketEventHandler::handleEvent (OpenDialogEvent): no current channel's team set");
 		return;
 	}
 
 	QJsonObject json {
-		{"channel_id", 	currentChannel->id},
+		{"channel_id", 	currentChannel->id.toString()},
 		{"callback_id", event.callbackID},
 		{"state", 		""},
 		{"submission", 	QJsonObject()},
-		{"team_id", 	currentChannel->team->id},
+		{"team_id", 	currentChannel->team->id.toString()},
 		{"url", 		event.url}
 	};
 
@@ -0,0 +1,153 @@
+/**
+ * @file SessionRecorder.cpp
+ * @brief Records HTTP replies and WebSocket events into a replay file for the stand-in server
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "SessionRecorder.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkReply>
+#include "log.h"
+
+namespace Mattermost {
+
+bool SessionRecorder::enabled = false;
+
+SessionRecorder& SessionRecorder::instance ()
+{
+	static SessionRecorder recorder;
+	return recorder;
+}
+
+bool SessionRecorder::isEnabled ()
+{
+	return enabled;
+}
+
+bool SessionRecorder::start (const QString& fileName)
+{
+	stop ();
+	file.setFileName (fileName);
+
+	if (!file.open (QIODevice::WriteOnly | QIODevice::Truncate)) {
+		LOG_ERROR (general, "Cannot open session recording file " << fileName << ": " << file.errorString());
+		return false;
+	}
+
+	timer.start ();
+	enabled = true;
+	LOG_INFO (general, "Recording session to " << fileName);
+	return true;
+}
+
+void SessionRecorder::stop ()
+{
+	if (!enabled) {
+		return;
+	}
+
+	enabled = false;
+	file.close ();
+}
+
+static const char* operationName (QNetworkAccessManager::Operation operation)
+{
+	switch (operation) {
+	case QNetworkAccessManager::HeadOperation:
+		return "HEAD";
+	case QNetworkAccessManager::GetOperation:
+		return "GET";
+	case QNetworkAccessManager::PutOperation:
+		return "PUT";
+	case QNetworkAccessManager::PostOperation:
+		return "POST";
+	case QNetworkAccessManager::DeleteOperation:
+		return "DELETE";
+	default:
+		return "CUSTOM";
+	}
+}
+
+/**
+ * Path and query, relative to the server root. For domains like https://example.com/mattermost/
+ * the '/mattermost' part is removed
+ */
+static QString relativePath (const QUrl& url)
+{
+	QString path (url.path (QUrl::FullyEncoded));
+
+	for (const char* root: {"/api/v4/", "/plugins/"}) {
+		int index = path.indexOf (root);
+
+		if (index > 0) {
+			path.remove (0, index);
+			break;
+		}
+	}
+
+	if (url.hasQuery()) {
+		path += '?' + url.query (QUrl::FullyEncoded);
+	}
+
+	return path;
+}
+
+void SessionRecorder::addHttpReply (const QNetworkReply& reply, const QByteArray& data)
+{
+	QString contentType (reply.header (QNetworkRequest::ContentTypeHeader).toString());
+
+	QJsonObject record {
+		{"type", "http"},
+		{"time_ms", timer.elapsed()},
+		{"method", operationName (reply.operation())},
+		{"path", relativePath (reply.url())},
+		{"status", reply.attribute (QNetworkRequest::HttpStatusCodeAttribute).toInt()},
+		{"content_type", contentType},
+	};
+
+	if (contentType.contains ("json") || contentType.startsWith ("text/")) {
+		record.insert ("body", QString::fromUtf8 (data));
+	} else {
+		record.insert ("body_base64", QString::fromLatin1 (data.toBase64()));
+	}
+
+	write (record);
+}
+
+void SessionRecorder::addWebSocketMessage (const QByteArray& message)
+{
+	write (QJsonObject {
+		{"type", "websocket"},
+		{"time_ms", timer.elapsed()},
+		{"message", QString::fromUtf8 (message)},
+	});
+}
+
+void SessionRecorder::write (const QJsonObject& record)
+{
+	file.write (QJsonDocument (record).toJson (QJsonDocument::Compact));
+	file.write ("\n");
+	file.flush ();
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,68 @@
+/**
+ * @file SessionRecorder.h
+ * @brief Records HTTP replies and WebSocket events into a replay file for the stand-in server
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QElapsedTimer>
+
+class QNetworkReply;
+class QJsonObject;
+
+namespace Mattermost {
+
+/**
+ * Records a real session, so that it can be replayed by the stand-in server (tools/stand-in-server).
+ * The file contains one JSON object per line:
+ *   {"type":"http","method":"GET","path":"/api/v4/users/me","status":200,"content_type":"...","body":"..."}
+ *   {"type":"websocket","time_ms":1234,"message":"..."}
+ * Binary bodies are stored in "body_base64" instead of "body". Request bodies, request headers
+ * and the login token are not recorded, so the file does not contain credentials.
+ * Paths are relative to the server root (the part of the domain before /api/v4/ is removed)
+ */
+class SessionRecorder {
+public:
+	static SessionRecorder& instance ();
+	static bool isEnabled ();
+public:
+	bool start (const QString& fileName);
+	void stop ();
+
+	void addHttpReply (const QNetworkReply& reply, const QByteArray& data);
+
+	/**
+	 * Add a WebSocket message received from the server. Replies to sent actions and 'hello'
+	 * are generated by the stand-in server, so they are not recorded
+	 */
+	void addWebSocketMessage (const QByteArray& message);
+private:
+	SessionRecorder () = default;
+	void write (const QJsonObject& record);
+private:
+	static bool		enabled;
+	QFile			file;
+	QElapsedTimer	timer;
+};
+
+} /* namespace Mattermost */
@@ -44,11 +44,12 @@ void Storage::reset ()
 	groupChannels.channels.clear();
 
 	channels.clear();
+	directChannelsByUser.clear();
 	users.clear();
 	totalUsersCount = 0;
 }
 
-const BackendUser* Storage::getUserById (const QString& userID) const
+const BackendUser* Storage::getUserById (const MattermostId& userID) const
 {
 	auto it = users.find (userID);
 
@@ -60,10 +61,10 @@ const BackendUser* Storage::getUserById (const QString& userID) const
 }
 
 
-QString Storage::getUserDisplayNameByUserId (const QString& userID, bool explainLoginUser) const
+QString Storage::getUserDisplayNameByUserId (const MattermostId& userID, bool explainLoginUser) const
 {
 	const BackendUser* user = getUserById (userID);
-	QString ret = user ? user->getDisplayName() : userID;
+	QString ret = user ? user->getDisplayName() : userID.toString();
 
 	if (explainLoginUser && user == loginUser) {
 		ret += " (you)";
@@ -72,7 +73,7 @@ QString Storage::getUserDisplayNameByUserId (const QString& userID, bool explain
 	return ret;
 }
 
-BackendUser* Storage::getUserById (const QString& userID)
+BackendUser* Storage::getUserById (const MattermostId& userID)
 {
 	auto it = users.find (userID);
 
@@ -83,7 +84,7 @@ BackendUser* Storage::getUserById (const QString& userID)
 	return &it->second;
 }
 
-BackendTeam* Storage::getTeamById (const QString& teamID)
+BackendTeam* Storage::getTeamById (const MattermostId& teamID)
 {
 	auto it = teams.find (teamID);
 
@@ -94,7 +95,7 @@ BackendTeam* Storage::getTeamById (const QString& teamID)
 	return &it->second;
 }
 
-const BackendTeam* Storage::getTeamById (const QString& teamID) const
+const BackendTeam* Storage::getTeamById (const MattermostId& teamID) const
 {
 	auto it = teams.find (teamID);
 
@@ -106,7 +107,7 @@ const BackendTeam* Storage::getTeamById (const QString& teamID) const
 }
 
 
-BackendChannel* Storage::getChannelById (const QString& channelID)
+BackendChannel* Storage::getChannelById (const MattermostId& channelID)
 {
 	auto it = channels.find (channelID);
 
@@ -114,10 +115,10 @@ BackendChannel* Storage::getChannelById (const QString& channelID)
 		return nullptr;
 	}
 
-	return *it;
+	return it->second;
 }
 
-BackendChannel* Storage::getDirectChannelByUserId (const QString& userID) const
+BackendChannel* Storage::getDirectChannelByUserId (const MattermostId& userID) const
 {
 	auto it = directChannelsByUser.find (userID);
 
@@ -125,21 +126,21 @@ BackendChannel* Storage::getDirectChannelByUserId (const QString& userID) const
 		return nullptr;
 	}
 
-	if ((*it)->type != BackendChannel::directChannel) {
+	if (it->second->type != BackendChannel::directChannel) {
 		return nullptr;
 	}
 
-	return *it;
+	return it->second;
 }
 
-const std::map<QString, BackendUser>& Storage::getAllUsers () const
+const IdHashMap<BackendUser>& Storage::getAllUsers () const
 {
 	return users;
 }
 
 BackendTeam* Storage::addTeam (const QJsonObject& json)
 {
-	QString teamId (json.value("id").toString());
+	MattermostId teamId (json.value("id").toString());
 
 	auto it = teams.find (teamId);
 
@@ -155,12 +156,10 @@ BackendChannel* Storage::addTeamScopeChannel (BackendTeam& team, const QJsonObje
 {
 	//get channel ID and channel type in order to check if a channel has to be created
 	uint32_t channelType = BackendChannel::getChannelType (json);
-	QString channelId = json.value("id").toString();
-
 	BackendChannel* newChannel;
 
 	if (channelType == BackendChannel::directChannel) {
-		LOG_DEBUG ("Storage::addNonDirectChannel called for direct channel " << newChannel->id << " " << newChannel->display_name);
+		LOG_DEBUG (storage, "Storage::addNonDirectChannel called for direct channel " << newChannel->id << " " << newChannel->display_name);
 		return nullptr;
 	}
 
@@ -178,7 +177,7 @@ BackendChannel* Storage::addDirectChannel (const QJsonObject& json)
 	 * a direct channel may appear multiple times. We create only one channel
 	 * instance for such duplicate channels and they are displayed only once
 	 */
-	QString channelId = json.value("id").toString();
+	MattermostId channelId (json.value("id").toString());
 
 	BackendChannel* existingChannel = getChannelById (channelId);
 
@@ -200,13 +199,13 @@ BackendChannel* Storage::addDirectChannel (const QJsonObject& json)
 	QStringList allUserIds = newChannel->name.split("__");
 
 	//allUserIds the logged-in user from this list
-	allUserIds.removeAll (loginUser->id);
+	allUserIds.removeAll (loginUser->id.toString());
 
 	QString userID;
 
 	//if the list is empty, the user has a chat with himself
 	if (allUserIds.isEmpty()) {
-		userID = loginUser->id;
+		userID = loginUser->id.toString();
 	} else {
 	//the remote user ID is the remaining id
 		userID = allUserIds.first();
@@ -223,7 +222,7 @@ BackendChannel* Storage::addDirectChannel (const QJsonObject& json)
 		newChannel->display_name = user->getDisplayName();
 		directChannels.members.push_back (user);
 	} else {
-		LOG_DEBUG ("Channel " << newChannel->id) << ": user name not found";
+		LOG_DEBUG (storage, "Channel " << newChannel->id << ": user name not found");
 		newChannel->display_name = userID;
 	}
 
@@ -241,7 +240,7 @@ BackendChannel* Storage::addGroupChannel (const QJsonObject& json)
 	 * a group channel may appear multiple times. We create only one channel
 	 * instance for such duplicate channels and they are displayed only once
 	 */
-	QString channelId = json.value("id").toString();
+	MattermostId channelId (json.value("id").toString());
 
 	BackendChannel* existingChannel = getChannelById (channelId);
 
@@ -274,7 +273,7 @@ BackendChannel* Storage::addGroupChannel (const QJsonObject& json)
 
 BackendUser* Storage::addUser (const QJsonObject& json, bool isLoggedInUser)
 {
-	QString userId (json.value("id").toString());
+	MattermostId userId (json.value("id").toString());
 
 	auto it = users.find (userId);
 
@@ -298,7 +297,7 @@ BackendUser* Storage::addUser (const QJsonObject& json, bool isLoggedInUser)
 	return user;
 }
 
-void Storage::eraseTeam (const QString& teamID)
+void Storage::eraseTeam (const MattermostId& teamID)
 {
 	auto teamIt = teams.find (teamID);
 
@@ -306,15 +305,15 @@ void Storage::eraseTeam (const QString& teamID)
 		auto& team = teamIt->second;
 		for (auto& it: team.channels) {
 
-			LOG_DEBUG ("Team Channel: " << it->id);
+			LOG_DEBUG (storage, "Team Channel: " << it->id);
 			auto channelIt = channels.find (it->id);
 
 			if (channelIt != channels.end()) {
-				LOG_DEBUG ("Erase Channel: " << channelIt.key() << " " << channelIt.value() << " " << channelIt.value()->name);
+				LOG_DEBUG (storage, "Erase Channel: " << channelIt->first << " " << channelIt->second << " " << channelIt->second->name);
 				channels.erase (channelIt);
 			}
 		}
-		LOG_DEBUG ("Erase Team: " << teamIt->first << " " << team.name);
+		LOG_DEBUG (storage, "Erase Team: " << teamIt->first << " " << team.name);
 		teams.erase (teamIt);
 	}
 }
@@ -328,7 +327,7 @@ void Storage::eraseChannel (BackendChannel& channel)
 			auto channelIt = channels.find (it->get()->id);
 
 			if (channelIt != channels.end()) {
-				LOG_DEBUG ("Erase Channel: " << channelIt.key() << " " << channelIt.value() << " " << channelIt.value()->name);
+				LOG_DEBUG (storage, "Erase Channel: " << channelIt->first << " " << channelIt->second << " " << channelIt->second->name);
 				channels.erase (channelIt);
 			}
 
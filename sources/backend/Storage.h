@@ -24,9 +24,8 @@
 
 #pragma once
 
-#include <QMap>
-#include <map>
 #include <QSharedPointer>
+#include "backend/IdHashMap.h"
 #include "backend/types/BackendUser.h"
 #include "backend/types/BackendTeam.h"
 #include "backend/types/BackendDirectChannelsTeam.h"
@@ -40,16 +39,16 @@ public:
 public:
 	void reset ();
 
-	BackendTeam* getTeamById (const QString& teamID);
-	const BackendTeam* getTeamById (const QString& teamID) const;
+	BackendTeam* getTeamById (const MattermostId& teamID);
+	const BackendTeam* getTeamById (const MattermostId& teamID) const;
 
-	BackendChannel* getChannelById (const QString& channelID);
-	BackendChannel* getDirectChannelByUserId (const QString& userID) const;
+	BackendChannel* getChannelById (const MattermostId& channelID);
+	BackendChannel* getDirectChannelByUserId (const MattermostId& userID) const;
 
-	const std::map<QString, BackendUser>& getAllUsers () const;
+	const IdHashMap<BackendUser>& getAllUsers () const;
 
-	BackendUser* getUserById (const QString& userID);
-	const BackendUser* getUserById (const QString& userID) const;
+	BackendUser* getUserById (const MattermostId& userID);
+	const BackendUser* getUserById (const MattermostId& userID) const;
 
 	/**
 	 * Get user's display name by given user ID.
@@ -58,7 +57,7 @@ public:
 	 * @param explainLoginUser if user is same as loginUser, the "(you)" string is appended to the name
 	 * @return user display name
 	 */
-	QString getUserDisplayNameByUserId (const QString& userID, bool explainLoginUser = false) const;
+	QString getUserDisplayNameByUserId (const MattermostId& userID, bool explainLoginUser = false) const;
 
 	BackendTeam* addTeam (const QJsonObject& json);
 
@@ -68,18 +67,18 @@ public:
 
 	BackendUser* addUser (const QJsonObject& json, bool isLoggedInUser = false);
 
-	void eraseTeam (const QString& teamID);
+	void eraseTeam (const MattermostId& teamID);
 
 	void eraseChannel (BackendChannel& channel);
 
 	void printTeams ();
 public:
-	std::map<QString, BackendTeam>					teams;
+	IdHashMap<BackendTeam>							teams;
 	BackendDirectChannelsTeam						directChannels;
 	BackendDirectChannelsTeam						groupChannels;
-	QMap<QString, BackendChannel*> 					channels;
-	QMap<QString, BackendChannel*> 					directChannelsByUser;
-	std::map<QString, BackendUser>					users;
+	IdHashMap<BackendChannel*>						channels;
+	IdHashMap<BackendChannel*>						directChannelsByUser;
+	IdHashMap<BackendUser>							users;
 	BackendUser*									loginUser;
 	BackendUser*									matterpollUser;
 	uint32_t										totalUsersCount;
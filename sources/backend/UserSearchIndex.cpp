@@ -0,0 +1,163 @@
+/**
+ * @file UserSearchIndex.cpp
+ * @brief
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "UserSearchIndex.h"
+
+#include <algorithm>
+#include "backend/types/BackendUser.h"
+
+namespace Mattermost {
+
+UserSearchIndex::UserSearchIndex (std::vector<const BackendUser*>&& users)
+:users (std::move (users))
+{
+	std::sort (this->users.begin(), this->users.end(), [] (const BackendUser* lhs, const BackendUser* rhs) {
+		return lhs->username < rhs->username;
+	});
+
+	//4 fields, most of them a single word
+	entries.reserve (this->users.size() * 4);
+
+	for (uint32_t i = 0; i < this->users.size(); ++i) {
+		const BackendUser* user = this->users[i];
+
+		addWords (user->username, i);
+		addWords (user->nickname, i);
+		addWords (user->first_name, i);
+		addWords (user->last_name, i);
+	}
+
+	std::sort (entries.begin(), entries.end(), [] (const Entry& lhs, const Entry& rhs) {
+		return lhs.word < rhs.word;
+	});
+
+	entries.shrink_to_fit ();
+}
+
+UserSearchIndex::~UserSearchIndex () = default;
+
+QString UserSearchIndex::fold (const QString& text)
+{
+	QString decomposed (text.normalized (QString::NormalizationForm_KD));
+	QString folded;
+
+	folded.reserve (decomposed.size());
+
+	for (const QChar& c: decomposed) {
+		if (!c.isMark()) {
+			folded.append (c.toCaseFolded());
+		}
+	}
+
+	return folded;
+}
+
+const std::vector<const BackendUser*>& UserSearchIndex::getUsers () const
+{
+	return users;
+}
+
+std::vector<uint32_t> UserSearchIndex::search (const QString& query) const
+{
+	std::vector<uint32_t> result;
+	bool first = true;
+
+	for (const QString& word: fold (query).split (' ')) {
+		if (word.isEmpty()) {
+			continue;
+		}
+
+		std::vector<uint32_t> matches (searchPrefix (word));
+
+		if (first) {
+			result = std::move (matches);
+			first = false;
+		} else {
+			std::vector<uint32_t> intersection;
+			std::set_intersection (result.begin(), result.end(), matches.begin(), matches.end(), std::back_inserter (intersection));
+			result = std::move (intersection);
+		}
+
+		if (result.empty()) {
+			return result;
+		}
+	}
+
+	//no words in the query
+	if (first) {
+		result.resize (users.size());
+
+		for (uint32_t i = 0; i < users.size(); ++i) {
+			result[i] = i;
+		}
+	}
+
+	return result;
+}
+
+/**
+ * A field is added as a whole, and each part after a separator is added as a separate word, so that
+ * 'john.smith' is found by 'john', 'smith' and 'john.s'
+ */
+void UserSearchIndex::addWords (const QString& text, uint32_t user)
+{
+	if (text.isEmpty()) {
+		return;
+	}
+
+	QString folded (fold (text));
+	bool wordStart = true;
+
+	for (int i = 0; i < folded.size(); ++i) {
+		if (!folded[i].isLetterOrNumber()) {
+			wordStart = true;
+			continue;
+		}
+
+		if (wordStart) {
+			entries.push_back (Entry {i == 0 ? folded : folded.mid (i), user});
+			wordStart = false;
+		}
+	}
+}
+
+std::vector<uint32_t> UserSearchIndex::searchPrefix (const QString& prefix) const
+{
+	auto it = std::lower_bound (entries.begin(), entries.end(), prefix, [] (const Entry& entry, const QString& prefix) {
+		return entry.word < prefix;
+	});
+
+	std::vector<uint32_t> matches;
+
+	for (; it != entries.end() && it->word.startsWith (prefix); ++it) {
+		matches.push_back (it->user);
+	}
+
+	//a user can have several words with the same prefix
+	std::sort (matches.begin(), matches.end());
+	matches.erase (std::unique (matches.begin(), matches.end()), matches.end());
+	return matches;
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,72 @@
+/**
+ * @file UserSearchIndex.h
+ * @brief Search of users by name prefix
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <vector>
+#include <QString>
+
+namespace Mattermost {
+
+class BackendUser;
+
+/**
+ * Index of a list of users for the user dialogs. The username, nickname, first and last name are folded
+ * (case and diacritics removed, see fold()) and split into words, which are kept in a sorted array. A query
+ * matches a user if each of its words is a prefix of one of the user's words, so a query word is a binary
+ * search and a walk over the matching entries, instead of a comparison with every user.
+ *
+ * The users are sorted by username. The index does not follow changes of the users - it is built for a dialog
+ * and dropped with it
+ */
+class UserSearchIndex {
+public:
+	explicit UserSearchIndex (std::vector<const BackendUser*>&& users);
+	~UserSearchIndex ();
+public:
+	/**
+	 * Case-fold the text and remove the diacritics (compatibility decomposition, without the combining marks)
+	 */
+	static QString fold (const QString& text);
+
+	const std::vector<const BackendUser*>& getUsers () const;
+
+	/**
+	 * Positions in getUsers() of the users, matching the query, in increasing order. All users for an empty query
+	 */
+	std::vector<uint32_t> search (const QString& query) const;
+private:
+	struct Entry {
+		QString		word;
+		uint32_t	user;
+	};
+
+	void addWords (const QString& text, uint32_t user);
+	std::vector<uint32_t> searchPrefix (const QString& prefix) const;
+private:
+	std::vector<const BackendUser*>		users;
+	std::vector<Entry>					entries;	//sorted by word
+};
+
+} /* namespace Mattermost */
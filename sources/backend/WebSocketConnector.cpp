@@ -27,8 +27,14 @@
 #include <iostream>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QElapsedTimer>
 
 #include "backend/WebSocketEventHandler.h"
+#include "Settings.h"
+#include "NetworkMetrics.h"
+#include "SessionRecorder.h"
+#include "log/Tracer.h"
+#include "log/LoadTestMonitor.h"
 #include "log.h"
 
 namespace Mattermost {
@@ -41,7 +47,7 @@ void handler (WebSocketConnector& conn, const QJsonObject& data, const QJsonObje
 
 static const QMap<QString, void(*)(WebSocketConnector&, const QJsonObject&, const QJsonObject&)> eventHandlers {
 	{"hello", [] (WebSocketConnector&, const QJsonObject&, const QJsonObject&) {
-		std::cout << "Hello" << std::endl;
+		LOG_DEBUG (websocket, "Hello");
 	}},
 	{"channel_viewed",		handler<ChannelViewedEvent>},
 	{"posted", 				handler<PostEvent>},
@@ -61,17 +67,18 @@ static const QMap<QString, void(*)(WebSocketConnector&, const QJsonObject&, cons
 	{"open_dialog",			handler<OpenDialogEvent>},				//a server-side dialog
 };
 
-WebSocketConnector::WebSocketConnector (WebSocketEventHandler& eventHandler)
+WebSocketConnector::WebSocketConnector (WebSocketEventHandler& eventHandler, NetworkMetrics& metrics)
 :eventHandler (eventHandler)
+,metrics (metrics)
 ,hasReconnect (false)
 {
-	connect (&webSocket, qOverload<QAbstractSocket::SocketError>(&QWebSocket::error), [this] (QAbstractSocket::SocketError error){
-		qDebug() << "WebSocket error " << error << " " << webSocket.errorString();
+	connect (&webSocket, qOverload<QAbstractSocket::SocketError>(&WebSocket::error), [this] (QAbstractSocket::SocketError error){
+		LOG_ERROR (websocket, "WebSocket error " << error << " " << webSocket.errorString());
 		doReconnect ();
 	});
 
-	connect(&webSocket, &QWebSocket::connected, [this] {
-		LOG_DEBUG ("WebSocket connected");
+	connect(&webSocket, &WebSocket::connected, [this] {
+		LOG_DEBUG (websocket, "WebSocket connected");
 		doHandshake ();
 
 		emit onConnect (hasReconnect);
@@ -80,13 +87,18 @@ WebSocketConnector::WebSocketConnector (WebSocketEventHandler& eventHandler)
 		pingTimer.start (5000);
 	});
 
-	connect(&webSocket, &QWebSocket::pong, [this]{
-		//LOG_DEBUG ("WebSocket pong");
+	connect(&webSocket, &WebSocket::pong, [this]{
+		//LOG_DEBUG (websocket, "WebSocket pong");
 		pongTimer.stop();
 	});
 
-	connect(&webSocket, &QWebSocket::disconnected, [this]{
-		LOG_DEBUG ("WebSocket disconnected: " << webSocket.closeCode() << " " << webSocket.closeReason());
+	connect(&webSocket, &WebSocket::disconnected, [this]{
+		LOG_DEBUG (websocket, "WebSocket disconnected: " << webSocket.closeCode() << " " << webSocket.closeReason());
+
+		if (simulatedLink) {
+			simulatedLink->clear ();
+		}
+
 		emit onDisconnect ();
 
 		//if the token is empty, this means that the disconnect was forced
@@ -95,17 +107,23 @@ WebSocketConnector::WebSocketConnector (WebSocketEventHandler& eventHandler)
 		}
 	});
 
-    connect(&webSocket, &QWebSocket::textMessageReceived, this, &WebSocketConnector::onNewPacket);
+    connect(&webSocket, &WebSocket::textMessageReceived, [this] (const QString& message) {
+		if (simulatedLink) {
+			simulatedLink->receive (message);
+		} else {
+			onNewPacket (message);
+		}
+	});
 
     connect (&pingTimer, &QTimer::timeout, [this] {
-		//LOG_DEBUG ("WebSocket send ping");
+		//LOG_DEBUG (websocket, "WebSocket send ping");
 		webSocket.ping ("ping");
 		pongTimer.start (4000);
 	});
 
     pongTimer.setSingleShot (true);
     connect (&pongTimer, &QTimer::timeout, [this] {
-		LOG_DEBUG ("WebSocket ping timeout. Reconnecting");
+		LOG_DEBUG (websocket, "WebSocket ping timeout. Reconnecting");
 		webSocket.close();
 	});
 }
@@ -115,11 +133,20 @@ WebSocketConnector::~WebSocketConnector () = default;
 void WebSocketConnector::open (const QString& urlString, const QString& token)
 {
 	QUrl url (urlString + "websocket");
-	url.setScheme("wss");
+	//plain HTTP is used only with local servers (the stand-in server, for example)
+	url.setScheme (url.scheme() == "http" ? "ws" : "wss");
 
 	//qDebug() << "WebSocket open: " << url << " " << token;
 
 	this->token = token;
+
+#if BUILD_WEBSOCKET_DEFLATE
+	QSettings settings;
+	webSocket.setCompressionEnabled (settings.value (WEBSOCKET_COMPRESSION, true).toBool());
+#else
+	compressionStats = WebSocketCompressionStats ();
+#endif
+
 	webSocket.open (url);
 }
 
@@ -139,7 +166,7 @@ void WebSocketConnector::doReconnect ()
 			return;
 		}
 
-		LOG_DEBUG ("WebSocket Reconnecting");
+		LOG_DEBUG (websocket, "WebSocket Reconnecting");
 		hasReconnect = true;
 		webSocket.open (webSocket.requestUrl());
 	});
@@ -158,7 +185,34 @@ void WebSocketConnector::doHandshake ()
 	});
 
 	QByteArray data = json.toJson(QJsonDocument::Compact);
-	webSocket.sendTextMessage (data);
+	sendMessage (data);
+	metrics.addWebSocketAction ("authentication_challenge", data.size());
+}
+
+void WebSocketConnector::setNetworkConditions (const NetworkConditions& conditions)
+{
+	if (conditions.isIdeal ()) {
+		simulatedLink.reset ();
+		return;
+	}
+
+	simulatedLink = std::make_unique<SimulatedWebSocketLink> (conditions);
+	connect (simulatedLink.get(), &SimulatedWebSocketLink::messageReceived, this, &WebSocketConnector::onNewPacket);
+	connect (simulatedLink.get(), &SimulatedWebSocketLink::messageSent, [this] (const QString& message) {
+		webSocket.sendTextMessage (message);
+	});
+	connect (simulatedLink.get(), &SimulatedWebSocketLink::disconnectRequested, [this] {
+		webSocket.close (QWebSocketProtocol::CloseCodeGoingAway, "Simulated disconnect");
+	});
+}
+
+void WebSocketConnector::sendMessage (const QString& message)
+{
+	if (simulatedLink) {
+		simulatedLink->send (message);
+	} else {
+		webSocket.sendTextMessage (message);
+	}
 }
 
 void WebSocketConnector::reset ()
@@ -168,6 +222,15 @@ void WebSocketConnector::reset ()
 	pongTimer.stop();
 }
 
+WebSocketCompressionStats WebSocketConnector::getCompressionStats () const
+{
+#if BUILD_WEBSOCKET_DEFLATE
+	return webSocket.compressionStats ();
+#else
+	return compressionStats;
+#endif
+}
+
 static bool printEvent (const QString& name)
 {
 	if (	name == "channel_viewed" 	||
@@ -184,7 +247,16 @@ static bool printEvent (const QString& name)
 
 void WebSocketConnector::onNewPacket (const QString& string)
 {
-	QJsonDocument doc = QJsonDocument::fromJson(string.toUtf8());
+	QByteArray data (string.toUtf8());
+
+#if !BUILD_WEBSOCKET_DEFLATE
+	compressionStats.receivedPayloadBytes += data.size();
+	compressionStats.receivedWireBytes += data.size();
+	++compressionStats.uncompressedMessages;
+#endif
+
+	TRACE_SCOPE (websocket, "WebSocketConnector::onNewPacket");
+	QJsonDocument doc = QJsonDocument::fromJson(data);
 
 	const QJsonObject& jsonObject = doc.object();
 
@@ -192,34 +264,44 @@ void WebSocketConnector::onNewPacket (const QString& string)
 	QJsonValue seqReply = jsonObject.value("seq_reply");
 
 	if (!seqReply.isUndefined()) {
-		std::cout << "got seqReply " << seqReply.toInt() << std::endl;
+		LOG_TRACE (websocket, "got seqReply " << seqReply.toInt());
+		metrics.addWebSocketEvent ("seq_reply", data.size(), 0);
 		return;
 	}
 
 	//event from server
 	QJsonValue event = jsonObject.value("event");
 
+	if (SessionRecorder::isEnabled () && event.toString() != "hello") {
+		SessionRecorder::instance().addWebSocketMessage (data);
+	}
+
 	auto it = eventHandlers.find(event.toString());
 
 
 	if (it == eventHandlers.end()) {
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
-		std::cout << jsonString.toStdString();
-
-		LOG_DEBUG ("Unhandled WebSocket event '" << event.toString() << "'\n");
-		qDebug() << "========" << '\n';
+		LOG_DEBUG (websocket, "Unhandled WebSocket event '" << event.toString() << "'");
+		LOG_TRACE (websocket, string);
+		metrics.addWebSocketEvent (event.toString(), data.size(), 0);
 		return;
 	}
 
 	if (printEvent (it.key())) {
-	qDebug() << "========" << '\n';
-		QString jsonString = doc.toJson(QJsonDocument::Indented);
-		std::cout << jsonString.toStdString();
+		LOG_TRACE (websocket, string);
 	}
 
+	QElapsedTimer timer;
+	timer.start ();
+	TRACE_SCOPE_DYNAMIC (websocket, "event " + it.key());
+
 	it.value() (*this, 	jsonObject.value ("data").toObject(),
 						jsonObject.value ("broadcast").toObject());
 
+	metrics.addWebSocketEvent (it.key(), data.size(), timer.nsecsElapsed() / 1000);
+
+	if (LoadTestMonitor::isEnabled ()) {
+		LoadTestMonitor::instance().addEvent (it.key(), jsonObject.value ("stand_in_sent_at").toVariant().toLongLong());
+	}
 
 //	if (obj.value("seq_reply")) {
 //
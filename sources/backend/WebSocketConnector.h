@@ -24,34 +24,61 @@
 
 #pragma once
 
+#include <memory>
 #include <QObject>
 #include <QTimer>
 #include <QtWebSockets/QWebSocket>
+#include "backend/DeflateWebSocket.h"
+#include "backend/NetworkSimulator.h"
 
 namespace Mattermost {
 
 class WebSocketEventHandler;
+class NetworkMetrics;
+
+#if BUILD_WEBSOCKET_DEFLATE
+using WebSocket = DeflateWebSocket;
+#else
+using WebSocket = QWebSocket;
+#endif
 
 class WebSocketConnector: public QObject {
 	Q_OBJECT
 public:
-	WebSocketConnector (WebSocketEventHandler& eventHandler);
+	WebSocketConnector (WebSocketEventHandler& eventHandler, NetworkMetrics& metrics);
 	virtual ~WebSocketConnector ();
 public:
 	void open (const QString& urlString, const QString& token);
 	void close ();
 	void reset ();
 	void doHandshake ();
+
+	/**
+	 * Simulate a slow or unreliable network for the WebSocket messages (see NetworkSimulator.h)
+	 */
+	void setNetworkConditions (const NetworkConditions& conditions);
+
+	/**
+	 * Compression counters for the current (or the last) WebSocket session.
+	 * Without permessage-deflate support, the payload and wire sizes are the same
+	 */
+	WebSocketCompressionStats getCompressionStats () const;
 signals:
 	void onConnect (bool isReconnect);
 	void onDisconnect ();
 private:
 	void onNewPacket (const QString& string);
 	void doReconnect ();
+	void sendMessage (const QString& message);
 public:
 	WebSocketEventHandler	&eventHandler;
 private:
-	QWebSocket 				webSocket;
+	NetworkMetrics&			metrics;
+	WebSocket 				webSocket;
+#if !BUILD_WEBSOCKET_DEFLATE
+	WebSocketCompressionStats	compressionStats;
+#endif
+	std::unique_ptr<SimulatedWebSocketLink>	simulatedLink;
 	QString					token;
 	QTimer					pingTimer;
 	QTimer					pongTimer;
@@ -43,7 +43,7 @@ WebSocketEventHandler::~WebSocketEventHandler () = default;
 void WebSocketEventHandler::handleEvent (const ChannelViewedEvent& event)
 {
 	BackendChannel* channel = storage.getChannelById (event.channelId);
-	QString channelName = channel ? channel->name : event.channelId;
+	QString channelName = channel ? channel->name : event.channelId.toString();
 
 	if (channel) {
 		emit channel->onViewed ();
@@ -54,7 +54,7 @@ void WebSocketEventHandler::handleEvent (const ChannelViewedEvent& event)
 void WebSocketEventHandler::handleEvent (const PostEvent& event)
 {
 	BackendTeam* team = storage.getTeamById (event.teamId);
-	QString teamName = team ? team->name : event.teamId;
+	QString teamName = team ? team->name : event.teamId.toString();
 
 	BackendChannel* channel = storage.getChannelById (event.channelId);
 
@@ -62,21 +62,32 @@ void WebSocketEventHandler::handleEvent (const PostEvent& event)
 		return;
 	}
 
-	QString channelName = channel ? channel->name : event.channelId;
+	QString channelName = channel ? channel->name : event.channelId.toString();
 
 	BackendPost* post = channel->addPost (event.postObject);
 
-	LOG_DEBUG ("Post in  '" << teamName << "' : '" << channelName << "' by " << post->getDisplayAuthorName() << ": " << post->message);
-	if (channel) {
+	//repeated event, or the post was already received with a page of posts
+	if (!post) {
+		return;
+	}
+
+	LOG_DEBUG (websocket, "Post in  '" << teamName << "' : '" << channelName << "' by " << post->getDisplayAuthorName() << ": " << post->getMessage());
+
+	//posts, which arrived out of order, are already added to the channel view by addPost()
+	if (post == channel->posts.back()) {
 		emit channel->onNewPost (*post);
-		emit backend.onNewPost (*channel, *post);
 	}
+
+	emit backend.onNewPost (*channel, *post);
+
+	//a reply to a post, which is not loaded
+	backend.scheduleMissingRootPosts ();
 }
 
 void WebSocketEventHandler::handleEvent (const PostEditedEvent& event)
 {
 	BackendTeam* team = storage.getTeamById (event.teamId);
-	QString teamName = team ? team->name : event.teamId;
+	QString teamName = team ? team->name : event.teamId.toString();
 
 	BackendChannel* channel = storage.getChannelById (event.channelId);
 
@@ -84,15 +95,14 @@ void WebSocketEventHandler::handleEvent (const PostEditedEvent& event)
 		return;
 	}
 
-	QString channelName = channel ? channel->name : event.channelId;
+	QString channelName = channel ? channel->name : event.channelId.toString();
 
-	BackendPost post (event.postObject, storage);
-	channel->editPost (post);
+	channel->editPost (event.postObject);
 
 #if 0
 	BackendPost* post = channel->addPost (event.postObject);
 
-	LOG_DEBUG ("Post edited in  '" << teamName << "' : '" << channelName << "' by " << post->getDisplayAuthorName() << ": " << post->message);
+	LOG_DEBUG (websocket, "Post edited in  '" << teamName << "' : '" << channelName << "' by " << post->getDisplayAuthorName() << ": " << post->getMessage());
 	if (channel) {
 		emit channel->onNewPost (*post);
 		emit backend.onNewPost (*channel, *post);
@@ -104,10 +114,10 @@ void WebSocketEventHandler::handleEvent (const PostDeletedEvent& event)
 {
 	BackendChannel* channel = storage.getChannelById (event.channelId);
 
-	LOG_DEBUG ("Delete post in  '" << (channel ? channel->name : event.channelId) << "' : '" << event.postId);
+	LOG_DEBUG (websocket, "Delete post in  '" << (channel ? channel->name : event.channelId.toString()) << "' : '" << event.postId);
 
 	if (channel) {
-		emit channel->onPostDeleted (event.postId);
+		channel->deletePost (event.postObject);
 	}
 }
 
@@ -122,7 +132,7 @@ void WebSocketEventHandler::handleEvent (const PostReactionAddedEvent& event)
 
 	channel->addPostReaction (event.postId, event.userId, event.emojiName);
 
-	LOG_DEBUG ("Reaction added " << event.emojiName << " from " << event.userId << " for post " << event.postId);
+	LOG_DEBUG (websocket, "Reaction added " << event.emojiName << " from " << event.userId << " for post " << event.postId);
 }
 
 void WebSocketEventHandler::handleEvent (const PostReactionRemovedEvent& event)
@@ -135,7 +145,7 @@ void WebSocketEventHandler::handleEvent (const PostReactionRemovedEvent& event)
 
 	channel->removePostReaction (event.postId, event.userId, event.emojiName);
 
-	LOG_DEBUG ("Reaction removed " << event.emojiName << " from " << event.userId << " for post " << event.postId);
+	LOG_DEBUG (websocket, "Reaction removed " << event.emojiName << " from " << event.userId << " for post " << event.postId);
 }
 
 
@@ -160,21 +170,21 @@ void WebSocketEventHandler::handleEvent (const StatusChangeEvent& event)
 		return;
 	}
 
-	LOG_DEBUG ("User " << user->getDisplayName() << " is " << event.statusString);
+	LOG_DEBUG (websocket, "User " << user->getDisplayName() << " is " << event.statusString);
 	user->status = event.statusString;
 	emit (user->onStatusChanged());
 }
 
 void WebSocketEventHandler::handleEvent (const NewDirectChannelEvent& event)
 {
-	LOG_DEBUG ("New Direct channel " << event.channelId << " created by: " << event.userId);
+	LOG_DEBUG (websocket, "New Direct channel " << event.channelId << " created by: " << event.userId);
 	backend.retrieveDirectChannel (event.channelId);
 }
 
 void WebSocketEventHandler::handleEvent (const UserAddedToChannelEvent& event)
 {
 	BackendTeam* team = storage.getTeamById (event.teamId);
-	QString teamName = team ? team->name : event.teamId;
+	QString teamName = team ? team->name : event.teamId.toString();
 
 	BackendChannel* channel = storage.getChannelById (event.channelId);
 
@@ -188,17 +198,24 @@ void WebSocketEventHandler::handleEvent (const UserAddedToChannelEvent& event)
 		backend.retrieveUser (event.userId, [] (BackendUser&){});
 	}
 
-	LOG_DEBUG ("User " << event.userId << " added to channel " << event.channelId << " of team " << teamName);
+	//if the members are not loaded, the new member comes with them
+	if (channel && channel->membersLoaded) {
+		BackendChannelMember member (QJsonObject {{"user_id", event.userId.toString()}});
+		member.user = user;
+		channel->addMember (std::move (member));
+	}
+
+	LOG_DEBUG (websocket, "User " << event.userId << " added to channel " << event.channelId << " of team " << teamName);
 }
 
 void WebSocketEventHandler::handleEvent (const UserAddedToTeamEvent& event)
 {
 	BackendTeam* team = storage.getTeamById (event.team_id);
-	QString teamName = team ? team->name : event.team_id;
-	LOG_DEBUG ("User " << event.user_id << " added to team: " << teamName);
+	QString teamName = team ? team->name : event.team_id.toString();
+	LOG_DEBUG (websocket, "User " << event.user_id << " added to team: " << teamName);
 
 	if (!team) {
-		LOG_DEBUG ("UserAddedToTeamEvent: No team " << teamName << " found. The team will be retrieved");
+		LOG_DEBUG (websocket, "UserAddedToTeamEvent: No team " << teamName << " found. The team will be retrieved");
 		backend.retrieveTeam (event.team_id);
 		return;
 	}
@@ -207,8 +224,10 @@ void WebSocketEventHandler::handleEvent (const UserAddedToTeamEvent& event)
 	if (event.user_id == storage.loginUser->id) {
 		//Adds the new team. It's channels and messages in channels will be obtained too
 		backend.retrieveTeam (event.team_id);
-	} else {
-#warning "TODO: Add the new user (memeber) to the team"
+	} else if (team->membersLoaded) {
+		BackendTeamMember member (QJsonObject {{"team_id", event.team_id.toString()}, {"user_id", event.user_id.toString()}});
+		member.user = storage.getUserById (event.user_id);
+		team->addMember (std::move (member));
 	}
 
 }
@@ -216,12 +235,12 @@ void WebSocketEventHandler::handleEvent (const UserAddedToTeamEvent& event)
 void WebSocketEventHandler::handleEvent (const UserLeaveTeamEvent& event)
 {
 	BackendTeam* team = storage.getTeamById (event.team_id);
-	QString teamName = team ? team->name : event.team_id;
+	QString teamName = team ? team->name : event.team_id.toString();
 
 	BackendUser* user = storage.getUserById (event.user_id);
-	QString userName = user ? user->getDisplayName() : event.user_id;
+	QString userName = user ? user->getDisplayName() : event.user_id.toString();
 
-	LOG_DEBUG ("User " << event.user_id << " left team: " << teamName);
+	LOG_DEBUG (websocket, "User " << event.user_id << " left team: " << teamName);
 
 	if (!team || !user) {
 		return;
@@ -236,7 +255,7 @@ void WebSocketEventHandler::handleEvent (const UserLeaveTeamEvent& event)
 		emit (team->onLeave());
 		storage.eraseTeam (team->id);
 	} else {
-#warning "TODO: Remove user from the team"
+		team->removeMember (user->id);
 	}
 	//printTeams ();
 }
@@ -246,7 +265,7 @@ void WebSocketEventHandler::handleEvent (const UserRemovedFromChannelEvent& even
 	BackendChannel* channel = storage.getChannelById (event.channelId);
 	BackendUser* user = storage.getUserById (event.userId);
 
-	LOG_DEBUG ("User " << event.userId << " left channel: " << event.channelId);
+	LOG_DEBUG (websocket, "User " << event.userId << " left channel: " << event.channelId);
 
 	if (!channel || !user) {
 		return;
@@ -256,15 +275,18 @@ void WebSocketEventHandler::handleEvent (const UserRemovedFromChannelEvent& even
 	if (user->id == storage.loginUser->id) {
 		emit channel->onLeave ();
 		storage.eraseChannel (*channel);
+		return;
 	}
+
+	channel->removeMember (user->id);
 }
 
 void WebSocketEventHandler::handleEvent (const ChannelCreatedEvent& event)
 {
 	BackendTeam* team = storage.getTeamById (event.teamId);
-	QString teamName = team ? team->name : event.teamId;
+	QString teamName = team ? team->name : event.teamId.toString();
 
-	LOG_DEBUG ("Channel created: " << event.channelId << " in team: " << teamName);
+	LOG_DEBUG (websocket, "Channel created: " << event.channelId << " in team: " << teamName);
 
 	if (!team) {
 		return;
@@ -281,7 +303,7 @@ void WebSocketEventHandler::handleEvent (const ChannelUpdatedEvent& event)
 		return;
 	}
 
-	LOG_DEBUG ("Channel updated: " << channel->display_name);
+	LOG_DEBUG (websocket, "Channel updated: " << channel->display_name);
 
 	channel->display_name = event.displayName;
 	channel->name = event.name;
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QJsonObject>
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -33,8 +34,8 @@ public:
 	ChannelCreatedEvent (const QJsonObject& object, const QJsonObject&);
 	virtual ~ChannelCreatedEvent ();
 public:
-	QString channelId;
-	QString teamId;
+	MattermostId channelId;
+	MattermostId teamId;
 };
 
 } /* namespace Mattermost */
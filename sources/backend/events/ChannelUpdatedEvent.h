@@ -26,6 +26,7 @@
 
 #include <QJsonObject>
 #include "backend/types/BackendChannel.h"
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -34,7 +35,7 @@ public:
 	ChannelUpdatedEvent (const QJsonObject& object, const QJsonObject&);
 	virtual ~ChannelUpdatedEvent ();
 public:
-	QString channelID;
+	MattermostId channelID;
 	QString	displayName;
 	QString	name;
 	QString	header;
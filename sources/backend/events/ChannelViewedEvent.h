@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QJsonObject>
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -33,7 +34,7 @@ public:
 	ChannelViewedEvent (const QJsonObject& object, const QJsonObject&);
 	virtual ~ChannelViewedEvent ();
 public:
-	QString channelId;
+	MattermostId channelId;
 };
 
 } /* namespace Mattermost */
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QJsonObject>
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -33,8 +34,8 @@ public:
 	NewDirectChannelEvent (const QJsonObject& data, const QJsonObject& broadcast);
 	virtual ~NewDirectChannelEvent ();
 public:
-	QString		channelId;
-	QString		userId;
+	MattermostId	channelId;
+	MattermostId	userId;
 };
 
 } /* namespace Mattermost */
@@ -29,8 +29,9 @@ namespace Mattermost {
 
 PostDeletedEvent::PostDeletedEvent (const QJsonObject& data, const QJsonObject& broadcast)
 :channelId (broadcast.value ("channel_id").toString())
-,postId (QJsonDocument::fromJson (data.value ("post").toString().toUtf8()).object().value ("id").toString())
+,postObject (QJsonDocument::fromJson (data.value ("post").toString().toUtf8()).object())
 {
+	postId = postObject.value ("id").toString();
 
 }
 
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QJsonObject>
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -33,8 +34,9 @@ public:
 	PostDeletedEvent (const QJsonObject& data, const QJsonObject& broadcast);
 	virtual ~PostDeletedEvent ();
 public:
-	QString		channelId;
-	QString		postId;
+	MattermostId	channelId;
+	MattermostId	postId;
+	QJsonObject		postObject;
 };
 
 } /* namespace Mattermost */
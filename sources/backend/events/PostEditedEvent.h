@@ -26,6 +26,7 @@
 
 #include <QString>
 #include <QJsonObject>
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -34,9 +35,9 @@ public:
 	PostEditedEvent (const QJsonObject& data, const QJsonObject& broadcast);
 	virtual ~PostEditedEvent ();
 public:
-	QString		teamId;
-	QString		channelId;
-	QJsonObject	postObject;
+	MattermostId	teamId;
+	MattermostId	channelId;
+	QJsonObject		postObject;
 };
 
 } /* namespace Mattermost */
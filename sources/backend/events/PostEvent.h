@@ -26,6 +26,7 @@
 
 #include <QString>
 #include <QJsonObject>
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -34,10 +35,10 @@ public:
 	PostEvent (const QJsonObject& data, const QJsonObject& broadcast);
 	virtual ~PostEvent ();
 public:
-	QString		teamId;
-	QString		channelId;
-	QJsonObject	postObject;
-	bool		set_online;
+	MattermostId	teamId;
+	MattermostId	channelId;
+	QJsonObject		postObject;
+	bool			set_online;
 };
 
 } /* namespace Mattermost */
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QJsonObject>
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -33,9 +34,9 @@ public:
 	PostReactionAddedEvent (const QJsonObject& data, const QJsonObject& broadcast);
 	virtual ~PostReactionAddedEvent ();
 public:
-	QString	channelId;
-	QString userId;
-	QString postId;
+	MattermostId channelId;
+	MattermostId userId;
+	MattermostId postId;
 	QString emojiName;
 };
 
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <QJsonObject>
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -34,8 +35,8 @@ public:
 	StatusChangeEvent (const QJsonObject& data, const QJsonObject&);
 	virtual ~StatusChangeEvent ();
 public:
-	QString		userId;
-	QString		statusString;
+	MattermostId	userId;
+	QString			statusString;
 };
 
 } /* namespace Mattermost */
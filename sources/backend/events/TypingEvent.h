@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QJsonObject>
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -33,8 +34,8 @@ public:
 	TypingEvent (const QJsonObject& data, const QJsonObject& broadcast);
 	virtual ~TypingEvent ();
 public:
-	QString		channel_id;
-	QString		user_id;
+	MattermostId	channel_id;
+	MattermostId	user_id;
 };
 
 } /* namespace Mattermost */
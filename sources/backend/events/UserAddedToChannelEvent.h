@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QJsonObject>
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -33,9 +34,9 @@ public:
 	UserAddedToChannelEvent (const QJsonObject& data, const QJsonObject& broadcast);
 	virtual ~UserAddedToChannelEvent ();
 public:
-	QString userId;
-	QString channelId;
-	QString teamId;
+	MattermostId userId;
+	MattermostId channelId;
+	MattermostId teamId;
 };
 
 } /* namespace Mattermost */
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QJsonObject>
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -33,8 +34,8 @@ public:
 	UserRemovedFromChannelEvent (const QJsonObject& data, const QJsonObject& broadcast);
 	virtual ~UserRemovedFromChannelEvent ();
 public:
-	QString userId;
-	QString channelId;
+	MattermostId userId;
+	MattermostId channelId;
 };
 
 } /* namespace Mattermost */
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QJsonObject>
+#include "backend/types/MattermostId.h"
 
 namespace Mattermost {
 
@@ -33,8 +34,8 @@ public:
 	UserTeamEvent (const QJsonObject& object, const QJsonObject&);
 	virtual ~UserTeamEvent ();
 public:
-	QString team_id;
-	QString user_id;
+	MattermostId team_id;
+	MattermostId user_id;
 };
 
 class UserAddedToTeamEvent: public UserTeamEvent {
@@ -22,6 +22,8 @@
  * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
  */
 
+#include <algorithm>
+#include <cstdint>
 #include <QJsonObject>
 #include <QDebug>
 #include <QJsonArray>
@@ -90,229 +92,645 @@ BackendChannel::BackendChannel (Storage& storage, const QJsonObject& jsonObject)
 	scheme_id = jsonObject.value("scheme_id").toVariant();
 	props = jsonObject.value("props").toVariant();
 	referenceCount = 1;
+	historyGeneration = 0;
+	lastActiveAt = 0;
+	membersLoaded = false;
 }
 
 BackendChannel::~BackendChannel () = default;
 
-BackendPost* BackendChannel::addPost (const QJsonObject& postObject)
+bool BackendChannel::postOrder (const BackendPost* left, const BackendPost* right)
+{
+	return left->create_at < right->create_at || (left->create_at == right->create_at && left->id < right->id);
+}
+
+size_t BackendChannel::findPostPosition (const BackendPost& post) const
 {
-	posts.emplace_back (postObject, storage);
+	return std::lower_bound (posts.begin(), posts.end(), &post, postOrder) - posts.begin();
+}
 
-	BackendPost* newPost = &posts.back ();
+BackendPost* BackendChannel::createPost (const QJsonObject& postObject)
+{
+	BackendPost* newPost = postArena.createPost (postObject, storage);
 	newPost->author = storage.getUserById (newPost->user_id);
-	postIdToPost[newPost->id] = newPost;
 	return newPost;
 }
 
-void BackendChannel::addPost (const QJsonObject& postObject, std::list<BackendPost>::iterator position, ChannelNewPostsChunk& currentChunk, QVector<QPair<QString, QString>>& rootIdAndPostList, bool initialLoad)
+void BackendChannel::attachPost (BackendPost* post)
 {
-	/*
-	 * Add a post.
-	 * And add added post to the list of new posts
-	 */
-	BackendPost* newPost = &*posts.emplace(position, postObject, storage);
-	newPost->author = storage.getUserById (newPost->user_id);
-	postIdToPost[newPost->id] = newPost;
+	//new posts are the newest almost always, so the search is skipped for them
+	if (posts.empty() || postOrder (posts.back(), post)) {
+		posts.push_back (post);
+	} else {
+		posts.insert (std::upper_bound (posts.begin(), posts.end(), post, postOrder), post);
+	}
 
-	currentChunk.postsToAdd.emplace_front (newPost);
+	postIdToPost[post->id] = post;
+}
 
-	QString rootId = postObject.value("root_id").toString();
+BackendPost* BackendChannel::addDetachedPost (const QJsonObject& postObject)
+{
+	MattermostId postId (postObject.value("id").toString());
+	BackendPost* post = findPostById (postId);
 
-	if (!rootId.isEmpty()) {
-		rootIdAndPostList.push_back(QPair<QString,QString> (rootId, newPost->id));
+	if (post) {
+		return post;
 	}
 
-	if (!initialLoad) {
-		qDebug() << newPost->create_at << " " << newPost->id << " " << newPost->getDisplayAuthorName() << " " << newPost->message;
+	post = createPost (postObject);
+	detachedPosts[post->id] = post;
+	indexThread (*post);
+	return post;
+}
+
+void BackendChannel::indexThread (BackendPost& post)
+{
+	if (!post.root_id.isEmpty()) {
+		std::vector<BackendPost*>& replies = threadReplies[post.root_id];
+		replies.insert (std::upper_bound (replies.begin(), replies.end(), &post, postOrder), &post);
+
+		post.rootPost = findPostById (post.root_id);
+
+		//fetched by Backend with the missing roots of all channels, in one request
+		if (!post.rootPost && requestedRootIds.insert (post.root_id)) {
+			missingRootIds.push_back (post.root_id);
+		}
+	}
+
+	//replies, which were received before their root post
+	auto it = threadReplies.find (post.id);
+
+	if (it == threadReplies.end()) {
+		return;
+	}
+
+	bool hadMissingRoot = false;
+
+	for (BackendPost* reply: it->second) {
+		if (!reply->rootPost) {
+			reply->rootPost = &post;
+			hadMissingRoot = true;
+		}
+	}
+
+	if (hadMissingRoot) {
+		emit onRootPostLoaded (post);
 	}
 }
 
+BackendChannel::UpsertResult BackendChannel::updatePost (BackendPost& post, const QJsonObject& postObject)
+{
+	uint64_t updateAt = postObject.value("update_at").toVariant().toULongLong();
+	uint64_t deleteAt = postObject.value("delete_at").toVariant().toULongLong();
+
+	//the post is kept as a tombstone, so that a late edit does not bring it back
+	if (post.isDeleted) {
+		return UpsertResult::unchanged;
+	}
+
+	if (deleteAt) {
+		post.delete_at = deleteAt;
+		post.update_at = std::max (post.update_at, updateAt);
+		post.isDeleted = true;
+		return UpsertResult::deleted;
+	}
+
+	//the same or an older version of the post (a repeated event, or an overlapping page)
+	if (updateAt <= post.update_at) {
+		return UpsertResult::unchanged;
+	}
+
+	//the texts of the edited post are stored in the channel's arena, so that the existing post can take them
+	{
+		BackendPost newPost (postObject, storage, postArena);
+		post.updatePostEdits (newPost, postArena);
+	}
 
-void BackendChannel::prependPosts (const QJsonArray& orderArray, const QJsonObject& postsObject)
+	postArena.reclaimUnusedTexts ();
+	return UpsertResult::updated;
+}
+
+BackendChannel::UpsertResult BackendChannel::upsertPost (const QJsonObject& postObject, BackendPost*& post)
 {
-	/*
-	 * A list of (sequential) groups of new posts
-	 */
-	ChannelNewPosts allNewPosts;
+	MattermostId postId (postObject.value("id").toString());
 
-	/*
-	 * A sequential group of new posts
-	 */
-	ChannelNewPostsChunk currentNewPostsChunk;
+	auto windowIt = postIdToPost.find (postId);
 
-	QVector<QPair<QString, QString>> rootIdAndPostList;
+	if (windowIt != postIdToPost.end()) {
+		post = windowIt->second;
+		return updatePost (*post, postObject);
+	}
 
-	bool initialLoad = true;
+	//a deleted post, which was never shown, has nothing to display
+	if (postObject.value("delete_at").toVariant().toULongLong()) {
+		post = nullptr;
+		return UpsertResult::unchanged;
+	}
 
-	//add all posts to the beginning of the posts list
-	for (const auto& newPostEl: orderArray) {
-		QString newPostId = newPostEl.toString();
-		addPost (postsObject.find (newPostId).value().toObject(), posts.begin (), currentNewPostsChunk, rootIdAndPostList, initialLoad);
+	//the post is known from a thread, and is now in the loaded history. It keeps its address, so the replies still point to it
+	auto detachedIt = detachedPosts.find (postId);
+
+	if (detachedIt != detachedPosts.end()) {
+		post = detachedIt->second;
+		detachedPosts.erase (detachedIt);
+		attachPost (post);
+		updatePost (*post, postObject);
+		return UpsertResult::added;
 	}
 
-	//if there are new posts left, add them to allMissingPosts
-	if (!currentNewPostsChunk.postsToAdd.empty()) {
-		allNewPosts.addChunk (std::move (currentNewPostsChunk));
+	post = createPost (postObject);
+	attachPost (post);
+	indexThread (*post);
+	return UpsertResult::added;
+}
+
+std::vector<MattermostId> BackendChannel::takeMissingRootIds ()
+{
+	std::vector<MattermostId> rootIds;
+
+	for (const MattermostId& rootId: missingRootIds) {
+		//may have arrived since, with a page of posts or a thread
+		if (!findPostById (rootId)) {
+			rootIds.push_back (rootId);
+		}
 	}
 
-	emit onNewPosts (allNewPosts);
+	missingRootIds.clear ();
+	return rootIds;
 }
 
-void BackendChannel::addPosts (const QJsonArray& orderArray, const QJsonObject& postsObject)
+void BackendChannel::requeueMissingRootIds (const std::vector<MattermostId>& rootIds)
 {
-	/*
-	 * A list of (sequential) groups of new posts
-	 */
-	ChannelNewPosts allNewPosts;
+	for (const MattermostId& rootId: rootIds) {
+		if (findPostById (rootId) || std::find (missingRootIds.begin(), missingRootIds.end(), rootId) != missingRootIds.end()) {
+			continue;
+		}
 
-	/*
-	 * A sequential group of new posts
-	 */
-	ChannelNewPostsChunk currentNewPostsChunk;
+		//the set may have been cleared by trimHistory() meanwhile
+		requestedRootIds.insert (rootId);
+		missingRootIds.push_back (rootId);
+	}
+}
 
-	QVector<QPair<QString, QString>> rootIdAndPostList;
+void BackendChannel::addThreadPosts (const MattermostId& rootId, const QJsonArray& orderArray, const QJsonObject& postsObject)
+{
+	for (const auto& postEl: orderArray) {
+		QJsonObject postObject (postsObject.value (postEl.toString()).toObject());
+		BackendPost* post = findPostById (postEl.toString());
 
-	//search local posts from newest to oldest
-	std::list<BackendPost>::reverse_iterator currentLocalPost = posts.rbegin();
+		if (!post) {
+			addDetachedPost (postObject);
+		} else if (updatePost (*post, postObject) == UpsertResult::updated) {
+			emit onPostEdited (*post);
+		}
+	}
 
-#warning "Handle case of deleted post, that is not deleted locally"
+	emit onThreadLoaded (rootId);
+}
 
-	bool initialLoad = (posts.empty());
-	bool lastPostWasSkipped = false;
+std::vector<BackendPost*> BackendChannel::getThread (const MattermostId& rootId)
+{
+	std::vector<BackendPost*> thread;
+	BackendPost* rootPost = findPostById (rootId);
+
+	if (rootPost) {
+		thread.push_back (rootPost);
+	}
 
-	int i = 0;
+	auto it = threadReplies.find (rootId);
 
-	for (const auto& newPostEl: orderArray) {
+	if (it != threadReplies.end()) {
+		thread.insert (thread.end(), it->second.begin(), it->second.end());
+	}
+
+	return thread;
+}
+
+BackendPost* BackendChannel::addPost (const QJsonObject& postObject)
+{
+	BackendPost* post;
+
+	if (upsertPost (postObject, post) != UpsertResult::added) {
+		LOG_DEBUG (storage, "Channel " << display_name << ": post " << postObject.value("id").toString() << " is already known");
+		return nullptr;
+	}
+
+	//arrived out of order - insert it between the existing posts
+	if (post != posts.back()) {
+		size_t position = findPostPosition (*post);
+		post->gapBefore = posts[position + 1]->gapBefore;
+		emitNewPost (*post);
+	} else {
+		post->gapBefore = false;
+	}
 
-		++i;
+	return post;
+}
 
-		QString newPostId = newPostEl.toString();
+BackendPost* BackendChannel::addAnchorPost (const QJsonObject& postObject)
+{
+	BackendPost* post;
+
+	switch (upsertPost (postObject, post)) {
+	case UpsertResult::added: {
+		//inside a gap, so it is not adjacent to any of the loaded posts, unless they are contiguous around it
+		size_t position = findPostPosition (*post);
+		post->gapBefore = position + 1 < posts.size() ? posts[position + 1]->gapBefore : true;
+		emitNewPost (*post);
+		break;
+	}
+	case UpsertResult::updated:
+		emit onPostEdited (*post);
+		break;
+	case UpsertResult::deleted:
+		emit onPostDeleted (post->id);
+		break;
+	case UpsertResult::unchanged:
+		break;
+	}
+
+	return post;
+}
 
-		//if a post is deleted, it will exist locally, but will not exist in the list of received post
-		while (currentLocalPost != posts.rend() && currentLocalPost->isDeleted) {
-			++currentLocalPost;
+bool BackendChannel::isPostLoaded (const MattermostId& postId) const
+{
+	return postIdToPost.find (postId) != postIdToPost.end();
+}
+
+void BackendChannel::emitNewPost (BackendPost& post)
+{
+	ChannelNewPostsChunk chunk;
+	size_t position = findPostPosition (post);
+
+	if (position > 0) {
+		chunk.previousPostId = posts[position - 1]->id;
+	}
+
+	chunk.postsToAdd.push_back (&post);
+
+	ChannelNewPosts newPosts;
+	newPosts.addChunk (std::move (chunk));
+	emit onNewPosts (newPosts);
+}
+
+void BackendChannel::addPosts (const QJsonArray& orderArray, const QJsonObject& postsObject)
+{
+	mergePosts (orderArray, postsObject, MattermostId (), MattermostId ());
+}
+
+void BackendChannel::addPostsBefore (const MattermostId& postId, const QJsonArray& orderArray, const QJsonObject& postsObject)
+{
+	mergePosts (orderArray, postsObject, postId, MattermostId ());
+}
+
+void BackendChannel::addPostsAfter (const MattermostId& postId, const QJsonArray& orderArray, const QJsonObject& postsObject)
+{
+	mergePosts (orderArray, postsObject, MattermostId (), postId);
+}
+
+void BackendChannel::mergePosts (const QJsonArray& orderArray, const QJsonObject& postsObject, const MattermostId& beforePostId, const MattermostId& afterPostId)
+{
+	std::vector<BackendPost*> addedPosts;
+	std::vector<BackendPost*> updatedPosts;
+	std::vector<MattermostId> deletedPosts;
+
+	//the creation time range of the page. The page is contiguous, so any local post inside it, which is not in the page, was deleted
+	uint64_t pageOldest = UINT64_MAX;
+	uint64_t pageNewest = 0;
+
+	//the oldest and the newest posts of the page, which are in the loaded history
+	BackendPost* pageOldestPost = nullptr;
+	BackendPost* pageNewestPost = nullptr;
+
+	for (const auto& newPostEl: orderArray) {
+		QJsonObject postObject (postsObject.value (newPostEl.toString()).toObject());
+		BackendPost* post;
+
+		switch (upsertPost (postObject, post)) {
+		case UpsertResult::added:
+			addedPosts.push_back (post);
+			break;
+		case UpsertResult::updated:
+			updatedPosts.push_back (post);
+			break;
+		case UpsertResult::deleted:
+			deletedPosts.push_back (post->id);
+			break;
+		case UpsertResult::unchanged:
+			break;
 		}
 
-		//end of local posts list. Save the current missing post sequence and add all missing posts
-		if (currentLocalPost == posts.rend()) {
-			addPost (postsObject.find (newPostId).value().toObject(), posts.begin (), currentNewPostsChunk, rootIdAndPostList, initialLoad);
-			++currentLocalPost;
-			continue;
+		uint64_t createAt = postObject.value("create_at").toVariant().toULongLong();
+		pageOldest = std::min (pageOldest, createAt);
+		pageNewest = std::max (pageNewest, createAt);
+
+		if (post) {
+			if (!pageOldestPost || postOrder (post, pageOldestPost)) {
+				pageOldestPost = post;
+			}
+
+			if (!pageNewestPost || postOrder (pageNewestPost, post)) {
+				pageNewestPost = post;
+			}
 		}
+	}
 
-		//post already exists. No need to be added. Save the current missing posts chunk and start a new one
-		if (currentLocalPost->id == newPostId) {
-			++currentLocalPost;
+	/*
+	 * Posts, deleted while the WebSocket was disconnected, are not in the page. The oldest creation time
+	 * is excluded, because the page may end between posts with the same time
+	 */
+	if (!orderArray.isEmpty()) {
+		auto it = std::upper_bound (posts.begin(), posts.end(), pageOldest, [] (uint64_t createAt, const BackendPost* post) {
+			return createAt < post->create_at;
+		});
 
-			if (lastPostWasSkipped) {
-				currentNewPostsChunk.previousPostId = newPostId;
-				allNewPosts.addChunk (std::move (currentNewPostsChunk));
-				lastPostWasSkipped = false;
+		for (; it != posts.end() && (*it)->create_at <= pageNewest; ++it) {
+			BackendPost* post = *it;
+
+			if (!post->isDeleted && !postsObject.contains (post->id.toString())) {
+				post->isDeleted = true;
+				deletedPosts.push_back (post->id);
 			}
-			continue;
 		}
+	}
 
-		//post not found. Add it to the list of new posts
-		qDebug () << "Add after currentLocalPost";
-		addPost (postsObject.find (newPostId).value().toObject(), currentLocalPost.base(), currentNewPostsChunk, rootIdAndPostList, initialLoad);
-		++currentLocalPost;
-		lastPostWasSkipped = true;
+	/*
+	 * The page is contiguous, and so is it with the post it was requested for. An empty page means that there
+	 * are no more posts in that direction. Posts after the newest page are from the WebSocket, so they follow it
+	 */
+	size_t contiguousFrom = SIZE_MAX;
+	size_t contiguousTo = 0;
+
+	if (pageOldestPost) {
+		contiguousFrom = findPostPosition (*pageOldestPost) + 1;
+		contiguousTo = findPostPosition (*pageNewestPost);
 	}
 
-	//if there are new posts left, add them to allMissingPosts
-	if (!currentNewPostsChunk.postsToAdd.empty()) {
-		if (currentLocalPost != posts.rend()) {
-			currentNewPostsChunk.previousPostId = currentLocalPost->id;
+	if (!beforePostId.isEmpty()) {
+		auto it = postIdToPost.find (beforePostId);
+
+		if (it != postIdToPost.end()) {
+			contiguousTo = findPostPosition (*it->second);
+			contiguousFrom = pageOldestPost ? contiguousFrom : contiguousTo;
 		}
-		allNewPosts.addChunk (std::move (currentNewPostsChunk));
+	} else if (!afterPostId.isEmpty()) {
+		auto it = postIdToPost.find (afterPostId);
+
+		if (it != postIdToPost.end()) {
+			contiguousFrom = findPostPosition (*it->second) + 1;
+			contiguousTo = pageOldestPost ? contiguousTo : posts.size() - 1;
+		}
+	} else if (pageOldestPost) {
+		contiguousTo = posts.size() - 1;
 	}
 
-	/**
-	 * Associate post with a root ID (if exists)
+	for (size_t i = contiguousFrom; i <= contiguousTo && i < posts.size(); ++i) {
+		posts[i]->gapBefore = false;
+	}
+
+	/*
+	 * Group the added posts in ranges of adjacent posts, so that each range is inserted in the view at once.
+	 * The ranges are collected from the newest, as addChunk() inserts at the front
 	 */
-	for (auto& it: rootIdAndPostList) {
-		QString& rootID = it.first;
-		QString& postID = it.second;
+	std::sort (addedPosts.begin(), addedPosts.end(), postOrder);
 
-		BackendPost* rootPost = findPostById (rootID);
-		BackendPost* post = findPostById (postID);
+	ChannelNewPosts allNewPosts;
+	ChannelNewPostsChunk currentNewPostsChunk;
+	size_t chunkStart = SIZE_MAX;
 
-		if (!rootPost) {
-			LOG_DEBUG("root post " << rootID << " not found  (to be associated with post " << postID << ")");
-			continue;
-		}
+	for (auto it = addedPosts.rbegin(); it != addedPosts.rend(); ++it) {
+		size_t position = findPostPosition (**it);
 
-		if (!post) {
-			LOG_DEBUG("post " << postID << " not found (to be associated with root " << rootID << ")");
-			continue;
+		//not adjacent to the current range - start a new one
+		if (!currentNewPostsChunk.postsToAdd.empty() && position + 1 != chunkStart) {
+			allNewPosts.addChunk (std::move (currentNewPostsChunk));
+			currentNewPostsChunk = ChannelNewPostsChunk ();
 		}
 
-		LOG_DEBUG("post " << postID << " add root " << rootID << ")");
-		post->rootPost = rootPost;
+		currentNewPostsChunk.postsToAdd.push_front (*it);
+		currentNewPostsChunk.previousPostId = position > 0 ? posts[position - 1]->id : MattermostId ();
+		chunkStart = position;
 	}
 
+	if (!currentNewPostsChunk.postsToAdd.empty()) {
+		allNewPosts.addChunk (std::move (currentNewPostsChunk));
+	}
+
+	LOG_DEBUG (storage, "Channel " << display_name << " merged page" << LogField ("posts", orderArray.size()) << LogField ("added", (qint64) addedPosts.size())
+			<< LogField ("updated", (qint64) updatedPosts.size()) << LogField ("deleted", (qint64) deletedPosts.size()) << LogField ("ranges", (qint64) allNewPosts.postsToAdd.size()));
+
 	emit onNewPosts (allNewPosts);
+
+	for (BackendPost* post: updatedPosts) {
+		emit onPostEdited (*post);
+	}
+
+	for (const MattermostId& postId: deletedPosts) {
+		emit onPostDeleted (postId);
+	}
 }
 
-void BackendChannel::editPost (BackendPost& newPost)
+void BackendChannel::editPost (const QJsonObject& postObject)
 {
-	BackendPost* existingPost = findPostById (newPost.id);
+	MattermostId postId (postObject.value("id").toString());
+	BackendPost* existingPost = findPostById (postId);
 
+	//posts, which are not loaded, are not added here, as that would leave a gap in the history
 	if (!existingPost) {
-		LOG_DEBUG ("BackendChannel::editPost: post with ID " << newPost.id << " not found");
+		LOG_DEBUG (storage, "BackendChannel::editPost: post with ID " << postId << " not found");
 		return;
 	}
 
-	existingPost->updatePostEdits (newPost);
-	emit onPostEdited (*existingPost);
+	switch (updatePost (*existingPost, postObject)) {
+	case UpsertResult::updated:
+		emit onPostEdited (*existingPost);
+		break;
+	case UpsertResult::deleted:
+		emit onPostDeleted (existingPost->id);
+		break;
+	default:
+		break;
+	}
 }
 
-void BackendChannel::addPostReaction (QString postId, QString userId, QString emojiName)
+void BackendChannel::deletePost (const QJsonObject& postObject)
 {
+	MattermostId postId (postObject.value("id").toString());
 	BackendPost* existingPost = findPostById (postId);
 
 	if (!existingPost) {
-		LOG_DEBUG ("BackendChannel::addPostReaction: post with ID " << postId << " not found");
+		LOG_DEBUG (storage, "BackendChannel::deletePost: post with ID " << postId << " not found");
+		return;
+	}
+
+	//repeated event
+	if (existingPost->isDeleted) {
 		return;
 	}
 
-	existingPost->addReaction (storage.getUserDisplayNameByUserId (userId, true), emojiName);
+	existingPost->isDeleted = true;
+	existingPost->delete_at = postObject.value("delete_at").toVariant().toULongLong();
+	emit onPostDeleted (postId);
+}
+
+void BackendChannel::addPostReaction (const MattermostId& postId, const MattermostId& userId, QString emojiName)
+{
+	BackendPost* existingPost = findPostById (postId);
+
+	if (!existingPost) {
+		LOG_DEBUG (storage, "BackendChannel::addPostReaction: post with ID " << postId << " not found");
+		return;
+	}
+
+	existingPost->addReaction (userId, emojiName);
 	emit onPostReactionUpdated (*existingPost);
 }
 
-void BackendChannel::removePostReaction (QString postId, QString userId, QString emojiName)
+void BackendChannel::removePostReaction (const MattermostId& postId, const MattermostId& userId, QString emojiName)
 {
 	BackendPost* existingPost = findPostById (postId);
 
 	if (!existingPost) {
-		LOG_DEBUG ("BackendChannel::addPostReaction: post with ID " << postId << " not found");
+		LOG_DEBUG (storage, "BackendChannel::addPostReaction: post with ID " << postId << " not found");
 		return;
 	}
 
-	existingPost->removeReaction (storage.getUserDisplayNameByUserId (userId, true), emojiName);
+	existingPost->removeReaction (userId, emojiName);
 	emit onPostReactionUpdated (*existingPost);
 }
 
-QSet<const BackendUser*> BackendChannel::getAllMembers () const
+void BackendChannel::trimHistory (uint32_t keepPosts)
 {
-	QSet<const BackendUser*> ret;
+	if (posts.size() <= keepPosts) {
+		return;
+	}
+
+	size_t postsBefore = posts.size ();
+	size_t memoryBefore = getHistoryMemory ();
+
+	/*
+	 * The kept posts are moved to a new arena, so that the memory of the evicted ones is released at once.
+	 * Deleted posts (tombstones) are not kept
+	 */
+	BackendPostArena keptArena;
+	IdHashMap<BackendPost*> keptIndex;
+	std::deque<BackendPost*> keptPosts;
+
+	//a gap before a dropped tombstone is a gap before the next kept post
+	bool droppedGap = false;
+
+	for (size_t i = posts.size() - keepPosts; i < posts.size(); ++i) {
+		if (posts[i]->isDeleted) {
+			droppedGap = droppedGap || posts[i]->gapBefore;
+			continue;
+		}
+
+		posts[i]->gapBefore = posts[i]->gapBefore || droppedGap;
+		droppedGap = false;
 
-	for (auto& member: members) {
-		ret.insert (member.user);
+		BackendPost* post = keptArena.movePost (*posts[i]);
+		keptPosts.push_back (post);
+		keptIndex[post->id] = post;
 	}
 
-	return ret;
+	/*
+	 * The old posts are still alive here, so the root posts can be found by ID. The roots of the kept replies are
+	 * kept as well (as detached posts, if they are evicted from the history), so the replies keep their quotes.
+	 * Other detached posts (loaded threads) are dropped
+	 */
+	IdHashMap<BackendPost*> keptDetached;
+
+	for (BackendPost* post: keptPosts) {
+		if (!post->rootPost) {
+			continue;
+		}
+
+		auto it = keptIndex.find (post->rootPost->id);
+
+		if (it != keptIndex.end()) {
+			post->rootPost = it->second;
+			continue;
+		}
+
+		BackendPost*& detachedRoot = keptDetached[post->rootPost->id];
+
+		if (!detachedRoot) {
+			detachedRoot = keptArena.movePost (*post->rootPost);
+		}
+
+		post->rootPost = detachedRoot;
+	}
+
+	postArena.swap (keptArena);
+	postIdToPost.swap (keptIndex);
+	detachedPosts.swap (keptDetached);
+	posts.swap (keptPosts);
+	++historyGeneration;
+
+	//the thread index is rebuilt for the moved posts. Roots, which are evicted without replies, can be requested again
+	threadReplies.clear ();
+	requestedRootIds.clear ();
+	missingRootIds.clear ();
+
+	for (BackendPost* post: posts) {
+		if (!post->root_id.isEmpty()) {
+			threadReplies[post->root_id].push_back (post);
+		}
+	}
+
+	LOG_DEBUG (storage, "Channel " << display_name << " history trimmed" << LogField ("posts_before", (qint64) postsBefore)
+			<< LogField ("posts_after", (qint64) posts.size()) << LogField ("bytes_before", (qint64) memoryBefore) << LogField ("bytes_after", (qint64) getHistoryMemory()));
+
+	//the old posts are destroyed with 'keptArena', after the listeners have dropped their references
+	emit onHistoryTrimmed ();
+}
+
+size_t BackendChannel::getHistoryMemory () const
+{
+	size_t threadsMemory = threadReplies.getAllocatedBytes ();
+
+	for (const auto& it: threadReplies) {
+		threadsMemory += it.second.capacity() * sizeof (BackendPost*);
+	}
+
+	return postArena.getAllocatedBytes () + postArena.getPostsHeapBytes () + postIdToPost.getAllocatedBytes ()
+			+ detachedPosts.getAllocatedBytes () + posts.size() * sizeof (BackendPost*) + threadsMemory;
+}
+
+bool BackendChannel::isMember (const MattermostId& userId) const
+{
+	return members.find (userId) != members.end();
+}
+
+void BackendChannel::addMember (BackendChannelMember&& member)
+{
+	auto it = members.emplace (member.user_id, std::move (member));
+
+	if (!it.second) {
+		it.first->second = std::move (member);
+	}
 }
 
-BackendPost* BackendChannel::findPostById (QString postID)
+void BackendChannel::removeMember (const MattermostId& userId)
+{
+	members.erase (userId);
+}
+
+BackendPost* BackendChannel::findPostById (const MattermostId& postID)
 {
 	auto it = postIdToPost.find (postID);
 
-	if (it == postIdToPost.end()) {
-		return nullptr;
+	if (it != postIdToPost.end()) {
+		return it->second;
+	}
+
+	it = detachedPosts.find (postID);
+
+	if (it != detachedPosts.end()) {
+		return it->second;
 	}
 
-	return it.value();
+	return nullptr;
 }
 
 } /* namespace Mattermost */
@@ -26,7 +26,11 @@
 
 #include <QVariant>
 #include <list>
+#include <deque>
+#include <vector>
 #include "BackendPost.h"
+#include "BackendPostArena.h"
+#include "backend/IdHashMap.h"
 #include "BackendChannelMember.h"
 #include "BackendChannelProperties.h"
 #include "fwd.h"
@@ -41,7 +45,7 @@ class Storage;
  * A sequence of new posts
  */
 struct ChannelNewPostsChunk {
-	QString 									previousPostId;
+	MattermostId								previousPostId;
 	std::list<BackendPost*>						postsToAdd;
 };
 
@@ -74,15 +78,96 @@ public:
 
 	QString getChannelDescription () const;
 
-	QSet<const BackendUser*> getAllMembers () const;
+	/**
+	 * Whether the user is a member of the channel. Valid only if 'membersLoaded' (see Backend::retrieveChannelMembers())
+	 */
+	bool isMember (const MattermostId& userId) const;
+
+	/**
+	 * Add a member, or replace the member with the same user ID
+	 */
+	void addMember (BackendChannelMember&& member);
+	void removeMember (const MattermostId& userId);
 
+	/**
+	 * Add a post, received from the WebSocket. Returns nullptr if the post is already known.
+	 * If the post is older than the newest one (arrived out of order), it is inserted in its place
+	 * and onNewPosts() is emitted for it, so the caller should emit onNewPost() only for the newest post
+	 */
 	BackendPost* addPost (const QJsonObject& postObject);
 
-	void prependPosts (const QJsonArray& orderArray, const QJsonObject& postsObject);
+	/**
+	 * Merge a page of posts, received from the server (in any order). New posts are inserted by creation time,
+	 * known posts are updated if the page has a newer version, and local posts in the time range of the page,
+	 * which are not in it, are marked as deleted. onNewPosts() is emitted with the ranges of adjacent new posts.
+	 *
+	 * The loaded history may have gaps (see BackendPost::gapBefore). A page closes the gaps inside it, and the gap
+	 * to the post it was requested for: addPosts() is for the newest page, addPostsBefore() is for a page
+	 * requested with 'before=postId', addPostsAfter() - with 'after=postId'
+	 */
 	void addPosts (const QJsonArray& orderArray, const QJsonObject& postsObject);
-	void editPost (BackendPost& newPost);
-	void addPostReaction (QString postId, QString userId, QString emojiName);
-	void removePostReaction (QString postId, QString userId, QString emojiName);
+	void addPostsBefore (const MattermostId& postId, const QJsonArray& orderArray, const QJsonObject& postsObject);
+	void addPostsAfter (const MattermostId& postId, const QJsonArray& orderArray, const QJsonObject& postsObject);
+
+	/**
+	 * Add a single post to the loaded history, around which the history is loaded (the target of a jump).
+	 * A detached post is moved to the history. Emits onNewPosts(), if the post is new to the history
+	 */
+	BackendPost* addAnchorPost (const QJsonObject& postObject);
+
+	/**
+	 * Whether the post is in the loaded history ('posts')
+	 */
+	bool isPostLoaded (const MattermostId& postId) const;
+	void editPost (const QJsonObject& postObject);
+
+	/**
+	 * Mark a post as deleted. Deleted posts are kept (as tombstones), until the history is trimmed
+	 */
+	void deletePost (const QJsonObject& postObject);
+
+	/**
+	 * Add a post, which is outside of the loaded history (the root of a loaded reply, or a post of a thread).
+	 * Such posts are not in 'posts', and are moved there if their part of the history is loaded.
+	 * Returns the existing post, if it is already known
+	 */
+	BackendPost* addDetachedPost (const QJsonObject& postObject);
+
+	/**
+	 * Add the posts of a thread (/posts/{post_id}/thread). Emits onThreadLoaded()
+	 */
+	void addThreadPosts (const MattermostId& rootId, const QJsonArray& orderArray, const QJsonObject& postsObject);
+
+	/**
+	 * The root post (if known), followed by the known replies, oldest first
+	 */
+	std::vector<BackendPost*> getThread (const MattermostId& rootId);
+
+	/**
+	 * IDs of the root posts, which are referenced by replies, but are not loaded. Each ID is returned once
+	 */
+	std::vector<MattermostId> takeMissingRootIds ();
+
+	/**
+	 * Return root IDs, taken by takeMissingRootIds(), which were not received (the request has failed),
+	 * so that they are requested again
+	 */
+	void requeueMissingRootIds (const std::vector<MattermostId>& rootIds);
+	void addPostReaction (const MattermostId& postId, const MattermostId& userId, QString emojiName);
+	void removePostReaction (const MattermostId& postId, const MattermostId& userId, QString emojiName);
+
+	/**
+	 * Keep only the newest 'keepPosts' posts. The older ones are freed, and are loaded again by
+	 * Backend::retrieveChannelPostsBefore(), when the user scrolls back. Gaps in the kept posts stay. The kept posts move,
+	 * so all pointers to posts of this channel are invalid after onHistoryTrimmed()
+	 */
+	void trimHistory (uint32_t keepPosts);
+
+	/**
+	 * Memory, used by the loaded posts (including the heap memory, owned by each post) and their indexes.
+	 * Walks all posts of the channel
+	 */
+	size_t getHistoryMemory () const;
 
 signals:
 
@@ -128,7 +213,7 @@ signals:
 	 * Called when a post is being deleted
 	 * @param postId postId
 	 */
-	void onPostDeleted (const QString& postId);
+	void onPostDeleted (const MattermostId& postId);
 
 	/**
 	 * Called when someone is typing in the channel.
@@ -146,12 +231,59 @@ signals:
 	 * Called when the user is removed from the channel, or has left the channel
 	 */
 	void onLeave ();
+
+	/**
+	 * Called when old posts are evicted by trimHistory(). The posts, passed by the previous signals are
+	 * destroyed after this signal returns, and the remaining ones are in 'posts'
+	 */
+	void onHistoryTrimmed ();
+
+	/**
+	 * Called when a root post is loaded after some of its replies, which are now linked to it
+	 */
+	void onRootPostLoaded (BackendPost& rootPost);
+
+	/**
+	 * Called when the posts of a thread are loaded by Backend::retrieveThread()
+	 */
+	void onThreadLoaded (const MattermostId& rootId);
 private:
-	void addPost (const QJsonObject& postObject, std::list<BackendPost>::iterator position, ChannelNewPostsChunk& currentChunk, QVector<QPair<QString, QString>>& rootIdAndPostList, bool initialLoad);
-	BackendPost* findPostById (QString postID);
+	enum class UpsertResult {
+		added,
+		updated,
+		deleted,
+		unchanged,
+	};
+
+	//posts are ordered by creation time, and by ID for posts created at the same time
+	static bool postOrder (const BackendPost* left, const BackendPost* right);
+
+	//index of the post in 'posts'
+	size_t findPostPosition (const BackendPost& post) const;
+
+	BackendPost* createPost (const QJsonObject& postObject);
+
+	//insert a post in 'posts'
+	void attachPost (BackendPost* post);
+
+	/**
+	 * Add a new post, or update a known one, if the given version is newer (by update_at)
+	 */
+	UpsertResult upsertPost (const QJsonObject& postObject, BackendPost*& post);
+	UpsertResult updatePost (BackendPost& post, const QJsonObject& postObject);
+	void mergePosts (const QJsonArray& orderArray, const QJsonObject& postsObject, const MattermostId& beforePostId, const MattermostId& afterPostId);
+
+	//emit onNewPosts() for a single post, which is not the newest one
+	void emitNewPost (BackendPost& post);
+
+	//add a new post to the thread index and link it with its root post, or with its replies
+	void indexThread (BackendPost& post);
+
+	//searches the loaded history and the detached posts
+	BackendPost* findPostById (const MattermostId& postID);
 public:
 	const Storage&					storage;
-    QString							id;
+    MattermostId					id;
     uint64_t						create_at;
     uint64_t						update_at;
     uint64_t						delete_at;
@@ -165,13 +297,36 @@ public:
     int								total_msg_count;
     int								extra_update_at;
     const BackendUser*				creator;
-    QList<BackendChannelMember> 	members;
+    //user ID -> member. Loaded only when needed, see Backend::retrieveChannelMembers()
+    IdHashMap<BackendChannelMember>	members;
+    bool							membersLoaded;
     QVariant						scheme_id;
     QVariant						props;
     uint32_t						referenceCount;
 
-    QMap<QString, BackendPost*>		postIdToPost;
-    std::list<BackendPost>			posts;
+    //incremented by trimHistory(), so that responses for the evicted history can be recognized
+    uint32_t						historyGeneration;
+
+    //when the channel was last shown (ms since epoch), 0 if never. Used for choosing which channels to trim
+    int64_t							lastActiveAt;
+
+    //owns the posts, must be destroyed after the indexes below
+    BackendPostArena				postArena;
+    IdHashMap<BackendPost*>			postIdToPost;
+
+    //oldest first, ordered by postOrder(). Includes the deleted posts
+    std::deque<BackendPost*>		posts;
+
+    //posts outside of the loaded history, see addDetachedPost()
+    IdHashMap<BackendPost*>			detachedPosts;
+
+    //root post ID -> replies (loaded and detached), ordered by postOrder()
+    IdHashMap<std::vector<BackendPost*>>	threadReplies;
+private:
+    std::vector<MattermostId>		missingRootIds;
+
+    //roots, which have been added to 'missingRootIds', so that each one is requested once
+    IdHashSet						requestedRootIds;
 };
 
 } /* namespace Mattermost */
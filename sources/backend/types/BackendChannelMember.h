@@ -25,6 +25,7 @@
 #pragma once
 
 #include <QJsonObject>
+#include "MattermostId.h"
 
 namespace Mattermost {
 
@@ -39,7 +40,7 @@ public:
 	uint64_t		last_viewed_at;
 	uint32_t		msg_count;
 	uint32_t		mention_count;
-	QString			user_id;
+	MattermostId	user_id;
 };
 
 } /* namespace Mattermost */
@@ -0,0 +1,45 @@
+/**
+ * @file BackendChannelSummary.cpp
+ * @brief
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "BackendChannelSummary.h"
+
+#include <QJsonObject>
+#include <QVariant>
+
+namespace Mattermost {
+
+BackendChannelSummary::BackendChannelSummary (const QJsonObject& jsonObject)
+:id (jsonObject.value("id").toString())
+,team_id (jsonObject.value("team_id").toString())
+,creator_id (jsonObject.value("creator_id").toString())
+,name (jsonObject.value("name").toString())
+,display_name (jsonObject.value("display_name").toString())
+,header (jsonObject.value("header").toString())
+,purpose (jsonObject.value("purpose").toString())
+,last_post_at (jsonObject.value("last_post_at").toVariant().toULongLong())
+,total_msg_count (jsonObject.value("total_msg_count").toInt())
+{
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,52 @@
+/**
+ * @file BackendChannelSummary.h
+ * @brief Lightweight description of a channel, which the user may not be a member of
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <QString>
+#include "MattermostId.h"
+
+class QJsonObject;
+
+namespace Mattermost {
+
+/**
+ * The fields of a channel, needed to list and join it. Unlike BackendChannel, it is a plain value
+ * and holds no posts or members, so pages of thousands of them are cheap to keep
+ */
+struct BackendChannelSummary {
+	BackendChannelSummary (const QJsonObject& jsonObject);
+
+	MattermostId	id;
+	MattermostId	team_id;
+	MattermostId	creator_id;
+	QString			name;
+	QString			display_name;
+	QString			header;
+	QString			purpose;
+	uint64_t		last_post_at;
+	uint32_t		total_msg_count;
+};
+
+} /* namespace Mattermost */
@@ -43,7 +43,6 @@ signals:
 	void onNewChannel (BackendChannel& channel);
 public:
 	QList<BackendUser*>		 							members;
-	std::list<BackendChannel>							allPublicChannels;
 	std::vector<std::unique_ptr<BackendChannel>>		channels;
 };
 
@@ -25,6 +25,7 @@
 #include "BackendPost.h"
 
 #include <QJsonArray>
+#include <QJsonDocument>
 #include "backend/emoji/EmojiInfo.h"
 #include "BackendPoll.h"
 #include "backend/Storage.h"
@@ -32,55 +33,62 @@
 
 namespace Mattermost {
 
-BackendPost::BackendPost (const QJsonObject& jsonObject, const Storage& storage)
+namespace {
+
+//heap block of a QString or a QByteArray: the header and the data. Empty ones use a shared static block
+template <typename String>
+size_t stringHeapBytes (const String& string)
+{
+	return string.isEmpty() ? 0 : sizeof (QArrayData) + (string.capacity() + 1) * sizeof (string[0]);
+}
+
+size_t fileHeapBytes (const BackendFile& file)
+{
+	return stringHeapBytes (file.id) + stringHeapBytes (file.name) + stringHeapBytes (file.mimeType)
+			+ stringHeapBytes (file.extension) + stringHeapBytes (file.mini_preview);
+}
+
+size_t pollHeapBytes (const BackendPoll& poll)
+{
+	size_t bytes = sizeof (BackendPoll) + stringHeapBytes (poll.id) + stringHeapBytes (poll.authorName)
+			+ stringHeapBytes (poll.title) + stringHeapBytes (poll.text)
+			+ poll.options.capacity() * sizeof (BackendPollOption) + poll.metadata.ownVoteOptions.capacity() * sizeof (uint32_t);
+
+	for (const BackendPollOption& option: poll.options) {
+		bytes += stringHeapBytes (option.name) + stringHeapBytes (option.voters) + stringHeapBytes (option.actionID);
+	}
+
+	return bytes;
+}
+
+}
+
+BackendPost::BackendPost (const QJsonObject& jsonObject, const Storage& storage, BackendPostArena& arena)
 :rootPost (nullptr)
 ,author (nullptr)
 ,isDeleted (false)
+,gapBefore (true)
 {
 	id = jsonObject.value("id").toString();
+	user_id = jsonObject.value("user_id").toString();
+	root_id = jsonObject.value("root_id").toString();
 	create_at = jsonObject.value("create_at").toVariant().toULongLong();
 	update_at = jsonObject.value("update_at").toVariant().toULongLong();
 	edit_at = jsonObject.value("edit_at").toVariant().toULongLong();
 	delete_at = jsonObject.value("delete_at").toVariant().toULongLong();
 	is_pinned = jsonObject.value("is_pinned").toBool();
-	user_id = jsonObject.value("user_id").toString();
-	channel_id = jsonObject.value("channel_id").toString();
-	root_id = jsonObject.value("root_id").toString();
-	parent_id = jsonObject.value("parent_id").toString();
-	original_id = jsonObject.value("original_id").toString();
-	message = jsonObject.value("message").toString();
-	type = jsonObject.value("type").toString();
-	props = jsonObject.value("props");
-	hashtags = jsonObject.value("hashtags").toString();
-	pending_post_id = jsonObject.value("pending_post_id").toString();
-
-	QJsonObject metadata = jsonObject.value("metadata").toObject();
-
-	for (const auto &fileElement: metadata.value("files").toArray()) {
-		files.emplace_back (fileElement.toObject());
-	}
-
-	for (const auto &reactionElement: metadata.value("reactions").toArray()) {
-
-		QString userName = storage.getUserDisplayNameByUserId (reactionElement.toObject().value ("user_id").toString(), true);
-		addReaction (userName, reactionElement.toObject().value ("emoji_name").toString());
-	}
-
-	/**
-	 * If there are attachments to the post, it is either a poll or a call
-	 */
-	QJsonValue attachments (props.toObject().value("attachments"));
-	if (attachments.isArray()) {
-		auto pollObject = attachments.toArray()[0].toObject();
-
-		/**
-		 * If there is no actions array and no fields array, this is not a poll
-		 */
-		if (pollObject.value("actions").toArray().isEmpty() && pollObject.value("fields").toArray().isEmpty()) {
-			return;
-		}
-
-		poll = std::make_unique<BackendPoll> (props.toObject().value("poll_id").toString(), pollObject);
+	message = arena.storeString (jsonObject.value("message").toString());
+	type = arena.storeString (jsonObject.value("type").toString());
+	hashtags = arena.storeString (jsonObject.value("hashtags").toString());
+
+	//the decoding is done on first access
+	QJsonObject metadataObject (jsonObject.value("metadata").toObject());
+	QJsonObject propsObject (jsonObject.value("props").toObject());
+
+	if (!metadataObject.isEmpty() || !propsObject.isEmpty()) {
+		rawFields.reset (new BackendPostRawFields {&arena,
+			metadataObject.isEmpty() ? QByteArray() : QJsonDocument (metadataObject).toJson (QJsonDocument::Compact),
+			propsObject.isEmpty() ? QByteArray() : QJsonDocument (propsObject).toJson (QJsonDocument::Compact)});
 	}
 }
 
@@ -98,7 +106,7 @@ bool BackendPost::isOwnPost () const
 bool BackendPost::isOwnPollPost () const
 {
 	//non-poll posts are not considered here
-	if (!poll) {
+	if (!getPoll()) {
 		return false;
 	}
 
@@ -115,58 +123,95 @@ bool BackendPost::isOwnPollPost () const
  */
 QString BackendPost::getDisplayAuthorName () const
 {
-	if (poll) {
+	if (BackendPoll* poll = getPoll()) {
 		return poll->authorName + " (" + getAuthorName() + ")";
 	}
 
 	return getAuthorName();
 }
 
-void BackendPost::addReaction (QString userName, QString emojiName)
+size_t BackendPost::getHeapMemory () const
 {
+	size_t bytes = files.getAllocatedBytes () + reactions.getAllocatedBytes ();
+
+	if (rawFields) {
+		bytes += sizeof (BackendPostRawFields) + stringHeapBytes (rawFields->metadata) + stringHeapBytes (rawFields->props);
+	}
+
+	for (const BackendFile& file: files) {
+		bytes += fileHeapBytes (file);
+	}
+
+	for (const BackendPostEmojiReaction& reaction: reactions) {
+		bytes += reaction.users.getAllocatedBytes ();
+	}
+
+	if (poll) {
+		bytes += pollHeapBytes (*poll);
+	}
+
+	return bytes;
+}
+
+void BackendPost::addReaction (const MattermostId& userId, QString emojiName)
+{
+	//the reactions from the post JSON come first
+	decodeRawFields ();
+
 	EmojiID emojiId = EmojiInfo::findByName(emojiName);
 
 	if (!emojiId) {
-		LOG_DEBUG ("Missing emoji: " << emojiName);
+		LOG_DEBUG (storage, "Missing emoji: " << emojiName);
 		return;
 	}
 
-	auto& vec = reactions[emojiId];
+	auto it = std::lower_bound (reactions.begin(), reactions.end(), emojiId, [] (const BackendPostEmojiReaction& reaction, const EmojiID& value) {
+		return reaction.emojiId < value;
+	});
+
+	if (it == reactions.end() || emojiId < it->emojiId) {
+		it = reactions.emplace (it, BackendPostEmojiReaction {emojiId, BackendPostReaction ()});
+	}
 
 	/**
 	 * If the same reaction from the same user already exists, remove it.
 	 * The official Mattermost client sends 'reaction added' on each reaction add,
 	 * but the reaction is removed if it already exists
 	 */
-	auto it = std::find (vec.begin(), vec.end(), userName);
-	if (it != vec.end()) {
-		vec.erase (it);
+	if (!it->users.insert (userId)) {
+		it->users.erase (userId);
+	}
 
-		//if this was the only user used this reaction, remove the reaction
-		if (vec.isEmpty()) {
-			reactions.erase (emojiId);
-		}
-	} else {
-		vec.push_back (userName);
+	//if this was the only user used this reaction, remove the reaction
+	if (it->users.empty()) {
+		reactions.erase (it);
 	}
 }
 
-void BackendPost::removeReaction (QString userName, QString emojiName)
+void BackendPost::removeReaction (const MattermostId& userId, QString emojiName)
 {
+	decodeRawFields ();
+
 	EmojiID emojiId = EmojiInfo::findByName(emojiName);
 
 	if (!emojiId) {
-		LOG_DEBUG ("Missing emoji: " << emojiName);
+		LOG_DEBUG (storage, "Missing emoji: " << emojiName);
 		return;
 	}
 
-	auto& vec = reactions[emojiId];
+	auto it = std::lower_bound (reactions.begin(), reactions.end(), emojiId, [] (const BackendPostEmojiReaction& reaction, const EmojiID& value) {
+		return reaction.emojiId < value;
+	});
+
+	if (it == reactions.end() || emojiId < it->emojiId) {
+		return;
+	}
 
-	vec.erase(std::remove(vec.begin(), vec.end(), userName), vec.end());
+	it->users.erase (userId);
 
 	//if this was the only user used this reaction, remove the reaction
-	if (vec.isEmpty()) {
-		reactions.erase (emojiId);
+	if (it->users.empty()) {
+		reactions.erase (it);
 	}
 }
 
@@ -180,7 +225,7 @@ QString BackendPost::getAuthorName () const
 		return author->getDisplayName ();
 	}
 
-	return user_id;
+	return user_id.toString ();
 }
 
 QDateTime BackendPost::getCreationTime () const
@@ -188,16 +233,142 @@ QDateTime BackendPost::getCreationTime () const
 	return QDateTime::fromMSecsSinceEpoch (create_at);
 }
 
-void BackendPost::updatePostEdits (BackendPost& editedPost)
+QString BackendPost::getMessage () const
+{
+	return message.toString ();
+}
+
+QJsonObject BackendPost::getProps () const
 {
+	const_cast<BackendPost*> (this)->decodeRawFields ();
+
+	if (props.isEmpty()) {
+		return QJsonObject ();
+	}
+
+	return QJsonDocument::fromJson (props.toUtf8 ()).object ();
+}
+
+const CompactVector<BackendFile>& BackendPost::getFiles () const
+{
+	const_cast<BackendPost*> (this)->decodeRawFields ();
+	return files;
+}
+
+CompactVector<BackendFile>& BackendPost::getFiles ()
+{
+	decodeRawFields ();
+	return files;
+}
+
+const CompactVector<BackendPostEmojiReaction>& BackendPost::getReactions () const
+{
+	const_cast<BackendPost*> (this)->decodeRawFields ();
+	return reactions;
+}
+
+BackendPoll* BackendPost::getPoll () const
+{
+	const_cast<BackendPost*> (this)->decodeRawFields ();
+	return poll.get ();
+}
+
+void BackendPost::decodeRawFields ()
+{
+	if (!rawFields) {
+		return;
+	}
+
+	//taken out first, as addReaction() calls this function
+	std::unique_ptr<BackendPostRawFields> raw (std::move (rawFields));
+
+	if (!raw->metadata.isEmpty()) {
+		QJsonObject metadata (QJsonDocument::fromJson (raw->metadata).object());
+
+		for (const auto &fileElement: metadata.value("files").toArray()) {
+			files.emplace_back (fileElement.toObject());
+		}
+
+		for (const auto &reactionElement: metadata.value("reactions").toArray()) {
+
+			addReaction (reactionElement.toObject().value ("user_id").toString(), reactionElement.toObject().value ("emoji_name").toString());
+		}
+	}
+
+	if (raw->props.isEmpty()) {
+		return;
+	}
+
+	props = raw->arena->storeString (raw->props);
+
+	/**
+	 * If there are attachments to the post, it is either a poll or a call
+	 */
+	QJsonObject propsObject (QJsonDocument::fromJson (raw->props).object());
+	QJsonValue attachments (propsObject.value("attachments"));
+	if (attachments.isArray()) {
+		auto pollObject = attachments.toArray()[0].toObject();
+
+		/**
+		 * If there is no actions array and no fields array, this is not a poll
+		 */
+		if (pollObject.value("actions").toArray().isEmpty() && pollObject.value("fields").toArray().isEmpty()) {
+			return;
+		}
+
+		poll = std::make_unique<BackendPoll> (propsObject.value("poll_id").toString(), pollObject);
+	}
+}
+
+void BackendPost::moveTexts (BackendPostArena& arena)
+{
+	copyTexts (arena);
+
+	if (rawFields) {
+		rawFields->arena = &arena;
+	}
+}
+
+void BackendPost::copyTexts (BackendPostArena& arena)
+{
+	message = arena.storeString (message);
+	type = arena.storeString (type);
+	hashtags = arena.storeString (hashtags);
+	props = arena.storeString (props);
+}
+
+void BackendPost::updatePostEdits (BackendPost& editedPost, BackendPostArena& arena)
+{
+	arena.releaseString (message);
 	message = editedPost.message;
+	arena.releaseString (hashtags);
+	hashtags = editedPost.hashtags;
 
-	if (poll && editedPost.poll) {
+	//the type of a post does not change
+	arena.releaseString (editedPost.type);
+
+	update_at = editedPost.update_at;
+	edit_at = editedPost.edit_at;
+	is_pinned = editedPost.is_pinned;
+
+	//files, reactions and props of the newer version replace the current ones. If they are not decoded yet, neither are the new ones
+	if (rawFields) {
+		rawFields = std::move (editedPost.rawFields);
+		return;
+	}
 
+	editedPost.decodeRawFields ();
+	files = std::move (editedPost.files);
+	reactions = std::move (editedPost.reactions);
+	arena.releaseString (props);
+	props = editedPost.props;
+
+	//the poll metadata (own votes, permissions) is received separately, so it is kept
+	if (poll && editedPost.poll) {
 		editedPost.poll->metadata = poll->metadata;
-		poll = std::move (editedPost.poll);
 	}
 
+	poll = std::move (editedPost.poll);
 }
 
 
@@ -27,10 +27,12 @@
 #include <QJsonObject>
 #include <QVariant>
 #include <QDateTime>
-#include <list>
 #include <memory>
 #include "BackendUser.h"
 #include "BackendFile.h"
+#include "BackendPostArena.h"
+#include "backend/CompactVector.h"
+#include "backend/IdHashSet.h"
 #include "backend/emoji/EmojiDefs.h"
 
 namespace Mattermost {
@@ -38,11 +40,37 @@ namespace Mattermost {
 class BackendPoll;
 class Storage;
 
-using BackendPostReaction = QVector<QString>;
+using BackendPostReaction = IdHashSet;
 
+/**
+ * Users, who reacted to a post with the same emoji. The IDs are resolved to display names
+ * when the reaction is shown, so renamed users are displayed with their current names
+ */
+struct BackendPostEmojiReaction {
+	EmojiID						emojiId;
+	BackendPostReaction			users;
+};
+
+/**
+ * Parts of the post JSON, which are decoded on first access. Most posts in the loaded pages are never
+ * displayed (background channels, scrolled-out history), so their files, reactions and polls are not decoded.
+ * They are kept as compact JSON text, rather than as QJsonObject values, which would keep the parsed
+ * data of the whole page alive
+ */
+struct BackendPostRawFields {
+	BackendPostArena*			arena;
+	QByteArray					metadata;
+	QByteArray					props;
+};
+
+/**
+ * A post. Posts of a channel are allocated in the channel's BackendPostArena, which also keeps their
+ * texts, so the layout is kept compact - ids in binary form, texts as arena strings, and one-pointer
+ * vectors for the files and reactions, which most posts do not have
+ */
 class BackendPost {
 public:
-	BackendPost (const QJsonObject& jsonObject, const Storage& storage);
+	BackendPost (const QJsonObject& jsonObject, const Storage& storage, BackendPostArena& arena);
 	BackendPost (BackendPost&& other) = default;
 	~BackendPost ();
 public:
@@ -64,38 +92,78 @@ public:
 	bool isOwnPollPost () 	const;
 	QString getDisplayAuthorName () const;
 	QDateTime getCreationTime () const;
-	void updatePostEdits (BackendPost& editedPost);
-	void addReaction (QString userName, QString emojiName);
-	void removeReaction (QString userName, QString emojiName);
+	QString getMessage () const;
+
+	/**
+	 * Props are kept as JSON text and parsed on each call
+	 */
+	QJsonObject getProps () const;
+
+	/**
+	 * Files, reactions and polls are decoded from the post JSON on the first call of any of these
+	 */
+	const CompactVector<BackendFile>& getFiles () const;
+	CompactVector<BackendFile>& getFiles ();
+	const CompactVector<BackendPostEmojiReaction>& getReactions () const;
+	BackendPoll* getPoll () const;
+
+	/**
+	 * Take the texts, files, reactions and the poll of a newer version of the post, which is created in the same arena.
+	 * The replaced texts are released in the arena
+	 */
+	void updatePostEdits (BackendPost& editedPost, BackendPostArena& arena);
+
+	/**
+	 * Copy the texts of the post to another arena. Used when the post is moved to it
+	 */
+	void moveTexts (BackendPostArena& arena);
+
+	/**
+	 * Copy the texts of the post to the text blocks of another arena, the post stays in its arena.
+	 * Used when the arena reclaims its unused text memory
+	 */
+	void copyTexts (BackendPostArena& arena);
+
+	/**
+	 * Estimate of the heap memory, owned by the post (not decoded fields, files, reactions and the poll).
+	 * The texts are in the arena and are not included
+	 */
+	size_t getHeapMemory () const;
+
+	void addReaction (const MattermostId& userId, QString emojiName);
+	void removeReaction (const MattermostId& userId, QString emojiName);
 private:
 	QString getAuthorName () const;
+	void decodeRawFields ();
 public:
-	QString						id;
+	MattermostId				id;
+	MattermostId				user_id;
+	MattermostId				root_id;
 	uint64_t					create_at;
 	uint64_t					update_at;
 	uint64_t					edit_at;
 	uint64_t					delete_at;
-	bool						is_pinned;
-	QString						user_id;
-	QString						channel_id;
-#if 1
-	QString						root_id;
-	QString						parent_id;
-	QString						original_id;
-#endif
 	BackendPost*				rootPost;
-	QString						message;
-	QString						type;
-	QJsonValue					props;
-	QString						hashtags;
-	QString						pending_post_id;
-	std::list<BackendFile>		files;
-	std::map<EmojiID, BackendPostReaction> reactions;
+	const BackendUser*			author;
+	PostString					message;
+	PostString					type;
+	PostString					hashtags;
+	bool						is_pinned;
+	bool						isDeleted;
 
+	//posts may be missing between this post and the previous one in BackendChannel::posts (not loaded yet)
+	bool						gapBefore;
+private:
+	//null if there is nothing left to decode
+	std::unique_ptr<BackendPostRawFields> rawFields;
+
+	PostString					props;
+	CompactVector<BackendFile>	files;
+
+	//sorted by emoji
+	CompactVector<BackendPostEmojiReaction> reactions;
 
 	std::unique_ptr<BackendPoll> poll;
-	const BackendUser*			author;
-	bool						isDeleted;
 };
 
 } /* namespace Mattermost */
@@ -0,0 +1,311 @@
+/**
+ * @file BackendPostArena.cpp
+ * @brief Per-channel storage for posts and their texts
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "BackendPostArena.h"
+
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <QHash>
+#include "BackendPost.h"
+
+namespace Mattermost {
+
+struct BackendPostArena::PostChunk {
+	typename std::aligned_storage<sizeof (BackendPost), alignof (BackendPost)>::type posts[postsPerChunk];
+
+	BackendPost* at (uint32_t index)
+	{
+		return reinterpret_cast<BackendPost*> (&posts[index]);
+	}
+};
+
+uint32_t PostString::size () const
+{
+	uint32_t length = 0;
+
+	if (data) {
+		memcpy (&length, data, sizeof (length));
+	}
+
+	return length;
+}
+
+QString PostString::toString () const
+{
+	if (!data) {
+		return QString ();
+	}
+
+	return QString::fromUtf8 (data + sizeof (uint32_t), size ());
+}
+
+QByteArray PostString::toUtf8 () const
+{
+	if (!data) {
+		return QByteArray ();
+	}
+
+	return QByteArray (data + sizeof (uint32_t), size ());
+}
+
+size_t BackendPostArena::StoredStringHash::operator() (const char* data) const
+{
+	uint32_t length;
+	memcpy (&length, data, sizeof (length));
+	return qHashBits (data + sizeof (length), length);
+}
+
+bool BackendPostArena::StoredStringEqual::operator() (const char* lhs, const char* rhs) const
+{
+	uint32_t lhsLength;
+	uint32_t rhsLength;
+	memcpy (&lhsLength, lhs, sizeof (lhsLength));
+	memcpy (&rhsLength, rhs, sizeof (rhsLength));
+	return lhsLength == rhsLength && memcmp (lhs + sizeof (lhsLength), rhs + sizeof (rhsLength), lhsLength) == 0;
+}
+
+BackendPostArena::BackendPostArena ()
+:postsCount (0)
+,textBlockUsed (textBlockSize)
+,postBytes (0)
+,textBytes (0)
+,unusedTextBytes (0)
+{
+}
+
+BackendPostArena::~BackendPostArena ()
+{
+	clear ();
+}
+
+void* BackendPostArena::allocatePost ()
+{
+	uint32_t index = postsCount % postsPerChunk;
+
+	if (index == 0 && postsCount / postsPerChunk == postChunks.size()) {
+		postChunks.emplace_back (new PostChunk);
+		postBytes += sizeof (PostChunk);
+	}
+
+	return postChunks[postsCount / postsPerChunk]->at (index);
+}
+
+BackendPost* BackendPostArena::createPost (const QJsonObject& jsonObject, const Storage& storage)
+{
+	BackendPost* post = new (allocatePost ()) BackendPost (jsonObject, storage, *this);
+	++postsCount;
+	return post;
+}
+
+BackendPost* BackendPostArena::movePost (BackendPost& post)
+{
+	BackendPost* movedPost = new (allocatePost ()) BackendPost (std::move (post));
+	++postsCount;
+	movedPost->moveTexts (*this);
+	return movedPost;
+}
+
+PostString BackendPostArena::storeString (const QString& string)
+{
+	if (string.isEmpty()) {
+		return PostString ();
+	}
+
+	return storeString (string.toUtf8 ());
+}
+
+PostString BackendPostArena::storeString (const QByteArray& utf8)
+{
+	if (utf8.isEmpty()) {
+		return PostString ();
+	}
+
+	if ((uint32_t) utf8.size() > sharedStringMaxLength) {
+		char* destination = allocateString (utf8.size ());
+		memcpy (destination + sizeof (uint32_t), utf8.constData(), utf8.size ());
+		return PostString (destination);
+	}
+
+	//looked up with a temporary copy in the length-prefixed format, on the stack
+	char key[sizeof (uint32_t) + sharedStringMaxLength];
+	uint32_t length = utf8.size ();
+	memcpy (key, &length, sizeof (length));
+	memcpy (key + sizeof (length), utf8.constData(), length);
+
+	auto it = sharedStrings.find (key);
+
+	if (it != sharedStrings.end()) {
+		return PostString (*it);
+	}
+
+	char* destination = allocateString (length);
+	memcpy (destination + sizeof (uint32_t), utf8.constData(), length);
+	sharedStrings.insert (destination);
+	return PostString (destination);
+}
+
+PostString BackendPostArena::storeString (const PostString& string)
+{
+	if (string.isEmpty()) {
+		return PostString ();
+	}
+
+	return storeString (QByteArray::fromRawData (string.data + sizeof (uint32_t), string.size ()));
+}
+
+void BackendPostArena::releaseString (const PostString& string)
+{
+	uint32_t length = string.size ();
+
+	if (length <= sharedStringMaxLength) {
+		return;
+	}
+
+	size_t required = sizeof (length) + length;
+
+	//long texts have their own blocks, which can be freed right away
+	if (required > textBlockSize / 4) {
+		for (auto it = longTexts.begin(); it != longTexts.end(); ++it) {
+			if (it->get() == string.data) {
+				longTexts.erase (it);
+				textBytes -= required;
+				return;
+			}
+		}
+
+		return;
+	}
+
+	unusedTextBytes += required;
+}
+
+void BackendPostArena::reclaimUnusedTexts ()
+{
+	if (unusedTextBytes < textBlockSize || unusedTextBytes * 2 < textBytes) {
+		return;
+	}
+
+	BackendPostArena texts;
+
+	for (uint32_t i = 0; i < postsCount; ++i) {
+		postChunks[i / postsPerChunk]->at (i % postsPerChunk)->copyTexts (texts);
+	}
+
+	//the old blocks are freed with 'texts'
+	textBlocks.swap (texts.textBlocks);
+	longTexts.swap (texts.longTexts);
+	sharedStrings.swap (texts.sharedStrings);
+	std::swap (textBlockUsed, texts.textBlockUsed);
+	std::swap (textBytes, texts.textBytes);
+	unusedTextBytes = 0;
+}
+
+char* BackendPostArena::allocateString (uint32_t length)
+{
+	size_t required = sizeof (length) + length;
+	char* destination;
+
+	if (required > textBlockSize / 4) {
+		//long text, a block of its own, so that the current block is not wasted
+		longTexts.emplace_back (new char[required]);
+		destination = longTexts.back().get();
+		textBytes += required;
+	} else {
+		if (textBlockUsed + required > textBlockSize) {
+			textBlocks.emplace_back (new char[textBlockSize]);
+			textBlockUsed = 0;
+			textBytes += textBlockSize;
+		}
+
+		destination = textBlocks.back().get() + textBlockUsed;
+		textBlockUsed += required;
+	}
+
+	memcpy (destination, &length, sizeof (length));
+	return destination;
+}
+
+void BackendPostArena::clear ()
+{
+	for (uint32_t i = 0; i < postsCount; ++i) {
+		postChunks[i / postsPerChunk]->at (i % postsPerChunk)->~BackendPost ();
+	}
+
+	postChunks.clear ();
+	postsCount = 0;
+
+	textBlocks.clear ();
+	longTexts.clear ();
+	sharedStrings.clear ();
+	textBlockUsed = textBlockSize;
+	postBytes = 0;
+	textBytes = 0;
+	unusedTextBytes = 0;
+}
+
+void BackendPostArena::swap (BackendPostArena& other)
+{
+	postChunks.swap (other.postChunks);
+	std::swap (postsCount, other.postsCount);
+	textBlocks.swap (other.textBlocks);
+	longTexts.swap (other.longTexts);
+	std::swap (textBlockUsed, other.textBlockUsed);
+	sharedStrings.swap (other.sharedStrings);
+	std::swap (postBytes, other.postBytes);
+	std::swap (textBytes, other.textBytes);
+	std::swap (unusedTextBytes, other.unusedTextBytes);
+}
+
+uint32_t BackendPostArena::getPostsCount () const
+{
+	return postsCount;
+}
+
+size_t BackendPostArena::getAllocatedBytes () const
+{
+	//a node of the set is the pointer and the cached hash, plus the link to the next node
+	size_t sharedStringsBytes = sharedStrings.bucket_count() * sizeof (void*) + sharedStrings.size() * 3 * sizeof (void*);
+
+	return postBytes + textBytes + sharedStringsBytes;
+}
+
+size_t BackendPostArena::getPostsHeapBytes () const
+{
+	size_t bytes = 0;
+
+	for (uint32_t i = 0; i < postsCount; ++i) {
+		bytes += postChunks[i / postsPerChunk]->at (i % postsPerChunk)->getHeapMemory ();
+	}
+
+	return bytes;
+}
+
+size_t BackendPostArena::getUnusedTextBytes () const
+{
+	return unusedTextBytes;
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,181 @@
+/**
+ * @file BackendPostArena.h
+ * @brief Per-channel storage for posts and their texts
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+#include <QString>
+
+class QJsonObject;
+
+namespace Mattermost {
+
+class BackendPost;
+class BackendPostArena;
+class Storage;
+
+/**
+ * Text field of a post (message, type, props), stored in the arena of the channel as UTF-8,
+ * prefixed with its length. Empty strings are not stored. The string is valid as long as the arena
+ */
+class PostString {
+public:
+	PostString ();
+public:
+	bool isEmpty () const;
+	uint32_t size () const;
+	QString toString () const;
+	QByteArray toUtf8 () const;
+private:
+	explicit PostString (const char* data);
+	friend class BackendPostArena;
+private:
+	const char*		data;
+};
+
+/**
+ * Posts of a channel are allocated in chunks, and their texts are copied in shared text blocks,
+ * so that a post takes a single allocation-free slot and the whole history of the channel is
+ * released at once. Posts are never freed one by one - a deleted post stays as a tombstone until
+ * the arena is cleared, or the kept posts are moved to a new arena by BackendChannel::trimHistory().
+ *
+ * Short texts are stored once per arena and shared by all posts with the same text (post types,
+ * common props, short replies). Longer texts, which are replaced by an edit, are released with
+ * releaseString(), and their space is reclaimed by reclaimUnusedTexts()
+ */
+class BackendPostArena {
+public:
+	BackendPostArena ();
+	~BackendPostArena ();
+
+	BackendPostArena (const BackendPostArena&) = delete;
+	BackendPostArena& operator= (const BackendPostArena&) = delete;
+public:
+	BackendPost* createPost (const QJsonObject& jsonObject, const Storage& storage);
+
+	/**
+	 * Move a post from another arena, together with its texts. The source post is left empty,
+	 * and is destroyed with its arena. Used for trimming the history of a channel
+	 */
+	BackendPost* movePost (BackendPost& post);
+
+	PostString storeString (const QString& string);
+	PostString storeString (const QByteArray& utf8);
+
+	/**
+	 * Copy a string from another arena
+	 */
+	PostString storeString (const PostString& string);
+
+	/**
+	 * Mark a string as no longer used by its post. Shared (short) strings are kept
+	 */
+	void releaseString (const PostString& string);
+
+	/**
+	 * Copy the texts of all posts into new text blocks, if most of the text memory is taken by released strings.
+	 * The posts keep their addresses, only the PostString values, which they hold, are changed
+	 */
+	void reclaimUnusedTexts ();
+
+	/**
+	 * Destroy all posts and release the memory
+	 */
+	void clear ();
+
+	void swap (BackendPostArena& other);
+
+	uint32_t getPostsCount () const;
+
+	/**
+	 * Memory, held by the arena (post slots, text blocks and the shared strings table). Does not include memory,
+	 * owned by the posts
+	 */
+	size_t getAllocatedBytes () const;
+
+	/**
+	 * Sum of BackendPost::getHeapMemory() of all posts in the arena. Walks all posts
+	 */
+	size_t getPostsHeapBytes () const;
+
+	/**
+	 * Memory of the released strings, which is not reclaimed yet
+	 */
+	size_t getUnusedTextBytes () const;
+private:
+	struct PostChunk;
+
+	//hash and equality of length-prefixed strings in the text blocks
+	struct StoredStringHash {
+		size_t operator() (const char* data) const;
+	};
+
+	struct StoredStringEqual {
+		bool operator() (const char* lhs, const char* rhs) const;
+	};
+
+	void* allocatePost ();
+
+	//space for a string of the given length, with the length already written
+	char* allocateString (uint32_t length);
+
+	static constexpr uint32_t	postsPerChunk = 64;
+	static constexpr size_t		textBlockSize = 16 * 1024;
+
+	//strings up to this length (in bytes) are shared
+	static constexpr uint32_t	sharedStringMaxLength = 64;
+
+	std::vector<std::unique_ptr<PostChunk>>		postChunks;
+	uint32_t									postsCount;
+
+	//the last block is the one being filled
+	std::vector<std::unique_ptr<char[]>>		textBlocks;
+	std::vector<std::unique_ptr<char[]>>		longTexts;
+	size_t										textBlockUsed;
+	std::unordered_set<const char*, StoredStringHash, StoredStringEqual>	sharedStrings;
+
+	size_t										postBytes;
+	size_t										textBytes;
+	size_t										unusedTextBytes;
+};
+
+inline PostString::PostString ()
+:data (nullptr)
+{
+}
+
+inline PostString::PostString (const char* data)
+:data (data)
+{
+}
+
+inline bool PostString::isEmpty () const
+{
+	return !data;
+}
+
+} /* namespace Mattermost */
@@ -23,7 +23,6 @@
  */
 
 #include "BackendTeam.h"
-#include <QSet>
 
 namespace Mattermost {
 
@@ -32,6 +31,7 @@ BackendTeam::BackendTeam (const QJsonObject& jsonObject)
 ,update_at (0)
 ,delete_at (0)
 ,allow_open_invite (false)
+,membersLoaded (false)
 {
 	id = jsonObject.value("id").toString();
 	create_at = jsonObject.value("create_at").toVariant().toULongLong();
@@ -52,15 +52,23 @@ BackendTeam::BackendTeam (const QJsonObject& jsonObject)
 
 BackendTeam::~BackendTeam () = default;
 
-QSet<const BackendUser*> BackendTeam::getAllMembers () const
+bool BackendTeam::isMember (const MattermostId& userId) const
 {
-	QSet<const BackendUser*> ret;
+	return members.find (userId) != members.end();
+}
+
+void BackendTeam::addMember (BackendTeamMember&& member)
+{
+	auto it = members.emplace (member.user_id, std::move (member));
 
-	for (auto& member: members) {
-		ret.insert (member.user);
+	if (!it.second) {
+		it.first->second = std::move (member);
 	}
+}
 
-	return ret;
+void BackendTeam::removeMember (const MattermostId& userId)
+{
+	members.erase (userId);
 }
 
 } /* namespace Mattermost */
@@ -40,13 +40,19 @@ public:
 	BackendTeam (const QJsonObject& jsonObject);
 	virtual ~BackendTeam ();
 public:
-	QSet<const BackendUser*> getAllMembers () const;
+	bool isMember (const MattermostId& userId) const;
+
+	/**
+	 * Add a member, or replace the member with the same user ID
+	 */
+	void addMember (BackendTeamMember&& member);
+	void removeMember (const MattermostId& userId);
 signals:
 	void onLeave ();
 	void onNewChannel (BackendChannel& channel);
 	void onChannelDeleted (BackendChannel& channel);
 public:
-    QString			id;
+    MattermostId	id;
     uint64_t		create_at;
     uint64_t		update_at;
     uint64_t		delete_at;
@@ -61,8 +67,9 @@ public:
     bool 			allow_open_invite;
     QVariant 		scheme_id;
 
-	QList<BackendTeamMember> 							members;
-	std::list<BackendChannel>							allPublicChannels;
+	//user ID -> member, see Backend::retrieveTeamMembers()
+	IdHashMap<BackendTeamMember>						members;
+	bool												membersLoaded;
 	std::vector<std::unique_ptr<BackendChannel>>		channels;
 };
 
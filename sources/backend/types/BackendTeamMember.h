@@ -41,8 +41,8 @@ public:
 	bool			scheme_admin;
 	bool			scheme_guest;
 	bool			scheme_user;
-	QString			team_id;
-	QString			user_id;
+	MattermostId	team_id;
+	MattermostId	user_id;
 
 	BackendUser*	user;
 };
@@ -26,6 +26,7 @@
 
 #include "BackendTimeZone.h"
 #include "BackendNotifyPreps.h"
+#include "MattermostId.h"
 
 class QJsonObject;
 
@@ -56,7 +57,7 @@ public:
 
 	QString getDisplayName () const;
 public:
-    QString 			id;
+    MattermostId		id;
     QByteArray			avatar;
     uint64_t 			create_at;
     uint64_t			update_at;
@@ -0,0 +1,170 @@
+/**
+ * @file MattermostId.cpp
+ * @brief Compact 128-bit Mattermost object ID
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "MattermostId.h"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <vector>
+#include <QDebug>
+#include <QHash>
+
+namespace Mattermost {
+
+static const char base32Alphabet[] = "ybndrfg8ejkmcpqxot1uwisza345h769";
+
+//26 characters * 5 bits = 130 bits. The last character holds 3 bits of data and 2 zero bits
+static constexpr int idLength = 26;
+
+//'high' of interned IDs. A server ID with this value is practically impossible (random 128 bits)
+static constexpr uint64_t internedMarker = ~0ull;
+
+namespace {
+
+struct Base32DecodeTable {
+	Base32DecodeTable ()
+	{
+		std::fill (std::begin (values), std::end (values), -1);
+
+		for (int i = 0; i < 32; ++i) {
+			values[(uint8_t)base32Alphabet[i]] = i;
+		}
+	}
+
+	int8_t values[128];
+};
+
+/**
+ * Strings, which are not in the server ID format (for example IDs of the stand-in server fixtures
+ * or local placeholders). They are never removed, there are only a few of them
+ */
+struct InternTable {
+	std::mutex				mutex;
+	std::vector<QString>	strings;
+	QHash<QString, uint64_t>	indexes;
+};
+
+InternTable& internTable ()
+{
+	static InternTable table;
+	return table;
+}
+
+} /* namespace */
+
+static bool decode (const QString& string, uint64_t& high, uint64_t& low)
+{
+	static const Base32DecodeTable table;
+
+	if (string.size() != idLength) {
+		return false;
+	}
+
+	high = 0;
+	low = 0;
+
+	for (int i = 0; i < idLength; ++i) {
+		ushort c = string[i].unicode();
+		int value = c < 128 ? table.values[c] : -1;
+
+		if (value < 0) {
+			return false;
+		}
+
+		if (i < idLength - 1) {
+			high = (high << 5) | (low >> 59);
+			low = (low << 5) | value;
+		} else {
+			//the 2 low bits of the last character are padding
+			if (value & 3) {
+				return false;
+			}
+
+			high = (high << 3) | (low >> 61);
+			low = (low << 3) | (value >> 2);
+		}
+	}
+
+	return high != internedMarker;
+}
+
+MattermostId::MattermostId (const QString& string)
+:high (0)
+,low (0)
+{
+	if (string.isEmpty() || decode (string, high, low)) {
+		return;
+	}
+
+	InternTable& table = internTable ();
+	std::lock_guard<std::mutex> lock (table.mutex);
+
+	auto it = table.indexes.find (string);
+
+	if (it == table.indexes.end()) {
+		it = table.indexes.insert (string, table.strings.size());
+		table.strings.push_back (string);
+	}
+
+	high = internedMarker;
+	low = it.value();
+}
+
+QString MattermostId::toString () const
+{
+	if (isNull ()) {
+		return QString ();
+	}
+
+	if (high == internedMarker) {
+		InternTable& table = internTable ();
+		std::lock_guard<std::mutex> lock (table.mutex);
+		return table.strings[low];
+	}
+
+	QString string (idLength, Qt::Uninitialized);
+	QChar* data = string.data ();
+	uint64_t h = high;
+	uint64_t l = low;
+
+	data[idLength - 1] = QLatin1Char (base32Alphabet[(l & 7) << 2]);
+	l = (l >> 3) | (h << 61);
+	h >>= 3;
+
+	for (int i = idLength - 2; i >= 0; --i) {
+		data[i] = QLatin1Char (base32Alphabet[l & 31]);
+		l = (l >> 5) | (h << 59);
+		h >>= 5;
+	}
+
+	return string;
+}
+
+QDebug operator<< (QDebug debug, const MattermostId& id)
+{
+	return debug << id.toString ();
+}
+
+} /* namespace Mattermost */
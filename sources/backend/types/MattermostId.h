@@ -0,0 +1,126 @@
+/**
+ * @file MattermostId.h
+ * @brief Compact 128-bit Mattermost object ID
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <QString>
+
+class QDebug;
+
+namespace Mattermost {
+
+/**
+ * User, channel, team and post IDs. The server generates them as 16 random bytes, encoded
+ * as 26 characters in base32 (alphabet "ybndrfg8ejkmcpqxot1uwisza345h769"). MattermostId keeps
+ * the 16 bytes, so comparison and hashing are two integer operations and no heap memory is used.
+ *
+ * The IDs are converted from strings once, when parsing the JSON from the server, and back to strings
+ * only when building requests. Strings, which are not in the server format, are interned in a global table,
+ * so that any string converts back to itself. An empty string is the null ID.
+ */
+class MattermostId {
+public:
+	MattermostId ();
+
+	//implicit, so that IDs from JSON, settings, etc. can be passed directly to lookups
+	MattermostId (const QString& string);
+public:
+	QString toString () const;
+
+	bool isNull () const;
+
+	/**
+	 * Same as isNull(). Matches QString, so that code, which checks IDs for emptiness, reads the same
+	 */
+	bool isEmpty () const;
+
+	size_t hash () const;
+
+	friend bool operator== (const MattermostId& left, const MattermostId& right);
+	friend bool operator< (const MattermostId& left, const MattermostId& right);
+private:
+	uint64_t	high;
+	uint64_t	low;
+};
+
+inline MattermostId::MattermostId ()
+:high (0)
+,low (0)
+{
+}
+
+inline bool MattermostId::isNull () const
+{
+	return !high && !low;
+}
+
+inline bool MattermostId::isEmpty () const
+{
+	return isNull ();
+}
+
+//non-member operators, so that a QString can be on either side
+inline bool operator== (const MattermostId& left, const MattermostId& right)
+{
+	return left.low == right.low && left.high == right.high;
+}
+
+inline bool operator!= (const MattermostId& left, const MattermostId& right)
+{
+	return !(left == right);
+}
+
+inline bool operator< (const MattermostId& left, const MattermostId& right)
+{
+	return left.high < right.high || (left.high == right.high && left.low < right.low);
+}
+
+inline size_t MattermostId::hash () const
+{
+	//the server IDs are random, the interned IDs differ in 'low'
+	return (size_t) (low ^ (high * 0x9E3779B97F4A7C15ull));
+}
+
+inline uint qHash (const MattermostId& id, uint seed = 0)
+{
+	return (uint) id.hash() ^ seed;
+}
+
+QDebug operator<< (QDebug debug, const MattermostId& id);
+
+} /* namespace Mattermost */
+
+namespace std {
+
+template<>
+struct hash<Mattermost::MattermostId> {
+	size_t operator() (const Mattermost::MattermostId& id) const
+	{
+		return id.hash ();
+	}
+};
+
+} /* namespace std */
@@ -38,7 +38,8 @@ public:
     FilterListDialog (QWidget *parent);
     ~FilterListDialog();
 private:
-    void applyFilter (const QString& filter);
+    //called on each edit of the filter text
+    virtual void applyFilter (const QString& filter) = 0;
     virtual void showContextMenu (const QPoint& pos) = 0;
 protected:
     Ui::FilterListDialog *ui;
@@ -0,0 +1,190 @@
+/**
+ * @file PublicChannelsModel.cpp
+ * @brief
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "PublicChannelsModel.h"
+
+#include <QPointer>
+#include "backend/Backend.h"
+#include "log.h"
+
+namespace Mattermost {
+
+namespace {
+
+//the view shows ~20 rows, so a page fills a few screens
+constexpr int channelsPerPage = 100;
+
+}
+
+PublicChannelsModel::PublicChannelsModel (Backend& backend, const MattermostId& teamId, QObject* parent)
+:QAbstractTableModel (parent)
+,backend (backend)
+,teamId (teamId)
+,nextPage (0)
+,hasMorePages (true)
+,loading (false)
+,generation (0)
+{
+}
+
+PublicChannelsModel::~PublicChannelsModel () = default;
+
+int PublicChannelsModel::rowCount (const QModelIndex& parent) const
+{
+	return parent.isValid() ? 0 : channels.size();
+}
+
+int PublicChannelsModel::columnCount (const QModelIndex& parent) const
+{
+	return parent.isValid() ? 0 : Column::columnCount;
+}
+
+QVariant PublicChannelsModel::data (const QModelIndex& index, int role) const
+{
+	const BackendChannelSummary* channel = getChannel (index);
+
+	if (!channel) {
+		return QVariant ();
+	}
+
+	switch (role) {
+	case Qt::DisplayRole:
+		return index.column() == nameColumn ? channel->display_name : channel->purpose;
+	case Qt::ToolTipRole:
+		return index.column() == nameColumn ? channel->name : channel->header;
+	default:
+		return QVariant ();
+	}
+}
+
+QVariant PublicChannelsModel::headerData (int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+		return QVariant ();
+	}
+
+	return section == nameColumn ? "Name" : "Purpose";
+}
+
+bool PublicChannelsModel::canFetchMore (const QModelIndex& parent) const
+{
+	return !parent.isValid() && searchTerm.isEmpty() && hasMorePages && !loading;
+}
+
+void PublicChannelsModel::fetchMore (const QModelIndex& parent)
+{
+	if (!canFetchMore (parent)) {
+		return;
+	}
+
+	setLoading (true);
+
+	QPointer<PublicChannelsModel> self (this);
+	uint32_t requestGeneration = generation;
+
+	backend.retrieveTeamPublicChannelsPage (teamId, nextPage, channelsPerPage, [self, requestGeneration] (std::vector<BackendChannelSummary>& newChannels) {
+		if (!self || self->generation != requestGeneration) {
+			return;
+		}
+
+		++self->nextPage;
+		self->hasMorePages = newChannels.size() == (size_t)channelsPerPage;
+		self->appendChannels (newChannels);
+		self->setLoading (false);
+	});
+}
+
+void PublicChannelsModel::setSearchTerm (const QString& term)
+{
+	QString trimmedTerm (term.trimmed());
+
+	if (trimmedTerm == searchTerm && generation != 0) {
+		return;
+	}
+
+	beginResetModel ();
+	++generation;
+	searchTerm = trimmedTerm;
+	channels.clear ();
+	channels.shrink_to_fit ();
+	nextPage = 0;
+	hasMorePages = true;
+	loading = false;
+	endResetModel ();
+
+	if (searchTerm.isEmpty()) {
+		fetchMore (QModelIndex());
+		return;
+	}
+
+	setLoading (true);
+
+	QPointer<PublicChannelsModel> self (this);
+	uint32_t requestGeneration = generation;
+
+	LOG_DEBUG (ui, "Search public channels" << LogField ("term", searchTerm));
+
+	backend.searchTeamPublicChannels (teamId, searchTerm, [self, requestGeneration] (std::vector<BackendChannelSummary>& newChannels) {
+		if (!self || self->generation != requestGeneration) {
+			return;
+		}
+
+		self->hasMorePages = false;
+		self->appendChannels (newChannels);
+		self->setLoading (false);
+	});
+}
+
+const BackendChannelSummary* PublicChannelsModel::getChannel (const QModelIndex& index) const
+{
+	if (!index.isValid() || index.row() < 0 || (size_t)index.row() >= channels.size()) {
+		return nullptr;
+	}
+
+	return &channels[index.row()];
+}
+
+bool PublicChannelsModel::isComplete () const
+{
+	return !hasMorePages && !loading;
+}
+
+void PublicChannelsModel::setLoading (bool loading)
+{
+	this->loading = loading;
+	emit loadingChanged (loading);
+}
+
+void PublicChannelsModel::appendChannels (std::vector<BackendChannelSummary>& newChannels)
+{
+	if (newChannels.empty()) {
+		return;
+	}
+
+	beginInsertRows (QModelIndex(), channels.size(), channels.size() + newChannels.size() - 1);
+	channels.insert (channels.end(), std::make_move_iterator (newChannels.begin()), std::make_move_iterator (newChannels.end()));
+	endInsertRows ();
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,89 @@
+/**
+ * @file PublicChannelsModel.h
+ * @brief Paged list of the public channels in a team
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <vector>
+#include <QAbstractTableModel>
+#include "backend/types/BackendChannelSummary.h"
+
+namespace Mattermost {
+
+class Backend;
+
+/**
+ * Model of the public channels in a team, for TeamChannelsListDialog. Without a search term, the channels
+ * are loaded a page at a time, when the view scrolls to the end of the loaded ones (canFetchMore() / fetchMore()).
+ * With a search term, the rows are the results of a server-side search. Replies to a page or a search,
+ * started before the term was changed, are ignored
+ */
+class PublicChannelsModel: public QAbstractTableModel {
+	Q_OBJECT
+public:
+	enum Column {
+		nameColumn,
+		purposeColumn,
+		columnCount
+	};
+
+	PublicChannelsModel (Backend& backend, const MattermostId& teamId, QObject* parent = nullptr);
+	virtual ~PublicChannelsModel ();
+public:
+	int rowCount (const QModelIndex& parent = QModelIndex()) const override;
+	int columnCount (const QModelIndex& parent = QModelIndex()) const override;
+	QVariant data (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+	QVariant headerData (int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+	bool canFetchMore (const QModelIndex& parent) const override;
+	void fetchMore (const QModelIndex& parent) override;
+
+	/**
+	 * Replace the rows with the search results for the term, or with the first page, if the term is empty
+	 */
+	void setSearchTerm (const QString& term);
+
+	const BackendChannelSummary* getChannel (const QModelIndex& index) const;
+
+	/**
+	 * Whether all the channels (or all the search results) are loaded
+	 */
+	bool isComplete () const;
+signals:
+	void loadingChanged (bool loading);
+private:
+	void setLoading (bool loading);
+	void appendChannels (std::vector<BackendChannelSummary>& newChannels);
+private:
+	Backend&							backend;
+	MattermostId						teamId;
+	std::vector<BackendChannelSummary>	channels;
+	QString								searchTerm;
+	int									nextPage;
+	bool								hasMorePages;
+	bool								loading;
+
+	//incremented when the rows are replaced, so that older replies can be recognized
+	uint32_t							generation;
+};
+
+} /* namespace Mattermost */
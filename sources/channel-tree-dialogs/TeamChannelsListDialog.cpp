@@ -24,91 +24,92 @@
 
 #include "TeamChannelsListDialog.h"
 
-#include <set>
 #include <QMenu>
 #include "backend/Backend.h"
-#include "backend/types/BackendChannel.h"
+#include "backend/types/BackendTeam.h"
 #include "info-dialogs/ChannelInfoDialog.h"
-#include "ui_FilterListDialog.h"
+#include "ui_TeamChannelsListDialog.h"
 
 
 namespace Mattermost {
 
 namespace {
 
-auto nameComparator = [] (const BackendChannel* const& lhs, const BackendChannel* const& rhs)
-{
-	return lhs->name < rhs->name;
-};
+//delay between the last key press in the search field and the search request
+constexpr int searchDelayMs = 300;
 
 }
 
-TeamChannelsListDialog::TeamChannelsListDialog (Backend& backend, const QString& teamName, const std::list<BackendChannel>& channels, QWidget *parent)
-:FilterListDialog (parent)
+TeamChannelsListDialog::TeamChannelsListDialog (Backend& backend, const BackendTeam& team, QWidget *parent)
+:QDialog (parent)
+,ui (new Ui::TeamChannelsListDialog)
 ,backend (backend)
+,model (backend, team.id)
 {
-	std::set<const BackendChannel*, decltype (nameComparator)> set (nameComparator);
+	ui->setupUi (this);
+	setAttribute (Qt::WA_DeleteOnClose);
 
-	for (auto& it: channels) {
-		set.insert (&it);
-	}
+	ui->teamLabel->setText ("Public Channels in team '" + team.display_name + "':");
+	ui->channelsView->setModel (&model);
+	ui->channelsView->header()->setSectionResizeMode (PublicChannelsModel::nameColumn, QHeaderView::Interactive);
+	ui->channelsView->header()->setSectionResizeMode (PublicChannelsModel::purposeColumn, QHeaderView::Stretch);
+	ui->channelsView->header()->resizeSection (PublicChannelsModel::nameColumn, 250);
 
-	uint32_t channelsCount = 0;
-	for (auto& channel: set) {
+	searchTimer.setSingleShot (true);
+	searchTimer.setInterval (searchDelayMs);
 
-		QTreeWidgetItem* item = new QTreeWidgetItem (ui->treeWidget, QStringList() << channel->display_name << channel->header);
-//		QImage img = QImage::fromData (user->avatar);
-//		item->setIcon (0, QIcon(QPixmap::fromImage(QImage::fromData (user->avatar)).scaled(32, 32)));
-		item->setData (0, Qt::UserRole, QVariant::fromValue ((BackendChannel*)channel));
-		ui->treeWidget->addTopLevelItem (item);
-		++channelsCount;
-	}
+	connect (&searchTimer, &QTimer::timeout, [this] {
+		model.setSearchTerm (ui->searchLineEdit->text());
+	});
 
-	setWindowTitle("Public Channels - Mattermost");
-	ui->selectUserLabel->setText ("Public Channels in team '" + teamName + "':");
-	ui->treeWidget->header()->setSectionResizeMode (0, QHeaderView::ResizeToContents);
-	ui->treeWidget->header()->setSectionResizeMode (1, QHeaderView::Stretch);
-	ui->usersCountLabel->setText(QString::number(channelsCount) + " channels");
-	ui->filterUsersLabel->setText("Filter channels by name");
+	connect (ui->searchLineEdit, &QLineEdit::textEdited, [this] {
+		searchTimer.start ();
+	});
+	connect (ui->channelsView, &QTreeView::customContextMenuRequested, this, &TeamChannelsListDialog::showContextMenu);
+	connect (&model, &PublicChannelsModel::rowsInserted, this, &TeamChannelsListDialog::updateChannelsCount);
+	connect (&model, &PublicChannelsModel::modelReset, this, &TeamChannelsListDialog::updateChannelsCount);
+	connect (&model, &PublicChannelsModel::loadingChanged, this, &TeamChannelsListDialog::updateChannelsCount);
 
-	ui->buttonBox->setStandardButtons(QDialogButtonBox::Close);
+	model.setSearchTerm (QString());
 }
 
 TeamChannelsListDialog::~TeamChannelsListDialog ()
 {
-	// TODO Auto-generated destructor stub
+	delete ui;
 }
 
 void TeamChannelsListDialog::showContextMenu (const QPoint& pos)
 {
-	// Create menu and insert some actions
-	QMenu myMenu;
-
-	// Handle global position
-	QPoint globalPos = ui->treeWidget->mapToGlobal(pos);
-
-	QTreeWidgetItem* pointedItem = ui->treeWidget->itemAt(pos);
+	const BackendChannelSummary* channel = model.getChannel (ui->channelsView->indexAt (pos));
 
-	if (!pointedItem) {
+	if (!channel) {
 		return;
 	}
 
-	BackendChannel *channel = pointedItem->data(0, Qt::UserRole).value<BackendChannel*>();
+	QMenu myMenu;
 
-	//direct channel
-	myMenu.addAction ("Join this channel", [this, channel] {
-		backend.joinChannel (*channel);
-	//	qDebug() << "View Profile for " << user->getDisplayName();
-		//UserProfileDialog* dialog = new UserProfileDialog (*user, ui->treeWidget);
-		//dialog->show ();
+	//the model may replace its rows while the menu is open, so the actions keep a copy
+	myMenu.addAction ("Join this channel", [this, summary = *channel] {
+		backend.joinChannel (summary);
 	});
 
-	myMenu.addAction ("View channel details", [this, channel] {
-		ChannelInfoDialog* dialog = new ChannelInfoDialog (*channel, this);
+	myMenu.addAction ("View channel details", [this, summary = *channel] {
+		ChannelInfoDialog* dialog = new ChannelInfoDialog (summary, backend.getStorage(), this);
 		dialog->show ();
 	});
 
-	myMenu.exec (globalPos + QPoint (15, 35));
+	myMenu.exec (ui->channelsView->viewport()->mapToGlobal (pos));
+}
+
+void TeamChannelsListDialog::updateChannelsCount ()
+{
+	QString text (QString::number (model.rowCount()) + " channels");
+
+	if (!model.isComplete()) {
+		text += ", loading...";
+	}
+
+	ui->channelsCountLabel->setText (text);
 }
 
 } /* namespace Mattermost */
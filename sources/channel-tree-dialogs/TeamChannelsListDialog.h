@@ -24,18 +24,35 @@
 
 #pragma once
 
-#include <list>
-#include "FilterListDialog.h"
+#include <QDialog>
+#include <QTimer>
+#include "PublicChannelsModel.h"
+
+namespace Ui {
+class TeamChannelsListDialog;
+}
 
 namespace Mattermost {
 
-class TeamChannelsListDialog: public FilterListDialog {
+class BackendTeam;
+
+/**
+ * Browser of the public channels in a team. The channels are listed by PublicChannelsModel, page by page
+ * while scrolling, and the search field runs a server-side search, shortly after the user stops typing
+ */
+class TeamChannelsListDialog: public QDialog {
+	Q_OBJECT
 public:
-	TeamChannelsListDialog (Backend& backend, const QString& teamName, const std::list<BackendChannel>& channels, QWidget *parent = nullptr);
+	TeamChannelsListDialog (Backend& backend, const BackendTeam& team, QWidget *parent = nullptr);
 	virtual ~TeamChannelsListDialog ();
-public:
-	void showContextMenu (const QPoint& pos)	override;
-	Backend& backend;
+private:
+	void showContextMenu (const QPoint& pos);
+	void updateChannelsCount ();
+private:
+	Ui::TeamChannelsListDialog*		ui;
+	Backend&						backend;
+	PublicChannelsModel				model;
+	QTimer							searchTimer;
 };
 
 } /* namespace Mattermost */
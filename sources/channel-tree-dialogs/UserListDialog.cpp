@@ -24,62 +24,56 @@
 
 #include "UserListDialog.h"
 
-#include <set>
 #include <QMenu>
+#include <QElapsedTimer>
 #include "backend/types/BackendUser.h"
 #include "info-dialogs/UserProfileDialog.h"
+#include "log.h"
 #include "ui_FilterListDialog.h"
 
 
 namespace Mattermost {
 
-bool UserListDialog::NameComparator::operator () (const BackendUser*const& lhs, const BackendUser*const& rhs)
-{
-	return lhs->username < rhs->username;
-}
+namespace {
 
-UserListDialog::UserListDialog (const UserListDialogConfig& cfg, const std::map<QString, BackendUser>& allUsers, const QSet<const BackendUser*>* alreadyExistingUsers, QWidget* parent)
-:FilterListDialog (parent)
+std::vector<const BackendUser*> toVector (const IdHashMap<BackendUser>& allUsers)
 {
-	setWindowTitle (cfg.title);
-	ui->selectUserLabel->setText(QCoreApplication::translate("FilterListDialog", cfg.description.toStdString().c_str(), nullptr));
-
-	std::set<const BackendUser*, NameComparator> set;
+	std::vector<const BackendUser*> users;
 
 	for (auto& it: allUsers) {
-		set.insert (&it.second);
+		users.push_back (&it.second);
 	}
 
+	return users;
+}
 
-	create (set, alreadyExistingUsers);
 }
 
-UserListDialog::UserListDialog (const UserListDialogConfig& cfg, const std::vector<const BackendUser*>& allUsers, const QSet<const BackendUser*>* alreadyExistingUsers, QWidget* parent)
+UserListDialog::UserListDialog (const UserListDialogConfig& cfg, const IdHashMap<BackendUser>& allUsers, const ExistingUserCheck& isExistingUser, QWidget* parent)
 :FilterListDialog (parent)
+,model (toVector (allUsers), isExistingUser)
 {
-	setWindowTitle (cfg.title);
-	ui->selectUserLabel->setText(QCoreApplication::translate("FilterListDialog", cfg.description.toStdString().c_str(), nullptr));
-
-    std::set<const BackendUser*, NameComparator> set;
-
-    for (auto& it: allUsers) {
-    	set.insert (it);
-    }
+	create (cfg);
+}
 
-    create (set, alreadyExistingUsers);
+UserListDialog::UserListDialog (const UserListDialogConfig& cfg, const std::vector<const BackendUser*>& allUsers, const ExistingUserCheck& isExistingUser, QWidget* parent)
+:FilterListDialog (parent)
+,model (std::vector<const BackendUser*> (allUsers), isExistingUser)
+{
+	create (cfg);
 }
 
 UserListDialog::~UserListDialog () = default;
 
 const BackendUser* UserListDialog::getSelectedUser ()
 {
-	auto selection = ui->treeWidget->selectedItems();
+	auto selection = ui->treeView->selectionModel()->selectedRows();
 
 	if (selection.size() == 0) {
 		return nullptr;
 	}
 
-	return selection.first()->data(0, Qt::UserRole).value<BackendUser*>();
+	return model.getUser (selection.first());
 }
 
 void UserListDialog::showContextMenu (const QPoint& pos)
@@ -88,60 +82,50 @@ void UserListDialog::showContextMenu (const QPoint& pos)
 	QMenu myMenu;
 
 	// Handle global position
-	QPoint globalPos = ui->treeWidget->mapToGlobal(pos);
+	QPoint globalPos = ui->treeView->viewport()->mapToGlobal(pos);
 
-	QTreeWidgetItem* pointedItem = ui->treeWidget->itemAt(pos);
+	const BackendUser* user = model.getUser (ui->treeView->indexAt(pos));
 
-	if (!pointedItem) {
+	if (!user) {
 		return;
 	}
 
-	BackendUser *user = pointedItem->data(0, Qt::UserRole).value<BackendUser*>();
-
 	//direct channel
 	myMenu.addAction ("View Profile", [this, user] {
 	//	qDebug() << "View Profile for " << user->getDisplayName();
-		UserProfileDialog* dialog = new UserProfileDialog (*user, ui->treeWidget);
+		UserProfileDialog* dialog = new UserProfileDialog (*user, ui->treeView);
 		dialog->show ();
 	});
 
-	myMenu.exec (globalPos + QPoint (15, 35));
+	myMenu.exec (globalPos);
 }
 
-void UserListDialog::create (const std::set<const BackendUser*, UserListDialog::NameComparator>& users, const QSet<const BackendUser*>* alreadyExistingUsers)
+void UserListDialog::applyFilter (const QString& filter)
 {
-	uint32_t usersCount = 0;
-	for (const BackendUser* user: users) {
-		QString displayName (user->getDisplayName());
-
-		if (!user->nickname.isEmpty()) {
-			displayName += " (" + user->nickname + ")";
-		}
-
-		QTreeWidgetItem* item = new QTreeWidgetItem (ui->treeWidget, QStringList() << displayName << user->status);
-		QImage img = QImage::fromData (user->avatar);
-		item->setIcon (0, QIcon(QPixmap::fromImage(QImage::fromData (user->avatar))));
-		item->setData (0, Qt::UserRole, QVariant::fromValue ((BackendUser*)user));
-
-		/**
-		 * Mark already existing users in italic
-		 */
-		if (alreadyExistingUsers && alreadyExistingUsers->find (user) != alreadyExistingUsers->end()) {
-
-			QFont font (item->font(0));
-			font.setItalic (true);
-			item->setFont (0, font);
-		}
-
-		ui->treeWidget->addTopLevelItem (item);
-		++usersCount;
-	}
+	QElapsedTimer timer;
+	timer.start ();
 
-	ui->treeWidget->setIconSize(QSize (24,24));
-	ui->treeWidget->header()->setSectionResizeMode (0, QHeaderView::Stretch);
-	ui->treeWidget->header()->setSectionResizeMode (1, QHeaderView::ResizeToContents);
-	ui->usersCountLabel->setText(QString::number(usersCount) + " users");
+	model.setFilter (filter);
+	updateUsersCount ();
+
+	LOG_DEBUG (ui, "User list filter" << LogField ("matches", model.rowCount()) << LogField ("us", timer.nsecsElapsed() / 1000));
 }
 
-} /* namespace Mattermost */
+void UserListDialog::create (const UserListDialogConfig& cfg)
+{
+	setWindowTitle (cfg.title);
+	ui->selectUserLabel->setText(QCoreApplication::translate("FilterListDialog", cfg.description.toStdString().c_str(), nullptr));
 
+	ui->treeView->setModel (&model);
+	ui->treeView->setIconSize(QSize (24,24));
+	ui->treeView->header()->setSectionResizeMode (UserListModel::nameColumn, QHeaderView::Stretch);
+	ui->treeView->header()->setSectionResizeMode (UserListModel::statusColumn, QHeaderView::ResizeToContents);
+	updateUsersCount ();
+}
+
+void UserListDialog::updateUsersCount ()
+{
+	ui->usersCountLabel->setText(QString::number(model.rowCount()) + " users");
+}
+
+} /* namespace Mattermost */
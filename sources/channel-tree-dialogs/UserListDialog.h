@@ -24,8 +24,10 @@
 
 #pragma once
 
-#include <set>
+#include <functional>
 #include "FilterListDialog.h"
+#include "UserListModel.h"
+#include "backend/IdHashMap.h"
 
 namespace Mattermost {
 
@@ -41,19 +43,21 @@ struct UserListDialogConfig {
 
 class UserListDialog: public FilterListDialog {
 public:
-	UserListDialog (const UserListDialogConfig& cfg, const std::map<QString, BackendUser>& allUsers, const QSet<const BackendUser*>* alreadyExistingUsers, QWidget *parent);
-	UserListDialog (const UserListDialogConfig& cfg, const std::vector<const BackendUser*>& allUsers, const QSet<const BackendUser*>* alreadyExistingUsers, QWidget *parent);
+	//whether the user is already a member (shown in italic). May be empty
+	using ExistingUserCheck = UserListModel::ExistingUserCheck;
+
+	UserListDialog (const UserListDialogConfig& cfg, const IdHashMap<BackendUser>& allUsers, const ExistingUserCheck& isExistingUser, QWidget *parent);
+	UserListDialog (const UserListDialogConfig& cfg, const std::vector<const BackendUser*>& allUsers, const ExistingUserCheck& isExistingUser, QWidget *parent);
 	virtual ~UserListDialog ();
 public:
     const BackendUser* getSelectedUser ();
     void showContextMenu (const QPoint& pos)	override;
 private:
-
-    struct NameComparator {
-    	bool operator () (const BackendUser* const& lhs, const BackendUser* const& rhs);
-    };
-    void create (const std::set<const BackendUser*, NameComparator>& users, const QSet<const BackendUser*>* alreadyExistingUsers);
-
+    void applyFilter (const QString& filter)	override;
+    void create (const UserListDialogConfig& cfg);
+    void updateUsersCount ();
+private:
+    UserListModel		model;
 };
 
 } /* namespace Mattermost */
@@ -0,0 +1,141 @@
+/**
+ * @file UserListModel.cpp
+ * @brief
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "UserListModel.h"
+
+#include <QFont>
+#include <QPixmap>
+#include "backend/types/BackendUser.h"
+
+namespace Mattermost {
+
+namespace {
+
+constexpr int avatarSize = 24;
+
+}
+
+UserListModel::UserListModel (std::vector<const BackendUser*>&& users, const ExistingUserCheck& isExistingUser, QObject* parent)
+:QAbstractTableModel (parent)
+,index (std::move (users))
+,rows (index.search (QString()))
+,isExistingUser (isExistingUser)
+{
+}
+
+UserListModel::~UserListModel () = default;
+
+int UserListModel::rowCount (const QModelIndex& parent) const
+{
+	return parent.isValid() ? 0 : rows.size();
+}
+
+int UserListModel::columnCount (const QModelIndex& parent) const
+{
+	return parent.isValid() ? 0 : Column::columnCount;
+}
+
+QVariant UserListModel::data (const QModelIndex& index, int role) const
+{
+	const BackendUser* user = getUser (index);
+
+	if (!user) {
+		return QVariant ();
+	}
+
+	if (index.column() == statusColumn) {
+		return role == Qt::DisplayRole ? QVariant (user->status) : QVariant ();
+	}
+
+	switch (role) {
+	case Qt::DisplayRole: {
+		QString displayName (user->getDisplayName());
+
+		if (!user->nickname.isEmpty()) {
+			displayName += " (" + user->nickname + ")";
+		}
+
+		return displayName;
+	}
+	case Qt::DecorationRole:
+		return getAvatarIcon (*user);
+	case Qt::FontRole: {
+		//mark already existing users in italic
+		if (!isExistingUser || !isExistingUser (*user)) {
+			return QVariant ();
+		}
+
+		QFont font;
+		font.setItalic (true);
+		return font;
+	}
+	default:
+		return QVariant ();
+	}
+}
+
+QVariant UserListModel::headerData (int section, Qt::Orientation orientation, int role) const
+{
+	if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+		return QVariant ();
+	}
+
+	return section == nameColumn ? "Name" : "Status";
+}
+
+void UserListModel::setFilter (const QString& filter)
+{
+	beginResetModel ();
+	rows = index.search (filter);
+	endResetModel ();
+}
+
+const BackendUser* UserListModel::getUser (const QModelIndex& index) const
+{
+	if (!index.isValid() || index.row() < 0 || (size_t)index.row() >= rows.size()) {
+		return nullptr;
+	}
+
+	return this->index.getUsers()[rows[index.row()]];
+}
+
+QIcon UserListModel::getAvatarIcon (const BackendUser& user) const
+{
+	auto it = icons.find (user.id);
+
+	if (it != icons.end()) {
+		return it->second;
+	}
+
+	QIcon icon;
+
+	if (!user.avatar.isEmpty()) {
+		icon = QIcon (QPixmap::fromImage (QImage::fromData (user.avatar).scaled (avatarSize, avatarSize, Qt::KeepAspectRatio, Qt::SmoothTransformation)));
+	}
+
+	icons.emplace (user.id, icon);
+	return icon;
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,72 @@
+/**
+ * @file UserListModel.h
+ * @brief Filtered list of users for the user dialogs
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <functional>
+#include <QAbstractTableModel>
+#include <QIcon>
+#include "backend/UserSearchIndex.h"
+#include "backend/IdHashMap.h"
+
+namespace Mattermost {
+
+/**
+ * Model of the users in UserListDialog. The rows are the users, matching the filter (see UserSearchIndex),
+ * in username order. Everything shown is computed when the view asks for it, so only the visible rows
+ * cost anything - the avatar icons are decoded the first time they are shown
+ */
+class UserListModel: public QAbstractTableModel {
+	Q_OBJECT
+public:
+	//whether the user is already a member (shown in italic). May be empty
+	using ExistingUserCheck = std::function<bool (const BackendUser&)>;
+
+	enum Column {
+		nameColumn,
+		statusColumn,
+		columnCount
+	};
+
+	UserListModel (std::vector<const BackendUser*>&& users, const ExistingUserCheck& isExistingUser, QObject* parent = nullptr);
+	virtual ~UserListModel ();
+public:
+	int rowCount (const QModelIndex& parent = QModelIndex()) const override;
+	int columnCount (const QModelIndex& parent = QModelIndex()) const override;
+	QVariant data (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+	QVariant headerData (int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+	void setFilter (const QString& filter);
+
+	const BackendUser* getUser (const QModelIndex& index) const;
+private:
+	QIcon getAvatarIcon (const BackendUser& user) const;
+private:
+	UserSearchIndex				index;
+	std::vector<uint32_t>		rows;		//positions in index.getUsers()
+	ExistingUserCheck			isExistingUser;
+	mutable IdHashMap<QIcon>	icons;
+};
+
+} /* namespace Mattermost */
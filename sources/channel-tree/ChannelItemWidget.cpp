@@ -35,7 +35,7 @@ ChannelItemWidget::~ChannelItemWidget()
 
 const QPixmap ChannelItemWidget::getPixmap () const
 {
-#if QT_VERSION <= QT_VERSION_CHECK(5,15,0)
+#if QT_VERSION < QT_VERSION_CHECK(5,15,0)
 	return ui->icon->pixmap () ? *ui->icon->pixmap () : QPixmap();
 #else
 	return ui->icon->pixmap (Qt::ReturnByValue);
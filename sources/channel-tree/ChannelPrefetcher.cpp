@@ -0,0 +1,324 @@
+/**
+ * @file ChannelPrefetcher.cpp
+ * @brief Loads the channels, which are likely to be opened next, while the user is idle
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include <algorithm>
+#include <QApplication>
+#include <QDateTime>
+#include <QTreeWidgetItem>
+#include "ChannelPrefetcher.h"
+#include "ChannelTree.h"
+#include "chat-area/ChatArea.h"
+#include "backend/Backend.h"
+#include "backend/types/BackendChannel.h"
+#include "backend/types/BackendUser.h"
+#include "Settings.h"
+#include "log.h"
+
+namespace Mattermost {
+
+namespace {
+
+constexpr int idleCheckIntervalMs = 1000;
+
+//no keyboard or mouse input for this long
+constexpr qint64 idleInputMs = 2000;
+
+constexpr qint64 bandwidthWindowMs = 60000;
+constexpr uint32_t defaultBandwidthBudgetKB = 1024;
+
+//the open counts are saved this long after a channel switch, so a burst of switches is saved once
+constexpr int openCountsSaveDelayMs = 60000;
+
+//when a count reaches this, or there are more channels than this, all counts are halved (see decayOpenCounts())
+constexpr int maxOpenCount = 100;
+constexpr int maxOpenCountChannels = 200;
+
+constexpr const char* openCountsKey = "channel_open_counts";
+
+}
+
+double ChannelPrefetchStats::hitRate () const
+{
+	return firstViews ? (double) prefetchHits / firstViews : 0;
+}
+
+ChannelPrefetcher::ChannelPrefetcher (Backend& backend, ChannelTree& channelTree, QObject* parent)
+:QObject (parent)
+,backend (backend)
+,channelTree (channelTree)
+,receivedBytesAtStart (0)
+{
+	QSettings settings;
+	bandwidthBudgetBytes = (uint64_t) settings.value (PREFETCH_BANDWIDTH, defaultBandwidthBudgetKB).toUInt() * 1024;
+	openCounts = settings.value (openCountsKey).toMap();
+	decayOpenCounts ();
+
+	lastInputTimer.start ();
+	clock.start ();
+	qApp->installEventFilter (this);
+
+	//connected after the tree's own handler, so the chat area is already activated here
+	connect (&channelTree, &QTreeWidget::currentItemChanged, this, &ChannelPrefetcher::onChannelSwitched);
+
+	connect (&idleTimer, &QTimer::timeout, this, &ChannelPrefetcher::prefetchNext);
+
+	saveTimer.setSingleShot (true);
+	connect (&saveTimer, &QTimer::timeout, this, &ChannelPrefetcher::saveOpenCounts);
+
+	//a budget of 0 disables the prefetching
+	if (bandwidthBudgetBytes) {
+		idleTimer.start (idleCheckIntervalMs);
+	}
+}
+
+ChannelPrefetcher::~ChannelPrefetcher ()
+{
+	qApp->removeEventFilter (this);
+
+	if (saveTimer.isActive()) {
+		saveOpenCounts ();
+	}
+}
+
+const ChannelPrefetchStats& ChannelPrefetcher::getStats () const
+{
+	return stats;
+}
+
+bool ChannelPrefetcher::eventFilter (QObject* watched, QEvent* event)
+{
+	switch (event->type()) {
+	case QEvent::KeyPress:
+	case QEvent::MouseButtonPress:
+	case QEvent::MouseMove:
+	case QEvent::Wheel:
+		lastInputTimer.restart ();
+		break;
+	default:
+		break;
+	}
+
+	return QObject::eventFilter (watched, event);
+}
+
+void ChannelPrefetcher::onChannelSwitched (QTreeWidgetItem* item)
+{
+	ChatArea* chatArea = item ? item->data(0, Qt::UserRole).value<ChatArea*>() : nullptr;
+
+	if (!chatArea) {
+		return;
+	}
+
+	++stats.switches;
+
+	if (chatArea->postsReadyOnActivate) {
+		++stats.instantSwitches;
+	}
+
+	//channels, which were shown before, are loaded and not prefetched
+	if (!chatArea->postsReadyOnActivate || chatArea->prefetched) {
+		++stats.firstViews;
+	}
+
+	if (chatArea->prefetched && chatArea->postsReadyOnActivate) {
+		++stats.prefetchHits;
+	}
+
+	chatArea->prefetched = false;
+
+	QString channelId (chatArea->channel.id.toString());
+	int openCount = openCounts.value(channelId).toInt() + 1;
+	openCounts[channelId] = openCount;
+
+	if (openCount >= maxOpenCount || openCounts.size() > maxOpenCountChannels) {
+		decayOpenCounts ();
+	}
+
+	if (!saveTimer.isActive()) {
+		saveTimer.start (openCountsSaveDelayMs);
+	}
+
+	LOG_DEBUG (ui, "Channel switch to " << chatArea->channel.display_name << LogField ("instant", chatArea->postsReadyOnActivate)
+			<< LogField ("prefetch_hits", stats.prefetchHits) << LogField ("first_views", stats.firstViews));
+}
+
+/**
+ * Halves all counts (until they fit the limits), so that the map does not grow without limit and the channels,
+ * which the user opens lately, outrank the ones opened often long ago. The channels opened once are dropped first
+ */
+void ChannelPrefetcher::decayOpenCounts ()
+{
+	auto overLimit = [this] {
+		return openCounts.size() > maxOpenCountChannels || std::any_of (openCounts.cbegin(), openCounts.cend(), [] (const QVariant& count) {
+			return count.toInt() >= maxOpenCount;
+		});
+	};
+
+	while (overLimit ()) {
+		for (auto it = openCounts.begin(); it != openCounts.end();) {
+			int count = it.value().toInt() / 2;
+
+			if (count) {
+				it.value() = count;
+				++it;
+			} else {
+				it = openCounts.erase (it);
+			}
+		}
+	}
+}
+
+void ChannelPrefetcher::saveOpenCounts ()
+{
+	saveTimer.stop ();
+
+	QSettings settings;
+	settings.setValue (openCountsKey, openCounts);
+}
+
+void ChannelPrefetcher::prefetchNext ()
+{
+	if (currentChatArea) {
+
+		if (currentChatArea->isLoading()) {
+			return;
+		}
+
+		uint64_t bytes = getReceivedBytes() - receivedBytesAtStart;
+		recentPrefetches.push_back (PrefetchRecord {clock.elapsed(), bytes});
+		stats.prefetchedBytes += bytes;
+
+		//most avatars are requested with the users at startup, the ones of other authors are requested here
+		for (BackendPost* post: currentChatArea->channel.posts) {
+			if (post->author && post->author->avatar.isEmpty()) {
+				backend.retrieveUserAvatar (post->author->id, post->author->update_at);
+			}
+		}
+
+		LOG_DEBUG (ui, "Prefetched " << currentChatArea->channel.display_name << LogField ("loaded", currentChatArea->isLoaded())
+				<< LogField ("bytes", bytes) << LogField ("ms", prefetchTimer.elapsed()));
+		currentChatArea = nullptr;
+	}
+
+	if (lastInputTimer.elapsed() < idleInputMs || backend.getPendingHttpRequestsCount()) {
+		return;
+	}
+
+	const PostHistoryBudget& historyBudget = backend.getHistoryBudget ();
+
+	//a budget of 0 disables the trimming, so the history never gets near it
+	bool nearHistoryBudget = historyBudget.getBudget() != 0 && historyBudget.getHistoryMemory() * 4 >= historyBudget.getBudget() * 3;
+
+	if (nearHistoryBudget || getRecentPrefetchedBytes() >= bandwidthBudgetBytes) {
+		return;
+	}
+
+	ChatArea* bestChatArea = nullptr;
+	double bestScore = 0;
+
+	for (ChatArea* chatArea: channelTree.getChatAreas ()) {
+
+		//a failed prefetch is not repeated, the channel is loaded when it is shown
+		if (!chatArea || chatArea->isLoaded() || chatArea->isLoading() || chatArea->prefetched) {
+			continue;
+		}
+
+		double score = getScore (*chatArea);
+
+		if (score > bestScore) {
+			bestScore = score;
+			bestChatArea = chatArea;
+		}
+	}
+
+	//nothing, which is likely to be opened
+	if (!bestChatArea) {
+		return;
+	}
+
+	LOG_DEBUG (ui, "Prefetch " << bestChatArea->channel.display_name << LogField ("score", bestScore));
+
+	currentChatArea = bestChatArea;
+	receivedBytesAtStart = getReceivedBytes ();
+	prefetchTimer.start ();
+	++stats.prefetchedChannels;
+
+	bestChatArea->prefetched = true;
+	bestChatArea->loadPosts ();
+}
+
+double ChannelPrefetcher::getScore (const ChatArea& chatArea) const
+{
+	const BackendChannel& channel = chatArea.channel;
+	double score = 0;
+
+	if (chatArea.unreadMessagesCount || !chatArea.lastReadPostId.isEmpty()) {
+		score += 100;
+
+		//every post in a direct or group channel is a mention
+		if (channel.type == BackendChannel::directChannel || channel.type == BackendChannel::groupChannel) {
+			score += 100;
+		}
+	}
+
+	//user history, saturating, so that the favourite channels do not hide the unread ones
+	int openCount = openCounts.value(channel.id.toString()).toInt();
+	score += 50.0 * openCount / (openCount + 5);
+
+	//channels with recent posts. The score halves every day
+	if (channel.last_post_at) {
+		double ageDays = std::max<qint64> (QDateTime::currentMSecsSinceEpoch() - (qint64) channel.last_post_at, 0) / (24 * 3600 * 1000.0);
+		score += 30 / (1 + ageDays);
+	}
+
+	return score;
+}
+
+uint64_t ChannelPrefetcher::getReceivedBytes () const
+{
+	uint64_t bytes = 0;
+
+	for (const auto& it: backend.getNetworkMetrics().getEndpoints()) {
+		bytes += it.second.responseBytes;
+	}
+
+	return bytes;
+}
+
+uint64_t ChannelPrefetcher::getRecentPrefetchedBytes ()
+{
+	while (!recentPrefetches.empty() && clock.elapsed() - recentPrefetches.front().timeMs > bandwidthWindowMs) {
+		recentPrefetches.pop_front ();
+	}
+
+	uint64_t bytes = 0;
+
+	for (const PrefetchRecord& record: recentPrefetches) {
+		bytes += record.bytes;
+	}
+
+	return bytes;
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,111 @@
+/**
+ * @file ChannelPrefetcher.h
+ * @brief Loads the channels, which are likely to be opened next, while the user is idle
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <deque>
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVariantMap>
+#include <QPointer>
+
+class QTreeWidgetItem;
+
+namespace Mattermost {
+
+class Backend;
+class ChannelTree;
+class ChatArea;
+
+struct ChannelPrefetchStats {
+
+	/**
+	 * Part of the switches to a channel, not shown before, which found the channel prefetched
+	 */
+	double hitRate () const;
+
+	uint32_t		switches = 0;			//!< all channel switches
+	uint32_t		instantSwitches = 0;	//!< switches, for which the posts were already loaded
+	uint32_t		firstViews = 0;			//!< switches to a channel, not shown before
+	uint32_t		prefetchHits = 0;		//!< first views of a prefetched channel
+	uint32_t		prefetchedChannels = 0;
+	uint64_t		prefetchedBytes = 0;
+};
+
+/**
+ * Channels are loaded when they are shown for the first time (see ChatArea::loadPosts()). While the user is idle
+ * (no input and no pending requests), this class loads the channels, which are likely to be opened next,
+ * one at a time, so that switching to them is instant. Loading a channel gets its newest posts, creates their
+ * widgets (laid out in the hidden chat area) and requests the missing avatars of their authors.
+ *
+ * Channels are ranked by unread posts (direct and group channels count as mentions), by how often the user
+ * opens them (saved in the settings periodically and at exit) and by the time of their last post. Prefetching stops, when the loaded
+ * history of all channels reaches 3/4 of the memory budget (see PostHistoryBudget), or when the prefetched
+ * data of the last minute reaches the bandwidth budget
+ */
+class ChannelPrefetcher: public QObject {
+	Q_OBJECT
+public:
+	ChannelPrefetcher (Backend& backend, ChannelTree& channelTree, QObject* parent);
+	virtual ~ChannelPrefetcher ();
+public:
+	const ChannelPrefetchStats& getStats () const;
+private:
+	bool eventFilter (QObject* watched, QEvent* event) override;
+	void onChannelSwitched (QTreeWidgetItem* item);
+	void decayOpenCounts ();
+	void saveOpenCounts ();
+	void prefetchNext ();
+	double getScore (const ChatArea& chatArea) const;
+	uint64_t getReceivedBytes () const;
+	uint64_t getRecentPrefetchedBytes ();
+private:
+	struct PrefetchRecord {
+		qint64		timeMs;
+		uint64_t	bytes;
+	};
+
+	Backend&					backend;
+	ChannelTree&				channelTree;
+	QTimer						idleTimer;
+	QElapsedTimer				lastInputTimer;
+	QElapsedTimer				clock;
+
+	//the channel, which is being prefetched, and the received bytes when it was started
+	QPointer<ChatArea>			currentChatArea;
+	uint64_t					receivedBytesAtStart;
+	QElapsedTimer				prefetchTimer;
+
+	//prefetches of the last minute, for the bandwidth budget
+	std::deque<PrefetchRecord>	recentPrefetches;
+	uint64_t					bandwidthBudgetBytes;
+
+	//channel ID -> how many times the user has opened the channel. Saved by saveTimer, not on every switch
+	QVariantMap					openCounts;
+	QTimer						saveTimer;
+	ChannelPrefetchStats		stats;
+};
+
+} /* namespace Mattermost */
@@ -0,0 +1,190 @@
+/**
+ * @file ChannelSwitchBenchmark.cpp
+ * @brief Benchmark, which switches between the channels and reports the switch time percentiles
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "ChannelSwitchBenchmark.h"
+
+#include <QApplication>
+#include <QTextStream>
+#include "ChannelTree.h"
+#include "chat-area/ChatArea.h"
+#include "backend/Backend.h"
+#include "backend/types/BackendChannel.h"
+#include "log.h"
+
+namespace Mattermost {
+
+namespace {
+
+constexpr int idleCheckIntervalMs = 500;
+
+//pause between the switches, so that the avatar and other follow-up requests of a switch are not measured in the next one
+constexpr int switchPauseMs = 300;
+
+//longer than the timeout of ChannelSwitchMetrics, which abandons the switch first
+constexpr int switchTimeoutMs = 15000;
+
+QString formatPercentiles (const LatencyHistogram& histogram)
+{
+	return QString ("%1 %2").arg (histogram.percentile (0.5) / 1000.0, 9, 'f', 1).arg (histogram.percentile (0.95) / 1000.0, 9, 'f', 1);
+}
+
+}
+
+ChannelSwitchBenchmark::ChannelSwitchBenchmark (Backend& backend, ChannelTree& channelTree, uint32_t switches, QObject* parent)
+:QObject (parent)
+,backend (backend)
+,channelTree (channelTree)
+,switches (switches)
+,failedSwitches (0)
+,nextChannelIndex (0)
+{
+	idleTimer.setInterval (idleCheckIntervalMs);
+	connect (&idleTimer, &QTimer::timeout, this, &ChannelSwitchBenchmark::waitForIdle);
+
+	switchTimer.setSingleShot (true);
+	switchTimer.setInterval (switchTimeoutMs);
+	connect (&switchTimer, &QTimer::timeout, this, &ChannelSwitchBenchmark::onSwitchTimeout);
+
+	//the direct and group channels are added to the tree by the main window's handler of the same signal
+	connect (&backend, &Backend::onAllTeamChannelsPopulated, this, [this] {
+		idleTimer.start ();
+	}, Qt::QueuedConnection);
+
+	LOG_INFO (ui, "Channel switch benchmark: waiting for the channels" << LogField ("switches", switches));
+}
+
+ChannelSwitchBenchmark::~ChannelSwitchBenchmark () = default;
+
+void ChannelSwitchBenchmark::waitForIdle ()
+{
+	if (backend.getPendingHttpRequestsCount()) {
+		return;
+	}
+
+	idleTimer.stop ();
+	start ();
+}
+
+void ChannelSwitchBenchmark::start ()
+{
+	for (ChatArea* chatArea: channelTree.getChatAreas ()) {
+		if (chatArea) {
+			channelIds.push_back (chatArea->channel.id);
+		}
+	}
+
+	if (channelIds.size() < 2) {
+		qCritical() << "Channel switch benchmark: at least 2 channels are needed, found " << channelIds.size();
+		qApp->exit (1);
+		return;
+	}
+
+	LOG_INFO (ui, "Channel switch benchmark started" << LogField ("channels", channelIds.size()));
+	connect (&ChannelSwitchMetrics::instance(), &ChannelSwitchMetrics::switchFinished, this, &ChannelSwitchBenchmark::onSwitchFinished);
+	switchNext ();
+}
+
+void ChannelSwitchBenchmark::switchNext ()
+{
+	if (records.size() + failedSwitches >= switches) {
+		report ();
+		return;
+	}
+
+	MattermostId channelId (channelIds[nextChannelIndex]);
+	nextChannelIndex = (nextChannelIndex + 1) % channelIds.size();
+
+	//opening the current channel does not switch
+	ChatArea* currentPage = channelTree.getCurrentPage ();
+	if (currentPage && currentPage->channel.id == channelId) {
+		channelId = channelIds[nextChannelIndex];
+		nextChannelIndex = (nextChannelIndex + 1) % channelIds.size();
+	}
+
+	switchTimer.start ();
+	channelTree.openChannel (channelId);
+}
+
+void ChannelSwitchBenchmark::onSwitchFinished (const ChannelSwitchRecord& record)
+{
+	if (!switchTimer.isActive()) {
+		return;
+	}
+
+	switchTimer.stop ();
+	records.push_back (record);
+	QTimer::singleShot (switchPauseMs, this, &ChannelSwitchBenchmark::switchNext);
+}
+
+void ChannelSwitchBenchmark::onSwitchTimeout ()
+{
+	LOG_WARNING (ui, "Channel switch benchmark: switch not finished in " << switchTimeoutMs << " ms");
+	++failedSwitches;
+	switchNext ();
+}
+
+void ChannelSwitchBenchmark::report ()
+{
+	std::array<LatencyHistogram, SwitchPhase::count> phases;
+	LatencyHistogram total;
+	LatencyHistogram cold;
+	LatencyHistogram warm;
+	uint32_t overBudget = 0;
+
+	for (const ChannelSwitchRecord& record: records) {
+		for (int phase = 0; phase < SwitchPhase::count; ++phase) {
+			phases[phase].add (record.phaseUs[phase]);
+		}
+
+		total.add (record.totalUs);
+		(record.cold ? cold : warm).add (record.totalUs);
+
+		if (record.totalUs > ChannelSwitchMetrics::budgetMs * 1000) {
+			++overBudget;
+		}
+	}
+
+	QTextStream out (stdout);
+	out << "Channel switches: " << records.size() << " (" << cold.count() << " cold, " << warm.count() << " warm, "
+		<< failedSwitches << " not finished), " << overBudget << " over the budget of " << ChannelSwitchMetrics::budgetMs << " ms\n";
+	out << "phase           p50 ms    p95 ms\n";
+
+	for (int phase = 0; phase < SwitchPhase::count; ++phase) {
+		out << QString (ChannelSwitchMetrics::phaseName ((SwitchPhase::type) phase)).leftJustified (12) << formatPercentiles (phases[phase]) << "\n";
+	}
+
+	out << QString ("total").leftJustified (12) << formatPercentiles (total) << "\n";
+	out << QString ("total cold").leftJustified (12) << formatPercentiles (cold) << "\n";
+	out << QString ("total warm").leftJustified (12) << formatPercentiles (warm) << "\n";
+	out.flush ();
+
+	LOG_INFO (ui, "Channel switch benchmark finished" << LogField ("switches", (uint32_t)records.size())
+			<< LogField ("p50_ms", total.percentile (0.5) / 1000.0)
+			<< LogField ("p95_ms", total.percentile (0.95) / 1000.0)
+			<< LogField ("failed", failedSwitches));
+
+	qApp->quit ();
+}
+
+} /* namespace Mattermost */
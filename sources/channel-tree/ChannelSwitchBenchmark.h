@@ -0,0 +1,70 @@
+/**
+ * @file ChannelSwitchBenchmark.h
+ * @brief Benchmark, which switches between the channels and reports the switch time percentiles
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <vector>
+#include <QObject>
+#include <QTimer>
+#include "backend/types/MattermostId.h"
+#include "log/ChannelSwitchMetrics.h"
+
+namespace Mattermost {
+
+class Backend;
+class ChannelTree;
+
+/**
+ * Started with --switch-benchmark, normally against the stand-in server. When the channels are loaded and
+ * the startup requests have finished, opens the channels of the tree one after the other, until the given
+ * number of switches is measured (see ChannelSwitchMetrics). Then prints the p50 / p95 of each phase
+ * and quits. The first switch to a channel has to fetch its posts (unless ChannelPrefetcher has loaded it
+ * during the pauses), the next ones only show it, so the cold and warm switches are reported separately
+ */
+class ChannelSwitchBenchmark: public QObject {
+	Q_OBJECT
+public:
+	ChannelSwitchBenchmark (Backend& backend, ChannelTree& channelTree, uint32_t switches, QObject* parent);
+	virtual ~ChannelSwitchBenchmark ();
+private:
+	void waitForIdle ();
+	void start ();
+	void switchNext ();
+	void onSwitchFinished (const ChannelSwitchRecord& record);
+	void onSwitchTimeout ();
+	void report ();
+private:
+	Backend&							backend;
+	ChannelTree&						channelTree;
+	uint32_t							switches;
+	uint32_t							failedSwitches;
+	QTimer								idleTimer;
+	QTimer								switchTimer;
+
+	QList<MattermostId>					channelIds;
+	int									nextChannelIndex;
+	std::vector<ChannelSwitchRecord>	records;
+};
+
+} /* namespace Mattermost */
@@ -31,6 +31,8 @@
 #include "backend/types/BackendTeam.h"
 #include "backend/Backend.h"
 #include "log.h"
+#include "log/Tracer.h"
+#include "log/ChannelSwitchMetrics.h"
 
 namespace Mattermost {
 
@@ -52,6 +54,7 @@ ChannelTree::ChannelTree (QWidget* parent)
 			return;
 		}
 
+		ChannelSwitchMetrics::instance().begin (newPage->channel, window ());
 		chatAreaStackedWidget->setCurrentWidget (newPage);
 		newPage->onActivate ();
 
@@ -85,6 +88,7 @@ bool ChannelTree::isChannelActive (const BackendChannel& channel)
  */
 void ChannelTree::addTeam (Backend& backend, BackendTeam& team)
 {
+	TRACE_SCOPE (ui, "ChannelTree::addTeam");
 	TeamItem* teamList = new GroupTeamItem (*this, backend, team.display_name, team.id);
 
 	addTopLevelItem (teamList);
@@ -125,7 +129,7 @@ void ChannelTree::addGroupChannelsList (Backend& backend)
 		return;
 	}
 
-	TeamItem* teamList = new DirectTeamItem (*this, backend, "Group Channels", "0");
+	TeamItem* teamList = new DirectTeamItem (*this, backend, "Group Channels", MattermostId ());
 
 	addTopLevelItem (teamList);
 	header()->setSectionResizeMode(0, QHeaderView::Stretch);
@@ -142,7 +146,7 @@ void ChannelTree::addGroupChannelsList (Backend& backend)
 
 void ChannelTree::addDirectChannelsList (Backend& backend)
 {
-	TeamItem* teamList = new DirectTeamItem (*this, backend, "Direct Channels", "0");
+	TeamItem* teamList = new DirectTeamItem (*this, backend, "Direct Channels", MattermostId ());
 
 	auto& team = backend.getStorage().directChannels;
 
@@ -164,7 +168,7 @@ void ChannelTree::setChatAreaStackedWidget (QStackedWidget* chatAreaStackedWidge
 	this->chatAreaStackedWidget = chatAreaStackedWidget;
 }
 
-void ChannelTree::openChannel (QString channelID)
+void ChannelTree::openChannel (const MattermostId& channelID)
 {
 	auto it = channelToItemMap.find (channelID);
 
@@ -176,16 +180,27 @@ void ChannelTree::openChannel (QString channelID)
 	setCurrentItem (it.value());
 }
 
-void ChannelTree::addChannelToItem (QString channelID, QTreeWidgetItem* item)
+void ChannelTree::addChannelToItem (const MattermostId& channelID, QTreeWidgetItem* item)
 {
 	channelToItemMap[channelID] = item;
 }
 
-void ChannelTree::removeChannelToItem (QString channelID)
+void ChannelTree::removeChannelToItem (const MattermostId& channelID)
 {
 	channelToItemMap.remove (channelID);
 }
 
+QList<ChatArea*> ChannelTree::getChatAreas () const
+{
+	QList<ChatArea*> chatAreas;
+
+	for (QTreeWidgetItem* item: channelToItemMap) {
+		chatAreas.push_back (item->data(0, Qt::UserRole).value<ChatArea*>());
+	}
+
+	return chatAreas;
+}
+
 void ChannelTree::showContextMenu (const QPoint& pos)
 {
 	// Handle global position
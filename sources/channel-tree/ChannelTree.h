@@ -26,6 +26,7 @@
 
 #include <QVector>
 #include <QTreeWidget>
+#include "backend/types/MattermostId.h"
 
 class QStackedWidget;
 class QListWidget;
@@ -59,13 +60,16 @@ public:
 	void setChatAreaStackedWidget (QStackedWidget* chatAreaStackedWidget);
 	ChatArea* getCurrentPage ();
 
-	void openChannel (QString channelID);
-	void addChannelToItem (QString channelID, QTreeWidgetItem* item);
-	void removeChannelToItem (QString channelID);
+	void openChannel (const MattermostId& channelID);
+	void addChannelToItem (const MattermostId& channelID, QTreeWidgetItem* item);
+	void removeChannelToItem (const MattermostId& channelID);
+
+	//chat areas of all channels in the tree
+	QList<ChatArea*> getChatAreas () const;
 private:
 	void showContextMenu (const QPoint& pos);
 	QStackedWidget*						chatAreaStackedWidget;
-	QMap<QString, QTreeWidgetItem*>		channelToItemMap;
+	QMap<MattermostId, QTreeWidgetItem*>	channelToItemMap;
 };
 
 } /* namespace Mattermost */
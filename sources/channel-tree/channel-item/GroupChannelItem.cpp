@@ -34,6 +34,11 @@
 
 namespace Mattermost {
 
+void GroupChannelItem::showMembersLoadError ()
+{
+	QMessageBox::warning (treeWidget(), "Channel members - Mattermost", "The channel members could not be loaded. Please try again.");
+}
+
 void GroupChannelItem::showContextMenu (const QPoint& pos)
 {
 	// Create menu and insert some actions
@@ -47,63 +52,88 @@ void GroupChannelItem::showContextMenu (const QPoint& pos)
 		dialog->show ();
 	});
 
+	//the channel members are loaded when one of these dialogs is opened for the first time
 	myMenu.addAction ("View Channel members", [this, &channel] {
 		qDebug() << "View Channel members ";
 
-		std::vector<const BackendUser*> channelMembers;
-
-		for (auto& it: channel.members) {
+		if (membersDialogPending) {
+			return;
+		}
 
-			if (!it.user) {
-				qDebug () << "user " << it.user_id << " is nullptr";
-				continue;
-			}
+		membersDialogPending = true;
 
-			channelMembers.push_back (it.user);
-		}
+		backend.retrieveChannelMembers (channel, [this, &channel] {
+			membersDialogPending = false;
+			std::vector<const BackendUser*> channelMembers;
 
-		UserListDialogConfig dialogCfg {
-			"Team Members - Mattermost",
-			"Members of channel '" + channel.display_name + "':"
-		};
+			for (auto& it: channel.members) {
 
-		UserListDialogForTeam* dialog = new UserListDialogForTeam (dialogCfg, channelMembers, treeWidget());
-		dialog->show ();
-	});
+				if (!it.second.user) {
+					qDebug () << "user " << it.first << " is nullptr";
+					continue;
+				}
 
-	myMenu.addAction ("Add new members to the channel", [this, &channel] {
+				channelMembers.push_back (it.second.user);
+			}
 
-		std::vector<const BackendUser*> availableUsers;
+			UserListDialogConfig dialogCfg {
+				"Team Members - Mattermost",
+				"Members of channel '" + channel.display_name + "':"
+			};
 
-		for (auto& member: channel.team->members) {
+			UserListDialogForTeam* dialog = new UserListDialogForTeam (dialogCfg, channelMembers, treeWidget());
+			dialog->show ();
+		}, [this] {
+			membersDialogPending = false;
+			showMembersLoadError ();
+		});
+	});
 
-			if (!member.user) {
-				qDebug() << "null user with id " << member.user_id;
-				continue;
-			}
+	myMenu.addAction ("Add new members to the channel", [this, &channel] {
 
-			availableUsers.emplace_back (member.user);
+		if (addMembersDialogPending) {
+			return;
 		}
 
-		QSet<const BackendUser*> channelMembers = channel.getAllMembers();
+		addMembersDialogPending = true;
 
-		UserListDialogConfig dialogCfg {
-			"Add user to channel - Mattermost",
-			"Select a user to add to the '" + channel.display_name + "' channel:"
-		};
+		backend.retrieveChannelMembers (channel, [this, &channel] {
+			addMembersDialogPending = false;
+			std::vector<const BackendUser*> availableUsers;
 
-		UserListDialog* dialog = new UserListDialog (dialogCfg, availableUsers, &channelMembers, treeWidget());
-		dialog->show ();
+			for (auto& member: channel.team->members) {
 
-		QObject::connect (dialog, &UserListDialog::accepted, [this, &channel, dialog] {
-			const BackendUser* user = dialog->getSelectedUser();
+				if (!member.second.user) {
+					qDebug() << "null user with id " << member.first;
+					continue;
+				}
 
-			if (!user) {
-				qDebug() << "dialog->getSelectedUser() returned nullptr";
-				return;
+				availableUsers.emplace_back (member.second.user);
 			}
 
-			backend.addUserToChannel (channel, user->id);
+			UserListDialogConfig dialogCfg {
+				"Add user to channel - Mattermost",
+				"Select a user to add to the '" + channel.display_name + "' channel:"
+			};
+
+			UserListDialog* dialog = new UserListDialog (dialogCfg, availableUsers, [&channel] (const BackendUser& user) {
+				return channel.isMember (user.id);
+			}, treeWidget());
+			dialog->show ();
+
+			QObject::connect (dialog, &UserListDialog::accepted, [this, &channel, dialog] {
+				const BackendUser* user = dialog->getSelectedUser();
+
+				if (!user) {
+					qDebug() << "dialog->getSelectedUser() returned nullptr";
+					return;
+				}
+
+				backend.addUserToChannel (channel, user->id);
+			});
+		}, [this] {
+			addMembersDialogPending = false;
+			showMembersLoadError ();
 		});
 	});
 
@@ -33,6 +33,12 @@ public:
 	using ChannelItem::ChannelItem;
 public:
 	void showContextMenu (const QPoint& pos) override;
+private:
+	void showMembersLoadError ();
+private:
+	//a dialog, which is opened when the channel members are loaded. Further clicks meanwhile do not open another one
+	bool	membersDialogPending = false;
+	bool	addMembersDialogPending = false;
 };
 
 } /* namespace Mattermost */
@@ -52,7 +52,9 @@ void DirectTeamItem::showContextMenu (const QPoint& pos)
 			"Select a user to start direct message channel with:"
 		};
 
-		UserListDialog* dialog = new UserListDialog (dialogCfg, backend.getStorage().getAllUsers(), &allDirectChannelUsers, treeWidget());
+		UserListDialog* dialog = new UserListDialog (dialogCfg, backend.getStorage().getAllUsers(), [&allDirectChannelUsers] (const BackendUser& user) {
+			return allDirectChannelUsers.contains (&user);
+		}, treeWidget());
 		dialog->show ();
 
 		connect (dialog, &UserListDialog::accepted, [this, dialog] {
@@ -54,12 +54,12 @@ void GroupTeamItem::showContextMenu (const QPoint& pos)
 
 		for (auto& it: team->members) {
 
-			if (!it.user) {
-				qDebug () << "user " << it.user_id << " is nullptr";
+			if (!it.second.user) {
+				qDebug () << "user " << it.first << " is nullptr";
 				continue;
 			}
 
-			teamMembers.push_back (it.user);
+			teamMembers.push_back (it.second.user);
 		}
 		qDebug() << "View Team members " << team->members.size();
 
@@ -83,14 +83,14 @@ void GroupTeamItem::showContextMenu (const QPoint& pos)
 			availableUsers.emplace_back (&user.second);
 		}
 
-		QSet<const BackendUser*> teamMembers = team->getAllMembers();
-
 		UserListDialogConfig dialogCfg {
 			"Add user to team - Mattermost",
 			"Select a user to add to the '" + team->display_name + "' team:"
 		};
 
-		UserListDialog* dialog = new UserListDialog (dialogCfg, availableUsers, &teamMembers, treeWidget());
+		UserListDialog* dialog = new UserListDialog (dialogCfg, availableUsers, [team] (const BackendUser& user) {
+			return team->isMember (user.id);
+		}, treeWidget());
 		dialog->show ();
 
 		QObject::connect (dialog, &UserListDialog::accepted, [this, team, dialog] {
@@ -108,10 +108,8 @@ void GroupTeamItem::showContextMenu (const QPoint& pos)
 	myMenu.addAction ("View Public Channels", [this] {
 			BackendTeam* team = backend.getStorage().getTeamById(teamId);
 
-			backend.retrieveTeamPublicChannels (team->id, [this, team] (std::list<BackendChannel>& channels) {
-				TeamChannelsListDialog* dialog = new TeamChannelsListDialog (backend, team->display_name, channels, treeWidget());
-				dialog->show ();
-			});
+			TeamChannelsListDialog* dialog = new TeamChannelsListDialog (backend, *team, treeWidget());
+			dialog->show ();
 	});
 
 	myMenu.exec (pos);
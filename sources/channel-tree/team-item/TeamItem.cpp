@@ -31,10 +31,11 @@
 #include "chat-area/ChatArea.h"
 #include "backend/Backend.h"
 #include "channel-tree/ChannelTree.h"
+#include "log/Tracer.h"
 
 namespace Mattermost {
 
-TeamItem::TeamItem (QTreeWidget& parent, Backend& backend, const QString& name, const QString& teamId)
+TeamItem::TeamItem (QTreeWidget& parent, Backend& backend, const QString& name, const MattermostId& teamId)
 :ChannelTreeItem (&parent, QStringList() << name)
 ,backend (backend)
 ,teamId (teamId)
@@ -51,6 +52,7 @@ TeamItem::~TeamItem () = default;
 
 void TeamItem::addChannel (BackendChannel& channel, QWidget *parent, QStackedWidget* chatAreaParent)
 {
+	TRACE_SCOPE (ui, "TeamItem::addChannel");
 	ChannelItemWidget* itemWidget = new ChannelItemWidget (parent);
 	itemWidget->setLabel (channel.display_name);
 
@@ -75,7 +77,6 @@ void TeamItem::addChannel (BackendChannel& channel, QWidget *parent, QStackedWid
 		treeWidget->removeChannelToItem (channel.id);
 	});
 
-	backend.retrieveChannelMembers (channel);
 	ChannelTree* treeWidget = static_cast<ChannelTree*> (this->treeWidget());
 	treeWidget->addChannelToItem (channel.id, item);
 }
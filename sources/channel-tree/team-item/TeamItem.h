@@ -25,6 +25,7 @@
 #pragma once
 
 #include "channel-tree/ChannelTreeItem.h"
+#include "backend/types/MattermostId.h"
 #include <QObject>
 
 class QListWidget;
@@ -47,7 +48,7 @@ class ChannelItem;
 class TeamItem: public QObject, public ChannelTreeItem {
 	Q_OBJECT
 public:
-	TeamItem (QTreeWidget& parent, Backend& backend, const QString& name, const QString& teamId);
+	TeamItem (QTreeWidget& parent, Backend& backend, const QString& name, const MattermostId& teamId);
 	virtual ~TeamItem ();
 public:
 	void addChannel (BackendChannel& channel, QWidget *parent, QStackedWidget* chatAreaParent);
@@ -56,7 +57,7 @@ private:
 	int getChannelIndex (const BackendChannel& channel);
 public:
 	Backend&							backend;
-	QString								teamId;
+	MattermostId						teamId;
 };
 
 } /* namespace Mattermost */
@@ -19,12 +19,18 @@
 
 #include "ChatArea.h"
 
+#include <algorithm>
+#include <QScrollBar>
+
 #include "channel-tree/ChannelItem.h"
 #include "ui_ChatArea.h"
 #include "post/PostWidget.h"
+#include "ThreadDialog.h"
 #include "backend/Backend.h"
 #include "channel-tree/ChannelItemWidget.h"
 #include "log.h"
+#include "log/Tracer.h"
+#include "log/ChannelSwitchMetrics.h"
 
 namespace Mattermost {
 
@@ -36,8 +42,13 @@ ChatArea::ChatArea (Backend& backend, BackendChannel& channel, ChannelItem* tree
 ,treeItem (treeItem)
 ,unreadMessagesCount (0)
 ,texteditDefaultHeight (70)
-,gettingOlderPosts (false)
+,unreadWindowRequested (false)
+,lastReadPostKnown (false)
+,postsState (PostsState::notLoaded)
+,prefetched (false)
+,postsReadyOnActivate (false)
 {
+	TRACE_SCOPE (ui, "ChatArea::ChatArea");
 	//accept drag&drop attachments
 	setAcceptDrops(true);
 
@@ -76,20 +87,42 @@ ChatArea::ChatArea (Backend& backend, BackendChannel& channel, ChannelItem* tree
 	}
 
 	/*
-	 * First, get the first unread post (if any). So that a separator can be inserted before it
+	 * First, get the first unread post (if any). So that a separator can be inserted before it.
+	 * The posts are loaded later, when the channel is shown or prefetched (see loadPosts())
 	 */
-	backend.retrieveChannelUnreadPost (channel, [this, &backend, &channel] (const QString& postId){
+	backend.retrieveChannelUnreadPost (channel, [this, &channel] (const MattermostId& postId){
 		lastReadPostId = postId;
+		lastReadPostKnown = true;
 
 		if (!postId.isEmpty()) {
 			qDebug () << "Last Read post for " << channel.display_name << ": " << postId;
 		}
 
-		backend.retrieveChannelPosts (channel, 0, 25);
+		if (postsState == PostsState::waitingForLastReadPost) {
+			retrieveNewestPosts ();
+		}
+	}, [this] {
+		//the posts are loaded without the new messages separator
+		lastReadPostKnown = true;
+
+		if (postsState == PostsState::waitingForLastReadPost) {
+			retrieveNewestPosts ();
+		}
 	});
 
+	//the pending requests are cancelled on reconnect, so the newest posts are requested again (after the cancellation)
+	connect (&backend, &Backend::onWebSocketConnect, this, [this] {
+		if (postsState == PostsState::loading || postsState == PostsState::waitingForLastReadPost) {
+			retrieveNewestPosts ();
+		}
+
+		//the gap fill and the older posts are requested again, when they are scrolled to
+		gapFillPostId = MattermostId ();
+		scrollBackPrefetcher.cancelRequests ();
+	}, Qt::QueuedConnection);
+
 	connect (&channel, &BackendChannel::onViewed, [this] {
-		LOG_DEBUG ("Channel viewed: " << this->channel.name);
+		LOG_DEBUG (ui, "Channel viewed: " << this->channel.name);
 		setUnreadMessagesCount (0);
 		ui->listWidget->removeNewMessagesSeparatorAfterTimeout (1000);
 	});
@@ -103,6 +136,31 @@ ChatArea::ChatArea (Backend& backend, BackendChannel& channel, ChannelItem* tree
 
 	connect (&channel, &BackendChannel::onNewPosts, this,  &ChatArea::fillChannelPosts);
 
+	connect (&channel, &BackendChannel::onHistoryTrimmed, this, &ChatArea::reloadChannelPosts);
+
+	//replies, shown before their root post was loaded, get the quote box now
+	connect (&channel, &BackendChannel::onRootPostLoaded, [this] (BackendPost& rootPost) {
+		const BackendPost* lastRootPost = nullptr;
+
+		for (int i = 0; i < ui->listWidget->count(); ++i) {
+			QListWidgetItem* item = ui->listWidget->item (i);
+
+			if (item->data(Qt::UserRole) != ItemType::post) {
+				continue;
+			}
+
+			PostWidget* postWidget = static_cast<PostWidget*> (ui->listWidget->itemWidget (item));
+
+			//as in fillChannelPosts(), only the first of the consecutive replies to the same root has the quote
+			if (postWidget->post.rootPost == &rootPost && lastRootPost != &rootPost) {
+				postWidget->addRootPostQuote (this);
+				item->setSizeHint (postWidget->sizeHint());
+			}
+
+			lastRootPost = postWidget->post.rootPost;
+		}
+	});
+
 	connect (&channel, &BackendChannel::onNewPost, this, &ChatArea::appendChannelPost);
 
 	//let the post creator know that the last sent / edited post has appeared so that the input box can be cleared
@@ -115,7 +173,10 @@ ChatArea::ChatArea (Backend& backend, BackendChannel& channel, ChannelItem* tree
 		PostWidget* postWidget = ui->listWidget->findPost (post.id);
 
 		if (postWidget) {
-			postWidget->setEdited (post.message);
+			postWidget->setEdited (post.getMessage());
+
+			//a newer version of the post carries its current reactions
+			postWidget->updateReactions ();
 			ui->listWidget->adjustSize();
 		}
 	});
@@ -132,9 +193,15 @@ ChatArea::ChatArea (Backend& backend, BackendChannel& channel, ChannelItem* tree
 	//initiate editing of post, when edit is selected from the context menu
 	connect (ui->listWidget, &PostsListWidget::postEditInitiated, ui->outgoingPostCreator, &OutgoingPostCreator::postEditInitiated);
 
+	//the thread is loaded on demand, when it is opened
+	connect (ui->listWidget, &PostsListWidget::threadViewRequested, [this] (BackendPost& post) {
+		ThreadDialog* dialog = new ThreadDialog (backend, channel, post.root_id.isEmpty() ? post.id : post.root_id, this);
+		dialog->show ();
+	});
+
 	connect (ui->outgoingPostCreator, &OutgoingPostCreator::postEditFinished, ui->listWidget, &PostsListWidget::postEditFinished);
 
-	connect (&channel, &BackendChannel::onPostDeleted, [this] (const QString& postId) {
+	connect (&channel, &BackendChannel::onPostDeleted, [this] (const MattermostId& postId) {
 		PostWidget* postWidget = ui->listWidget->findPost (postId);
 
 		if (postWidget) {
@@ -156,12 +223,36 @@ ChatArea::ChatArea (Backend& backend, BackendChannel& channel, ChannelItem* tree
 		setTextEditWidgetHeight (height);
 	});
 
-	//when scrolling to top, get older posts
-	connect (ui->listWidget, &PostsListWidget::scrolledToTop, [this, &backend, &channel] {
-		if (!gettingOlderPosts) {
-			//do not spam requests
-			gettingOlderPosts = true;
-			backend.retrieveChannelOlderPosts (channel, 40);
+	//when getting near the top, get older posts
+	connect (ui->listWidget->verticalScrollBar(), &QAbstractSlider::valueChanged, this, &ChatArea::prefetchOlderPosts);
+
+	/*
+	 * When a gap in the loaded history is scrolled into view, load the posts next to the ones the user is coming from.
+	 * Scrolling up, the posts before the gap are kept in place, so that the gap moves out of the view
+	 */
+	connect (ui->listWidget, &PostsListWidget::gapShown, [this, &backend, &channel] (const MattermostId& previousPostId, const MattermostId& nextPostId, bool atTop) {
+		if (!gapFillPostId.isEmpty()) {
+			return;
+		}
+
+		//the gap is filled again, when it is scrolled to the next time
+		MattermostId fillPostId (atTop ? nextPostId : previousPostId);
+
+		auto onFailed = [this, fillPostId] {
+			if (gapFillPostId == fillPostId) {
+				gapFillPostId = MattermostId ();
+				keepInViewPostId = MattermostId ();
+			}
+		};
+
+		if (atTop) {
+			gapFillPostId = nextPostId;
+			keepInViewPostId = nextPostId;
+			backend.retrieveChannelPostsBefore (channel, nextPostId, 40, nullptr, onFailed);
+		} else {
+			gapFillPostId = previousPostId;
+			keepInViewPostId = MattermostId ();
+			backend.retrieveChannelPostsAfter (channel, previousPostId, 40, nullptr, onFailed);
 		}
 	});
 }
@@ -198,33 +289,48 @@ BackendChannel& ChatArea::getChannel ()
 
 void ChatArea::fillChannelPosts (const ChannelNewPosts& newPosts)
 {
+	TRACE_SCOPE (ui, "ChatArea::fillChannelPosts");
+
+	//the widgets are created from all loaded posts, when the newest page arrives
+	if (postsState != PostsState::loaded) {
+		return;
+	}
+
 	QDate currentDate = QDateTime::currentDateTime().date();
 	int insertPos = 0;
 	int startPos = 0;
 	int postSeq = 0;
 
-	//elapsed days since the last post that was added from the new posts packet
-	int elapsedDaysSinceLastNewPost = INT32_MAX;
+	auto getDaysAgo = [this, &currentDate] (int row) -> int {
+		PostWidget* postWidget = static_cast<PostWidget*> (ui->listWidget->itemWidget (ui->listWidget->item (row)));
+		return postWidget->post.getCreationTime().date().daysTo (currentDate);
+	};
 
-	//elapsed days since the oldest post that was available before retrieving older posts
-	int elapsedDaysSinceFirstExistingPost = INT32_MAX;
+	/*
+	 * The post, which keeps its position in the view. When older posts are inserted on top, it is the first existing post,
+	 * so that the view does not move. The older posts are requested before the top is reached, so they are laid out off-screen
+	 */
+	QListWidgetItem* keptItem = nullptr;
+	int keptItemTop = 0;
+	bool prependingPosts = !newPosts.postsToAdd.empty() && newPosts.postsToAdd.front().previousPostId.isEmpty() && ui->listWidget->count() > 0;
 
-	//save the first post (before insertion), so that the list will be scrolled to it after the insertion
-	QListWidgetItem* widgetToScrollTo = nullptr;
-	QListWidgetItem* daySeparatorOnTop = nullptr;
+	if (prependingPosts) {
 
-	if (gettingOlderPosts) {
+		int firstPostRow = ui->listWidget->findNextPostRow (0);
 
-		widgetToScrollTo = ui->listWidget->item(0);
-		uint32_t firstPostIndex = 0;
+		if (firstPostRow >= 0) {
+			keptItem = ui->listWidget->item (firstPostRow);
+		}
+	} else if (!keepInViewPostId.isEmpty()) {
+		int keptItemPos = ui->listWidget->findPostByIndex (keepInViewPostId, 0);
 
-		if (widgetToScrollTo->data(Qt::UserRole) != ItemType::post) {
-			daySeparatorOnTop = widgetToScrollTo;
-			firstPostIndex = 1;
+		if (keptItemPos >= 0) {
+			keptItem = ui->listWidget->item (keptItemPos);
 		}
+	}
 
-		PostWidget* firstPostWidget = static_cast<PostWidget*> (ui->listWidget->itemWidget (ui->listWidget->item(firstPostIndex)));
-		elapsedDaysSinceFirstExistingPost = firstPostWidget->post.getCreationTime().date().daysTo(currentDate);
+	if (keptItem) {
+		keptItemTop = ui->listWidget->visualItemRect(keptItem).top();
 	}
 
 	BackendPost* lastRootPost = nullptr;
@@ -239,19 +345,21 @@ void ChatArea::fillChannelPosts (const ChannelNewPosts& newPosts)
 		++insertPos;
 		startPos = insertPos;
 
+		//elapsed days since the post before the chunk (or the last added post). The chunk may be inserted in the middle of the list
+		int previousPostRow = ui->listWidget->findPreviousPostRow (insertPos);
+		int elapsedDaysSinceLastNewPost = previousPostRow >= 0 ? getDaysAgo (previousPostRow) : INT32_MAX;
+
 		for (auto& post: chunk.postsToAdd) {
 
 			if (!chunk.previousPostId.isEmpty()) {
 				qDebug() << "\tAdd post " << post->id;
 			}
 
-			lastPostDate = post->getCreationTime ().date();
-
-			int elapsedDaysSinceThisNewPost = (lastPostDate.daysTo (currentDate));
+			int elapsedDaysSinceThisNewPost = post->getCreationTime().date().daysTo (currentDate);
 
 			/**
-			 * Add a day separator, if the next added post is from a day, different from the previous added post.
-			 * Day separator is always added for the first new post.
+			 * Add a day separator, if the post is from a day, different from the previous post.
+			 * A day separator is always added for the first post of the list.
 			 */
 			if (elapsedDaysSinceThisNewPost != elapsedDaysSinceLastNewPost) {
 
@@ -266,51 +374,218 @@ void ChatArea::fillChannelPosts (const ChannelNewPosts& newPosts)
 			++postSeq;
 
 			if (post->id == lastReadPostId) {
-				ui->listWidget->addNewMessagesSeparator ();
+				ui->listWidget->addNewMessagesSeparator (insertPos);
 				++insertPos;
 				++unreadMessagesCount;
 			}
 		}
+
+		int nextPostRow = ui->listWidget->findNextPostRow (insertPos);
+
+		//the chunk is at the bottom, new posts from the WebSocket are compared with its last post
+		if (nextPostRow < 0) {
+
+			if (!chunk.postsToAdd.empty()) {
+				lastPostDate = chunk.postsToAdd.back()->getCreationTime().date();
+			}
+
+			continue;
+		}
+
+		/*
+		 * The existing post after the chunk has a day separator only if it is from another day than the last added post.
+		 * The day separator is right before the post (after the gap and the new messages separator, if any)
+		 */
+		int elapsedDaysSinceNextPost = getDaysAgo (nextPostRow);
+		bool nextPostHasSeparator = ui->listWidget->isDaySeparator (nextPostRow - 1);
+
+		if (elapsedDaysSinceNextPost == elapsedDaysSinceLastNewPost && nextPostHasSeparator) {
+			delete ui->listWidget->item (nextPostRow - 1);
+		} else if (elapsedDaysSinceNextPost != elapsedDaysSinceLastNewPost && !nextPostHasSeparator) {
+			ui->listWidget->addDaySeparator (nextPostRow, elapsedDaysSinceNextPost);
+		}
 	}
 
-	gettingOlderPosts = false;
+	setUnreadMessagesCount (unreadMessagesCount);
+
+	ui->listWidget->updateGaps ();
 
-	if (widgetToScrollTo) {
-		ui->listWidget->scrollToItem (widgetToScrollTo, QAbstractItemView::PositionAtTop);
+	if (keptItem) {
+		QScrollBar* scrollBar = ui->listWidget->verticalScrollBar();
+		scrollBar->setValue (scrollBar->value() + ui->listWidget->visualItemRect(keptItem).top() - keptItemTop);
 	}
 
-	/**
-	 * If existing posts and new posts are from the same day, remove the day separator (if any) from the existing posts list
+	if (!pendingJumpPostId.isEmpty()) {
+		int pos = ui->listWidget->findPostByIndex (pendingJumpPostId, 0);
+
+		if (pos >= 0) {
+			ui->listWidget->scrollToItem (ui->listWidget->item(pos), QAbstractItemView::PositionAtTop);
+			pendingJumpPostId = MattermostId ();
+		}
+	}
+
+	//the gaps, which are still in the view after the insertion, are filled further
+	gapFillPostId = MattermostId ();
+	ui->listWidget->checkVisibleGaps ();
+
+	/*
+	 * The last read post is older than the newest page. The history around it is loaded, so that the
+	 * new messages separator is shown, and the user can continue reading from there
 	 */
-	if (elapsedDaysSinceLastNewPost == elapsedDaysSinceFirstExistingPost && daySeparatorOnTop) {
-		delete (daySeparatorOnTop);
-		daySeparatorOnTop = nullptr;
-		qDebug () << "Delete day separator";
+	if (!unreadWindowRequested && !lastReadPostId.isEmpty() && !channel.posts.empty() && !channel.isPostLoaded (lastReadPostId)) {
+		unreadWindowRequested = true;
+		keepInViewPostId = lastReadPostId;
+		pendingJumpPostId = lastReadPostId;
+		backend.retrieveChannelPostsAround (channel, lastReadPostId, 20);
 	}
+}
+
+void ChatArea::reloadChannelPosts ()
+{
+	TRACE_SCOPE (ui, "ChatArea::reloadChannelPosts");
 
+	/*
+	 * The existing widgets reference the evicted posts, so all of them are recreated.
+	 * The new messages separator is shown again only if the channel has not been viewed since
+	 */
+	if (postsState != PostsState::loaded) {
+		return;
+	}
+
+	uint32_t savedUnreadMessagesCount = unreadMessagesCount;
+	MattermostId savedLastReadPostId = lastReadPostId;
+
+	if (!unreadMessagesCount) {
+		lastReadPostId = MattermostId ();
+	}
+
+	createPostWidgets ();
+
+	lastReadPostId = savedLastReadPostId;
+	unreadMessagesCount = savedUnreadMessagesCount;
 	setUnreadMessagesCount (unreadMessagesCount);
 }
 
-void ChatArea::appendChannelPost (BackendPost& post)
+void ChatArea::createPostWidgets ()
 {
-	QDate currentDate = QDateTime::currentDateTime().date();
+	ui->listWidget->clearPosts ();
+	scrollBackPrefetcher.reset ();
 
-	if (lastPostDate.daysTo (currentDate) >= 1) {
-		ui->listWidget->addDaySeparator (0);
-		QDateTime postTime = QDateTime::fromMSecsSinceEpoch (post.create_at);
-		lastPostDate = postTime.date();
+	ChannelNewPostsChunk chunk;
+	chunk.postsToAdd.assign (channel.posts.begin(), channel.posts.end());
+
+	ChannelNewPosts newPosts;
+	newPosts.addChunk (std::move (chunk));
+	fillChannelPosts (newPosts);
+}
+
+void ChatArea::loadPosts ()
+{
+	if (postsState != PostsState::notLoaded) {
+		return;
 	}
 
-	bool chatAreaHasFocus = treeItem->isSelected() && isActiveWindow ();
+	//the newest page is requested after the last read post is known, so that the new messages separator can be placed
+	if (!lastReadPostKnown) {
+		postsState = PostsState::waitingForLastReadPost;
+		return;
+	}
 
-	if (!chatAreaHasFocus) {
-		ui->listWidget->addNewMessagesSeparator ();
+	retrieveNewestPosts ();
+}
+
+bool ChatArea::isLoaded () const
+{
+	return postsState == PostsState::loaded;
+}
+
+bool ChatArea::isLoading () const
+{
+	return postsState == PostsState::loading || postsState == PostsState::waitingForLastReadPost;
+}
+
+void ChatArea::retrieveNewestPosts ()
+{
+	postsState = PostsState::loading;
+
+	backend.retrieveChannelPosts (channel, 0, 25, [this] {
+		TRACE_SCOPE (ui, "ChatArea::createPostWidgets");
+
+		//repeated request (after a reconnect). The posts of the second reply are added by fillChannelPosts()
+		if (postsState == PostsState::loaded) {
+			return;
+		}
+
+		//the posts, received from the WebSocket while loading, are in 'channel.posts' as well
+		postsState = PostsState::loaded;
+		createPostWidgets ();
+		ui->listWidget->scrollToUnreadPostsOrBottom ();
+		ChannelSwitchMetrics::instance().phaseDone (channel, SwitchPhase::build);
+		emit postsLoaded ();
+	}, [this] {
+		//loaded again, when the channel is shown
+		if (postsState == PostsState::loading) {
+			postsState = PostsState::notLoaded;
+		}
+	});
+}
+
+void ChatArea::prefetchOlderPosts (int scrollValue)
+{
+	PostsListWidget* listWidget = ui->listWidget;
+	int viewportHeight = listWidget->viewport()->height();
+	int averagePostHeight = (listWidget->verticalScrollBar()->maximum() + viewportHeight) / std::max (listWidget->count(), 1);
+	int perPage = scrollBackPrefetcher.onScrolled (scrollValue, viewportHeight, averagePostHeight);
+
+	if (!perPage) {
+		return;
 	}
 
-	ui->listWidget->insertPost (new PostWidget (backend, post, ui->listWidget, this, nullptr));
+	//the whole history may have been evicted (see PostHistoryBudget), then load it from the start
+	if (channel.posts.empty()) {
+		scrollBackPrefetcher.requestStarted (MattermostId (), perPage);
+
+		backend.retrieveChannelPosts (channel, 0, perPage, [this] {
+			scrollBackPrefetcher.requestFinished (MattermostId (), channel.posts.size());
+		}, [this] {
+			scrollBackPrefetcher.requestFailed (MattermostId ());
+		});
+		return;
+	}
+
+	MattermostId beforePostId = channel.posts.front()->id;
+	scrollBackPrefetcher.requestStarted (beforePostId, perPage);
+
+	backend.retrieveChannelPostsBefore (channel, beforePostId, perPage, [this, beforePostId] (int receivedPosts) {
+		scrollBackPrefetcher.requestFinished (beforePostId, receivedPosts);
+	}, [this, beforePostId] {
+		scrollBackPrefetcher.requestFailed (beforePostId);
+	});
+}
+
+void ChatArea::appendChannelPost (BackendPost& post)
+{
+	QDate currentDate = QDateTime::currentDateTime().date();
+	bool chatAreaHasFocus = treeItem->isSelected() && isActiveWindow ();
+
+	//the widget is created with the others, when the posts are loaded
+	if (postsState == PostsState::loaded) {
+
+		if (lastPostDate.daysTo (currentDate) >= 1) {
+			ui->listWidget->addDaySeparator (0);
+			QDateTime postTime = QDateTime::fromMSecsSinceEpoch (post.create_at);
+			lastPostDate = postTime.date();
+		}
+
+		if (!chatAreaHasFocus) {
+			ui->listWidget->addNewMessagesSeparator ();
+		}
 
-	ui->listWidget->adjustSize();
-	ui->listWidget->scrollToBottom();
+		ui->listWidget->insertPost (new PostWidget (backend, post, ui->listWidget, this, nullptr));
+
+		ui->listWidget->adjustSize();
+		ui->listWidget->scrollToBottom();
+	}
 
 	moveOnListTop ();
 
@@ -325,14 +600,21 @@ void ChatArea::appendChannelPost (BackendPost& post)
 
 void ChatArea::handleUserTyping (const BackendUser& user)
 {
-	LOG_DEBUG (channel.display_name << ": " << user.getDisplayName() << " is typing");
+	LOG_DEBUG (ui, channel.display_name << ": " << user.getDisplayName() << " is typing");
 }
 
 void ChatArea::onActivate ()
 {
+	postsReadyOnActivate = isLoaded ();
+	loadPosts ();
 	backend.setCurrentChannel (channel);
 	backend.markChannelAsViewed (channel);
 	ui->listWidget->scrollToUnreadPostsOrBottom ();
+
+	//otherwise the widgets are built, when the posts arrive
+	if (postsReadyOnActivate) {
+		ChannelSwitchMetrics::instance().phaseDone (channel, SwitchPhase::build);
+	}
 }
 
 void ChatArea::onMainWindowActivate ()
@@ -416,6 +698,15 @@ void ChatArea::goToPost (const BackendPost& post)
 {
 	int pos = ui->listWidget->findPostByIndex (post.id, 0);
 
+	//root posts of replies may be outside of the loaded history. Load the posts around it, and scroll when it is shown
+	if (pos < 0) {
+		keepInViewPostId = post.id;
+		pendingJumpPostId = post.id;
+		backend.retrieveChannelPostsAround (channel, post.id, 20);
+		return;
+	}
+
+	keepInViewPostId = post.id;
 	ui->listWidget->scrollToItem(ui->listWidget->item(pos), QAbstractItemView::PositionAtTop);
 }
 
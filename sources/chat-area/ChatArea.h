@@ -24,6 +24,7 @@
 #include <QTreeWidgetItem>
 
 #include "outgoing-post/OutgoingPostCreator.h"
+#include "ScrollBackPrefetcher.h"
 
 namespace Ui {
 class ChatArea;
@@ -54,10 +55,23 @@ public:
 	BackendChannel& getChannel ();
 	void appendChannelPost (BackendPost& post);
 	void fillChannelPosts (const ChannelNewPosts& newPosts);
+
+	/**
+	 * Recreate the post widgets from the posts of the channel, after its history is trimmed
+	 */
+	void reloadChannelPosts ();
+
+	/**
+	 * Load the newest posts and create their widgets, if not done yet. Called when the chat area
+	 * is shown for the first time, or earlier by ChannelPrefetcher. Emits postsLoaded()
+	 */
+	void loadPosts ();
+	bool isLoaded () const;
+	bool isLoading () const;
 	void handleUserTyping (const BackendUser& user);
 
 	/**
-	 * Scroll to given post
+	 * Scroll to given post. If the post is not loaded, the history around it is loaded first
 	 * @param post post
 	 */
 	void goToPost (const BackendPost& post);
@@ -72,12 +86,27 @@ public:
 	 * Called only if the chat area is the currently active one (so that it's contents is visible)
 	 */
 	void onMainWindowActivate ();
+signals:
+	void postsLoaded ();
 private:
+	enum class PostsState {
+		notLoaded,
+		waitingForLastReadPost,
+		loading,
+		loaded,
+	};
+
+	void retrieveNewestPosts ();
+	void createPostWidgets ();
+
 	void dragEnterEvent (QDragEnterEvent* event) override;
 	void dragMoveEvent (QDragMoveEvent* event) override;
 	void dropEvent (QDropEvent* event) override;
 
 	void setUserAvatar (const BackendUser& user);
+
+	//request older posts, if the view is getting near the top of the list
+	void prefetchOlderPosts (int scrollValue);
 	void moveOnListTop ();
 	void setUnreadMessagesCount (uint32_t count);
 	void setTextEditWidgetHeight (int height);
@@ -86,12 +115,30 @@ public:
 	Backend& 						backend;
 	BackendChannel& 				channel;
 	ChannelItem* 					treeItem;
-	QString 						lastReadPostId;
+	MattermostId					lastReadPostId;
 
 	uint32_t						unreadMessagesCount;
 	int 							texteditDefaultHeight;
 	QDate							lastPostDate;
-	bool							gettingOlderPosts;
+	ScrollBackPrefetcher			scrollBackPrefetcher;
+
+	//a post, which keeps its position in the view while posts are inserted before it
+	MattermostId					keepInViewPostId;
+
+	//the post to scroll to, when it is loaded (see goToPost())
+	MattermostId					pendingJumpPostId;
+
+	//the post around which a gap is being filled, empty if none
+	MattermostId					gapFillPostId;
+	bool							unreadWindowRequested;
+	bool							lastReadPostKnown;
+	PostsState						postsState;
+
+	//the posts were loaded by ChannelPrefetcher, and the chat area has not been shown since
+	bool							prefetched;
+
+	//whether the posts were ready, when the chat area was shown the last time
+	bool							postsReadyOnActivate;
 };
 
 } /* namespace Mattermost */
@@ -32,6 +32,7 @@
 #include "post-separator/PostDaySeparatorWidget.h"
 #include "backend/Backend.h"
 #include "backend/types/BackendPost.h"
+#include "log/Tracer.h"
 #include "info-dialogs/UserProfileDialog.h"
 #include "PostsListWidget.h"
 #include "choose-emoji-dialog/ChooseEmojiDialogWrapper.h"
@@ -51,11 +52,7 @@ PostsListWidget::PostsListWidget (QWidget* parent)
 
 	connect (this, &QListWidget::customContextMenuRequested, this, &PostsListWidget::showContextMenu);
 
-	connect (verticalScrollBar(), &QAbstractSlider::valueChanged, [this] (int value) {
-		if (value == 0) {
-			emit scrolledToTop ();
-		}
-	});
+	connect (verticalScrollBar(), &QAbstractSlider::valueChanged, this, &PostsListWidget::checkVisibleGaps);
 }
 
 PostsListWidget::~PostsListWidget () = default;
@@ -87,7 +84,7 @@ void PostsListWidget::insertPost (PostWidget* postWidget)
 	return insertPost (count (), postWidget);
 }
 
-int PostsListWidget::findPostByIndex (const QString& postId, int startIndex)
+int PostsListWidget::findPostByIndex (const MattermostId& postId, int startIndex)
 {
 	if (postId.isEmpty()) {
 		return -1;
@@ -95,6 +92,11 @@ int PostsListWidget::findPostByIndex (const QString& postId, int startIndex)
 
 	while (startIndex < count()) {
 
+		if (item (startIndex)->data(Qt::UserRole) != ItemType::post) {
+			++startIndex;
+			continue;
+		}
+
 		PostWidget* message = static_cast <PostWidget*> (itemWidget (item (startIndex)));
 
 		if (message->post.id == postId) {
@@ -108,7 +110,34 @@ int PostsListWidget::findPostByIndex (const QString& postId, int startIndex)
 	return -1;
 }
 
-PostWidget* PostsListWidget::findPost (const QString& postId)
+int PostsListWidget::findPreviousPostRow (int row) const
+{
+	for (--row; row >= 0; --row) {
+		if (item (row)->data(Qt::UserRole) == ItemType::post) {
+			return row;
+		}
+	}
+
+	return -1;
+}
+
+int PostsListWidget::findNextPostRow (int row) const
+{
+	for (; row < count(); ++row) {
+		if (item (row)->data(Qt::UserRole) == ItemType::post) {
+			return row;
+		}
+	}
+
+	return -1;
+}
+
+bool PostsListWidget::isDaySeparator (int row) const
+{
+	return row >= 0 && row < count() && item (row)->data(Qt::UserRole) == ItemType::daySeparator;
+}
+
+PostWidget* PostsListWidget::findPost (const MattermostId& postId)
 {
 	if (postId.isEmpty()) {
 		return nullptr;
@@ -118,6 +147,11 @@ PostWidget* PostsListWidget::findPost (const QString& postId)
 
 	while (startIndex < count()) {
 
+		if (item (startIndex)->data(Qt::UserRole) != ItemType::post) {
+			++startIndex;
+			continue;
+		}
+
 		PostWidget* message = static_cast <PostWidget*> (itemWidget (item (startIndex)));
 
 		if (message->post.id == postId) {
@@ -130,6 +164,16 @@ PostWidget* PostsListWidget::findPost (const QString& postId)
 	return nullptr;
 }
 
+void PostsListWidget::clearPosts ()
+{
+	removeNewMessagesSeparatorTimer.stop ();
+	newMessagesSeparator = nullptr;
+	lastOwnPost = nullptr;
+	currentEditedItem = nullptr;
+	gapItems.clear ();
+	clear ();
+}
+
 void PostsListWidget::scrollToUnreadPostsOrBottom ()
 {
 	if (newMessagesSeparator) {
@@ -143,7 +187,7 @@ void PostsListWidget::addDaySeparator (int daysAgo)
 {
 	PostSeparatorWidget* separator = new PostDaySeparatorWidget (daysAgo);
 	QListWidgetItem* newItem = new QListWidgetItem();
-	newItem->setData(Qt::UserRole, ItemType::separator);
+	newItem->setData(Qt::UserRole, ItemType::daySeparator);
 	addItem (newItem);
 	setItemWidget (newItem, separator);
 }
@@ -152,7 +196,7 @@ void PostsListWidget::addDaySeparator (int insertPos, int daysAgo)
 {
 	PostSeparatorWidget* separator = new PostDaySeparatorWidget (daysAgo);
 	QListWidgetItem* newItem = new QListWidgetItem();
-	newItem->setData(Qt::UserRole, ItemType::separator);
+	newItem->setData(Qt::UserRole, ItemType::daySeparator);
 	insertItem (insertPos, newItem);
 	setItemWidget (newItem, separator);
 }
@@ -170,6 +214,64 @@ void PostsListWidget::addNewMessagesSeparator ()
 	setItemWidget (newMessagesSeparator, separator);
 }
 
+void PostsListWidget::addNewMessagesSeparator (int insertPos)
+{
+	if (newMessagesSeparator) {
+		return;
+	}
+
+	PostSeparatorWidget* separator = new PostSeparatorWidget ("New messages");
+	newMessagesSeparator = new QListWidgetItem();
+
+	insertItem (insertPos, newMessagesSeparator);
+	setItemWidget (newMessagesSeparator, separator);
+}
+
+void PostsListWidget::updateGaps ()
+{
+	qDeleteAll (gapItems);
+	gapItems.clear ();
+
+	const BackendPost* previousPost = nullptr;
+	int previousPostRow = 0;
+
+	for (int i = 0; i < count(); ++i) {
+
+		if (item(i)->data(Qt::UserRole) != ItemType::post) {
+			continue;
+		}
+
+		PostWidget* postWidget = static_cast <PostWidget*> (itemWidget (item (i)));
+
+		//the gap is shown right after the previous post, before the day separator of the next one (if any)
+		if (previousPost && postWidget->post.gapBefore) {
+			QListWidgetItem* gapItem = new QListWidgetItem();
+			gapItem->setData (Qt::UserRole, ItemType::gap);
+			gapItem->setData (previousPostRole, previousPost->id.toString());
+			gapItem->setData (nextPostRole, postWidget->post.id.toString());
+			insertItem (previousPostRow + 1, gapItem);
+			setItemWidget (gapItem, new PostSeparatorWidget ("Loading messages..."));
+			gapItems.push_back (gapItem);
+			++i;
+		}
+
+		previousPost = &postWidget->post;
+		previousPostRow = i;
+	}
+}
+
+void PostsListWidget::checkVisibleGaps ()
+{
+	for (QListWidgetItem* gapItem: gapItems) {
+		QRect gapRect = visualItemRect (gapItem);
+
+		if (gapRect.intersects (viewport()->rect())) {
+			emit gapShown (gapItem->data(previousPostRole).toString(), gapItem->data(nextPostRole).toString(), gapRect.center().y() < viewport()->height() / 2);
+			return;
+		}
+	}
+}
+
 void PostsListWidget::removeNewMessagesSeparator ()
 {
 	if (!newMessagesSeparator) {
@@ -201,7 +303,7 @@ void PostsListWidget::initiatePostEdit (QListWidgetItem& postItem)
 
 	PostWidget* post = static_cast <PostWidget*> (itemWidget (&postItem));
 
-	qDebug() << "Edit " << post->post.message;
+	qDebug() << "Edit " << post->post.getMessage();
 	currentEditedItem = &postItem;
 	postItem.setBackground(Qt::yellow);
 	clearSelection ();
@@ -300,7 +402,7 @@ void PostsListWidget::showContextMenu (const QPoint& pos)
 			});
 
 			myMenu.addAction ("Delete", [this, post] {
-				qDebug() << "Delete " << post->post.message;
+				qDebug() << "Delete " << post->post.getMessage();
 				backend->deletePost (post->post.id);
 			});
 
@@ -311,7 +413,7 @@ void PostsListWidget::showContextMenu (const QPoint& pos)
 
 	if (!post->hoveredLink.isEmpty() && selectedItemsCount == 1) {
 		myMenu.addAction ("Copy link to clipboard", [this, post] {
-			//qDebug() << "Copy " << post->post.message;
+			//qDebug() << "Copy " << post->post.getMessage();
 			QApplication::clipboard()->setText (post->hoveredLink);
 		});
 	}
@@ -326,13 +428,13 @@ void PostsListWidget::showContextMenu (const QPoint& pos)
 	}
 
 	myMenu.addAction ("Copy entire post (formatted)", [this, post] {
-		//qDebug() << "Copy " << post->post.message;
+		//qDebug() << "Copy " << post->post.getMessage();
 		copySelectedItemsToClipboard (PostWidget::entirePost);
 	});
 
 	if (selectedItemsCount == 1) {
 		myMenu.addAction ("Copy post message", [this, post] {
-			//qDebug() << "Copy " << post->post.message;
+			//qDebug() << "Copy " << post->post.getMessage();
 			copySelectedItemsToClipboard (PostWidget::messageOnly);
 		});
 	}
@@ -343,10 +445,16 @@ void PostsListWidget::showContextMenu (const QPoint& pos)
 		});
 	});
 
+	if (selectedItemsCount == 1) {
+		myMenu.addAction ("View thread", [this, post] {
+			emit threadViewRequested (post->post);
+		});
+	}
+
 	myMenu.addSeparator();
 
 	myMenu.addAction ("View " + post->post.author->getDisplayName() + "'s profile", [this, post] {
-		//qDebug() << "Copy " << post->post.message;
+		//qDebug() << "Copy " << post->post.getMessage();
 		UserProfileDialog* dialog = new UserProfileDialog (*post->post.author, this);
 		dialog->show ();
 	});
@@ -354,12 +462,12 @@ void PostsListWidget::showContextMenu (const QPoint& pos)
 #if 0
 	if (selectedItemsCount == 1) {
 		myMenu.addAction ("Reply", [post] {
-			qDebug() << "Reply " << post->post.message;
+			qDebug() << "Reply " << post->post.getMessage();
 		});
 	}
 
 	myMenu.addAction ("Pin", [post] {
-		qDebug() << "Pin " << post->post.message;
+		qDebug() << "Pin " << post->post.getMessage();
 	});
 #endif
 
@@ -371,7 +479,7 @@ void PostsListWidget::showContextMenu (const QPoint& pos)
 
 void PostsListWidget::resizeEvent (QResizeEvent* event)
 {
-	qDebug() << "ResizeEvent " << event->size();
+	TRACE_SCOPE (ui, "PostsListWidget::resizeEvent");
 	for (int i = 0; i < count(); ++i) {
 		QListWidgetItem* item = this->item(i);
 		QWidget* widget = (QWidget*)itemWidget (item);
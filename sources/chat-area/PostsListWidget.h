@@ -36,6 +36,8 @@ namespace ItemType {
 enum id {
 	post,
 	separator,
+	daySeparator,	//!< before the first post of each day
+	gap,			//!< posts between the neighbouring ones are not loaded (BackendPost::gapBefore)
 };
 }
 
@@ -44,16 +46,45 @@ class PostsListWidget: public QListWidget {
 public:
 	explicit PostsListWidget (QWidget* parent);
 	~PostsListWidget ();
+public:
+	//data roles of gap items - the IDs of the posts around the gap
+	enum GapDataRole {
+		previousPostRole = Qt::UserRole + 1,
+		nextPostRole,
+	};
 public:
 	void insertPost (int position, PostWidget* postWidget);
 	void insertPost (PostWidget* postWidget);
-	PostWidget* findPost (const QString& postId);
-	int findPostByIndex (const QString& postId, int startIndex);
+	PostWidget* findPost (const MattermostId& postId);
+	int findPostByIndex (const MattermostId& postId, int startIndex);
+
+	/**
+	 * The row of the nearest post before 'row' / at or after 'row', -1 if there is none
+	 */
+	int findPreviousPostRow (int row) const;
+	int findNextPostRow (int row) const;
+	bool isDaySeparator (int row) const;
+
+	/**
+	 * Remove all posts and separators, for example when the history of the channel is trimmed
+	 */
+	void clearPosts ();
 
 	void scrollToUnreadPostsOrBottom ();
 	void addDaySeparator (int daysAgo);
 	void addDaySeparator (int insertPos, int daysAgo);
 	void addNewMessagesSeparator ();
+	void addNewMessagesSeparator (int insertPos);
+
+	/**
+	 * Recreate the gap items between the posts, after posts are inserted
+	 */
+	void updateGaps ();
+
+	/**
+	 * Emit gapShown() for the first gap item in the view (if any)
+	 */
+	void checkVisibleGaps ();
 	void removeNewMessagesSeparator ();
 	void removeNewMessagesSeparatorAfterTimeout (int timeoutMs);
 	QListWidgetItem* getLastOwnPost () const;
@@ -62,8 +93,16 @@ public:
 	Backend*						backend;
 signals:
 	void postEditInitiated (BackendPost& post);
-	void scrolledToTop ();
+
+	//'View thread' is selected in the context menu of a post (a root post or a reply)
+	void threadViewRequested (BackendPost& post);
+	/**
+	 * A gap item is scrolled into view
+	 * @param atTop whether the gap is in the upper half of the view (the user scrolls up, towards older posts)
+	 */
+	void gapShown (const MattermostId& previousPostId, const MattermostId& nextPostId, bool atTop);
 private:
+
 	QList<QListWidgetItem*> sortedSelectedItems () const;
 
 	void copySelectedItemsToClipboard (PostWidget::FormatType formatType);
@@ -76,6 +115,7 @@ private:
 	QListWidgetItem*				newMessagesSeparator;
 	QListWidgetItem*				lastOwnPost;
 	QListWidgetItem*				currentEditedItem;
+	QList<QListWidgetItem*>			gapItems;
 	bool							menuShown;
 };
 
@@ -0,0 +1,128 @@
+/**
+ * @file ScrollBackPrefetcher.cpp
+ * @brief Decides when and how many older posts to load, while the user scrolls back
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include <algorithm>
+#include "ScrollBackPrefetcher.h"
+#include "Settings.h"
+#include "log.h"
+
+namespace Mattermost {
+
+namespace {
+
+constexpr int defaultPrefetchScreens = 3;
+
+//limits of the page size (the server limit is 200)
+constexpr int minPageSize = 20;
+constexpr int maxPageSize = 200;
+
+//scroll events, further apart than this, are separate scroll gestures
+constexpr qint64 scrollGestureGapMs = 1000;
+
+}
+
+ScrollBackPrefetcher::ScrollBackPrefetcher ()
+:lastScrollValue (0)
+,scrollSpeed (0)
+,responseTime (500)
+,reachedOldestPost (false)
+{
+	QSettings settings;
+	prefetchScreens = std::max (settings.value (SCROLL_PREFETCH_SCREENS, defaultPrefetchScreens).toInt(), 1);
+}
+
+int ScrollBackPrefetcher::onScrolled (int scrollValue, int viewportHeight, int averagePostHeight)
+{
+	qint64 elapsedMs = scrollTimer.isValid() ? scrollTimer.restart () : scrollGestureGapMs;
+
+	if (!scrollTimer.isValid()) {
+		scrollTimer.start ();
+	}
+
+	if (elapsedMs >= scrollGestureGapMs) {
+		scrollSpeed = 0;
+	} else if (elapsedMs > 0) {
+		double speed = std::max (lastScrollValue - scrollValue, 0) * 1000.0 / elapsedMs;
+		scrollSpeed = scrollSpeed * 0.7 + speed * 0.3;
+	}
+
+	lastScrollValue = scrollValue;
+
+	if (reachedOldestPost || !pendingRequests.empty() || scrollValue > prefetchScreens * viewportHeight) {
+		return 0;
+	}
+
+	//the distance to the top, plus what is scrolled while the page is on the way (twice, to absorb the variation)
+	double pixelsToCover = prefetchScreens * viewportHeight + scrollSpeed * responseTime * 2 / 1000.0;
+	int perPage = pixelsToCover / std::max (averagePostHeight, 1);
+
+	return std::min (std::max (perPage, minPageSize), maxPageSize);
+}
+
+void ScrollBackPrefetcher::requestStarted (const MattermostId& beforePostId, int perPage)
+{
+	pendingRequests.push_back (PendingRequest {beforePostId, perPage, QElapsedTimer ()});
+	pendingRequests.back().timer.start ();
+}
+
+void ScrollBackPrefetcher::requestFinished (const MattermostId& beforePostId, int receivedPosts)
+{
+	auto it = std::find_if (pendingRequests.begin(), pendingRequests.end(), [&beforePostId] (const PendingRequest& request) {
+		return request.beforePostId == beforePostId;
+	});
+
+	//requested before reset()
+	if (it == pendingRequests.end()) {
+		return;
+	}
+
+	qint64 elapsedMs = it->timer.elapsed ();
+	responseTime = responseTime * 0.5 + elapsedMs * 0.5;
+	reachedOldestPost = receivedPosts < it->perPage;
+
+	LOG_DEBUG (ui, "Older posts page" << LogField ("per_page", it->perPage) << LogField ("received", receivedPosts)
+			<< LogField ("ms", elapsedMs) << LogField ("scroll_px_s", (qint64) scrollSpeed));
+
+	pendingRequests.erase (it);
+}
+
+void ScrollBackPrefetcher::requestFailed (const MattermostId& beforePostId)
+{
+	pendingRequests.erase (std::remove_if (pendingRequests.begin(), pendingRequests.end(), [&beforePostId] (const PendingRequest& request) {
+		return request.beforePostId == beforePostId;
+	}), pendingRequests.end());
+}
+
+void ScrollBackPrefetcher::cancelRequests ()
+{
+	pendingRequests.clear ();
+}
+
+void ScrollBackPrefetcher::reset ()
+{
+	pendingRequests.clear ();
+	reachedOldestPost = false;
+}
+
+} /* namespace Mattermost */
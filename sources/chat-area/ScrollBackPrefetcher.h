@@ -0,0 +1,91 @@
+/**
+ * @file ScrollBackPrefetcher.h
+ * @brief Decides when and how many older posts to load, while the user scrolls back
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <vector>
+#include <QElapsedTimer>
+#include "backend/types/MattermostId.h"
+
+namespace Mattermost {
+
+/**
+ * Older posts are requested when the view is within a few screens of the top of the list, so that they are
+ * inserted (and laid out) above the view, before the user gets there. The page size is chosen, so that the
+ * page covers the distance, which is scrolled while the next page is being loaded, at the current scroll speed.
+ * The pending requests are tracked by the post they are requested before, so each range is requested once.
+ * The newest page, requested when no posts are loaded, is tracked by an empty id
+ */
+class ScrollBackPrefetcher {
+public:
+	ScrollBackPrefetcher ();
+public:
+	/**
+	 * Record a scroll position. Returns the number of posts to request, or 0 if nothing should be requested now
+	 * @param averagePostHeight average height of the loaded posts, in pixels
+	 */
+	int onScrolled (int scrollValue, int viewportHeight, int averagePostHeight);
+
+	void requestStarted (const MattermostId& beforePostId, int perPage);
+
+	/**
+	 * A requested page is merged. A page, shorter than requested, means that the oldest post is loaded
+	 */
+	void requestFinished (const MattermostId& beforePostId, int receivedPosts);
+
+	/**
+	 * A request has failed, the range is requested again on the next scroll
+	 */
+	void requestFailed (const MattermostId& beforePostId);
+
+	/**
+	 * Forget the pending requests, which were cancelled by a reconnect
+	 */
+	void cancelRequests ();
+
+	/**
+	 * Forget the pending requests and the oldest post state, for example after the history is trimmed
+	 */
+	void reset ();
+private:
+	struct PendingRequest {
+		MattermostId		beforePostId;
+		int					perPage;
+		QElapsedTimer		timer;
+	};
+private:
+	std::vector<PendingRequest>	pendingRequests;
+	QElapsedTimer				scrollTimer;
+	int							lastScrollValue;
+
+	//smoothed speed of scrolling up, pixels per second
+	double						scrollSpeed;
+
+	//smoothed response time of the pages, milliseconds
+	double						responseTime;
+	bool						reachedOldestPost;
+	int							prefetchScreens;
+};
+
+} /* namespace Mattermost */
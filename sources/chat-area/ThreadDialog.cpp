@@ -0,0 +1,80 @@
+/**
+ * @file ThreadDialog.cpp
+ * @brief
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "ThreadDialog.h"
+#include "ui_ThreadDialog.h"
+
+#include "backend/Backend.h"
+#include "backend/types/BackendChannel.h"
+#include "backend/types/BackendPost.h"
+
+namespace Mattermost {
+
+ThreadDialog::ThreadDialog (Backend& backend, BackendChannel& channel, const MattermostId& rootId, QWidget* parent)
+:QDialog (parent)
+,ui (new Ui::ThreadDialog)
+,channel (channel)
+,rootId (rootId)
+{
+	ui->setupUi (this);
+	setAttribute (Qt::WA_DeleteOnClose);
+	setWindowTitle ("Thread in " + channel.display_name + " - Mattermost");
+
+	connect (&channel, &BackendChannel::onThreadLoaded, this, [this] (const MattermostId& loadedRootId) {
+		if (loadedRootId == this->rootId) {
+			fillPosts ();
+		}
+	});
+
+	//the shown posts are copies of the texts, but they are refreshed, so that evicted posts are not listed
+	connect (&channel, &BackendChannel::onHistoryTrimmed, this, &ThreadDialog::fillPosts);
+
+	fillPosts ();
+	backend.retrieveThread (channel, rootId);
+}
+
+ThreadDialog::~ThreadDialog ()
+{
+	delete ui;
+}
+
+void ThreadDialog::fillPosts ()
+{
+	std::vector<BackendPost*> thread (channel.getThread (rootId));
+
+	ui->postsList->clear ();
+
+	for (const BackendPost* post: thread) {
+		if (post->isDeleted) {
+			continue;
+		}
+
+		QString header (post->getDisplayAuthorName() + ", " + post->getCreationTime().toString ("dd.MM.yyyy hh:mm"));
+		ui->postsList->addItem (header + "\n" + post->getMessage());
+	}
+
+	ui->threadLabel->setText (QString::number (ui->postsList->count()) + " posts in the thread:");
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,56 @@
+/**
+ * @file ThreadDialog.h
+ * @brief Posts of a thread, loaded when the dialog is opened
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <QDialog>
+#include "backend/types/MattermostId.h"
+
+namespace Ui {
+class ThreadDialog;
+}
+
+namespace Mattermost {
+
+class Backend;
+class BackendChannel;
+
+/**
+ * Shows the root post and the replies of a thread. The posts, which the channel already knows, are shown
+ * right away, and the whole thread is requested (Backend::retrieveThread()) when the dialog is opened
+ */
+class ThreadDialog: public QDialog {
+	Q_OBJECT
+public:
+	ThreadDialog (Backend& backend, BackendChannel& channel, const MattermostId& rootId, QWidget* parent = nullptr);
+	virtual ~ThreadDialog ();
+private:
+	void fillPosts ();
+private:
+	Ui::ThreadDialog*		ui;
+	BackendChannel&			channel;
+	MattermostId			rootId;
+};
+
+} /* namespace Mattermost */
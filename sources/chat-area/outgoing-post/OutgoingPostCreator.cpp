@@ -42,7 +42,7 @@
 namespace Mattermost {
 
 struct OutgoingPostData {
-	const BackendPost*					postToEdit;			//!< Post to be edited. If nullptr - start a new post
+	MattermostId						postToEdit;			//!< ID of the post to be edited. If empty - start a new post
 	std::unique_ptr<BackendNewPollData> pollData;			//!< Poll data, used when creating a poll
 	QString 							message;			//!< Message text
 	QList<QString>						attachmentPaths;	//!< List of file paths waiting to be attached
@@ -52,7 +52,6 @@ struct OutgoingPostData {
 OutgoingPostCreator::OutgoingPostCreator(QWidget *parent)
 :QWidget(parent)
 ,ui(new Ui::OutgoingPostCreator)
-,postToEdit (nullptr)
 ,attachmentList (nullptr)
 ,isConnected (true)
 {
@@ -71,7 +70,7 @@ void OutgoingPostCreator::init (Backend& backend, BackendChannel& channel, Outgo
 	 */
 	connect (ui->textEdit, &MessageTextEditWidget::escapePressed, [this] {
 		ui->textEdit->clear();
-		postToEdit = nullptr;
+		postToEdit = MattermostId ();
 		postEditFinished ();
 	});
 
@@ -165,10 +164,10 @@ void OutgoingPostCreator::postEditInitiated (BackendPost& post)
 		return;
 	}
 
-	ui->textEdit->setText (post.message);
+	ui->textEdit->setText (post.getMessage());
 	ui->textEdit->setFocus ();
 	ui->textEdit->moveCursor (QTextCursor::End);
-	postToEdit = &post;
+	postToEdit = post.id;
 }
 
 static NewPollDialog* newPollDialog;
@@ -206,7 +205,7 @@ void OutgoingPostCreator::sendPostButtonAction ()
 
 	outgoingPostData->message = message;
 	outgoingPostData->postToEdit = postToEdit;
-	postToEdit = nullptr;
+	postToEdit = MattermostId ();
 
 
 	if (attachmentList) {
@@ -253,9 +252,9 @@ void OutgoingPostCreator::sendPost ()
 {
 	QString attachmentsLogStr (outgoingPostData->attachmentIds.isEmpty() ? "" : " (+attachments)");
 
-	if (outgoingPostData->postToEdit) {
+	if (!outgoingPostData->postToEdit.isEmpty()) {
 		qDebug () << "Send post edit" << attachmentsLogStr;
-		backend->editPost (outgoingPostData->postToEdit->id, outgoingPostData->message, outgoingPostData->attachmentIds);
+		backend->editPost (outgoingPostData->postToEdit, outgoingPostData->message, outgoingPostData->attachmentIds);
 	} else if (outgoingPostData->pollData) {
 		backend->addPoll (*channel, *outgoingPostData->pollData);
 	} else {
@@ -303,7 +302,7 @@ void OutgoingPostCreator::onPostReceived (BackendPost& post)
 		setStatusLabelText ("");
 
 		//reset the 'editing post' state
-		if (outgoingPostData->postToEdit) {
+		if (!outgoingPostData->postToEdit.isEmpty()) {
 			emit postEditFinished();
 		}
 
@@ -27,6 +27,7 @@
 #include <QTimer>
 #include <QWidget>
 #include "fwd.h"
+#include "backend/types/MattermostId.h"
 
 class QDragEnterEvent;
 class QDragMoveEvent;
@@ -87,7 +88,7 @@ private:
 	BackendChannel*						channel;
 	OutgoingPostPanel*					panel;
 	QTimer								sendRetryTimer;
-	const BackendPost*					postToEdit;
+	MattermostId						postToEdit;
 	OutgoingAttachmentList*				attachmentList;
 	std::unique_ptr<OutgoingPostData> 	outgoingPostData;
 	bool								isConnected;
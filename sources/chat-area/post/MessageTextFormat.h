@@ -0,0 +1,41 @@
+/**
+ * @file MessageTextFormat.h
+ * @brief Conversion of post messages to the rich text, displayed in the chat area
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <QString>
+
+namespace Mattermost {
+
+/**
+ * Replace emoji names, enclosed in ':' (for example :wave:), with their unicode value
+ */
+void replaceEmojis (QString& str);
+
+/**
+ * Convert a post message to rich text - HTML-escaped, with line breaks, emojis and links
+ */
+QString formatMessageText (const QString& str);
+
+} /* namespace Mattermost */
@@ -39,10 +39,10 @@ PostQuoteFrame::PostQuoteFrame (BackendPost& containingPost, const BackendPost&
 	bool isMatterpollQuote = quotedPost.author == storage.matterpollUser && containingPost.author == storage.matterpollUser;
 	if (isMatterpollQuote) {
 
-		if (!quotedPost.poll) {
+		if (!quotedPost.getPoll()) {
 			qDebug() << "Matterpoll quoted post contains no poll";
 		} else {
-			QString pollTitle = quotedPost.poll->title;
+			QString pollTitle = quotedPost.getPoll()->title;
 
 			/**
 			 * When a poll ends, there is auto-generated message with the following text, from the Matterpoll user.
@@ -50,7 +50,7 @@ PostQuoteFrame::PostQuoteFrame (BackendPost& containingPost, const BackendPost&
 			 */
 			QString expectedText = "The poll **" + pollTitle + "** has ended and the original post has been updated. You can jump to it by pressing";
 
-			if (containingPost.message.startsWith (expectedText)) {
+			if (containingPost.getMessage().startsWith (expectedText)) {
 				ui->header->setText ("The poll '" + pollTitle + "' has ended.");
 				ui->message->setText("");
 				ui->message->setMaximumHeight (0);
@@ -60,7 +60,7 @@ PostQuoteFrame::PostQuoteFrame (BackendPost& containingPost, const BackendPost&
 	} else {
 
 		ui->header->setText ("Originally posted by " + quotedPost.author->getDisplayName ());
-		ui->message->setText (quotedPost.message);
+		ui->message->setText (quotedPost.getMessage());
 	}
 
 	setContentsMargins (20, 4, 4, 4);
@@ -28,18 +28,25 @@
 #include "backend/emoji/EmojiInfo.h"
 #include "chat-area/ChatArea.h"
 #include "PostQuoteFrame.h"
+#include "MessageTextFormat.h"
 #include "attachments/PostAttachmentList.h"
 #include "attachments/PostPoll.h"
 #include "reactions/PostReactionList.h"
 #include "ui_PostWidget.h"
+#include "log/Tracer.h"
 
 namespace Mattermost {
 
+uint32_t PostWidget::instanceCount = 0;
+
 PostWidget::PostWidget (Backend& backend, BackendPost &post, QWidget *parent, ChatArea* chatArea, BackendPost* lastRootPost)
 :QWidget(parent)
 ,post (post)
+,storage (backend.getStorage())
 ,ui(new Ui::PostWidget)
 {
+	TRACE_SCOPE (ui, "PostWidget::PostWidget");
+	++instanceCount;
 	ui->setupUi(this);
 	ui->authorName->setText (post.getDisplayAuthorName ());
 
@@ -47,7 +54,7 @@ PostWidget::PostWidget (Backend& backend, BackendPost &post, QWidget *parent, Ch
 		ui->authorName->setStyleSheet("QLabel { color : blue; }");
 	}
 
-	ui->message->setText (formatMessageText (post.message));
+	ui->message->setText (formatMessageText (post.getMessage()));
 	ui->time->setText (getMessageTimeString (post.create_at));
 
 	if (!post.author || post.author->avatar.isEmpty()) {
@@ -64,43 +71,34 @@ PostWidget::PostWidget (Backend& backend, BackendPost &post, QWidget *parent, Ch
 	 * Multiple consecutive posts, quoting the same post will have the quote added only to the first of them.
 	 */
 	if (post.rootPost && post.rootPost != lastRootPost) {
-
-		quoteFrame = std::make_unique<PostQuoteFrame> (post, *post.rootPost, backend.getStorage(), this);
-
-		//insert the frame after the post author line
-		ui->verticalLayout->insertWidget (1, quoteFrame.get(), 0, Qt::AlignLeft);
-
-		connect (quoteFrame.get(), &PostQuoteFrame::postClicked, [&post, chatArea] {
-			chatArea->goToPost (*post.rootPost);
-		});
+		addRootPostQuote (chatArea);
 	}
 
 	//Add previews for files, if any
-	if (!post.files.empty()) {
+	if (!post.getFiles().empty()) {
 		attachments = std::make_unique<PostAttachmentList> (backend, this);
-		for (BackendFile& file: post.files) {
+		for (BackendFile& file: post.getFiles()) {
 			attachments->addFile (file, post.getDisplayAuthorName());
 		}
 		ui->verticalLayout->addWidget (attachments.get(), 0, Qt::AlignLeft);
 	}
 
 	//Add reactions, if any
-	if (!post.reactions.empty()) {
+	if (!post.getReactions().empty()) {
 		reactions = std::make_unique<PostReactionList> (this);
 
-		for (auto& it: post.reactions) {
-			EmojiID emojiID = it.first;
-			Emoji emoji = EmojiInfo::getEmoji (emojiID);
-			reactions->addReaction (emoji.name, emoji.unicodeString, it.second);
+		for (auto& it: post.getReactions()) {
+			Emoji emoji = EmojiInfo::getEmoji (it.emojiId);
+			reactions->addReaction (emoji.name, emoji.unicodeString, it.users, storage);
 		}
 
 		ui->verticalLayout->addWidget (reactions.get(), 0, Qt::AlignLeft);
 	}
 
-	if (post.poll) {
+	if (post.getPoll()) {
 		//clear message text, because poll messages do not contain free text (outside the poll itself)
 		clearMessageText ();
-		poll = std::make_unique<PostPoll> (backend, post, *post.poll, this);
+		poll = std::make_unique<PostPoll> (backend, post, *post.getPoll(), this);
 		ui->verticalLayout->addWidget (poll.get(), 0, Qt::AlignLeft);
 	}
 
@@ -113,6 +111,12 @@ PostWidget::PostWidget (Backend& backend, BackendPost &post, QWidget *parent, Ch
 PostWidget::~PostWidget()
 {
     delete ui;
+    --instanceCount;
+}
+
+uint32_t PostWidget::getInstanceCount ()
+{
+	return instanceCount;
 }
 
 void PostWidget::setEdited (const QString& message)
@@ -122,10 +126,10 @@ void PostWidget::setEdited (const QString& message)
 	/**
 	 * if (there is a poll in the post, just recreate the poll instance
 	 */
-	if (post.poll) {
+	if (post.getPoll()) {
 		//clear message text, because poll messages do not contain free text (outside the poll itself)
 		clearMessageText ();
-		std::unique_ptr<PostPoll> newPoll = std::make_unique<PostPoll> (poll->backend, post, *post.poll, this);
+		std::unique_ptr<PostPoll> newPoll = std::make_unique<PostPoll> (poll->backend, post, *post.getPoll(), this);
 		ui->verticalLayout->replaceWidget (poll.get(), newPoll.get());
 		poll = std::move (newPoll);
 	}
@@ -138,23 +142,37 @@ void PostWidget::updateReactions ()
 	}
 
 	//Add reactions, if any
-	if (!post.reactions.empty()) {
+	if (!post.getReactions().empty()) {
 		reactions = std::make_unique<PostReactionList> (this);
 
-		for (auto& it: post.reactions) {
-			EmojiID emojiID = it.first;
-			Emoji emoji = EmojiInfo::getEmoji (emojiID);
-			reactions->addReaction (emoji.name, emoji.unicodeString, it.second);
+		for (auto& it: post.getReactions()) {
+			Emoji emoji = EmojiInfo::getEmoji (it.emojiId);
+			reactions->addReaction (emoji.name, emoji.unicodeString, it.users, storage);
 		}
 
 		ui->verticalLayout->addWidget (reactions.get(), 0, Qt::AlignLeft);
 	}
 }
 
+void PostWidget::addRootPostQuote (ChatArea* chatArea)
+{
+	if (quoteFrame || !post.rootPost) {
+		return;
+	}
+
+	quoteFrame = std::make_unique<PostQuoteFrame> (post, *post.rootPost, storage, this);
+
+	//insert the frame after the post author line
+	ui->verticalLayout->insertWidget (1, quoteFrame.get(), 0, Qt::AlignLeft);
+
+	connect (quoteFrame.get(), &PostQuoteFrame::postClicked, [this, chatArea] {
+		chatArea->goToPost (*post.rootPost);
+	});
+}
+
 void PostWidget::markAsDeleted ()
 {
 	attachments.reset (nullptr);
-	post.isDeleted = true;
 	if (poll) {
 		ui->verticalLayout->removeWidget (poll.get());
 		poll.reset (nullptr);
@@ -172,104 +190,6 @@ QString PostWidget::getSelectedText ()
 	return ui->message->selectedText();
 }
 
-void replaceEmojis (QString& str)
-{
-	int emojiStart = 0;
-	int emojiEnd = 0;
-
-	do {
-
-		//find a substring enclosed in ':' - for example - :wave:
-		emojiStart = str.indexOf (':', emojiEnd);
-		if (emojiStart == -1) {
-			break;
-		}
-
-		emojiEnd = str.indexOf (':', emojiStart + 1);
-		if (emojiEnd == -1) {
-			break;
-		}
-
-		if (emojiEnd - emojiStart == 1) {
-			++emojiEnd;
-			continue;
-		}
-
-		int emojiNameSize = emojiEnd - emojiStart - 1;
-
-		//get the substring enclosed in ':' (without the ':'). This is the emoji name
-		QString emojiName = str.mid (emojiStart + 1, emojiNameSize);
-
-		EmojiID emojiID = EmojiInfo::findByName (emojiName);
-
-		if (!emojiID) {
-			continue;
-		}
-
-		Emoji emoji = EmojiInfo::getEmoji (emojiID);
-
-		//replace the emoji name (together with ':') with it's corresponding value
-		str.replace (emojiStart, emojiNameSize + 2, emoji.unicodeString);
-
-		emojiEnd -= emojiName.size() + 2 - emoji.unicodeString.size();
-		++emojiEnd;
-
-	} while (emojiStart != -1);
-
-}
-
-QString PostWidget::formatMessageText (const QString& str)
-{
-	QString ret (str.toHtmlEscaped ());
-	ret.replace("\n", "<br>");
-
-	int linkStart = 0;
-	int linkEnd = 0;
-
-	replaceEmojis (ret);
-
-	do {
-
-		QLatin1String lookups[2] = { QLatin1String ("http://"), QLatin1String ("https://") };
-		QLatin1String* useLookup = nullptr;
-
-		for (auto& lookup: lookups) {
-			linkStart = ret.indexOf (lookup, linkEnd);
-
-			if (linkStart != -1) {
-				useLookup = &lookup;
-				break;
-			}
-		}
-
-		if (!useLookup) {
-			break;
-		}
-
-		//poor man's find_first_of - there is no such thing in QT, and std::string is not aware of multibyte characters
-		for (linkEnd = linkStart + useLookup->size(); linkEnd < ret.size(); ++linkEnd) {
-			if (ret.at (linkEnd) == ' ' || ret.at (linkEnd) == '<') {
-				break;
-			}
-		}
-
-		if (linkEnd == -1) {
-			linkEnd = ret.size();
-		}
-
-		size_t size = linkEnd - linkStart;
-
-		ret.insert (linkEnd, "\">" + QStringRef (&ret, linkStart,  size) + "</a>");
-		ret.insert (linkStart, "<a href=\"");
-
-		linkEnd += size + 15;
-	} while (linkStart != -1);
-
-	//std::cout << str.toStdString() << std::endl;
-	//std::cout << ret.toStdString() << std::endl;
-	return ret;
-}
-
 QString PostWidget::getMessageTimeString (uint64_t timestamp)
 {
 	QDate currentDate = QDateTime::currentDateTime().date();
@@ -292,11 +212,11 @@ QString PostWidget::getMessageTimeString (uint64_t timestamp)
 QString PostWidget::formatForClipboardSelection (FormatType formatType) const
 {
 	if (formatType == messageOnly) {
-		return post.message;
+		return post.getMessage();
 	}
 
 	QString ret (post.getDisplayAuthorName() + "\t[" + ui->time->text() + "]\n");
-	ret += " " + post.message + "\n\n";
+	ret += " " + post.getMessage() + "\n\n";
 	return ret;
 }
 
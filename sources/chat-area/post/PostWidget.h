@@ -30,6 +30,7 @@ namespace Mattermost {
 
 class Backend;
 class BackendPost;
+class Storage;
 class PostQuoteFrame;
 class PostAttachmentList;
 class PostReactionList;
@@ -58,21 +59,33 @@ public:
     QString getSelectedText ();
 
     QString getMessageTimeString (uint64_t timestamp);
-    QString formatMessageText (const QString& str);
     QString formatForClipboardSelection (FormatType formatType) const;
 
     void clearMessageText ();
 
+    /**
+     * Show the root post as a quote box, if it is not shown already. Called for replies, whose root post is loaded later
+     */
+    void addRootPostQuote (ChatArea* chatArea);
+
+    /**
+     * Number of existing PostWidget objects
+     */
+    static uint32_t getInstanceCount ();
+
     BackendPost&						post;
     QString								hoveredLink;
 signals:
 	void dimensionsChanged ();
 private:
+    const Storage&						storage;
     Ui::PostWidget*						ui;
     std::unique_ptr<PostQuoteFrame>		quoteFrame;
     std::unique_ptr<PostAttachmentList>	attachments;
     std::unique_ptr<PostPoll>			poll;
     std::unique_ptr<PostReactionList>	reactions;
+
+    static uint32_t						instanceCount;
 };
 
 } /* namespace Mattermost */
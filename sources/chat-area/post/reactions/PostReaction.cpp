@@ -19,11 +19,12 @@
 
 #include "PostReaction.h"
 #include "backend/types/BackendPost.h"
+#include "backend/Storage.h"
 #include "ui_PostReaction.h"
 
 namespace Mattermost {
 
-PostReaction::PostReaction (const QString& emojiName, const QString& emojiValue, const BackendPostReaction& reactionData, QWidget *parent)
+PostReaction::PostReaction (const QString& emojiName, const QString& emojiValue, const BackendPostReaction& reactionData, const Storage& storage, QWidget *parent)
 :QWidget(parent)
 ,ui(new Ui::PostReaction)
 {
@@ -36,7 +37,16 @@ PostReaction::PostReaction (const QString& emojiName, const QString& emojiValue,
 
     QString tooltip (emojiName + "  " + emojiValue + "\n");
 
-    for (auto& it: reactionData) {
+    //the names are resolved here, so that renamed users are shown with their current names
+    QStringList userNames;
+
+    for (const MattermostId& userId: reactionData) {
+    	userNames.append (storage.getUserDisplayNameByUserId (userId, true));
+    }
+
+    userNames.sort (Qt::CaseInsensitive);
+
+    for (auto& it: userNames) {
     	tooltip += it + "\n";
     }
 
@@ -28,13 +28,16 @@ class PostReaction;
 
 namespace Mattermost {
 
-using BackendPostReaction = QVector<QString>;
+class IdHashSet;
+class Storage;
+
+using BackendPostReaction = IdHashSet;
 
 class PostReaction: public QWidget
 {
     Q_OBJECT
 public:
-    explicit PostReaction (const QString& emojiName, const QString& emojiValue, const BackendPostReaction& reactionData, QWidget *parent = nullptr);
+    explicit PostReaction (const QString& emojiName, const QString& emojiValue, const BackendPostReaction& reactionData, const Storage& storage, QWidget *parent = nullptr);
     ~PostReaction();
 
 private:
@@ -37,9 +37,9 @@ PostReactionList::~PostReactionList()
     delete ui;
 }
 
-void PostReactionList::addReaction (const QString& emojiName, const QString& emojiValue, const BackendPostReaction& reactionData)
+void PostReactionList::addReaction (const QString& emojiName, const QString& emojiValue, const BackendPostReaction& reactionData, const Storage& storage)
 {
-	PostReaction* reaction = new PostReaction (emojiName, emojiValue, reactionData, this);
+	PostReaction* reaction = new PostReaction (emojiName, emojiValue, reactionData, storage, this);
 	ui->horizontalLayout_2->addWidget (reaction, 0, Qt::AlignLeft);
 }
 
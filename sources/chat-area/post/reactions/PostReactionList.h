@@ -28,7 +28,10 @@ class PostReactionList;
 
 namespace Mattermost {
 
-using BackendPostReaction = QVector<QString>;
+class IdHashSet;
+class Storage;
+
+using BackendPostReaction = IdHashSet;
 
 class PostReactionList: public QWidget
 {
@@ -37,7 +40,7 @@ public:
     explicit PostReactionList(QWidget *parent = nullptr);
     ~PostReactionList();
 public:
-    void addReaction (const QString& emojiName, const QString& emojiValue, const BackendPostReaction& reactionData);
+    void addReaction (const QString& emojiName, const QString& emojiValue, const BackendPostReaction& reactionData, const Storage& storage);
 
 private:
     Ui::PostReactionList *ui;
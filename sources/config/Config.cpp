@@ -67,4 +67,9 @@ QDir Config::tempDirectory ()
 	return tempDir.filePath("qmattermost");
 }
 
+QDir Config::logDirectory ()
+{
+	return QDir (QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath("logs");
+}
+
 } /* namespace Mattermost */
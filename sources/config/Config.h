@@ -35,6 +35,7 @@ public:
 public:
 	static void init ();
 	static QDir tempDirectory ();
+	static QDir logDirectory ();
 };
 
 } /* namespace Mattermost */
@@ -22,6 +22,8 @@
 
 #include "backend/types/BackendChannel.h"
 #include "backend/types/BackendTeam.h"
+#include "backend/types/BackendChannelSummary.h"
+#include "backend/Storage.h"
 
 namespace Mattermost {
 
@@ -47,6 +49,25 @@ ChannelInfoDialog::ChannelInfoDialog (const BackendChannel& channel, QWidget *pa
     ui->messageCountValue->setText (QString::number (channel.total_msg_count));
 }
 
+ChannelInfoDialog::ChannelInfoDialog (const BackendChannelSummary& channel, Storage& storage, QWidget *parent)
+:QDialog(parent)
+,ui(new Ui::ChannelInfoDialog)
+{
+    ui->setupUi(this);
+
+    setWindowTitle ("Information for channel '" + channel.display_name + "' - Mattermost");
+
+    BackendTeam* team = storage.getTeamById (channel.team_id);
+    BackendUser* creator = storage.getUserById (channel.creator_id);
+
+    ui->nameValue->setText (channel.name);
+	ui->teamValue->setText (team ? team->display_name : "N/A");
+    ui->headerValue->setText (getString (channel.header));
+	ui->purposeValue->setText (getString (channel.purpose));
+    ui->creatorValue->setText (creator ? creator->getDisplayName() : "N/A");
+    ui->messageCountValue->setText (QString::number (channel.total_msg_count));
+}
+
 ChannelInfoDialog::~ChannelInfoDialog()
 {
     delete ui;
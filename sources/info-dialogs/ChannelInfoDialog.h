@@ -29,12 +29,18 @@ class ChannelInfoDialog;
 
 namespace Mattermost {
 
+class Storage;
+struct BackendChannelSummary;
+
 class ChannelInfoDialog: public QDialog
 {
     Q_OBJECT
 
 public:
     explicit ChannelInfoDialog (const BackendChannel& channel, QWidget *parent = nullptr);
+
+    //for a channel, which the user may not be a member of. The team and the creator are looked up in the storage
+    ChannelInfoDialog (const BackendChannelSummary& channel, Storage& storage, QWidget *parent = nullptr);
     ~ChannelInfoDialog();
 
 private:
@@ -0,0 +1,254 @@
+/**
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "DiagnosticsDialog.h"
+#include "ui_DiagnosticsDialog.h"
+
+#include <QFile>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QJsonDocument>
+#include <QMessageBox>
+#include "backend/Backend.h"
+#include "log/StallWatchdog.h"
+#include "log/ChannelSwitchMetrics.h"
+
+namespace Mattermost {
+
+namespace NetworkColumn {
+enum type {
+	endpoint,
+	requests,
+	failures,
+	p50,
+	p95,
+	p99,
+	requestBytes,
+	responseBytes,
+	cacheHitRatio,
+};
+}
+
+namespace StallColumn {
+enum type {
+	time,
+	duration,
+	span,
+};
+}
+
+namespace SwitchColumn {
+enum type {
+	phase,
+	p50,
+	p95,
+	max,
+};
+}
+
+static QString formatMs (uint32_t durationUs)
+{
+	return QString::number (durationUs / 1000.0, 'f', 1);
+}
+
+DiagnosticsDialog::DiagnosticsDialog (Backend& backend, StallWatchdog& watchdog, QWidget *parent)
+:QDialog(parent)
+,ui(new Ui::DiagnosticsDialog)
+,backend (backend)
+,watchdog (watchdog)
+{
+    ui->setupUi(this);
+
+    ui->networkTree->header()->setSectionResizeMode (QHeaderView::ResizeToContents);
+    ui->networkTree->sortByColumn (NetworkColumn::endpoint, Qt::AscendingOrder);
+
+    connect (ui->refreshButton, &QPushButton::clicked, this, &DiagnosticsDialog::refresh);
+    connect (ui->exportButton, &QPushButton::clicked, this, &DiagnosticsDialog::exportJson);
+
+    connect (ui->resetButton, &QPushButton::clicked, [this] {
+    	this->backend.getNetworkMetrics().reset ();
+    	refresh ();
+    });
+
+    ui->stallsTree->header()->setSectionResizeMode (QHeaderView::ResizeToContents);
+
+    connect (ui->clearStallsButton, &QPushButton::clicked, [this] {
+    	this->watchdog.clearStalls ();
+    	refreshStalls ();
+    });
+
+    connect (&watchdog, &StallWatchdog::stallDetected, this, &DiagnosticsDialog::refreshStalls);
+
+    ui->switchesTree->header()->setSectionResizeMode (QHeaderView::ResizeToContents);
+
+    connect (ui->clearSwitchesButton, &QPushButton::clicked, [this] {
+    	ChannelSwitchMetrics::instance().clear ();
+    	refreshSwitches ();
+    });
+
+    connect (&ChannelSwitchMetrics::instance(), &ChannelSwitchMetrics::switchFinished, this, &DiagnosticsDialog::refreshSwitches);
+
+    refresh ();
+    refreshStalls ();
+    refreshSwitches ();
+}
+
+DiagnosticsDialog::~DiagnosticsDialog()
+{
+    delete ui;
+}
+
+void DiagnosticsDialog::refresh ()
+{
+	const NetworkMetrics& metrics = backend.getNetworkMetrics ();
+
+	ui->networkTree->setSortingEnabled (false);
+	ui->networkTree->clear ();
+
+	for (const auto& it: metrics.getEndpoints()) {
+		const EndpointMetrics& endpoint = it.second;
+		QTreeWidgetItem* item = new QTreeWidgetItem (ui->networkTree);
+
+		item->setText (NetworkColumn::endpoint, it.first);
+		item->setData (NetworkColumn::requests, Qt::DisplayRole, endpoint.requests);
+		item->setData (NetworkColumn::failures, Qt::DisplayRole, endpoint.failures);
+		item->setText (NetworkColumn::p50, formatMs (endpoint.latency.percentile (0.5)));
+		item->setText (NetworkColumn::p95, formatMs (endpoint.latency.percentile (0.95)));
+		item->setText (NetworkColumn::p99, formatMs (endpoint.latency.percentile (0.99)));
+		item->setData (NetworkColumn::requestBytes, Qt::DisplayRole, (qulonglong)endpoint.requestBytes);
+		item->setData (NetworkColumn::responseBytes, Qt::DisplayRole, (qulonglong)endpoint.responseBytes);
+		item->setText (NetworkColumn::cacheHitRatio, QString::number (endpoint.cacheHitRatio() * 100, 'f', 1) + "%");
+	}
+
+	ui->networkTree->setSortingEnabled (true);
+
+	WebSocketCompressionStats compression (backend.getWebSocketCompressionStats ());
+	ui->websocketLabel->setText (QString ("WebSocket: received %1 bytes (ratio %2), sent %3 bytes (ratio %4). Metrics since %5")
+			.arg (compression.receivedPayloadBytes)
+			.arg (compression.receiveRatio(), 0, 'f', 2)
+			.arg (compression.sentPayloadBytes)
+			.arg (compression.sendRatio(), 0, 'f', 2)
+			.arg (metrics.getStartTime().toString ("HH:mm:ss")));
+}
+
+void DiagnosticsDialog::refreshStalls ()
+{
+	ui->stallsTree->clear ();
+
+	//newest first
+	const std::deque<StallRecord>& stalls = watchdog.getStalls ();
+	for (auto it = stalls.rbegin(); it != stalls.rend(); ++it) {
+		QTreeWidgetItem* item = new QTreeWidgetItem (ui->stallsTree);
+
+		item->setText (StallColumn::time, it->time.toString ("HH:mm:ss.zzz"));
+		item->setData (StallColumn::duration, Qt::DisplayRole, it->durationMs);
+		item->setText (StallColumn::span, it->span.isEmpty() ? QString ("(unknown)") : it->span);
+	}
+
+	ui->latencyLabel->setText (QString ("Event loop latency: %1 ms, max %2 ms in the last second. Stall threshold: %3 ms")
+			.arg (watchdog.getLatencyMs())
+			.arg (watchdog.getMaxLatencyMs())
+			.arg (StallWatchdog::stallThresholdMs));
+}
+
+void DiagnosticsDialog::refreshSwitches ()
+{
+	const ChannelSwitchMetrics& metrics = ChannelSwitchMetrics::instance ();
+	const std::deque<ChannelSwitchRecord>& records = metrics.getRecords ();
+
+	ui->switchesTree->clear ();
+
+	for (int phase = 0; phase <= SwitchPhase::count; ++phase) {
+		LatencyHistogram histogram (metrics.getHistogram (phase));
+		QTreeWidgetItem* item = new QTreeWidgetItem (ui->switchesTree);
+
+		item->setText (SwitchColumn::phase, ChannelSwitchMetrics::phaseName ((SwitchPhase::type) phase));
+		item->setText (SwitchColumn::p50, formatMs (histogram.percentile (0.5)));
+		item->setText (SwitchColumn::p95, formatMs (histogram.percentile (0.95)));
+		item->setText (SwitchColumn::max, formatMs (histogram.max ()));
+	}
+
+	uint32_t coldSwitches = (uint32_t) std::count_if (records.begin(), records.end(), [] (const ChannelSwitchRecord& record) {
+		return record.cold;
+	});
+
+	QString text (QString ("Last %1 switches (%2 had to fetch the posts), %3 over the budget of %4 ms")
+			.arg (records.size())
+			.arg (coldSwitches)
+			.arg (metrics.getOverBudgetCount())
+			.arg (ChannelSwitchMetrics::budgetMs));
+
+	if (!records.empty()) {
+		const ChannelSwitchRecord& last = records.back();
+		text += QString ("\nLast: %1, %2 ms at %3").arg (last.channelName).arg (formatMs (last.totalUs)).arg (last.time.toString ("HH:mm:ss"));
+	}
+
+	ui->switchesLabel->setText (text);
+}
+
+void DiagnosticsDialog::exportJson ()
+{
+	QString fileName = QFileDialog::getSaveFileName (this, "Export Network Metrics", "mattermost-qt-metrics.json", "JSON (*.json)");
+
+	if (fileName.isEmpty()) {
+		return;
+	}
+
+	QJsonObject json (backend.getNetworkMetrics().toJson ());
+	WebSocketCompressionStats compression (backend.getWebSocketCompressionStats ());
+
+	json.insert ("websocket_compression", QJsonObject {
+		{"received_bytes", (qint64)compression.receivedPayloadBytes},
+		{"received_wire_bytes", (qint64)compression.receivedWireBytes},
+		{"sent_bytes", (qint64)compression.sentPayloadBytes},
+		{"sent_wire_bytes", (qint64)compression.sentWireBytes},
+		{"receive_ratio", compression.receiveRatio()},
+		{"send_ratio", compression.sendRatio()},
+	});
+
+	const ChannelSwitchMetrics& switchMetrics = ChannelSwitchMetrics::instance ();
+	QJsonObject switchesJson {
+		{"switches", (qint64)switchMetrics.getRecords().size()},
+		{"over_budget", (qint64)switchMetrics.getOverBudgetCount()},
+		{"budget_ms", (qint64)ChannelSwitchMetrics::budgetMs},
+	};
+
+	for (int phase = 0; phase <= SwitchPhase::count; ++phase) {
+		LatencyHistogram histogram (switchMetrics.getHistogram (phase));
+
+		switchesJson.insert (ChannelSwitchMetrics::phaseName ((SwitchPhase::type) phase), QJsonObject {
+			{"p50_ms", histogram.percentile (0.5) / 1000.0},
+			{"p95_ms", histogram.percentile (0.95) / 1000.0},
+			{"max_ms", histogram.max () / 1000.0},
+		});
+	}
+
+	json.insert ("channel_switches", switchesJson);
+
+	QFile file (fileName);
+
+	if (!file.open (QIODevice::WriteOnly)) {
+		QMessageBox::critical (this, "Export Network Metrics", "Cannot open " + fileName + ": " + file.errorString());
+		return;
+	}
+
+	file.write (QJsonDocument (json).toJson (QJsonDocument::Indented));
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#ifndef DIAGNOSTICSDIALOG_H
+#define DIAGNOSTICSDIALOG_H
+
+#include <QDialog>
+#include "fwd.h"
+
+namespace Ui {
+class DiagnosticsDialog;
+}
+
+namespace Mattermost {
+
+class Backend;
+class StallWatchdog;
+
+/**
+ * Diagnostics dialog, not reachable from the menu (opened with Ctrl+Shift+D).
+ * Shows the per-endpoint network metrics (exported as JSON), the recorded event loop stalls
+ * and the timing of the recent channel switches
+ */
+class DiagnosticsDialog: public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsDialog (Backend& backend, StallWatchdog& watchdog, QWidget *parent = nullptr);
+    ~DiagnosticsDialog();
+
+private:
+    void refresh ();
+    void refreshStalls ();
+    void refreshSwitches ();
+    void exportJson ();
+
+private:
+    Ui::DiagnosticsDialog *ui;
+    Backend& backend;
+    StallWatchdog& watchdog;
+};
+
+} /* namespace Mattermost */
+
+#endif // DIAGNOSTICSDIALOG_H
@@ -24,12 +24,47 @@
 
 #pragma once
 
-#include <QTime>
-#include <QDebug>
+#include "build-config.h"
+#include "log/Logger.h"
 
-namespace Mattermost {
+/**
+ * Logging macros. Usage:
+ * 	LOG_DEBUG (http, "reply for " << path << LogField ("duration_ms", elapsed));
+ *
+ * The first argument is a LogCategory name. The rest is evaluated only if the level is enabled for
+ * the category at runtime. Levels below LOG_COMPILE_LEVEL (set by CMake) are removed at compile time.
+ */
+#define LOG_RECORD(level,category,x) \
+	do { \
+		if (::Mattermost::Logger::instance().isEnabled (::Mattermost::LogCategory::category, ::Mattermost::LogLevel::level)) { \
+			::Mattermost::Logger::instance().write (::Mattermost::LogLevel::level, ::Mattermost::LogCategory::category, ::Mattermost::LogRecord() << x); \
+		} \
+	} while (0)
+
+#define LOG_DISABLED(category,x) do {} while (0)
+
+#if LOG_COMPILE_LEVEL <= 0
+#define LOG_TRACE(category,x) LOG_RECORD(trace,category,x)
+#else
+#define LOG_TRACE(category,x) LOG_DISABLED(category,x)
+#endif
+
+#if LOG_COMPILE_LEVEL <= 1
+#define LOG_DEBUG(category,x) LOG_RECORD(debug,category,x)
+#else
+#define LOG_DEBUG(category,x) LOG_DISABLED(category,x)
+#endif
 
-#define LOG_DEBUG(x) qDebug().noquote().nospace() << QTime::currentTime().toString("HH:mm:ss:zzz ") << x
+#if LOG_COMPILE_LEVEL <= 2
+#define LOG_INFO(category,x) LOG_RECORD(info,category,x)
+#else
+#define LOG_INFO(category,x) LOG_DISABLED(category,x)
+#endif
 
-} /* namespace Mattermost */
+#if LOG_COMPILE_LEVEL <= 3
+#define LOG_WARNING(category,x) LOG_RECORD(warning,category,x)
+#else
+#define LOG_WARNING(category,x) LOG_DISABLED(category,x)
+#endif
 
+#define LOG_ERROR(category,x) LOG_RECORD(error,category,x)
@@ -0,0 +1,206 @@
+/**
+ * @file ChannelSwitchMetrics.cpp
+ * @brief Timing of channel switches, from the click in the channel tree to the first paint
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "ChannelSwitchMetrics.h"
+
+#include <algorithm>
+#include <QEvent>
+#include "backend/types/BackendChannel.h"
+#include "log.h"
+
+namespace Mattermost {
+
+namespace {
+
+//switches kept for the percentiles
+constexpr size_t maxRecords = 200;
+
+//a switch, which has not been painted in this time (minimized window, failed request), is abandoned
+constexpr int switchTimeoutMs = 10000;
+
+}
+
+ChannelSwitchMetrics& ChannelSwitchMetrics::instance ()
+{
+	static ChannelSwitchMetrics metrics;
+	return metrics;
+}
+
+const char* ChannelSwitchMetrics::phaseName (SwitchPhase::type phase)
+{
+	switch (phase) {
+	case SwitchPhase::fetch:
+		return "fetch";
+	case SwitchPhase::decode:
+		return "decode";
+	case SwitchPhase::build:
+		return "build";
+	case SwitchPhase::layout:
+		return "layout";
+	case SwitchPhase::paint:
+		return "paint";
+	default:
+		return "total";
+	}
+}
+
+ChannelSwitchMetrics::ChannelSwitchMetrics ()
+:channel (nullptr)
+,nextPhase (SwitchPhase::count)
+,lastPhaseEndUs (0)
+{
+	timeoutTimer.setSingleShot (true);
+	timeoutTimer.setInterval (switchTimeoutMs);
+	connect (&timeoutTimer, &QTimer::timeout, this, &ChannelSwitchMetrics::abandon);
+}
+
+void ChannelSwitchMetrics::begin (const BackendChannel& channel, QObject* window)
+{
+	if (this->channel) {
+		abandon ();
+	}
+
+	if (this->window != window) {
+
+		if (this->window) {
+			this->window->removeEventFilter (this);
+		}
+
+		this->window = window;
+		window->installEventFilter (this);
+	}
+
+	this->channel = &channel;
+	current = ChannelSwitchRecord ();
+	current.time = QDateTime::currentDateTime ();
+	current.channelName = channel.display_name;
+	nextPhase = SwitchPhase::fetch;
+	lastPhaseEndUs = 0;
+	switchTimer.start ();
+	timeoutTimer.start ();
+}
+
+void ChannelSwitchMetrics::phaseDone (const BackendChannel& channel, SwitchPhase::type phase)
+{
+	if (this->channel != &channel || phase < nextPhase) {
+		return;
+	}
+
+	qint64 nowUs = switchTimer.nsecsElapsed() / 1000;
+	current.phaseUs[phase] = (uint32_t) (nowUs - lastPhaseEndUs);
+	lastPhaseEndUs = nowUs;
+	nextPhase = phase + 1;
+
+	if (phase == SwitchPhase::fetch) {
+		current.cold = true;
+	}
+
+	if (nextPhase == SwitchPhase::count) {
+		finish ();
+	}
+}
+
+const std::deque<ChannelSwitchRecord>& ChannelSwitchMetrics::getRecords () const
+{
+	return records;
+}
+
+LatencyHistogram ChannelSwitchMetrics::getHistogram (int phase) const
+{
+	LatencyHistogram histogram;
+
+	for (const ChannelSwitchRecord& record: records) {
+		histogram.add (phase == SwitchPhase::count ? record.totalUs : record.phaseUs[phase]);
+	}
+
+	return histogram;
+}
+
+uint32_t ChannelSwitchMetrics::getOverBudgetCount () const
+{
+	return (uint32_t) std::count_if (records.begin(), records.end(), [] (const ChannelSwitchRecord& record) {
+		return record.totalUs > budgetMs * 1000;
+	});
+}
+
+void ChannelSwitchMetrics::clear ()
+{
+	records.clear ();
+}
+
+bool ChannelSwitchMetrics::eventFilter (QObject* watched, QEvent* event)
+{
+	//the window is repainted while UpdateRequest is processed, so the paint ends right after it
+	if (watched == window && event->type() == QEvent::UpdateRequest && channel && nextPhase == SwitchPhase::layout) {
+		phaseDone (*channel, SwitchPhase::layout);
+
+		const BackendChannel* paintedChannel = channel;
+		QTimer::singleShot (0, this, [this, paintedChannel] {
+			if (channel == paintedChannel) {
+				phaseDone (*channel, SwitchPhase::paint);
+			}
+		});
+	}
+
+	return QObject::eventFilter (watched, event);
+}
+
+void ChannelSwitchMetrics::finish ()
+{
+	timeoutTimer.stop ();
+	current.totalUs = (uint32_t) lastPhaseEndUs;
+	channel = nullptr;
+
+	if (current.totalUs > budgetMs * 1000) {
+		LOG_WARNING (ui, "Channel switch to " << current.channelName << " over budget" << LogField ("total_ms", current.totalUs / 1000)
+				<< LogField ("fetch_ms", current.phaseUs[SwitchPhase::fetch] / 1000)
+				<< LogField ("decode_ms", current.phaseUs[SwitchPhase::decode] / 1000)
+				<< LogField ("build_ms", current.phaseUs[SwitchPhase::build] / 1000)
+				<< LogField ("layout_ms", current.phaseUs[SwitchPhase::layout] / 1000)
+				<< LogField ("paint_ms", current.phaseUs[SwitchPhase::paint] / 1000));
+	} else {
+		LOG_DEBUG (ui, "Channel switch to " << current.channelName << LogField ("total_ms", current.totalUs / 1000) << LogField ("cold", current.cold));
+	}
+
+	records.push_back (current);
+
+	if (records.size() > maxRecords) {
+		records.pop_front ();
+	}
+
+	emit switchFinished (records.back());
+}
+
+void ChannelSwitchMetrics::abandon ()
+{
+	if (!channel) {
+		return;
+	}
+
+	LOG_DEBUG (ui, "Channel switch to " << current.channelName << " not measured" << LogField ("phase", phaseName ((SwitchPhase::type) nextPhase)));
+	timeoutTimer.stop ();
+	channel = nullptr;
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,118 @@
+/**
+ * @file ChannelSwitchMetrics.h
+ * @brief Timing of channel switches, from the click in the channel tree to the first paint
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <array>
+#include <deque>
+#include <QObject>
+#include <QDateTime>
+#include <QPointer>
+#include <QTimer>
+#include <QElapsedTimer>
+#include "backend/NetworkMetrics.h"
+
+namespace Mattermost {
+
+class BackendChannel;
+
+namespace SwitchPhase {
+enum type {
+	fetch,		//!< waiting for the posts of the channel (zero if they are loaded)
+	decode,		//!< parsing the reply and creating the posts
+	build,		//!< creating (or showing the existing) post widgets
+	layout,		//!< from the widgets being ready to the start of the repaint
+	paint,		//!< repainting the window
+	count
+};
+}
+
+struct ChannelSwitchRecord {
+	QDateTime							time;
+	QString								channelName;
+	std::array<uint32_t, SwitchPhase::count>	phaseUs {};
+	uint32_t							totalUs = 0;
+
+	//the posts had to be fetched
+	bool								cold = false;
+};
+
+/**
+ * Measures the switches between channels, from the current item change in the channel tree to the
+ * first repaint of the window after the post widgets are ready. The phases are measured back to back,
+ * so their sum is the total time. Only one switch is measured at a time, a switch started before the
+ * previous one has finished abandons it. The last switches are kept for the percentiles in the diagnostics
+ */
+class ChannelSwitchMetrics: public QObject {
+	Q_OBJECT
+public:
+	static ChannelSwitchMetrics& instance ();
+	static const char* phaseName (SwitchPhase::type phase);
+public:
+	/**
+	 * Called when the current item of the channel tree changes, before the chat area is activated
+	 */
+	void begin (const BackendChannel& channel, QObject* window);
+
+	/**
+	 * Marks the end of the given phase of the switch to 'channel'. Ignored if the channel is not
+	 * being switched to, or the phase has already ended. The skipped phases get zero durations
+	 */
+	void phaseDone (const BackendChannel& channel, SwitchPhase::type phase);
+
+	const std::deque<ChannelSwitchRecord>& getRecords () const;
+
+	/**
+	 * Histogram of a phase over the kept switches. SwitchPhase::count gives the total time
+	 */
+	LatencyHistogram getHistogram (int phase) const;
+	uint32_t getOverBudgetCount () const;
+	void clear ();
+
+	/**
+	 * Switches slower than this are logged with their phases
+	 */
+	static constexpr uint32_t budgetMs = 100;
+signals:
+	void switchFinished (const ChannelSwitchRecord& record);
+private:
+	ChannelSwitchMetrics ();
+
+	bool eventFilter (QObject* watched, QEvent* event) override;
+	void finish ();
+	void abandon ();
+private:
+	//the switch being measured
+	const BackendChannel*				channel;
+	ChannelSwitchRecord					current;
+	int									nextPhase;
+	QElapsedTimer						switchTimer;
+	qint64								lastPhaseEndUs;
+
+	QPointer<QObject>					window;
+	QTimer								timeoutTimer;
+	std::deque<ChannelSwitchRecord>		records;
+};
+
+} /* namespace Mattermost */
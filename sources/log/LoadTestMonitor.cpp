@@ -0,0 +1,225 @@
+/**
+ * @file LoadTestMonitor.cpp
+ * @brief Throughput, event-to-paint latency and memory growth under a WebSocket event firehose
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "LoadTestMonitor.h"
+
+#include <algorithm>
+#include <QDateTime>
+#include <QEvent>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include "ProcessMemory.h"
+#include "log.h"
+
+namespace Mattermost {
+
+//events, which are never painted (minimized window, for example), are dropped after this count
+static constexpr size_t maxPendingEvents = 1000000;
+
+bool LoadTestMonitor::enabled = false;
+
+LoadTestMonitor& LoadTestMonitor::instance ()
+{
+	static LoadTestMonitor monitor;
+	return monitor;
+}
+
+bool LoadTestMonitor::isEnabled ()
+{
+	return enabled;
+}
+
+LoadTestMonitor::LoadTestMonitor ()
+:paintCheckScheduled (false)
+,sampleEvents (0)
+,startMemory (0)
+,peakMemory (0)
+{
+	sampleTimer.setInterval (1000);
+	connect (&sampleTimer, &QTimer::timeout, this, &LoadTestMonitor::takeSample);
+}
+
+void LoadTestMonitor::start (const QString& reportFileName)
+{
+	this->reportFileName = reportFileName;
+	startMemory = peakMemory = getResidentMemory ();
+	elapsed.start ();
+	sampleTimer.start ();
+	enabled = true;
+
+	LOG_INFO (websocket, "Load test started" << LogField ("report", reportFileName));
+}
+
+void LoadTestMonitor::stop ()
+{
+	if (!enabled) {
+		return;
+	}
+
+	enabled = false;
+	sampleTimer.stop ();
+
+	if (window) {
+		window->removeEventFilter (this);
+	}
+
+	if (!saveReport ()) {
+		LOG_ERROR (websocket, "Cannot save the load test report to " << reportFileName);
+	}
+}
+
+void LoadTestMonitor::watchPaints (QObject* window)
+{
+	if (this->window) {
+		this->window->removeEventFilter (this);
+	}
+
+	this->window = window;
+	window->installEventFilter (this);
+}
+
+void LoadTestMonitor::addEvent (const QString& type, int64_t sentAtMs)
+{
+	++eventCounts[type];
+	++sampleEvents;
+
+	if (sentAtMs && pendingEvents.size() < maxPendingEvents) {
+		pendingEvents.push_back (sentAtMs);
+	}
+}
+
+bool LoadTestMonitor::eventFilter (QObject* watched, QEvent* event)
+{
+	//the window is repainted while UpdateRequest is processed, so the check runs right after it
+	if (watched == window && event->type() == QEvent::UpdateRequest && !pendingEvents.empty() && !paintCheckScheduled) {
+		paintCheckScheduled = true;
+		QTimer::singleShot (0, this, &LoadTestMonitor::onPainted);
+	}
+
+	return QObject::eventFilter (watched, event);
+}
+
+void LoadTestMonitor::onPainted ()
+{
+	int64_t now = QDateTime::currentMSecsSinceEpoch ();
+
+	for (int64_t sentAt: pendingEvents) {
+		uint32_t latencyUs = (uint32_t)std::min<int64_t> (std::max<int64_t> (now - sentAt, 0) * 1000, UINT32_MAX);
+		sampleLatency.add (latencyUs);
+		totalLatency.add (latencyUs);
+	}
+
+	pendingEvents.clear ();
+	paintCheckScheduled = false;
+}
+
+void LoadTestMonitor::takeSample ()
+{
+	Sample sample {
+		(uint32_t)elapsed.elapsed(),
+		sampleEvents,
+		sampleLatency.percentile (0.5),
+		sampleLatency.percentile (0.99),
+		sampleLatency.max (),
+		getResidentMemory (),
+	};
+
+	peakMemory = std::max (peakMemory, sample.residentMemory);
+	samples.push_back (sample);
+
+	LOG_INFO (websocket, "Load test sample" << LogField ("events_per_s", sample.events)
+			<< LogField ("latency_p50_ms", sample.latencyP50Us / 1000)
+			<< LogField ("latency_p99_ms", sample.latencyP99Us / 1000)
+			<< LogField ("pending", (uint32_t)pendingEvents.size())
+			<< LogField ("rss_mb", sample.residentMemory / (1024 * 1024)));
+
+	sampleEvents = 0;
+	sampleLatency = LatencyHistogram ();
+}
+
+bool LoadTestMonitor::saveReport ()
+{
+	QJsonArray samplesJson;
+	uint32_t maxSustainedRate = 0;
+	uint64_t totalEvents = 0;
+
+	for (const Sample& sample: samples) {
+		samplesJson.push_back (QJsonObject {
+			{"time_ms", (qint64)sample.timeMs},
+			{"events", (qint64)sample.events},
+			{"latency_p50_ms", sample.latencyP50Us / 1000.0},
+			{"latency_p99_ms", sample.latencyP99Us / 1000.0},
+			{"latency_max_ms", sample.latencyMaxUs / 1000.0},
+			{"resident_memory", (qint64)sample.residentMemory},
+		});
+
+		if (sample.latencyP99Us <= lagThresholdMs * 1000) {
+			maxSustainedRate = std::max (maxSustainedRate, sample.events);
+		}
+	}
+
+	QJsonObject eventsByType;
+	for (auto it = eventCounts.begin(); it != eventCounts.end(); ++it) {
+		eventsByType.insert (it.key(), (qint64)it.value());
+		totalEvents += it.value();
+	}
+
+	uint64_t endMemory = getResidentMemory ();
+	int64_t durationMs = elapsed.elapsed ();
+
+	QJsonObject report {
+		{"duration_ms", durationMs},
+		{"events", (qint64)totalEvents},
+		{"events_by_type", eventsByType},
+		{"average_rate", durationMs ? totalEvents * 1000.0 / durationMs : 0.0},
+		{"max_sustained_rate", (qint64)maxSustainedRate},
+		{"lag_threshold_ms", (qint64)lagThresholdMs},
+		{"latency_ms", QJsonObject {
+			{"p50", totalLatency.percentile (0.5) / 1000.0},
+			{"p95", totalLatency.percentile (0.95) / 1000.0},
+			{"p99", totalLatency.percentile (0.99) / 1000.0},
+			{"max", totalLatency.max () / 1000.0},
+		}},
+		{"resident_memory", QJsonObject {
+			{"start", (qint64)startMemory},
+			{"end", (qint64)endMemory},
+			{"peak", (qint64)std::max (peakMemory, endMemory)},
+			{"growth", (qint64)endMemory - (qint64)startMemory},
+		}},
+		{"samples", samplesJson},
+	};
+
+	QFile file (reportFileName);
+
+	if (!file.open (QIODevice::WriteOnly | QIODevice::Truncate)) {
+		return false;
+	}
+
+	file.write (QJsonDocument (report).toJson (QJsonDocument::Indented));
+	return true;
+}
+
+} /* namespace Mattermost */
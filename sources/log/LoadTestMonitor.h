@@ -0,0 +1,103 @@
+/**
+ * @file LoadTestMonitor.h
+ * @brief Throughput, event-to-paint latency and memory growth under a WebSocket event firehose
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <vector>
+#include <QObject>
+#include <QMap>
+#include <QPointer>
+#include <QTimer>
+#include <QElapsedTimer>
+#include "backend/NetworkMetrics.h"
+
+namespace Mattermost {
+
+/**
+ * Measures the client under the event firehose of the stand-in server (--firehose). The server adds
+ * its send time (wall clock, ms) to each event as 'stand_in_sent_at'. The time from it to the end of
+ * the next repaint of the main window is the event-to-paint latency. Every second, a sample with the
+ * event rate, latency percentiles and resident memory is taken and logged. stop() saves the samples
+ * and the totals as JSON. The main window has to stay visible during the test, otherwise no paints happen.
+ */
+class LoadTestMonitor: public QObject {
+	Q_OBJECT
+public:
+	static LoadTestMonitor& instance ();
+	static bool isEnabled ();
+public:
+	void start (const QString& reportFileName);
+	void stop ();
+
+	/**
+	 * Events are considered displayed when this window is repainted
+	 */
+	void watchPaints (QObject* window);
+
+	/**
+	 * Called after a WebSocket event is handled. 'sentAtMs' is 0 for events, which do not come from the stand-in server
+	 */
+	void addEvent (const QString& type, int64_t sentAtMs);
+
+	/**
+	 * The UI is considered lagging, if the 99th percentile of the event-to-paint latency in a sample is above this
+	 */
+	static constexpr uint32_t lagThresholdMs = 100;
+private:
+	LoadTestMonitor ();
+
+	struct Sample {
+		uint32_t	timeMs;
+		uint32_t	events;
+		uint32_t	latencyP50Us;
+		uint32_t	latencyP99Us;
+		uint32_t	latencyMaxUs;
+		uint64_t	residentMemory;
+	};
+
+	bool eventFilter (QObject* watched, QEvent* event) override;
+	void onPainted ();
+	void takeSample ();
+	bool saveReport ();
+private:
+	static bool					enabled;
+	QString						reportFileName;
+	QPointer<QObject>			window;
+	QTimer						sampleTimer;
+	QElapsedTimer				elapsed;
+
+	//send times of the events, handled since the last paint
+	std::vector<int64_t>		pendingEvents;
+	bool						paintCheckScheduled;
+
+	QMap<QString, uint64_t>		eventCounts;
+	uint32_t					sampleEvents;
+	LatencyHistogram			sampleLatency;
+	LatencyHistogram			totalLatency;
+	uint64_t					startMemory;
+	uint64_t					peakMemory;
+	std::vector<Sample>			samples;
+};
+
+} /* namespace Mattermost */
@@ -0,0 +1,129 @@
+/**
+ * @file LogRingBuffer.h
+ * @brief Bounded lock-free multi-producer / single-consumer queue, used by the logger
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace Mattermost {
+
+/**
+ * Fixed size ring buffer. Any thread can push, a single thread pops.
+ * Each cell has a sequence number, which tells whether the cell is free for the producer
+ * at a given position, or holds a value for the consumer. push() never waits - if the buffer
+ * is full, it fails and the caller decides what to do with the value.
+ */
+template <typename T, size_t capacity>
+class LogRingBuffer {
+	static_assert (capacity >= 2 && (capacity & (capacity - 1)) == 0, "LogRingBuffer capacity must be a power of 2");
+public:
+	LogRingBuffer ();
+public:
+	bool push (T&& value);
+	bool pop (T& value);
+
+	/**
+	 * Approximate number of values in the buffer
+	 */
+	size_t size () const;
+private:
+	struct Cell {
+		std::atomic<size_t>		sequence;
+		T						value;
+	};
+
+	static constexpr size_t mask = capacity - 1;
+
+	Cell						cells[capacity];
+	alignas (64) std::atomic<size_t>	enqueuePosition;
+	alignas (64) std::atomic<size_t>	dequeuePosition;
+};
+
+template <typename T, size_t capacity>
+LogRingBuffer<T, capacity>::LogRingBuffer ()
+:enqueuePosition (0)
+,dequeuePosition (0)
+{
+	for (size_t i = 0; i < capacity; ++i) {
+		cells[i].sequence.store (i, std::memory_order_relaxed);
+	}
+}
+
+template <typename T, size_t capacity>
+bool LogRingBuffer<T, capacity>::push (T&& value)
+{
+	Cell* cell;
+	size_t position = enqueuePosition.load (std::memory_order_relaxed);
+
+	while (true) {
+		cell = &cells[position & mask];
+		size_t sequence = cell->sequence.load (std::memory_order_acquire);
+		intptr_t diff = (intptr_t)sequence - (intptr_t)position;
+
+		if (diff == 0) {
+			if (enqueuePosition.compare_exchange_weak (position, position + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			//the consumer has not freed this cell yet - the buffer is full
+			return false;
+		} else {
+			position = enqueuePosition.load (std::memory_order_relaxed);
+		}
+	}
+
+	cell->value = std::move (value);
+	cell->sequence.store (position + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename T, size_t capacity>
+bool LogRingBuffer<T, capacity>::pop (T& value)
+{
+	size_t position = dequeuePosition.load (std::memory_order_relaxed);
+	Cell& cell = cells[position & mask];
+	size_t sequence = cell.sequence.load (std::memory_order_acquire);
+
+	if ((intptr_t)sequence - (intptr_t)(position + 1) < 0) {
+		return false;
+	}
+
+	value = std::move (cell.value);
+	cell.sequence.store (position + capacity, std::memory_order_release);
+	dequeuePosition.store (position + 1, std::memory_order_relaxed);
+	return true;
+}
+
+template <typename T, size_t capacity>
+size_t LogRingBuffer<T, capacity>::size () const
+{
+	size_t enqueued = enqueuePosition.load (std::memory_order_relaxed);
+	size_t dequeued = dequeuePosition.load (std::memory_order_relaxed);
+	return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+} /* namespace Mattermost */
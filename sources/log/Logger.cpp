@@ -0,0 +1,392 @@
+/**
+ * @file Logger.cpp
+ * @brief Asynchronous logger - records are queued by the calling thread and written by a background thread
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "Logger.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include "LogRingBuffer.h"
+
+namespace Mattermost {
+
+namespace {
+
+struct LogEntry {
+	qint64				time;
+	LogLevel::type		level;
+	LogCategory::type	category;
+	QString				message;
+	QVector<LogField>	fields;
+};
+
+constexpr size_t queueCapacity = 8192;
+constexpr qint64 maxFileSize = 4 * 1024 * 1024;
+constexpr int maxBackupFiles = 3;
+constexpr int flushIntervalMs = 200;
+
+const char* levelNames[] = {"trace", "debug", "info", "warning", "error", "off"};
+const char* categoryNames[] = {"general", "backend", "http", "websocket", "storage", "ui"};
+
+QByteArray formatEntry (const LogEntry& entry)
+{
+	QString line (QDateTime::fromMSecsSinceEpoch (entry.time).toString ("yyyy-MM-dd HH:mm:ss.zzz "));
+	line += QString (Logger::levelName (entry.level)).toUpper();
+	line += " [";
+	line += Logger::categoryName (entry.category);
+	line += "] ";
+	line += entry.message;
+
+	for (const LogField& field: entry.fields) {
+		line += ' ';
+		line += field.name;
+		line += '=';
+
+		if (field.value.contains (' ')) {
+			line += '"' + field.value + '"';
+		} else {
+			line += field.value;
+		}
+	}
+
+	line += '\n';
+	return line.toUtf8 ();
+}
+
+void messageHandler (QtMsgType type, const QMessageLogContext&, const QString& message)
+{
+	LogLevel::type level;
+
+	switch (type) {
+	case QtDebugMsg:
+		level = LogLevel::debug;
+		break;
+	case QtInfoMsg:
+		level = LogLevel::info;
+		break;
+	case QtWarningMsg:
+		level = LogLevel::warning;
+		break;
+	default:
+		level = LogLevel::error;
+		break;
+	}
+
+	Logger& logger = Logger::instance ();
+
+	if (logger.isEnabled (LogCategory::general, level)) {
+		logger.write (level, LogCategory::general, LogRecord() << message);
+	}
+
+	if (type == QtFatalMsg) {
+		logger.stop ();
+		abort ();
+	}
+}
+
+} /* namespace */
+
+class LoggerThread {
+public:
+	LoggerThread (const QString& directory, const QString& fileName, const std::atomic<bool>& consoleOutput);
+	~LoggerThread ();
+public:
+	bool push (LogEntry&& entry, bool urgent);
+	void stop ();
+private:
+	void run ();
+	void drain ();
+	void openFile ();
+	void rotate ();
+private:
+	LogRingBuffer<LogEntry, queueCapacity>	queue;
+	QString									filePath;
+	QFile									file;
+	const std::atomic<bool>&				consoleOutput;
+	std::atomic<bool>						running;
+	std::mutex								mutex;
+	std::condition_variable					wakeup;
+	std::thread								thread;
+};
+
+LoggerThread::LoggerThread (const QString& directory, const QString& fileName, const std::atomic<bool>& consoleOutput)
+:filePath (QDir (directory).filePath (fileName))
+,consoleOutput (consoleOutput)
+,running (true)
+{
+	QDir().mkpath (directory);
+	openFile ();
+	thread = std::thread (&LoggerThread::run, this);
+}
+
+LoggerThread::~LoggerThread ()
+{
+	stop ();
+}
+
+bool LoggerThread::push (LogEntry&& entry, bool urgent)
+{
+	if (!queue.push (std::move (entry))) {
+		wakeup.notify_one ();
+		return false;
+	}
+
+	if (urgent || queue.size() > queueCapacity / 2) {
+		wakeup.notify_one ();
+	}
+
+	return true;
+}
+
+void LoggerThread::stop ()
+{
+	if (!thread.joinable()) {
+		return;
+	}
+
+	running = false;
+	wakeup.notify_one ();
+	thread.join ();
+
+	//records, pushed while the thread was stopping
+	drain ();
+}
+
+void LoggerThread::run ()
+{
+	while (running) {
+		drain ();
+
+		std::unique_lock<std::mutex> lock (mutex);
+		wakeup.wait_for (lock, std::chrono::milliseconds (flushIntervalMs));
+	}
+
+	drain ();
+}
+
+void LoggerThread::drain ()
+{
+	LogEntry entry;
+	bool written = false;
+
+	while (queue.pop (entry)) {
+		QByteArray line (formatEntry (entry));
+
+		if (consoleOutput) {
+			fwrite (line.constData(), 1, line.size(), stderr);
+		}
+
+		if (file.isOpen()) {
+			file.write (line);
+		}
+
+		written = true;
+	}
+
+	if (!written || !file.isOpen()) {
+		return;
+	}
+
+	file.flush ();
+
+	if (file.size() > maxFileSize) {
+		rotate ();
+	}
+}
+
+void LoggerThread::openFile ()
+{
+	file.setFileName (filePath);
+
+	if (!file.open (QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+		fprintf (stderr, "Cannot open log file %s: %s\n", qPrintable (filePath), qPrintable (file.errorString()));
+	}
+}
+
+void LoggerThread::rotate ()
+{
+	file.close ();
+
+	QFile::remove (filePath + '.' + QString::number (maxBackupFiles));
+
+	for (int i = maxBackupFiles - 1; i > 0; --i) {
+		QFile::rename (filePath + '.' + QString::number (i), filePath + '.' + QString::number (i + 1));
+	}
+
+	QFile::rename (filePath, filePath + ".1");
+	openFile ();
+}
+
+LogRecord::LogRecord ()
+:stream (&message)
+{
+	stream.noquote().nospace();
+}
+
+LogRecord& LogRecord::operator<< (const LogField& field)
+{
+	fields.append (field);
+	return *this;
+}
+
+Logger::Logger ()
+:consoleOutput (true)
+,dropped (0)
+,activeThread (nullptr)
+{
+	setLevel (LogLevel::debug);
+}
+
+Logger::~Logger ()
+{
+	stop ();
+}
+
+Logger& Logger::instance ()
+{
+	static Logger logger;
+	return logger;
+}
+
+void Logger::start (const QString& directory, const QString& fileName)
+{
+	if (thread) {
+		return;
+	}
+
+	thread = std::make_unique<LoggerThread> (directory, fileName, consoleOutput);
+	activeThread.store (thread.get(), std::memory_order_release);
+}
+
+void Logger::stop ()
+{
+	if (!thread) {
+		return;
+	}
+
+	//the thread object is kept alive, in case some other thread is still pushing to it
+	activeThread.store (nullptr, std::memory_order_release);
+	thread->stop ();
+}
+
+void Logger::setLevel (LogCategory::type category, LogLevel::type level)
+{
+	levels[category].store (level, std::memory_order_relaxed);
+}
+
+void Logger::setLevel (LogLevel::type level)
+{
+	for (int i = 0; i < LogCategory::count; ++i) {
+		setLevel ((LogCategory::type)i, level);
+	}
+}
+
+void Logger::configure (const QString& levels)
+{
+	for (const QString& item: levels.split (',')) {
+		if (item.trimmed().isEmpty()) {
+			continue;
+		}
+
+		QStringList parts (item.split ('='));
+		QString levelString (parts.size() == 2 ? parts[1].trimmed() : parts[0].trimmed());
+		QString categoryString (parts.size() == 2 ? parts[0].trimmed() : "*");
+
+		int level = 0;
+		while (level <= LogLevel::off && levelString != levelNames[level]) {
+			++level;
+		}
+
+		if (level > LogLevel::off) {
+			qWarning() << "Unknown log level" << levelString;
+			continue;
+		}
+
+		if (categoryString == "*") {
+			setLevel ((LogLevel::type)level);
+			continue;
+		}
+
+		int category = 0;
+		while (category < LogCategory::count && categoryString != categoryNames[category]) {
+			++category;
+		}
+
+		if (category == LogCategory::count) {
+			qWarning() << "Unknown log category" << categoryString;
+			continue;
+		}
+
+		setLevel ((LogCategory::type)category, (LogLevel::type)level);
+	}
+}
+
+void Logger::setConsoleOutput (bool enabled)
+{
+	consoleOutput = enabled;
+}
+
+void Logger::installMessageHandler ()
+{
+	qInstallMessageHandler (messageHandler);
+}
+
+void Logger::write (LogLevel::type level, LogCategory::type category, const LogRecord& record)
+{
+	LogEntry entry {QDateTime::currentMSecsSinceEpoch(), level, category, record.message, record.fields};
+	LoggerThread* loggerThread = activeThread.load (std::memory_order_acquire);
+
+	if (!loggerThread) {
+		//the writer is not running - write synchronously
+		QByteArray line (formatEntry (entry));
+		fwrite (line.constData(), 1, line.size(), stderr);
+		return;
+	}
+
+	if (!loggerThread->push (std::move (entry), level >= LogLevel::warning)) {
+		dropped.fetch_add (1, std::memory_order_relaxed);
+	}
+}
+
+uint64_t Logger::droppedRecords () const
+{
+	return dropped.load (std::memory_order_relaxed);
+}
+
+const char* Logger::levelName (LogLevel::type level)
+{
+	return levelNames[level];
+}
+
+const char* Logger::categoryName (LogCategory::type category)
+{
+	return categoryNames[category];
+}
+
+} /* namespace Mattermost */
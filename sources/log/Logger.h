@@ -0,0 +1,163 @@
+/**
+ * @file Logger.h
+ * @brief Asynchronous logger - records are queued by the calling thread and written by a background thread
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <QString>
+#include <QVector>
+#include <QDebug>
+
+namespace Mattermost {
+
+namespace LogLevel {
+enum type: uint8_t {
+	trace,
+	debug,
+	info,
+	warning,
+	error,
+	off,
+};
+}
+
+namespace LogCategory {
+enum type: uint8_t {
+	general,
+	backend,
+	http,
+	websocket,
+	storage,
+	ui,
+	count
+};
+}
+
+/**
+ * Named value, attached to a log record. Written as 'name=value' after the message,
+ * so that the log file can be filtered by endpoint, channel id, duration, etc.
+ */
+struct LogField {
+	template <typename T>
+	LogField (const char* name, const T& value);
+
+	const char*		name;
+	QString			value;
+};
+
+/**
+ * Log record, built by the LOG_* macros in the calling thread. Anything, printable with qDebug(),
+ * can be streamed into it. LogField values are kept separately from the message text.
+ */
+class LogRecord {
+public:
+	LogRecord ();
+public:
+	template <typename T>
+	LogRecord& operator<< (const T& value);
+
+	LogRecord& operator<< (const LogField& field);
+public:
+	QString				message;
+	QVector<LogField>	fields;
+private:
+	QDebug				stream;
+};
+
+class LoggerThread;
+
+class Logger {
+public:
+	static Logger& instance ();
+public:
+	/**
+	 * Start the background writer. Records are written to 'fileName' inside 'directory',
+	 * which is rotated when it gets bigger than maxFileSize. Until start() is called,
+	 * records are written directly to stderr
+	 */
+	void start (const QString& directory, const QString& fileName);
+
+	/**
+	 * Write all queued records and stop the background writer
+	 */
+	void stop ();
+
+	bool isEnabled (LogCategory::type category, LogLevel::type level) const;
+	void setLevel (LogCategory::type category, LogLevel::type level);
+	void setLevel (LogLevel::type level);
+
+	/**
+	 * Set levels from a string like 'http=trace,websocket=debug,*=info'
+	 */
+	void configure (const QString& levels);
+
+	void setConsoleOutput (bool enabled);
+
+	/**
+	 * Route qDebug(), qWarning(), etc. messages through the logger (category 'general')
+	 */
+	void installMessageHandler ();
+
+	void write (LogLevel::type level, LogCategory::type category, const LogRecord& record);
+
+	/**
+	 * Number of records, lost because the queue was full
+	 */
+	uint64_t droppedRecords () const;
+
+	static const char* levelName (LogLevel::type level);
+	static const char* categoryName (LogCategory::type category);
+private:
+	Logger ();
+	~Logger ();
+private:
+	std::atomic<uint8_t>			levels[LogCategory::count];
+	std::atomic<bool>				consoleOutput;
+	std::atomic<uint64_t>			dropped;
+	std::unique_ptr<LoggerThread>	thread;
+	std::atomic<LoggerThread*>		activeThread;
+};
+
+template <typename T>
+LogField::LogField (const char* name, const T& value)
+:name (name)
+{
+	QDebug (&this->value).noquote().nospace() << value;
+}
+
+template <typename T>
+LogRecord& LogRecord::operator<< (const T& value)
+{
+	stream << value;
+	return *this;
+}
+
+inline bool Logger::isEnabled (LogCategory::type category, LogLevel::type level) const
+{
+	return level >= levels[category].load (std::memory_order_relaxed);
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,78 @@
+/**
+ * @file ProcessMemory.cpp
+ * @brief Memory usage of the process
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "ProcessMemory.h"
+
+#include <QtGlobal>
+#include <QFile>
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#include <malloc.h>
+#elif defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#endif
+
+namespace Mattermost {
+
+uint64_t getResidentMemory ()
+{
+#if defined(Q_OS_LINUX)
+	QFile file ("/proc/self/statm");
+
+	if (!file.open (QIODevice::ReadOnly)) {
+		return 0;
+	}
+
+	QList<QByteArray> fields (file.readAll().split (' '));
+	return fields.size() > 1 ? fields[1].toULongLong() * sysconf (_SC_PAGESIZE) : 0;
+#elif defined(Q_OS_MACOS)
+	mach_task_basic_info info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+	if (task_info (mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+		return 0;
+	}
+
+	return info.resident_size;
+#else
+	return 0;
+#endif
+}
+
+uint64_t getAllocatedHeapMemory ()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	struct mallinfo2 info = mallinfo2 ();
+	return info.uordblks + info.hblkhd;
+#elif defined(__GLIBC__)
+	//the fields of the older interface are int, and wrap above 2 GB
+	struct mallinfo info = mallinfo ();
+	return (uint32_t) info.uordblks + (uint32_t) info.hblkhd;
+#else
+	return 0;
+#endif
+}
+
+} /* namespace Mattermost */
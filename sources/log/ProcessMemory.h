@@ -0,0 +1,42 @@
+/**
+ * @file ProcessMemory.h
+ * @brief Memory usage of the process
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace Mattermost {
+
+/**
+ * Resident set size of the process in bytes, 0 if not supported on the platform
+ */
+uint64_t getResidentMemory ();
+
+/**
+ * Bytes allocated on the heap and not yet freed, 0 if not supported (only glibc is supported).
+ * Unlike the resident set size, it is exact, so it is used for measuring the memory of data structures
+ */
+uint64_t getAllocatedHeapMemory ();
+
+} /* namespace Mattermost */
@@ -0,0 +1,175 @@
+/**
+ * @file StallWatchdog.cpp
+ * @brief Detects stalls of the GUI event loop
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "StallWatchdog.h"
+
+#include <algorithm>
+#include "Tracer.h"
+#include "log.h"
+
+namespace Mattermost {
+
+StallWatchdog::StallWatchdog (QObject* parent)
+:QObject (parent)
+,latencies {}
+,latencyIndex (0)
+,longestSpanUs (0)
+,lastHeartbeat (0)
+,blockedSpan (nullptr)
+,running (false)
+{
+	heartbeatTimer.setTimerType (Qt::PreciseTimer);
+	heartbeatTimer.setInterval (heartbeatIntervalMs);
+	connect (&heartbeatTimer, &QTimer::timeout, this, &StallWatchdog::onHeartbeat);
+}
+
+StallWatchdog::~StallWatchdog ()
+{
+	stop ();
+}
+
+void StallWatchdog::start ()
+{
+	if (running) {
+		return;
+	}
+
+	Tracer::instance().trackThread (stallThresholdMs * 1000, [this] (const QString& name, int64_t durationUs) {
+		onLongSpan (name, durationUs);
+	});
+
+	lastHeartbeat = Tracer::now ();
+	heartbeatElapsed.start ();
+	heartbeatTimer.start ();
+
+	running = true;
+	thread = std::thread (&StallWatchdog::watch, this);
+}
+
+void StallWatchdog::stop ()
+{
+	if (!running) {
+		return;
+	}
+
+	heartbeatTimer.stop ();
+	Tracer::instance().untrackThread ();
+
+	running = false;
+	wakeup.notify_one ();
+	thread.join ();
+}
+
+uint32_t StallWatchdog::getLatencyMs () const
+{
+	return latencies[(latencyIndex + latencyWindow - 1) % latencyWindow];
+}
+
+uint32_t StallWatchdog::getMaxLatencyMs () const
+{
+	return *std::max_element (latencies, latencies + latencyWindow);
+}
+
+const std::deque<StallRecord>& StallWatchdog::getStalls () const
+{
+	return stalls;
+}
+
+void StallWatchdog::clearStalls ()
+{
+	stalls.clear ();
+}
+
+void StallWatchdog::onHeartbeat ()
+{
+	int64_t elapsed = heartbeatElapsed.restart ();
+	uint32_t latency = elapsed > heartbeatIntervalMs ? elapsed - heartbeatIntervalMs : 0;
+
+	lastHeartbeat = Tracer::now ();
+	latencies[latencyIndex] = latency;
+	latencyIndex = (latencyIndex + 1) % latencyWindow;
+
+	const char* spanAtDetection = blockedSpan.exchange (nullptr);
+
+	if (latency >= stallThresholdMs) {
+		StallRecord stall {QDateTime::currentDateTime().addMSecs (-(qint64)elapsed), latency, longestSpan};
+
+		if (stall.span.isEmpty() && spanAtDetection) {
+			stall.span = spanAtDetection;
+		}
+
+		if (stall.span.isEmpty()) {
+			stall.span = "(unknown)";
+		}
+
+		LOG_WARNING (ui, "Event loop stall" << LogField ("duration_ms", latency) << LogField ("span", stall.span));
+
+		if (stalls.size() == maxStalls) {
+			stalls.pop_front ();
+		}
+
+		stalls.push_back (stall);
+		emit stallDetected (stall);
+	}
+
+	longestSpan.clear ();
+	longestSpanUs = 0;
+}
+
+void StallWatchdog::onLongSpan (const QString& name, int64_t durationUs)
+{
+	//spans finish from the innermost to the outermost. Prefer the innermost one, unless an outer span is much longer
+	if (durationUs > longestSpanUs * 2) {
+		longestSpan = name;
+		longestSpanUs = durationUs;
+	}
+}
+
+void StallWatchdog::watch ()
+{
+	int64_t reportedHeartbeat = 0;
+
+	while (running) {
+		{
+			std::unique_lock<std::mutex> lock (mutex);
+			wakeup.wait_for (lock, std::chrono::milliseconds (heartbeatIntervalMs / 2));
+		}
+
+		int64_t heartbeat = lastHeartbeat;
+		int64_t blockedMs = (Tracer::now() - heartbeat) / 1000 - heartbeatIntervalMs;
+
+		if (blockedMs < (int64_t)stallThresholdMs || heartbeat == reportedHeartbeat) {
+			continue;
+		}
+
+		//report each stall once, while it is still in progress
+		reportedHeartbeat = heartbeat;
+		const char* span = Tracer::currentSpan ();
+		blockedSpan = span;
+
+		LOG_WARNING (ui, "GUI thread is not responding" << LogField ("blocked_ms", blockedMs) << LogField ("span", span ? span : "(none)"));
+	}
+}
+
+} /* namespace Mattermost */
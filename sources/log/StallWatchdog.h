@@ -0,0 +1,100 @@
+/**
+ * @file StallWatchdog.h
+ * @brief Detects stalls of the GUI event loop
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QDateTime>
+
+namespace Mattermost {
+
+struct StallRecord {
+	QDateTime	time;
+	uint32_t	durationMs;
+
+	//the longest trace span, which finished during the stall, or the span running when the stall was detected
+	QString		span;
+};
+
+/**
+ * A precise timer in the GUI thread sends a heartbeat every heartbeatIntervalMs. The delay of each heartbeat
+ * is the event loop latency. If it is over stallThresholdMs, the stall is recorded together with the
+ * trace span, which caused it. A helper thread checks the heartbeats too, so that a stall is logged
+ * (with the currently running span) while the GUI thread is still blocked.
+ */
+class StallWatchdog: public QObject {
+	Q_OBJECT
+public:
+	explicit StallWatchdog (QObject* parent = nullptr);
+	virtual ~StallWatchdog ();
+public:
+	void start ();
+	void stop ();
+
+	/**
+	 * Latency of the last heartbeat and the maximal latency of the last second, in milliseconds
+	 */
+	uint32_t getLatencyMs () const;
+	uint32_t getMaxLatencyMs () const;
+
+	const std::deque<StallRecord>& getStalls () const;
+	void clearStalls ();
+
+	static constexpr uint32_t heartbeatIntervalMs = 100;
+	static constexpr uint32_t stallThresholdMs = 200;
+signals:
+	void stallDetected (const StallRecord& stall);
+private:
+	void onHeartbeat ();
+	void onLongSpan (const QString& name, int64_t durationUs);
+	void watch ();
+private:
+	static constexpr size_t maxStalls = 200;
+	static constexpr size_t latencyWindow = 1000 / heartbeatIntervalMs;
+
+	QTimer							heartbeatTimer;
+	QElapsedTimer					heartbeatElapsed;
+	uint32_t						latencies[latencyWindow];
+	size_t							latencyIndex;
+	std::deque<StallRecord>			stalls;
+	QString							longestSpan;
+	int64_t							longestSpanUs;
+
+	//shared with the helper thread
+	std::atomic<int64_t>			lastHeartbeat;
+	std::atomic<const char*>		blockedSpan;
+	std::atomic<bool>				running;
+	std::mutex						mutex;
+	std::condition_variable			wakeup;
+	std::thread						thread;
+};
+
+} /* namespace Mattermost */
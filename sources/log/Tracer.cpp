@@ -0,0 +1,220 @@
+/**
+ * @file Tracer.cpp
+ * @brief Scoped-span tracing with Chrome trace-event JSON export
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "Tracer.h"
+
+#include <chrono>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace Mattermost {
+
+namespace {
+
+//tracing is stopped after that many events, to limit the memory usage
+constexpr size_t maxEvents = 1000000;
+
+std::atomic<uint32_t> threadCount (0);
+thread_local bool threadTracked = false;
+
+} /* namespace */
+
+std::atomic<uint8_t> Tracer::flags (0);
+std::atomic<const char*> Tracer::trackedSpan (nullptr);
+
+Tracer& Tracer::instance ()
+{
+	static Tracer tracer;
+	return tracer;
+}
+
+int64_t Tracer::now ()
+{
+	using namespace std::chrono;
+	return duration_cast<microseconds> (steady_clock::now().time_since_epoch()).count();
+}
+
+void Tracer::start ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	events.clear ();
+	flags |= recordingFlag;
+}
+
+void Tracer::stop ()
+{
+	flags &= ~recordingFlag;
+}
+
+bool Tracer::save (const QString& fileName)
+{
+	QJsonArray traceEvents;
+	qint64 pid = QCoreApplication::applicationPid ();
+
+	traceEvents.push_back (QJsonObject {
+		{"name", "thread_name"},
+		{"ph", "M"},
+		{"pid", pid},
+		{"tid", 1},
+		{"args", QJsonObject {{"name", "GUI"}}},
+	});
+
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+
+		for (const Event& event: events) {
+			if (event.asyncId) {
+				QJsonObject begin {
+					{"name", event.name},
+					{"cat", event.category},
+					{"ph", "b"},
+					{"id", (qint64)event.asyncId},
+					{"ts", (qint64)event.start},
+					{"pid", pid},
+					{"tid", (qint64)event.thread},
+				};
+
+				QJsonObject end (begin);
+				end["ph"] = "e";
+				end["ts"] = (qint64)event.end;
+
+				traceEvents.push_back (begin);
+				traceEvents.push_back (end);
+				continue;
+			}
+
+			traceEvents.push_back (QJsonObject {
+				{"name", event.name},
+				{"cat", event.category},
+				{"ph", "X"},
+				{"ts", (qint64)event.start},
+				{"dur", (qint64)(event.end - event.start)},
+				{"pid", pid},
+				{"tid", (qint64)event.thread},
+			});
+		}
+	}
+
+	QFile file (fileName);
+
+	if (!file.open (QIODevice::WriteOnly)) {
+		return false;
+	}
+
+	QJsonObject root {
+		{"traceEvents", traceEvents},
+		{"displayTimeUnit", "ms"},
+	};
+
+	return file.write (QJsonDocument (root).toJson (QJsonDocument::Compact)) > 0;
+}
+
+void Tracer::addSpan (const char* category, const QString& name, int64_t start, int64_t end)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+
+	if (events.size() >= maxEvents) {
+		flags &= ~recordingFlag;
+		return;
+	}
+
+	events.push_back (Event {category, name, start, end, currentThread (), 0});
+}
+
+void Tracer::addAsyncSpan (const char* category, const QString& name, int64_t start, int64_t end)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+
+	if (events.size() >= maxEvents) {
+		flags &= ~recordingFlag;
+		return;
+	}
+
+	events.push_back (Event {category, name, start, end, currentThread (), nextAsyncId++});
+}
+
+size_t Tracer::eventCount ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	return events.size ();
+}
+
+void Tracer::trackThread (int64_t thresholdUs, std::function<void (const QString&, int64_t)> callback)
+{
+	longSpanThreshold = thresholdUs;
+	longSpanCallback = std::move (callback);
+	threadTracked = true;
+	flags |= trackingFlag;
+}
+
+void Tracer::untrackThread ()
+{
+	flags &= ~trackingFlag;
+	threadTracked = false;
+	trackedSpan = nullptr;
+	longSpanCallback = nullptr;
+}
+
+const char* Tracer::currentSpan ()
+{
+	return trackedSpan.load (std::memory_order_relaxed);
+}
+
+bool Tracer::isThreadTracked ()
+{
+	return threadTracked;
+}
+
+void TraceSpan::finish ()
+{
+	int64_t end = Tracer::now ();
+	Tracer& tracer = Tracer::instance ();
+	QString spanName (name ? QString (name) : dynamicName);
+
+	if (Tracer::isEnabled ()) {
+		tracer.addSpan (category, spanName, start, end);
+	}
+
+	if (!tracked) {
+		return;
+	}
+
+	Tracer::trackedSpan.store (parentSpan, std::memory_order_relaxed);
+
+	if (end - start > tracer.longSpanThreshold && tracer.longSpanCallback) {
+		tracer.longSpanCallback (spanName, end - start);
+	}
+}
+
+uint32_t Tracer::currentThread ()
+{
+	//the first thread, which records an event, is the GUI thread in practice
+	thread_local uint32_t thread = ++threadCount;
+	return thread;
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,200 @@
+/**
+ * @file Tracer.h
+ * @brief Scoped-span tracing with Chrome trace-event JSON export
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <QString>
+
+namespace Mattermost {
+
+/**
+ * Collects trace events and saves them in the Chrome trace-event format, which can be opened
+ * in chrome://tracing or https://ui.perfetto.dev. While tracing is stopped, TRACE_SCOPE costs
+ * a single atomic load.
+ */
+class Tracer {
+public:
+	static Tracer& instance ();
+
+	/**
+	 * Whether spans are recorded
+	 */
+	static bool isEnabled ();
+
+	/**
+	 * Whether spans are recorded or tracked (TraceSpan has something to do)
+	 */
+	static bool isActive ();
+
+	/**
+	 * Monotonic time in microseconds
+	 */
+	static int64_t now ();
+public:
+	void start ();
+	void stop ();
+	bool save (const QString& fileName);
+
+	/**
+	 * Add a span on the calling thread's track. Spans on the same thread must be nested
+	 */
+	void addSpan (const char* category, const QString& name, int64_t start, int64_t end);
+
+	/**
+	 * Add a span on a separate track. Used for operations, which overlap each other - HTTP requests, for example
+	 */
+	void addAsyncSpan (const char* category, const QString& name, int64_t start, int64_t end);
+
+	size_t eventCount ();
+
+	/**
+	 * Track the spans of the calling thread, even if tracing is stopped. The name of the innermost
+	 * running span can be read from any thread with currentSpan(). For spans, which take longer than
+	 * 'thresholdUs', 'longSpanCallback' is called on the tracked thread
+	 */
+	void trackThread (int64_t thresholdUs, std::function<void(const QString&, int64_t)> longSpanCallback);
+	void untrackThread ();
+
+	/**
+	 * Name of the innermost running span of the tracked thread. Dynamic span names are not
+	 * accessible from other threads, so only their category is returned for them
+	 */
+	static const char* currentSpan ();
+private:
+	Tracer () = default;
+
+	struct Event {
+		const char*		category;
+		QString			name;
+		int64_t			start;
+		int64_t			end;
+		uint32_t		thread;
+		uint32_t		asyncId;
+	};
+
+	static uint32_t currentThread ();
+	static bool isThreadTracked ();
+
+	static constexpr uint8_t recordingFlag = 1;
+	static constexpr uint8_t trackingFlag = 2;
+private:
+	static std::atomic<uint8_t>		flags;
+	static std::atomic<const char*>	trackedSpan;
+	std::mutex						mutex;
+	std::vector<Event>				events;
+	uint32_t						nextAsyncId = 1;
+	int64_t							longSpanThreshold = 0;
+	std::function<void(const QString&, int64_t)>	longSpanCallback;
+
+	friend class TraceSpan;
+};
+
+/**
+ * RAII span - from construction to destruction
+ */
+class TraceSpan {
+public:
+	TraceSpan (const char* category, const char* name);
+	~TraceSpan ();
+
+	bool isActive () const;
+	void setName (const QString& name);
+private:
+	void finish ();
+private:
+	const char*		category;
+	const char*		name;
+	const char*		parentSpan;
+	QString			dynamicName;
+	int64_t			start;
+	bool			active;
+	bool			tracked;
+};
+
+#define TRACE_CONCAT_(a,b) a##b
+#define TRACE_CONCAT(a,b) TRACE_CONCAT_(a,b)
+
+/**
+ * Trace the current scope. The name should be a string literal
+ */
+#define TRACE_SCOPE(category,name) ::Mattermost::TraceSpan TRACE_CONCAT(traceSpan, __LINE__) (#category, name)
+
+/**
+ * Trace the current scope. 'x' is a QString expression, evaluated only if the span is active
+ */
+#define TRACE_SCOPE_DYNAMIC(category,x) \
+	::Mattermost::TraceSpan TRACE_CONCAT(traceSpan, __LINE__) (#category, nullptr); \
+	if (TRACE_CONCAT(traceSpan, __LINE__).isActive()) TRACE_CONCAT(traceSpan, __LINE__).setName (x)
+
+inline bool Tracer::isEnabled ()
+{
+	return flags.load (std::memory_order_relaxed) & recordingFlag;
+}
+
+inline bool Tracer::isActive ()
+{
+	return flags.load (std::memory_order_relaxed) != 0;
+}
+
+inline TraceSpan::TraceSpan (const char* category, const char* name)
+:category (category)
+,name (name)
+,parentSpan (nullptr)
+,start (0)
+,active (Tracer::isActive ())
+,tracked (false)
+{
+	if (active) {
+		start = Tracer::now ();
+
+		if (Tracer::isThreadTracked ()) {
+			tracked = true;
+			parentSpan = Tracer::trackedSpan.exchange (name ? name : category, std::memory_order_relaxed);
+		}
+	}
+}
+
+inline TraceSpan::~TraceSpan ()
+{
+	if (active) {
+		finish ();
+	}
+}
+
+inline bool TraceSpan::isActive () const
+{
+	return active;
+}
+
+inline void TraceSpan::setName (const QString& name)
+{
+	dynamicName = name;
+}
+
+} /* namespace Mattermost */
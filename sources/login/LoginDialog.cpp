@@ -86,7 +86,7 @@ void LoginDialog::loginToServer (const BackendLoginData& loginData)
     ui->login_pushButton->setEnabled(false);
     ui->error_label->clear();
 
-    LOG_DEBUG ("LoginDialog login");
+    LOG_DEBUG (ui, "LoginDialog login");
     backend.login (loginData, [this, loginData = loginData] (const QString& token) mutable {
 
 		//token already saved. If the callback is called, the login is ok
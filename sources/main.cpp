@@ -21,11 +21,19 @@
 #include <QApplication>
 #include <QMenu>
 #include <QSystemTrayIcon>
+#include <QSettings>
+#include <QCommandLineParser>
 
 #include "login/LoginDialog.h"
 #include "mainwindow.h"
 #include "backend/Backend.h"
 #include "config/Config.h"
+#include "Settings.h"
+#include "log.h"
+#include "log/Tracer.h"
+#include "log/StallWatchdog.h"
+#include "backend/SessionRecorder.h"
+#include "log/LoadTestMonitor.h"
 
 namespace Mattermost {
 
@@ -37,13 +45,20 @@ public:
 	void showWindow ();
 	void toggleShowWindow ();
 	void reopen ();
+	void stopWatchdog ();
+	void setNetworkConditions (const NetworkConditions& conditions);
+	void setChannelSwitchBenchmark (uint32_t switches);
+private:
+	void initLogger ();
 private:
 	std::unique_ptr<MainWindow>			mainWindow;
 	std::unique_ptr<QSystemTrayIcon> 	trayIcon;
 	std::unique_ptr<QMenu>				trayIconMenu;
 	Backend								backend;
+	StallWatchdog						watchdog;
 	LoginDialog*						loginDialog;
 	QWidget*							currentWindow;
+	uint32_t							channelSwitchBenchmark;
 };
 
 inline MattermostApplication::MattermostApplication (int& argc, char *argv[])
@@ -51,8 +66,11 @@ inline MattermostApplication::MattermostApplication (int& argc, char *argv[])
 ,trayIcon (std::make_unique<QSystemTrayIcon> (QIcon(":/icons/img/icon0.ico"), nullptr))
 ,trayIconMenu (std::make_unique<QMenu> (nullptr))
 ,currentWindow (nullptr)
+,channelSwitchBenchmark (0)
 {
     Config::init ();
+	initLogger ();
+	watchdog.start ();
 	trayIcon->setToolTip(tr("Mattermost Qt"));
 	trayIcon->setContextMenu (trayIconMenu.get());
 	trayIcon->show();
@@ -79,7 +97,16 @@ void MattermostApplication::openLoginWindow ()
 	connect (loginDialog, &LoginDialog::accepted, [this] {
 		//create Main Window and open it, after successful login
 		loginDialog = nullptr;
-		mainWindow = std::make_unique<MainWindow> (nullptr, *trayIcon, backend);
+		mainWindow = std::make_unique<MainWindow> (nullptr, *trayIcon, backend, watchdog);
+
+		if (LoadTestMonitor::isEnabled ()) {
+			LoadTestMonitor::instance().watchPaints (mainWindow.get());
+		}
+
+		if (channelSwitchBenchmark) {
+			mainWindow->startChannelSwitchBenchmark (channelSwitchBenchmark);
+		}
+
 		mainWindow->show();
 		currentWindow = mainWindow.get();
 	});
@@ -105,6 +132,21 @@ inline void MattermostApplication::toggleShowWindow ()
 	}
 }
 
+/**
+ * Log levels are read from the settings and then from the MATTERMOST_QT_LOG environment variable,
+ * for example MATTERMOST_QT_LOG="*=info,http=trace"
+ */
+inline void MattermostApplication::initLogger ()
+{
+	Logger& logger = Logger::instance ();
+	QSettings settings;
+
+	logger.configure (settings.value (LOG_LEVELS, "").toString());
+	logger.configure (QString::fromLocal8Bit (qgetenv ("MATTERMOST_QT_LOG")));
+	logger.installMessageHandler ();
+	logger.start (Config::logDirectory().path(), "mattermost-qt.log");
+}
+
 inline void MattermostApplication::reopen ()
 {
 	qDebug () << "lastWindowClosed";
@@ -117,6 +159,21 @@ inline void MattermostApplication::reopen ()
 	openLoginWindow ();
 }
 
+inline void MattermostApplication::stopWatchdog ()
+{
+	watchdog.stop ();
+}
+
+inline void MattermostApplication::setNetworkConditions (const NetworkConditions& conditions)
+{
+	backend.setNetworkConditions (conditions);
+}
+
+inline void MattermostApplication::setChannelSwitchBenchmark (uint32_t switches)
+{
+	channelSwitchBenchmark = switches;
+}
+
 } /* namespace Mattermost */
 
 int main( int argc, char *argv[])
@@ -125,7 +182,71 @@ int main( int argc, char *argv[])
 	QCoreApplication::setApplicationName("Mattermost");
 
 	Mattermost::MattermostApplication app (argc, argv);
+
+	QCommandLineParser parser;
+	QCommandLineOption traceOption ("trace", "Record a trace from startup to exit and save it to <file> (Chrome trace-event format)", "file");
+	QCommandLineOption recordOption ("record", "Record the HTTP replies and WebSocket events of the session to <file>, for replay by the stand-in server", "file");
+	QCommandLineOption loadTestOption ("load-test", "Measure the event throughput, event-to-paint latency and memory growth under the firehose of the stand-in server and save a report to <file>", "file");
+	QCommandLineOption networkOption ("network", "Simulate network conditions: a profile (" + Mattermost::NetworkConditions::profileNames().join (", ")
+			+ ") and / or values, for example 'hotel-wifi,loss=5' or 'latency=200,jitter=50,down=1000,up=500,loss=1,disconnect=1'", "spec");
+	QCommandLineOption switchBenchmarkOption ("switch-benchmark", "After login, switch between the channels <count> times, print the p50 / p95 of the switch time and its phases and quit", "count");
+	parser.addHelpOption ();
+	parser.addOption (traceOption);
+	parser.addOption (recordOption);
+	parser.addOption (loadTestOption);
+	parser.addOption (networkOption);
+	parser.addOption (switchBenchmarkOption);
+	parser.process (app);
+
+	if (parser.isSet (traceOption)) {
+		Mattermost::Tracer::instance().start ();
+	}
+
+	if (parser.isSet (recordOption)) {
+		Mattermost::SessionRecorder::instance().start (parser.value (recordOption));
+	}
+
+	if (parser.isSet (loadTestOption)) {
+		Mattermost::LoadTestMonitor::instance().start (parser.value (loadTestOption));
+	}
+
+	if (parser.isSet (networkOption)) {
+		Mattermost::NetworkConditions conditions;
+
+		if (!conditions.parse (parser.value (networkOption))) {
+			qCritical() << "Invalid --network value: " << parser.value (networkOption);
+			return 1;
+		}
+
+		app.setNetworkConditions (conditions);
+	}
+
+	if (parser.isSet (switchBenchmarkOption)) {
+		uint32_t switches = parser.value (switchBenchmarkOption).toUInt ();
+
+		if (!switches) {
+			qCritical() << "Invalid --switch-benchmark value: " << parser.value (switchBenchmarkOption);
+			return 1;
+		}
+
+		app.setChannelSwitchBenchmark (switches);
+	}
+
 	app.openLoginWindow ();
-	return app.exec();
+	int ret = app.exec();
+
+	if (parser.isSet (traceOption)) {
+		Mattermost::Tracer::instance().stop ();
+
+		if (!Mattermost::Tracer::instance().save (parser.value (traceOption))) {
+			qCritical() << "Cannot save trace to " << parser.value (traceOption);
+		}
+	}
+
+	app.stopWatchdog ();
+	Mattermost::LoadTestMonitor::instance().stop ();
+	Mattermost::SessionRecorder::instance().stop ();
+	Mattermost::Logger::instance().stop ();
+	return ret;
 }
 
@@ -23,30 +23,41 @@
 #include <QCloseEvent>
 #include <QMessageBox>
 #include <QSystemTrayIcon>
+#include <QShortcut>
+#include <QFileDialog>
 #include "./ui_mainwindow.h"
 #include "chat-area/ChatArea.h"
 #include "backend/Backend.h"
 #include "SettingsWindow.h"
+#include "info-dialogs/DiagnosticsDialog.h"
+#include "PerformanceHud.h"
+#include "channel-tree/ChannelPrefetcher.h"
+#include "channel-tree/ChannelSwitchBenchmark.h"
 #include "build-config.h"
 #include "log.h"
+#include "log/Tracer.h"
 
 namespace Mattermost {
 
-MainWindow::MainWindow (QWidget *parent, QSystemTrayIcon& trayIcon, Backend& _backend)
+MainWindow::MainWindow (QWidget *parent, QSystemTrayIcon& trayIcon, Backend& _backend, StallWatchdog& _watchdog)
 :QMainWindow(parent)
 ,ui (std::make_unique<Ui::MainWindow>())
 ,trayIcon (trayIcon)
 ,chooseEmojiDialog (this)
 ,backend (_backend)
+,watchdog (_watchdog)
 ,currentTeamRestoredFromSettings (false)
 ,doDeinit (false)
 {
-	LOG_DEBUG ("MainWindow create start");
+	TRACE_SCOPE (ui, "MainWindow::MainWindow");
+	LOG_DEBUG (ui, "MainWindow create start");
 
 	ui->setupUi(this);
 	ui->channelList->setChatAreaStackedWidget (ui->chatAreaStackedWidget);
 	ui->channelList->setFocus();
 
+	channelPrefetcher = new ChannelPrefetcher (backend, *ui->channelList, this);
+	performanceHud = new PerformanceHud (this, backend, watchdog, *channelPrefetcher);
 	createMenu ();
 
 	const BackendUser& currentUser = backend.getLoginUser();
@@ -64,7 +75,7 @@ MainWindow::MainWindow (QWidget *parent, QSystemTrayIcon& trayIcon, Backend& _ba
 	ui->usernameLabel->setText (currentUser.username);
 
 	connect (&currentUser, &BackendUser::onAvatarChanged, [this, &currentUser] {
-		LOG_DEBUG ("Got User Image");
+		LOG_DEBUG (ui, "Got User Image");
 		QImage img = QImage::fromData (currentUser.avatar).scaled(42, 42, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
 		ui->usericon_label->setPixmap (QPixmap::fromImage(img));
 	});
@@ -112,7 +123,7 @@ MainWindow::MainWindow (QWidget *parent, QSystemTrayIcon& trayIcon, Backend& _ba
 
 		//Activate the same team that was active during the last session
 //				if (teamChannelTree->team.id == currentTeam) {
-//					LOG_DEBUG ("MainWindow activate team " << currentTeam);
+//					LOG_DEBUG (ui, "MainWindow activate team " << currentTeam);
 //					//ui->teamComboBox->setCurrentIndex (teamSeq);
 //					//channelList.activateTeam (teamSeq);
 //					currentTeamRestoredFromSettings = true;
@@ -143,14 +154,14 @@ MainWindow::MainWindow (QWidget *parent, QSystemTrayIcon& trayIcon, Backend& _ba
 	 */
 	connect (&backend, &Backend::onUnreadPostsAtStartup, this, &MainWindow::unreadMessagesNotify);
 
-	LOG_DEBUG ("MainWindow signal register finish");
+	LOG_DEBUG (ui, "MainWindow signal register finish");
 
 	//Restore saved window position and dimensions
 	QSettings settings;
 	restoreGeometry (settings.value( "geometry", saveGeometry()).toByteArray());
 
 	connect (qApp, &QApplication::aboutToQuit, this, &MainWindow::saveState);
-	LOG_DEBUG ("MainWindow create finish");
+	LOG_DEBUG (ui, "MainWindow create finish");
 }
 
 MainWindow::~MainWindow()
@@ -186,7 +197,7 @@ void MainWindow::createMenu ()
 		backend.logout ([this] {
 			doDeinit = true;
 			QMainWindow::close ();
-			LOG_DEBUG ("Logout done");
+			LOG_DEBUG (ui, "Logout done");
 		});
 	});
 
@@ -223,7 +234,41 @@ void MainWindow::createMenu ()
 		QMessageBox::aboutQt (this, "About QT");
 	});
 
+	helpMenu->addSeparator ();
+	QAction* traceAction = helpMenu->addAction (Tracer::isEnabled() ? "Stop Tracing..." : "Start Tracing");
+	connect (traceAction, &QAction::triggered, [this, traceAction] {
+
+		if (!Tracer::isEnabled()) {
+			Tracer::instance().start ();
+			traceAction->setText ("Stop Tracing...");
+			return;
+		}
+
+		Tracer::instance().stop ();
+		traceAction->setText ("Start Tracing");
+
+		QString fileName = QFileDialog::getSaveFileName (this, "Save Trace", "mattermost-qt-trace.json", "Chrome trace (*.json)");
+
+		if (!fileName.isEmpty() && !Tracer::instance().save (fileName)) {
+			QMessageBox::critical (this, "Save Trace", "Cannot save the trace to " + fileName);
+		}
+	});
+
+	QAction* hudAction = helpMenu->addAction ("Performance Overlay");
+	hudAction->setCheckable (true);
+	hudAction->setShortcut (QKeySequence ("Ctrl+Shift+P"));
+	addAction (hudAction);
+	connect (hudAction, &QAction::triggered, performanceHud, &PerformanceHud::toggle);
+
 	ui->toolButton->setMenu(mainMenu);
+
+	//the diagnostics dialog is intentionally not in the menu
+	QShortcut* diagnosticsShortcut = new QShortcut (QKeySequence ("Ctrl+Shift+D"), this);
+	connect (diagnosticsShortcut, &QShortcut::activated, [this] {
+		DiagnosticsDialog* dialog = new DiagnosticsDialog (backend, watchdog, this);
+		dialog->setAttribute (Qt::WA_DeleteOnClose);
+		dialog->show ();
+	});
 }
 
 void MainWindow::reload ()
@@ -279,7 +324,8 @@ void MainWindow::closeEvent(QCloseEvent *event)
 
 void MainWindow::initializationComplete ()
 {
-	LOG_DEBUG ("MainWindow initialization comlete");
+	TRACE_SCOPE (ui, "MainWindow::initializationComplete");
+	LOG_DEBUG (ui, "MainWindow initialization comlete");
 
 	/*
 	 * No team was restored from settings. Either there was no team saved, or the saved team
@@ -315,7 +361,7 @@ void MainWindow::messageNotify (const BackendChannel& channel, const BackendPost
 		title = post.getDisplayAuthorName () + " posted in '" + channel.display_name + "'";
 	}
 
-	trayIcon.showMessage (title, post.message, QSystemTrayIcon::Information);
+	trayIcon.showMessage (title, post.getMessage(), QSystemTrayIcon::Information);
 	qApp->alert (nullptr, 0);
 
 	//update the count of new channels in the taskbar and tray icon
@@ -345,9 +391,14 @@ void MainWindow::setNotificationsCountVisualization (uint32_t notificationsCount
 	trayIcon.setIcon(QIcon(iconName));
 }
 
+void MainWindow::startChannelSwitchBenchmark (uint32_t switches)
+{
+	new ChannelSwitchBenchmark (backend, *ui->channelList, switches, this);
+}
+
 void MainWindow::saveState ()
 {
-	LOG_DEBUG ("MainWindow saveState");
+	LOG_DEBUG (ui, "MainWindow saveState");
 	QSettings settings;
 	settings.setValue ("geometry", saveGeometry());
 //	settings.setValue ("current_team", channelList.getCurrentTeamId());
@@ -39,11 +39,14 @@ class BackendChannel;
 class BackendPost;
 class BackendTeam;
 class SettingsWindow;
+class StallWatchdog;
+class PerformanceHud;
+class ChannelPrefetcher;
 
 class MainWindow: public QMainWindow {
 	Q_OBJECT
 public:
-	MainWindow (QWidget *parent, QSystemTrayIcon& trayIcon, Backend& backend);
+	MainWindow (QWidget *parent, QSystemTrayIcon& trayIcon, Backend& backend, StallWatchdog& watchdog);
 	~MainWindow();
 public:
 	void initializationComplete ();
@@ -75,6 +78,11 @@ public:
 	 */
 	void unreadMessagesNotify (const BackendChannel& channel);
 	void setNotificationsCountVisualization (uint32_t notificationsCount);
+
+	/**
+	 * Measure the given number of channel switches, when the channels are loaded, then quit (--switch-benchmark)
+	 */
+	void startChannelSwitchBenchmark (uint32_t switches);
 private:
 	void createMenu ();
 	void reload ();
@@ -84,9 +92,12 @@ private:
 	ChooseEmojiDialogWrapper			chooseEmojiDialog;
 	QSet<const BackendChannel*>			channelsWithNewPosts;
 	Backend&							backend;
+	StallWatchdog&						watchdog;
 	bool								currentTeamRestoredFromSettings;
 	QMenu*								mainMenu;
 	SettingsWindow*						settingsWindow;
+	ChannelPrefetcher*					channelPrefetcher;
+	PerformanceHud*						performanceHud;
 	bool								doDeinit;
 };
 
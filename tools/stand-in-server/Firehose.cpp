@@ -0,0 +1,207 @@
+/**
+ * @file Firehose.cpp
+ * @brief WebSocket event firehose of the stand-in server, for load testing of the client
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "Firehose.h"
+
+#include <iostream>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include "StandInServer.h"
+#include "SyntheticFixtures.h"
+
+namespace Mattermost {
+
+static const char* emojis[] = {"thumbsup", "smile", "tada", "heart", "eyes", "rocket"};
+static const char* statuses[] = {"online", "away", "dnd", "offline"};
+
+bool FirehoseParams::parse (const QString& spec)
+{
+	for (const QString& item: spec.split (',')) {
+
+		if (item.trimmed().isEmpty()) {
+			continue;
+		}
+
+		QStringList keyValue (item.split ('='));
+		bool ok = false;
+		int value = keyValue.size() == 2 ? keyValue[1].toInt (&ok) : 0;
+
+		if (!ok || value < 0) {
+			return false;
+		}
+
+		const QString key (keyValue[0].trimmed());
+
+		if (key == "rate") {
+			rate = value;
+		} else if (key == "ramp") {
+			ramp = value;
+		} else if (key == "channels") {
+			channels = std::max (value, 1);
+		} else if (key == "duration") {
+			duration = value;
+		} else if (key == "posted") {
+			posted = value;
+		} else if (key == "reactions") {
+			reactions = value;
+		} else if (key == "statuses") {
+			statuses = value;
+		} else {
+			return false;
+		}
+	}
+
+	return posted + reactions + statuses > 0;
+}
+
+Firehose::Firehose (StandInServer& server, SyntheticFixtures& fixtures, const FirehoseParams& params)
+:server (server)
+,fixtures (fixtures)
+,params (params)
+,lastTickMs (0)
+,credit (0)
+,sentEvents (0)
+,reportedEvents (0)
+,random (1)
+{
+	for (const QJsonObject& channel: fixtures.getChannels()) {
+		if (channels.size() == params.channels) {
+			break;
+		}
+
+		channels.push_back (channel.value("id").toString());
+	}
+
+	tickTimer.setTimerType (Qt::PreciseTimer);
+	tickTimer.setInterval (10);
+	connect (&tickTimer, &QTimer::timeout, this, &Firehose::onTick);
+
+	reportTimer.setInterval (1000);
+	connect (&reportTimer, &QTimer::timeout, this, &Firehose::report);
+}
+
+void Firehose::start ()
+{
+	if (tickTimer.isActive()) {
+		return;
+	}
+
+	std::cout << "Firehose started: " << params.rate << " events/s, +" << params.ramp << " events/s every second, "
+			<< channels.size() << " channels" << std::endl;
+
+	elapsed.start ();
+	tickTimer.start ();
+	reportTimer.start ();
+}
+
+void Firehose::onTick ()
+{
+	int64_t now = elapsed.elapsed ();
+
+	if (params.duration && now >= params.duration * 1000) {
+		tickTimer.stop ();
+		reportTimer.stop ();
+		std::cout << "Firehose finished: " << sentEvents << " events in " << params.duration << " s" << std::endl;
+		return;
+	}
+
+	//the ticks are not exact, so the number of events is based on the elapsed time
+	double rate = params.rate + params.ramp * (now / 1000);
+	credit += rate * (now - lastTickMs) / 1000.0;
+	lastTickMs = now;
+
+	int totalWeight = params.posted + params.reactions + params.statuses;
+
+	for (; credit >= 1; credit -= 1) {
+		int pick = random() % totalWeight;
+
+		if (pick < params.posted) {
+			sendPosted ();
+		} else if (pick < params.posted + params.reactions) {
+			sendReaction ();
+		} else {
+			sendStatus ();
+		}
+
+		++sentEvents;
+	}
+}
+
+void Firehose::sendPosted ()
+{
+	fixtures.addPost (randomChannel (), randomUser (), QString ("firehose message %1").arg (sentEvents));
+}
+
+void Firehose::sendReaction ()
+{
+	QString channelId (randomChannel ());
+
+	QJsonObject reaction {
+		{"user_id", randomUser ()},
+		{"post_id", fixtures.latestPostId (channelId)},
+		{"emoji_name", emojis[random() % (sizeof (emojis) / sizeof (emojis[0]))]},
+		{"create_at", QDateTime::currentMSecsSinceEpoch ()},
+	};
+
+	server.broadcastEvent (QJsonObject {
+		{"event", "reaction_added"},
+		{"data", QJsonObject {{"reaction", QString::fromUtf8 (QJsonDocument (reaction).toJson (QJsonDocument::Compact))}}},
+		{"broadcast", QJsonObject {{"omit_users", QJsonValue ()}, {"user_id", ""}, {"channel_id", channelId}, {"team_id", ""}}},
+	});
+}
+
+void Firehose::sendStatus ()
+{
+	QString userId (randomUser ());
+
+	server.broadcastEvent (QJsonObject {
+		{"event", "status_change"},
+		{"data", QJsonObject {{"status", statuses[random() % (sizeof (statuses) / sizeof (statuses[0]))]}, {"user_id", userId}}},
+		{"broadcast", QJsonObject {{"omit_users", QJsonValue ()}, {"user_id", userId}, {"channel_id", ""}, {"team_id", ""}}},
+	});
+}
+
+void Firehose::report ()
+{
+	std::cout << "Firehose: " << sentEvents - reportedEvents << " events/s to " << server.authenticatedClientsCount() << " clients" << std::endl;
+	reportedEvents = sentEvents;
+}
+
+QString Firehose::randomChannel ()
+{
+	return channels[random() % channels.size()];
+}
+
+/**
+ * Any user, except the logged-in one (if there are other users)
+ */
+QString Firehose::randomUser ()
+{
+	int users = fixtures.getUsers().size();
+	int index = users > 1 ? 1 + random() % (users - 1) : 0;
+	return fixtures.getUsers()[index].value("id").toString();
+}
+
+} /* namespace Mattermost */
@@ -0,0 +1,91 @@
+/**
+ * @file Firehose.h
+ * @brief WebSocket event firehose of the stand-in server, for load testing of the client
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <random>
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QStringList>
+
+namespace Mattermost {
+
+class StandInServer;
+class SyntheticFixtures;
+
+struct FirehoseParams {
+
+	/**
+	 * Parse "rate=500,ramp=100,channels=10,duration=60,posted=70,reactions=20,statuses=10".
+	 * Missing keys keep their defaults
+	 */
+	bool parse (const QString& spec);
+
+	int		rate = 100;			//events per second at start
+	int		ramp = 0;			//added to the rate every second
+	int		channels = 10;		//number of channels, which receive posts and reactions
+	int		duration = 0;		//seconds, 0 - until the server is stopped
+
+	//relative weights of the event types
+	int		posted = 70;
+	int		reactions = 20;
+	int		statuses = 10;
+};
+
+/**
+ * Sends a configurable mix of 'posted', 'reaction_added' and 'status_change' events to all
+ * authenticated clients. The rate starts at 'rate' and grows by 'ramp' every second, so that
+ * the rate at which the client starts to lag can be found in a single run.
+ */
+class Firehose: public QObject {
+	Q_OBJECT
+public:
+	Firehose (StandInServer& server, SyntheticFixtures& fixtures, const FirehoseParams& params);
+public:
+	void start ();
+private:
+	void onTick ();
+	void sendPosted ();
+	void sendReaction ();
+	void sendStatus ();
+	void report ();
+	QString randomChannel ();
+	QString randomUser ();
+private:
+	StandInServer&		server;
+	SyntheticFixtures&	fixtures;
+	FirehoseParams		params;
+	QStringList			channels;
+	QTimer				tickTimer;
+	QTimer				reportTimer;
+	QElapsedTimer		elapsed;
+	int64_t				lastTickMs;
+	double				credit;
+	uint64_t			sentEvents;
+	uint64_t			reportedEvents;
+	std::mt19937		random;
+};
+
+} /* namespace Mattermost */
@@ -0,0 +1,48 @@
+/**
+ * @file FixtureSource.cpp
+ * @brief Interface of the fixture sources, used by the stand-in server
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "FixtureSource.h"
+
+#include <QUrlQuery>
+
+namespace Mattermost {
+
+QString HttpRequest::path () const
+{
+	int queryStart = target.indexOf ('?');
+	return queryStart < 0 ? target : target.left (queryStart);
+}
+
+QString HttpRequest::queryItem (const QString& name) const
+{
+	int queryStart = target.indexOf ('?');
+
+	if (queryStart < 0) {
+		return QString ();
+	}
+
+	return QUrlQuery (target.mid (queryStart + 1)).queryItemValue (name, QUrl::FullyDecoded);
+}
+
+} /* namespace Mattermost */
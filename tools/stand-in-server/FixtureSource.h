@@ -0,0 +1,89 @@
+/**
+ * @file FixtureSource.h
+ * @brief Interface of the fixture sources, used by the stand-in server
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <functional>
+#include <QByteArray>
+#include <QString>
+#include <QMap>
+#include <QVector>
+#include <QJsonObject>
+
+namespace Mattermost {
+
+struct HttpRequest {
+
+	/**
+	 * Path without the query
+	 */
+	QString path () const;
+
+	/**
+	 * Value of a query item, empty if missing
+	 */
+	QString queryItem (const QString& name) const;
+
+	QByteArray						method;
+	QString							target;		//path and query, as sent by the client
+	QMap<QByteArray, QByteArray>	headers;	//lowercase names
+	QByteArray						body;
+};
+
+struct HttpResponse {
+	int									status = 200;
+	QByteArray							contentType = "application/json";
+	QVector<QPair<QByteArray, QByteArray>>	headers;
+	QByteArray							body;
+};
+
+struct WebSocketMessage {
+	int64_t		timeMs;		//time after the authentication of the client
+	QByteArray	message;
+};
+
+/**
+ * Source of HTTP responses and WebSocket events for the stand-in server
+ */
+class FixtureSource {
+public:
+	virtual ~FixtureSource () = default;
+
+	/**
+	 * Fill the response for a request. Return false if there is no fixture for it (the server sends 404)
+	 */
+	virtual bool respond (const HttpRequest& request, HttpResponse& response) = 0;
+
+	/**
+	 * Messages, sent to each WebSocket client after it is authenticated
+	 */
+	virtual QVector<WebSocketMessage> webSocketMessages () const = 0;
+
+	/**
+	 * Set by the server. Sends a WebSocket event to all authenticated clients. The server adds the sequence number
+	 */
+	std::function<void (const QJsonObject& event)>	broadcastEvent;
+};
+
+} /* namespace Mattermost */
@@ -0,0 +1,155 @@
+/**
+ * @file RecordedFixtures.cpp
+ * @brief Fixtures, recorded from a real session with 'mattermost-qt --record'
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "RecordedFixtures.h"
+
+#include <iostream>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace Mattermost {
+
+bool RecordedFixtures::load (const QString& fileName)
+{
+	QFile file (fileName);
+
+	if (!file.open (QIODevice::ReadOnly)) {
+		std::cerr << "Cannot open " << fileName.toStdString() << ": " << file.errorString().toStdString() << std::endl;
+		return false;
+	}
+
+	int64_t firstMessageTime = -1;
+	int lineNumber = 0;
+
+	while (!file.atEnd()) {
+		QByteArray line (file.readLine().trimmed());
+		++lineNumber;
+
+		if (line.isEmpty()) {
+			continue;
+		}
+
+		QJsonParseError error;
+		QJsonObject record (QJsonDocument::fromJson (line, &error).object());
+
+		if (error.error != QJsonParseError::NoError) {
+			std::cerr << fileName.toStdString() << ":" << lineNumber << ": " << error.errorString().toStdString() << std::endl;
+			return false;
+		}
+
+		QString type (record.value ("type").toString());
+		int64_t time = record.value ("time_ms").toVariant().toLongLong();
+
+		if (type == "websocket") {
+			if (firstMessageTime < 0) {
+				firstMessageTime = time;
+			}
+
+			messages.push_back (WebSocketMessage {time - firstMessageTime, record.value ("message").toString().toUtf8()});
+			continue;
+		}
+
+		if (type != "http") {
+			continue;
+		}
+
+		HttpResponse response;
+		response.status = record.value ("status").toInt();
+		response.contentType = record.value ("content_type").toString().toUtf8();
+
+		if (record.contains ("body_base64")) {
+			response.body = QByteArray::fromBase64 (record.value ("body_base64").toString().toLatin1());
+		} else {
+			response.body = record.value ("body").toString().toUtf8();
+		}
+
+		QString method (record.value ("method").toString());
+		QString target (record.value ("path").toString());
+		int queryStart = target.indexOf ('?');
+
+		exactResponses[method + ' ' + target].list.push_back (response);
+		pathResponses[method + ' ' + (queryStart < 0 ? target : target.left (queryStart))].list.push_back (response);
+		++fixturesCount;
+	}
+
+	return true;
+}
+
+bool RecordedFixtures::respond (const HttpRequest& request, HttpResponse& response)
+{
+	QString method (QString::fromLatin1 (request.method));
+
+	if (request.path() == "/api/v4/users/login") {
+
+		//the recorded token is not stored, the client gets a new one
+		response.headers.push_back ({"Token", "stand-in-token"});
+		return respondFrom ("POST /api/v4/users/login", response) || respondFrom ("GET /api/v4/users/me", response);
+	}
+
+	if (respondFrom (method + ' ' + request.target, response)) {
+		return true;
+	}
+
+	return respondFrom (method + ' ' + request.path(), response);
+}
+
+QVector<WebSocketMessage> RecordedFixtures::webSocketMessages () const
+{
+	return messages;
+}
+
+int RecordedFixtures::httpFixturesCount () const
+{
+	return fixturesCount;
+}
+
+bool RecordedFixtures::respondFrom (const QString& key, HttpResponse& response)
+{
+	auto it = exactResponses.find (key);
+
+	if (it == exactResponses.end()) {
+		it = pathResponses.find (key);
+
+		if (it == pathResponses.end()) {
+			return false;
+		}
+	}
+
+	Responses& responses = it.value ();
+	const HttpResponse& recorded = responses.list[responses.next];
+
+	//headers, set by the caller, are kept
+	response.status = recorded.status;
+	response.contentType = recorded.contentType;
+	response.body = recorded.body;
+
+	if (responses.next + 1 < responses.list.size()) {
+		++responses.next;
+	}
+
+	return true;
+}
+
+} /* namespace Mattermost */
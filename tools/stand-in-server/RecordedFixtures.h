@@ -0,0 +1,60 @@
+/**
+ * @file RecordedFixtures.h
+ * @brief Fixtures, recorded from a real session with 'mattermost-qt --record'
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <QHash>
+#include "FixtureSource.h"
+
+namespace Mattermost {
+
+/**
+ * Replays a file, written by SessionRecorder. Responses are looked up by method, path and query.
+ * If there is no exact match, the query is ignored. If the same request was recorded more than once,
+ * the responses are replayed in order and the last one is repeated. A token login is recorded as
+ * 'GET users/me', so it is used for 'POST users/login' too, if there is no recorded password login
+ */
+class RecordedFixtures: public FixtureSource {
+public:
+	bool load (const QString& fileName);
+public:
+	bool respond (const HttpRequest& request, HttpResponse& response) override;
+	QVector<WebSocketMessage> webSocketMessages () const override;
+
+	int httpFixturesCount () const;
+private:
+	struct Responses {
+		QVector<HttpResponse>	list;
+		int						next = 0;
+	};
+
+	bool respondFrom (const QString& key, HttpResponse& response);
+private:
+	QHash<QString, Responses>	exactResponses;		//key is "METHOD path?query"
+	QHash<QString, Responses>	pathResponses;		//key is "METHOD path"
+	QVector<WebSocketMessage>	messages;
+	int							fixturesCount = 0;
+};
+
+} /* namespace Mattermost */
@@ -0,0 +1,290 @@
+/**
+ * @file StandInServer.cpp
+ * @brief Local Mattermost stand-in server (REST and WebSocket), serving fixtures
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "StandInServer.h"
+
+#include <iostream>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QWebSocket>
+
+namespace Mattermost {
+
+static const char* reasonPhrase (int status)
+{
+	switch (status) {
+	case 200:
+		return "OK";
+	case 201:
+		return "Created";
+	case 400:
+		return "Bad Request";
+	case 404:
+		return "Not Found";
+	default:
+		return "Status";
+	}
+}
+
+StandInServer::StandInServer (FixtureSource& fixtures, QObject* parent)
+:QObject (parent)
+,fixtures (fixtures)
+,webSocketServer ("mattermost-stand-in", QWebSocketServer::NonSecureMode)
+,seq (1)
+,webSocketBurst (false)
+{
+	fixtures.broadcastEvent = [this] (const QJsonObject& event) {
+		broadcastEvent (event);
+	};
+
+	connect (&tcpServer, &QTcpServer::newConnection, this, &StandInServer::onNewConnection);
+	connect (&webSocketServer, &QWebSocketServer::newConnection, this, &StandInServer::onWebSocketConnection);
+}
+
+StandInServer::~StandInServer ()
+{
+	fixtures.broadcastEvent = nullptr;
+}
+
+bool StandInServer::listen (const QHostAddress& address, quint16 port)
+{
+	return tcpServer.listen (address, port);
+}
+
+quint16 StandInServer::serverPort () const
+{
+	return tcpServer.serverPort ();
+}
+
+QString StandInServer::errorString () const
+{
+	return tcpServer.errorString ();
+}
+
+void StandInServer::setWebSocketBurst (bool burst)
+{
+	webSocketBurst = burst;
+}
+
+int StandInServer::authenticatedClientsCount () const
+{
+	return authenticatedClients.size ();
+}
+
+void StandInServer::broadcastEvent (QJsonObject event)
+{
+	event.insert ("seq", seq++);
+
+	//used by the client to measure the event-to-paint latency in load tests (mattermost-qt --load-test)
+	event.insert ("stand_in_sent_at", QDateTime::currentMSecsSinceEpoch ());
+	broadcastMessage (QJsonDocument (event).toJson (QJsonDocument::Compact));
+}
+
+void StandInServer::broadcastMessage (const QByteArray& message)
+{
+	QString text (QString::fromUtf8 (message));
+
+	for (QWebSocket* client: authenticatedClients) {
+		client->sendTextMessage (text);
+	}
+}
+
+void StandInServer::onNewConnection ()
+{
+	while (QTcpSocket* socket = tcpServer.nextPendingConnection()) {
+		connect (socket, &QTcpSocket::readyRead, this, [this, socket] {
+			onReadyRead (socket);
+		});
+
+		connect (socket, &QTcpSocket::disconnected, this, [this, socket] {
+			httpBuffers.remove (socket);
+			socket->deleteLater ();
+		});
+	}
+}
+
+void StandInServer::onReadyRead (QTcpSocket* socket)
+{
+	/*
+	 * WebSocket upgrade requests are handed over to QWebSocketServer, which has to read the handshake
+	 * itself. So the first request of each connection is only peeked, until it is known that it is HTTP
+	 */
+	if (!httpBuffers.contains (socket)) {
+		QByteArray peeked (socket->peek (socket->bytesAvailable()));
+		int headerEnd = peeked.indexOf ("\r\n\r\n");
+
+		if (headerEnd < 0) {
+			return;
+		}
+
+		if (peeked.left (headerEnd).toLower().contains ("upgrade: websocket")) {
+			socket->disconnect (this);
+			webSocketServer.handleConnection (socket);
+			return;
+		}
+
+		httpBuffers.insert (socket, QByteArray ());
+	}
+
+	QByteArray& buffer = httpBuffers[socket];
+	buffer.append (socket->readAll());
+
+	//there may be more than one (pipelined) request in the buffer
+	for (;;) {
+		int headerEnd = buffer.indexOf ("\r\n\r\n");
+
+		if (headerEnd < 0) {
+			return;
+		}
+
+		QList<QByteArray> lines (buffer.left (headerEnd).split ('\n'));
+		QList<QByteArray> requestLine (lines[0].trimmed().split (' '));
+
+		if (requestLine.size() < 2) {
+			socket->write ("HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+			socket->disconnectFromHost ();
+			return;
+		}
+
+		HttpRequest request;
+		request.method = requestLine[0];
+		request.target = QString::fromUtf8 (requestLine[1]);
+
+		for (int i = 1; i < lines.size(); ++i) {
+			int colon = lines[i].indexOf (':');
+
+			if (colon > 0) {
+				request.headers.insert (lines[i].left (colon).trimmed().toLower(), lines[i].mid (colon + 1).trimmed());
+			}
+		}
+
+		int contentLength = request.headers.value ("content-length").toInt ();
+
+		if (buffer.size() < headerEnd + 4 + contentLength) {
+			return;
+		}
+
+		request.body = buffer.mid (headerEnd + 4, contentLength);
+		buffer.remove (0, headerEnd + 4 + contentLength);
+
+		processRequest (socket, request);
+	}
+}
+
+void StandInServer::processRequest (QTcpSocket* socket, const HttpRequest& request)
+{
+	HttpResponse response;
+
+	if (!fixtures.respond (request, response)) {
+		std::cerr << "No fixture for " << request.method.toStdString() << " " << request.target.toStdString() << std::endl;
+
+		response = HttpResponse ();
+		response.status = 404;
+		response.body = QJsonDocument (QJsonObject {
+			{"id", "stand_in.no_fixture"},
+			{"message", "No fixture for " + QString::fromLatin1 (request.method) + " " + request.target},
+			{"status_code", 404},
+		}).toJson (QJsonDocument::Compact);
+	}
+
+	QByteArray header;
+	header += "HTTP/1.1 " + QByteArray::number (response.status) + " " + reasonPhrase (response.status) + "\r\n";
+	header += "Content-Type: " + response.contentType + "\r\n";
+	header += "Content-Length: " + QByteArray::number (response.body.size()) + "\r\n";
+
+	for (const auto& it: response.headers) {
+		header += it.first + ": " + it.second + "\r\n";
+	}
+
+	bool close = request.headers.value ("connection").toLower() == "close";
+	header += close ? "Connection: close\r\n\r\n" : "Connection: keep-alive\r\n\r\n";
+
+	socket->write (header);
+	socket->write (response.body);
+
+	if (close) {
+		socket->disconnectFromHost ();
+	}
+}
+
+void StandInServer::onWebSocketConnection ()
+{
+	while (QWebSocket* client = webSocketServer.nextPendingConnection()) {
+		connect (client, &QWebSocket::textMessageReceived, this, [this, client] (const QString& message) {
+			onWebSocketMessage (client, message);
+		});
+
+		connect (client, &QWebSocket::disconnected, this, [this, client] {
+			authenticatedClients.removeOne (client);
+			client->deleteLater ();
+		});
+	}
+}
+
+void StandInServer::onWebSocketMessage (QWebSocket* client, const QString& message)
+{
+	QJsonObject action (QJsonDocument::fromJson (message.toUtf8()).object());
+
+	client->sendTextMessage (QJsonDocument (QJsonObject {
+		{"status", "OK"},
+		{"seq_reply", action.value ("seq")},
+	}).toJson (QJsonDocument::Compact));
+
+	if (action.value ("action").toString() != "authentication_challenge" || authenticatedClients.contains (client)) {
+		return;
+	}
+
+	authenticatedClients.push_back (client);
+
+	client->sendTextMessage (QJsonDocument (QJsonObject {
+		{"event", "hello"},
+		{"data", QJsonObject {{"server_version", "stand-in"}}},
+		{"broadcast", QJsonObject {{"omit_users", QJsonValue ()}, {"user_id", ""}, {"channel_id", ""}, {"team_id", ""}}},
+		{"seq", seq++},
+	}).toJson (QJsonDocument::Compact));
+
+	sendFixtureMessages (client);
+	emit clientAuthenticated (client);
+}
+
+void StandInServer::sendFixtureMessages (QWebSocket* client)
+{
+	for (const WebSocketMessage& message: fixtures.webSocketMessages()) {
+
+		if (webSocketBurst || message.timeMs == 0) {
+			client->sendTextMessage (QString::fromUtf8 (message.message));
+			continue;
+		}
+
+		QByteArray data (message.message);
+		//the client is the context object, so the timer is cancelled if it disconnects
+		QTimer::singleShot (message.timeMs, client, [client, data] {
+			client->sendTextMessage (QString::fromUtf8 (data));
+		});
+	}
+}
+
+} /* namespace Mattermost */
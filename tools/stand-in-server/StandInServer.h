@@ -0,0 +1,90 @@
+/**
+ * @file StandInServer.h
+ * @brief Local Mattermost stand-in server (REST and WebSocket), serving fixtures
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QTcpServer>
+#include <QWebSocketServer>
+#include "FixtureSource.h"
+
+class QTcpSocket;
+class QWebSocket;
+
+namespace Mattermost {
+
+/**
+ * Minimal HTTP/1.1 server (keep-alive, Content-Length bodies) and a WebSocket endpoint on the same port.
+ * Requests are answered by a FixtureSource. On the WebSocket, every action is acknowledged with
+ * a 'seq_reply'. After 'authentication_challenge', 'hello' and the fixture messages are sent.
+ */
+class StandInServer: public QObject {
+	Q_OBJECT
+public:
+	explicit StandInServer (FixtureSource& fixtures, QObject* parent = nullptr);
+	virtual ~StandInServer ();
+public:
+	bool listen (const QHostAddress& address, quint16 port);
+	quint16 serverPort () const;
+	QString errorString () const;
+
+	/**
+	 * If set, the fixture messages are sent to each client right after authentication,
+	 * instead of with their recorded timing
+	 */
+	void setWebSocketBurst (bool burst);
+
+	/**
+	 * Send an event to all authenticated WebSocket clients. 'seq' is added to it
+	 */
+	void broadcastEvent (QJsonObject event);
+
+	/**
+	 * Send an already serialized message to all authenticated WebSocket clients
+	 */
+	void broadcastMessage (const QByteArray& message);
+
+	int authenticatedClientsCount () const;
+signals:
+	void clientAuthenticated (QWebSocket* client);
+private:
+	void onNewConnection ();
+	void onReadyRead (QTcpSocket* socket);
+	void processRequest (QTcpSocket* socket, const HttpRequest& request);
+	void onWebSocketConnection ();
+	void onWebSocketMessage (QWebSocket* client, const QString& message);
+	void sendFixtureMessages (QWebSocket* client);
+private:
+	FixtureSource&					fixtures;
+	QTcpServer						tcpServer;
+	QWebSocketServer				webSocketServer;
+	QHash<QTcpSocket*, QByteArray>	httpBuffers;
+	QList<QWebSocket*>				authenticatedClients;
+	int64_t							seq;
+	bool							webSocketBurst;
+};
+
+} /* namespace Mattermost */
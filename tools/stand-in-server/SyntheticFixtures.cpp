@@ -0,0 +1,832 @@
+/**
+ * @file SyntheticFixtures.cpp
+ * @brief Generated teams, channels, users and posts for the stand-in server
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include "SyntheticFixtures.h"
+
+#include <algorithm>
+#include <random>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QStringList>
+
+namespace Mattermost {
+
+//creation time of the generated data. Fixed, so that the fixtures do not depend on the current time
+static constexpr int64_t baseTime = 1760000000000;
+static constexpr int64_t postInterval = 60000;
+static constexpr int postsPerChannelIdRange = 1000000;
+
+//1x1 transparent PNG, used for all avatars
+static const char* avatarPng = "iVBORw0KGgoAAAANSUhEUgAAAAEAAAABCAQAAAC1HAwCAAAAC0lEQVR42mNkYAAAAAYAAjCB0C8AAAAASUVORK5CYII=";
+
+static const char* words[] = {
+	"the", "build", "server", "release", "review", "branch", "meeting", "deploy", "cache", "channel",
+	"tomorrow", "fixed", "crash", "please", "check", "latency", "thanks", "merged", "test", "logs",
+	"client", "update", "issue", "config", "version", "looks", "good", "why", "memory", "team",
+};
+
+bool SyntheticParams::parse (const QString& spec)
+{
+	for (const QString& item: spec.split (',')) {
+
+		if (item.trimmed().isEmpty()) {
+			continue;
+		}
+
+		QStringList keyValue (item.split ('='));
+		bool ok = false;
+		int value = keyValue.size() == 2 ? keyValue[1].toInt (&ok) : 0;
+
+		if (!ok || value < 0) {
+			return false;
+		}
+
+		const QString key (keyValue[0].trimmed());
+
+		if (key == "teams") {
+			teams = std::max (value, 1);
+		} else if (key == "channels") {
+			channelsPerTeam = std::max (value, 1);
+		} else if (key == "direct") {
+			directChannels = value;
+		} else if (key == "users") {
+			users = std::max (value, 1);
+		} else if (key == "posts") {
+			postsPerChannel = std::min (value, postsPerChannelIdRange - 1);
+		} else {
+			return false;
+		}
+	}
+
+	directChannels = std::min (directChannels, users - 1);
+	return true;
+}
+
+static QByteArray toJson (const QJsonValue& value)
+{
+	if (value.isArray()) {
+		return QJsonDocument (value.toArray()).toJson (QJsonDocument::Compact);
+	}
+
+	return QJsonDocument (value.toObject()).toJson (QJsonDocument::Compact);
+}
+
+static QJsonObject statusOk ()
+{
+	return QJsonObject {{"status", "OK"}};
+}
+
+//the page size of a list request, 60 if not given (as by the server)
+static int perPageOf (const HttpRequest& request)
+{
+	return request.queryItem ("per_page").isEmpty() ? 60 : std::max (request.queryItem ("per_page").toInt(), 1);
+}
+
+SyntheticFixtures::SyntheticFixtures (const SyntheticParams& params)
+:params (params)
+,nextPostIndex (0)
+{
+	generate ();
+}
+
+QString SyntheticFixtures::makeId (char prefix, int index)
+{
+	static const char alphabet[] = "ybndrfg8ejkmcpqxot1uwisza345h769";
+
+	//'y' is zero. The last character holds only 3 bits, it is always zero
+	QString id (26, 'y');
+	id[0] = prefix;
+
+	for (int i = 24; index && i > 0; --i, index /= 32) {
+		id[i] = alphabet[index % 32];
+	}
+
+	return id;
+}
+
+const SyntheticParams& SyntheticFixtures::getParams () const
+{
+	return params;
+}
+
+const std::vector<QJsonObject>& SyntheticFixtures::getTeams () const
+{
+	return teams;
+}
+
+const std::vector<QJsonObject>& SyntheticFixtures::getChannels () const
+{
+	return channels;
+}
+
+const std::vector<QJsonObject>& SyntheticFixtures::getUsers () const
+{
+	return users;
+}
+
+const QJsonObject* SyntheticFixtures::findChannel (const QString& channelId) const
+{
+	auto it = channelIndexes.find (channelId);
+	return it == channelIndexes.end() ? nullptr : &channels[it.value()];
+}
+
+void SyntheticFixtures::generate ()
+{
+	for (int i = 0; i < params.users; ++i) {
+		QString id (makeId ('u', i));
+		userIndexes[id] = i;
+		users.push_back (QJsonObject {
+			{"id", id},
+			{"create_at", baseTime},
+			{"update_at", baseTime},
+			{"delete_at", 0},
+			{"username", QString ("user%1").arg (i)},
+			{"first_name", QString ("First%1").arg (i)},
+			{"last_name", QString ("Last%1").arg (i)},
+			{"nickname", ""},
+			{"email", QString ("user%1@stand-in.local").arg (i)},
+			{"position", ""},
+			{"roles", i == 0 ? "system_admin system_user" : "system_user"},
+			{"locale", "en"},
+			{"notify_props", QJsonObject {{"desktop", "mention"}, {"push", "mention"}}},
+			{"timezone", QJsonObject {{"automaticTimezone", ""}, {"manualTimezone", ""}, {"useAutomaticTimezone", "true"}}},
+		});
+	}
+
+	int64_t lastPostAt = baseTime + (int64_t)params.postsPerChannel * postInterval;
+
+	auto addChannel = [this, lastPostAt] (const QString& id, const QString& teamId, const QString& type, const QString& name, const QString& displayName) {
+		channelIndexes[id] = channels.size();
+		channels.push_back (QJsonObject {
+			{"id", id},
+			{"create_at", baseTime},
+			{"update_at", baseTime},
+			{"delete_at", 0},
+			{"team_id", teamId},
+			{"type", type},
+			{"name", name},
+			{"display_name", displayName},
+			{"header", ""},
+			{"purpose", ""},
+			{"last_post_at", lastPostAt},
+			{"total_msg_count", params.postsPerChannel},
+			{"extra_update_at", 0},
+			{"creator_id", users[0].value("id")},
+		});
+	};
+
+	int channelIndex = 0;
+
+	for (int team = 0; team < params.teams; ++team) {
+		QString teamId (makeId ('t', team));
+		teams.push_back (QJsonObject {
+			{"id", teamId},
+			{"create_at", baseTime},
+			{"update_at", baseTime},
+			{"delete_at", 0},
+			{"display_name", QString ("Team %1").arg (team)},
+			{"name", QString ("team-%1").arg (team)},
+			{"description", ""},
+			{"email", ""},
+			{"type", "O"},
+			{"company_name", ""},
+			{"allowed_domains", ""},
+			{"invite_id", ""},
+			{"allow_open_invite", true},
+		});
+
+		for (int i = 0; i < params.channelsPerTeam; ++i) {
+			QString name (i == 0 ? QString ("town-square") : QString ("channel-%1").arg (i));
+			QString displayName (i == 0 ? QString ("Town Square") : QString ("Channel %1").arg (i));
+			addChannel (makeId ('c', channelIndex++), teamId, i % 4 == 3 ? "P" : "O", name, displayName);
+		}
+	}
+
+	//direct channel names consist of the ids of both users, sorted
+	for (int i = 1; i <= params.directChannels; ++i) {
+		QString userId (users[i].value("id").toString());
+		addChannel (makeId ('d', i), "", "D", users[0].value("id").toString() + "__" + userId, "");
+	}
+}
+
+std::vector<QJsonObject>& SyntheticFixtures::channelPosts (const QString& channelId)
+{
+	auto it = posts.find (channelId);
+
+	if (it != posts.end()) {
+		return it.value();
+	}
+
+	std::vector<QJsonObject>& list = posts[channelId];
+	int channelIndex = channelIndexes.value (channelId);
+	const QJsonObject& channel = channels[channelIndex];
+	bool isDirect = channel.value("type").toString() == "D";
+	std::mt19937 random (channelIndex);
+
+	list.reserve (params.postsPerChannel);
+
+	for (int i = 0; i < params.postsPerChannel; ++i) {
+		int wordsCount = 3 + random() % 40;
+		QStringList message;
+
+		for (int word = 0; word < wordsCount; ++word) {
+			message << words[random() % (sizeof (words) / sizeof (words[0]))];
+		}
+
+		QString messageText (message.join (' '));
+
+		if (i % 10 == 9) {
+			messageText.replace (messageText.indexOf (' '), 1, '\n');
+		}
+
+		int author = isDirect ? (i % 2 ? 0 : userIndexes.value (channel.value("name").toString().section ("__", 1))) : (i * 7 + channelIndex) % params.users;
+		int64_t createAt = baseTime + (int64_t)(i + 1) * postInterval;
+		QString postId (makeId ('p', channelIndex * postsPerChannelIdRange + i));
+
+		//some posts have props and reactions, as on a real server
+		QJsonObject props;
+		if (i % 10 == 4) {
+			props.insert ("disable_group_highlight", true);
+		}
+
+		QJsonObject metadata;
+		if (i % 6 == 5) {
+			metadata.insert ("reactions", QJsonArray {QJsonObject {
+				{"user_id", users[(author + 1) % params.users].value("id")},
+				{"post_id", postId},
+				{"emoji_name", "smile"},
+				{"create_at", createAt},
+			}});
+		}
+
+		list.push_back (QJsonObject {
+			{"id", postId},
+			{"create_at", createAt},
+			{"update_at", createAt},
+			{"edit_at", 0},
+			{"delete_at", 0},
+			{"is_pinned", false},
+			{"user_id", users[author].value("id")},
+			{"channel_id", channelId},
+			//replies to a post 20 posts earlier, which is often on an older page of posts
+			{"root_id", i % 25 == 24 ? list[i - 20].value("id").toString() : QString ()},
+			{"original_id", ""},
+			{"message", messageText},
+			{"type", ""},
+			{"props", props},
+			{"hashtags", ""},
+			{"pending_post_id", ""},
+			{"metadata", metadata},
+		});
+	}
+
+	return list;
+}
+
+QJsonObject SyntheticFixtures::postsList (const std::vector<QJsonObject>& list, int first, int last) const
+{
+	QJsonArray order;
+	QJsonObject postsObject;
+
+	//newest first
+	for (int i = last - 1; i >= first; --i) {
+		QString id (list[i].value("id").toString());
+		order.push_back (id);
+		postsObject.insert (id, list[i]);
+	}
+
+	return QJsonObject {
+		{"order", order},
+		{"posts", postsObject},
+		{"next_post_id", ""},
+		{"prev_post_id", first > 0 ? list[first - 1].value("id").toString() : QString ()},
+	};
+}
+
+const QJsonObject* SyntheticFixtures::findPost (const QString& postId) const
+{
+	for (const std::vector<QJsonObject>& list: posts) {
+		for (const QJsonObject& post: list) {
+			if (post.value("id").toString() == postId) {
+				return &post;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+QString SyntheticFixtures::latestPostId (const QString& channelId)
+{
+	const std::vector<QJsonObject>& list = channelPosts (channelId);
+	return list.empty() ? QString () : list.back().value("id").toString();
+}
+
+QJsonObject SyntheticFixtures::addPost (const QString& channelId, const QString& userId, const QString& message)
+{
+	std::vector<QJsonObject>& list = channelPosts (channelId);
+	int64_t now = QDateTime::currentMSecsSinceEpoch ();
+
+	QJsonObject post {
+		{"id", makeId ('n', nextPostIndex++)},
+		{"create_at", now},
+		{"update_at", now},
+		{"edit_at", 0},
+		{"delete_at", 0},
+		{"is_pinned", false},
+		{"user_id", userId},
+		{"channel_id", channelId},
+		{"root_id", ""},
+		{"original_id", ""},
+		{"message", message},
+		{"type", ""},
+		{"props", QJsonObject ()},
+		{"hashtags", ""},
+		{"pending_post_id", ""},
+		{"metadata", QJsonObject ()},
+	};
+
+	list.push_back (post);
+
+	const QJsonObject* channel = findChannel (channelId);
+	const QJsonObject& user = users[userIndexes.value (userId)];
+
+	if (broadcastEvent) {
+		broadcastEvent (QJsonObject {
+			{"event", "posted"},
+			{"data", QJsonObject {
+				{"channel_display_name", channel->value("display_name")},
+				{"channel_name", channel->value("name")},
+				{"channel_type", channel->value("type")},
+				{"post", QString::fromUtf8 (toJson (post))},
+				{"sender_name", "@" + user.value("username").toString()},
+				{"team_id", channel->value("team_id")},
+				{"set_online", true},
+			}},
+			{"broadcast", QJsonObject {
+				{"omit_users", QJsonValue ()},
+				{"user_id", ""},
+				{"channel_id", channelId},
+				{"team_id", ""},
+			}},
+		});
+	}
+
+	return post;
+}
+
+bool SyntheticFixtures::respond (const HttpRequest& request, HttpResponse& response)
+{
+	static const QString apiRoot ("/api/v4/");
+	QString path (request.path ());
+
+	if (!path.startsWith (apiRoot)) {
+		return false;
+	}
+
+	QStringList segments (path.mid (apiRoot.size()).split ('/'));
+
+	if (segments[0] == "users") {
+		return respondUsers (request, segments, response);
+	}
+
+	if (segments[0] == "teams") {
+		return respondTeams (request, segments, response);
+	}
+
+	if (segments[0] == "channels") {
+		return respondChannels (request, segments, response);
+	}
+
+	if (segments[0] == "posts" || segments[0] == "reactions") {
+		return respondPosts (request, segments, response);
+	}
+
+	if (segments[0] == "emoji" && segments.size() == 1) {
+		response.body = "[]";
+		return true;
+	}
+
+	return false;
+}
+
+bool SyntheticFixtures::respondUsers (const HttpRequest& request, const QStringList& path, HttpResponse& response)
+{
+	const QJsonObject& loginUser = users[0];
+
+	if (path.size() == 1) {
+		int perPage = perPageOf (request);
+		int page = request.queryItem ("page").toInt ();
+		QJsonArray array;
+
+		for (int i = page * perPage; i < std::min ((page + 1) * perPage, params.users); ++i) {
+			array.push_back (users[i]);
+		}
+
+		response.body = toJson (array);
+		return true;
+	}
+
+	if (path[1] == "login" && request.method == "POST") {
+		response.headers.push_back ({"Token", "stand-in-token"});
+		response.body = toJson (loginUser);
+		return true;
+	}
+
+	if (path[1] == "logout") {
+		response.body = toJson (statusOk ());
+		return true;
+	}
+
+	if (path[1] == "stats") {
+		response.body = toJson (QJsonObject {{"total_users_count", params.users}});
+		return true;
+	}
+
+	if (path.size() == 3 && path[1] == "status" && path[2] == "ids") {
+		QJsonArray statuses;
+
+		for (const QJsonValue& id: QJsonDocument::fromJson (request.body).array()) {
+			statuses.push_back (QJsonObject {
+				{"user_id", id},
+				{"status", userIndexes.value (id.toString()) % 3 ? "offline" : "online"},
+				{"last_activity_at", baseTime},
+			});
+		}
+
+		response.body = toJson (statuses);
+		return true;
+	}
+
+	if (path.size() == 3 && path[1] == "me" && path[2] == "teams") {
+		QJsonArray array;
+
+		for (const QJsonObject& team: teams) {
+			array.push_back (team);
+		}
+
+		response.body = toJson (array);
+		return true;
+	}
+
+	//users/me/teams/{team_id}/channels - the team channels and all direct channels
+	if (path.size() == 5 && path[1] == "me" && path[2] == "teams" && path[4] == "channels") {
+		QJsonArray array;
+
+		for (const QJsonObject& channel: channels) {
+			QString teamId (channel.value("team_id").toString());
+
+			if (teamId == path[3] || teamId.isEmpty()) {
+				array.push_back (channel);
+			}
+		}
+
+		response.body = toJson (array);
+		return true;
+	}
+
+	//users/me/channels/{channel_id}/posts/unread - everything is read
+	if (path.size() == 6 && path[1] == "me" && path[2] == "channels" && path[5] == "unread") {
+
+		if (!findChannel (path[3])) {
+			return false;
+		}
+
+		const std::vector<QJsonObject>& list = channelPosts (path[3]);
+		response.body = toJson (postsList (list, list.size(), list.size()));
+		return true;
+	}
+
+	QString userId (path[1] == "me" ? loginUser.value("id").toString() : path[1]);
+	auto it = userIndexes.find (userId);
+
+	if (it == userIndexes.end()) {
+		return false;
+	}
+
+	if (path.size() == 2) {
+		response.body = toJson (users[it.value()]);
+		return true;
+	}
+
+	if (path[2] == "image") {
+		response.contentType = "image/png";
+		response.body = QByteArray::fromBase64 (avatarPng);
+		return true;
+	}
+
+	if (path[2] == "preferences") {
+		response.body = request.method == "GET" ? QByteArray ("[]") : toJson (statusOk ());
+		return true;
+	}
+
+	return false;
+}
+
+bool SyntheticFixtures::respondTeams (const HttpRequest& request, const QStringList& path, HttpResponse& response)
+{
+	if (path.size() < 2) {
+		return false;
+	}
+
+	auto team = std::find_if (teams.begin(), teams.end(), [&path] (const QJsonObject& team) {
+		return team.value("id").toString() == path[1];
+	});
+
+	if (team == teams.end()) {
+		return false;
+	}
+
+	if (path.size() == 2) {
+		response.body = toJson (*team);
+		return true;
+	}
+
+	if (path[2] == "stats") {
+		response.body = toJson (QJsonObject {
+			{"team_id", path[1]},
+			{"total_member_count", params.users},
+			{"active_member_count", params.users},
+		});
+		return true;
+	}
+
+	//the public channels, paged, or the ones with a name containing the search term
+	if (path[2] == "channels") {
+		bool isSearch = path.size() == 4 && path[3] == "search";
+		QString term (QJsonDocument::fromJson (request.body).object().value("term").toString());
+		int perPage = perPageOf (request);
+		int first = isSearch ? 0 : request.queryItem ("page").toInt() * perPage;
+		int index = 0;
+		QJsonArray array;
+
+		for (const QJsonObject& channel: channels) {
+			if (channel.value("team_id").toString() != path[1] || channel.value("type").toString() != "O") {
+				continue;
+			}
+
+			if (isSearch && !channel.value("name").toString().contains (term, Qt::CaseInsensitive)
+					&& !channel.value("display_name").toString().contains (term, Qt::CaseInsensitive)) {
+				continue;
+			}
+
+			if (index++ >= first) {
+				array.push_back (channel);
+			}
+
+			if (array.size() == perPage) {
+				break;
+			}
+		}
+
+		response.body = toJson (array);
+		return true;
+	}
+
+	//every user is a member of every team
+	if (path[2] == "members") {
+		int perPage = perPageOf (request);
+		int page = request.queryItem ("page").toInt ();
+		QJsonArray array;
+
+		for (int i = page * perPage; i < std::min ((page + 1) * perPage, params.users); ++i) {
+			array.push_back (QJsonObject {
+				{"team_id", path[1]},
+				{"user_id", users[i].value("id")},
+				{"roles", i == 0 ? "team_admin team_user" : "team_user"},
+				{"delete_at", 0},
+				{"scheme_user", true},
+				{"scheme_admin", i == 0},
+			});
+		}
+
+		response.body = toJson (array);
+		return true;
+	}
+
+	return false;
+}
+
+bool SyntheticFixtures::respondChannels (const HttpRequest& request, const QStringList& path, HttpResponse& response)
+{
+	if (path.size() == 4 && path[1] == "members" && path[2] == "me" && path[3] == "view") {
+		response.body = toJson (statusOk ());
+		return true;
+	}
+
+	if (path.size() < 2) {
+		return false;
+	}
+
+	const QJsonObject* channel = findChannel (path[1]);
+
+	if (!channel) {
+		return false;
+	}
+
+	if (path.size() == 2) {
+		response.body = toJson (*channel);
+		return true;
+	}
+
+	//every user is a member of every channel, except for the direct ones
+	bool isDirect = channel->value("type").toString() == "D";
+	auto isMember = [this, channel, isDirect] (int userIndex) {
+		return !isDirect || channel->value("name").toString().contains (users[userIndex].value("id").toString());
+	};
+
+	if (path[2] == "stats") {
+		int memberCount = 0;
+
+		for (int i = 0; i < params.users; ++i) {
+			memberCount += isMember (i);
+		}
+
+		response.body = toJson (QJsonObject {
+			{"channel_id", path[1]},
+			{"member_count", memberCount},
+			{"guest_count", 0},
+			{"pinnedpost_count", 0},
+		});
+		return true;
+	}
+
+	if (path[2] == "members") {
+		int perPage = perPageOf (request);
+		int page = request.queryItem ("page").toInt ();
+		int skip = page * perPage;
+		QJsonArray array;
+
+		for (int i = 0; i < params.users && array.size() < perPage; ++i) {
+			QString userId (users[i].value("id").toString());
+
+			if (!isMember (i) || skip-- > 0) {
+				continue;
+			}
+
+			array.push_back (QJsonObject {
+				{"channel_id", path[1]},
+				{"user_id", userId},
+				{"roles", "channel_user"},
+				{"last_viewed_at", baseTime},
+				{"msg_count", params.postsPerChannel},
+				{"mention_count", 0},
+				{"notify_props", QJsonObject ()},
+				{"last_update_at", baseTime},
+			});
+		}
+
+		response.body = toJson (array);
+		return true;
+	}
+
+	if (path[2] == "posts") {
+		const std::vector<QJsonObject>& list = channelPosts (path[1]);
+		int perPage = perPageOf (request);
+		int page = request.queryItem ("page").toInt ();
+		int end = list.size ();
+		QString before (request.queryItem ("before"));
+		QString after (request.queryItem ("after"));
+
+		auto findPosition = [&list] (const QString& postId) {
+			return std::find_if (list.begin(), list.end(), [&postId] (const QJsonObject& post) {
+				return post.value("id").toString() == postId;
+			}) - list.begin();
+		};
+
+		//the pages after a post are counted from it, towards the newest post
+		if (!after.isEmpty()) {
+			int first = std::min<int> (findPosition (after) + 1 + page * perPage, list.size());
+			int last = std::min<int> (first + perPage, list.size());
+			response.body = toJson (postsList (list, first, last));
+			return true;
+		}
+
+		if (!before.isEmpty()) {
+			end = findPosition (before);
+		}
+
+		int last = std::max (end - page * perPage, 0);
+		int first = std::max (last - perPage, 0);
+		response.body = toJson (postsList (list, first, last));
+		return true;
+	}
+
+	return false;
+}
+
+bool SyntheticFixtures::respondPosts (const HttpRequest& request, const QStringList& path, HttpResponse& response)
+{
+	QJsonObject body (QJsonDocument::fromJson (request.body).object());
+
+	if (path[0] == "reactions") {
+		response.body = request.body;
+		return true;
+	}
+
+	if (path.size() == 1 && request.method == "POST") {
+		QString channelId (body.value("channel_id").toString());
+
+		if (!findChannel (channelId)) {
+			return false;
+		}
+
+		response.status = 201;
+		response.body = toJson (addPost (channelId, users[0].value("id").toString(), body.value("message").toString()));
+		return true;
+	}
+
+	if (path.size() == 2 && path[1] == "ids" && request.method == "POST") {
+		QJsonArray list;
+
+		for (const auto& id: QJsonDocument::fromJson (request.body).array()) {
+			const QJsonObject* post = findPost (id.toString());
+
+			if (post) {
+				list.push_back (*post);
+			}
+		}
+
+		response.body = toJson (list);
+		return true;
+	}
+
+	if (path.size() == 3 && path[2] == "thread") {
+		const QJsonObject* post = findPost (path[1]);
+
+		if (!post) {
+			return false;
+		}
+
+		QString rootId (post->value("root_id").toString().isEmpty() ? path[1] : post->value("root_id").toString());
+		QJsonArray order;
+		QJsonObject postsObject;
+
+		//newest first
+		const std::vector<QJsonObject>& list = channelPosts (post->value("channel_id").toString());
+
+		for (auto it = list.rbegin(); it != list.rend(); ++it) {
+			QString id (it->value("id").toString());
+
+			if (id == rootId || it->value("root_id").toString() == rootId) {
+				order.push_back (id);
+				postsObject.insert (id, *it);
+			}
+		}
+
+		response.body = toJson (QJsonObject {{"order", order}, {"posts", postsObject}});
+		return true;
+	}
+
+	if (path.size() == 2 && request.method == "GET") {
+		const QJsonObject* post = findPost (path[1]);
+
+		if (!post) {
+			return false;
+		}
+
+		response.body = toJson (*post);
+		return true;
+	}
+
+	//editing and deleting are accepted, but not applied to the generated posts
+	if (path.size() == 3 && path[2] == "patch") {
+		response.body = request.body;
+		return true;
+	}
+
+	if (path.size() == 2 && request.method == "DELETE") {
+		response.body = toJson (statusOk ());
+		return true;
+	}
+
+	return false;
+}
+
+QVector<WebSocketMessage> SyntheticFixtures::webSocketMessages () const
+{
+	return QVector<WebSocketMessage> ();
+}
+
+} /* namespace Mattermost */
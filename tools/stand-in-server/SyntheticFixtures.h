@@ -0,0 +1,107 @@
+/**
+ * @file SyntheticFixtures.h
+ * @brief Generated teams, channels, users and posts for the stand-in server
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#pragma once
+
+#include <vector>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QHash>
+#include "FixtureSource.h"
+
+namespace Mattermost {
+
+struct SyntheticParams {
+
+	/**
+	 * Parse "teams=2,channels=20,users=100,posts=500,direct=10". Missing keys keep their defaults
+	 */
+	bool parse (const QString& spec);
+
+	int		teams = 1;
+	int		channelsPerTeam = 10;	//public and private
+	int		directChannels = 5;
+	int		users = 50;
+	int		postsPerChannel = 200;
+};
+
+/**
+ * Deterministic data set - the same parameters always give the same ids, names and messages,
+ * so that the results of benchmarks can be compared. The first user is the logged-in user.
+ * New posts (POST posts) are stored and broadcast as 'posted' events
+ */
+class SyntheticFixtures: public FixtureSource {
+public:
+	explicit SyntheticFixtures (const SyntheticParams& params);
+public:
+	bool respond (const HttpRequest& request, HttpResponse& response) override;
+	QVector<WebSocketMessage> webSocketMessages () const override;
+
+	/**
+	 * Id in the Mattermost format (26 base32 characters, as generated by the server), so that the client
+	 * stores it in the compact form. The prefix separates the object kinds and must be a base32 character
+	 */
+	static QString makeId (char prefix, int index);
+
+	const SyntheticParams& getParams () const;
+	const QJsonObject* findChannel (const QString& channelId) const;
+	const std::vector<QJsonObject>& getTeams () const;
+	const std::vector<QJsonObject>& getChannels () const;
+	const std::vector<QJsonObject>& getUsers () const;
+
+	/**
+	 * Id of the newest post in a channel, empty if the channel has no posts
+	 */
+	QString latestPostId (const QString& channelId);
+
+	/**
+	 * Create a post in a channel and broadcast it. Returns the post
+	 */
+	QJsonObject addPost (const QString& channelId, const QString& userId, const QString& message);
+private:
+	void generate ();
+	std::vector<QJsonObject>& channelPosts (const QString& channelId);
+	QJsonObject postsList (const std::vector<QJsonObject>& posts, int first, int last) const;
+
+	//searches the posts, which are already generated
+	const QJsonObject* findPost (const QString& postId) const;
+
+	bool respondUsers (const HttpRequest& request, const QStringList& path, HttpResponse& response);
+	bool respondTeams (const HttpRequest& request, const QStringList& path, HttpResponse& response);
+	bool respondChannels (const HttpRequest& request, const QStringList& path, HttpResponse& response);
+	bool respondPosts (const HttpRequest& request, const QStringList& path, HttpResponse& response);
+private:
+	SyntheticParams								params;
+	std::vector<QJsonObject>					users;
+	std::vector<QJsonObject>					teams;
+	std::vector<QJsonObject>					channels;
+	QHash<QString, int>							channelIndexes;
+	QHash<QString, int>							userIndexes;
+
+	//generated on first access, oldest first
+	QHash<QString, std::vector<QJsonObject>>	posts;
+	int											nextPostIndex;
+};
+
+} /* namespace Mattermost */
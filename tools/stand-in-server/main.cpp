@@ -0,0 +1,116 @@
+/**
+ * @file main.cpp
+ * @brief Local Mattermost stand-in server for offline and deterministic performance testing
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include <iostream>
+#include <memory>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include "StandInServer.h"
+#include "RecordedFixtures.h"
+#include "SyntheticFixtures.h"
+#include "Firehose.h"
+
+using namespace Mattermost;
+
+/**
+ * Serves either a session, recorded with 'mattermost-qt --record <file>', or a generated data set.
+ * Log in from the client with the domain http://127.0.0.1:<port> and any user name and password
+ */
+int main (int argc, char** argv)
+{
+	QCoreApplication app (argc, argv);
+
+	QCommandLineParser parser;
+	QCommandLineOption portOption ({"p", "port"}, "Listen on <port> (default 8065)", "port", "8065");
+	QCommandLineOption addressOption ("address", "Listen on <address> (default 127.0.0.1)", "address", "127.0.0.1");
+	QCommandLineOption replayOption ("replay", "Replay a session recorded to <file>", "file");
+	QCommandLineOption syntheticOption ("synthetic", "Generated data set, for example 'teams=2,channels=20,users=100,posts=500,direct=10'", "spec", "");
+	QCommandLineOption burstOption ("ws-burst", "Send the recorded WebSocket events right after authentication, without the recorded delays");
+	QCommandLineOption firehoseOption ("firehose", "With --synthetic: send a stream of events after the first client logs in, "
+			"for example 'rate=500,ramp=100,channels=10,duration=60,posted=70,reactions=20,statuses=10'", "spec");
+	parser.setApplicationDescription ("Mattermost stand-in server");
+	parser.addHelpOption ();
+	parser.addOptions ({portOption, addressOption, replayOption, syntheticOption, burstOption, firehoseOption});
+	parser.process (app);
+
+	std::unique_ptr<FixtureSource> fixtures;
+	SyntheticFixtures* synthetic = nullptr;
+	FirehoseParams firehoseParams;
+
+	if (parser.isSet (firehoseOption)) {
+		if (parser.isSet (replayOption)) {
+			std::cerr << "--firehose can be used only with synthetic data sets" << std::endl;
+			return 1;
+		}
+
+		if (!firehoseParams.parse (parser.value (firehoseOption))) {
+			std::cerr << "Invalid --firehose value: " << parser.value (firehoseOption).toStdString() << std::endl;
+			return 1;
+		}
+	}
+
+	if (parser.isSet (replayOption)) {
+		auto recorded = std::make_unique<RecordedFixtures> ();
+
+		if (!recorded->load (parser.value (replayOption))) {
+			return 1;
+		}
+
+		std::cout << "Replaying " << recorded->httpFixturesCount() << " HTTP responses and "
+				<< recorded->webSocketMessages().size() << " WebSocket messages" << std::endl;
+		fixtures = std::move (recorded);
+	} else {
+		SyntheticParams params;
+
+		if (!params.parse (parser.value (syntheticOption))) {
+			std::cerr << "Invalid --synthetic value: " << parser.value (syntheticOption).toStdString() << std::endl;
+			return 1;
+		}
+
+		std::cout << "Synthetic data set: " << params.teams << " teams, " << params.channelsPerTeam << " channels per team, "
+				<< params.directChannels << " direct channels, " << params.users << " users, "
+				<< params.postsPerChannel << " posts per channel" << std::endl;
+		auto generated = std::make_unique<SyntheticFixtures> (params);
+		synthetic = generated.get ();
+		fixtures = std::move (generated);
+	}
+
+	StandInServer server (*fixtures);
+	server.setWebSocketBurst (parser.isSet (burstOption));
+
+	if (!server.listen (QHostAddress (parser.value (addressOption)), parser.value (portOption).toUShort())) {
+		std::cerr << "Cannot listen: " << server.errorString().toStdString() << std::endl;
+		return 1;
+	}
+
+	std::unique_ptr<Firehose> firehose;
+
+	if (parser.isSet (firehoseOption)) {
+		firehose = std::make_unique<Firehose> (server, *synthetic, firehoseParams);
+		QObject::connect (&server, &StandInServer::clientAuthenticated, firehose.get(), &Firehose::start);
+	}
+
+	std::cout << "Listening on http://" << parser.value (addressOption).toStdString() << ":" << server.serverPort() << std::endl;
+	return app.exec ();
+}
@@ -0,0 +1,103 @@
+/**
+ * @file websocketDeflateCheck.cpp
+ * @brief Check permessage-deflate support of DeflateWebSocket against a WebSocket echo server
+ * @author Lyubomir Filipov
+ * @date Oct 19, 2026
+ *
+ * Copyright 2021, 2022 Lyubomir Filipov
+ *
+ * This file is part of Mattermost-QT.
+ *
+ * Mattermost-QT is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Mattermost-QT is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Mattermost-QT. if not, see https://www.gnu.org/licenses/.
+ */
+
+#include <iostream>
+#include <QCoreApplication>
+#include <QTimer>
+#include "backend/DeflateWebSocket.h"
+
+using namespace Mattermost;
+
+/**
+ * Sends a number of Mattermost-like event messages to an echo server (for example
+ * 'websocat -s 9001 --deflate' or the autobahn echo server) and checks that every message
+ * comes back unchanged. Prints the compression statistics of the session on exit.
+ */
+int main (int argc, char** argv)
+{
+	QCoreApplication app (argc, argv);
+
+	if (argc < 2) {
+		std::cout << "Usage: " << argv[0] << " <ws://host:port> [message count] - sends messages to a WebSocket echo server and checks the replies" << std::endl;
+		return 1;
+	}
+
+	QUrl url (argv[1]);
+	int messageCount = argc > 2 ? atoi (argv[2]) : 100;
+
+	QStringList messages;
+	for (int i = 0; i < messageCount; ++i) {
+		messages << QString (R"({"event":"posted","data":{"channel_display_name":"Town Square","channel_name":"town-square",)"
+				R"("channel_type":"O","post":"{\"id\":\"%1\",\"message\":\"message number %1\"}","sender_name":"@user"},"seq":%1})").arg (i);
+	}
+
+	DeflateWebSocket webSocket;
+	int received = 0;
+	int mismatched = 0;
+	int exitCode = 1;
+
+	QObject::connect (&webSocket, &DeflateWebSocket::connected, [&] {
+		std::cout << "Connected, compression " << (webSocket.isCompressionActive() ? "active" : "not negotiated") << std::endl;
+		for (const QString& message: messages) {
+			webSocket.sendTextMessage (message);
+		}
+	});
+
+	QObject::connect (&webSocket, &DeflateWebSocket::textMessageReceived, [&] (const QString& message) {
+		if (message != messages.value (received)) {
+			++mismatched;
+		}
+
+		if (++received == messages.size()) {
+			exitCode = mismatched ? 1 : 0;
+			webSocket.close ();
+		}
+	});
+
+	QObject::connect (&webSocket, &DeflateWebSocket::disconnected, [&] {
+		app.exit (exitCode);
+	});
+
+	QObject::connect (&webSocket, qOverload<QAbstractSocket::SocketError>(&DeflateWebSocket::error), [&] (QAbstractSocket::SocketError) {
+		std::cout << "Error: " << webSocket.errorString().toStdString() << std::endl;
+		app.exit (1);
+	});
+
+	QTimer::singleShot (10000, [&] {
+		std::cout << "Timeout, " << received << " of " << messages.size() << " messages received" << std::endl;
+		app.exit (1);
+	});
+
+	webSocket.setCompressionEnabled (true);
+	webSocket.open (url);
+	int ret = app.exec ();
+
+	const WebSocketCompressionStats& stats = webSocket.compressionStats ();
+	std::cout << "Received " << received << " messages, " << mismatched << " mismatched" << std::endl;
+	std::cout << "Compressed messages: " << stats.compressedMessages << ", uncompressed: " << stats.uncompressedMessages << std::endl;
+	std::cout << "Sent " << stats.sentPayloadBytes << " bytes, " << stats.sentWireBytes << " on wire, ratio " << stats.sendRatio() << std::endl;
+	std::cout << "Received " << stats.receivedPayloadBytes << " bytes, " << stats.receivedWireBytes << " on wire, ratio " << stats.receiveRatio() << std::endl;
+	std::cout << (ret == 0 ? "OK" : "FAILED") << std::endl;
+	return ret;
+}